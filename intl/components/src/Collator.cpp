@@ -27,11 +27,8 @@ Result<UniquePtr<Collator>, ICUError> Collator::TryCreate(const char* aLocale) {
   return MakeUnique<Collator>(collator);
 };
 
-int32_t Collator::CompareStrings(Span<const char16_t> aSource,
-                                 Span<const char16_t> aTarget) const {
-  switch (ucol_strcoll(mCollator.GetConst(), aSource.data(),
-                       static_cast<int32_t>(aSource.size()), aTarget.data(),
-                       static_cast<int32_t>(aTarget.size()))) {
+static int32_t ToCompareResult(UCollationResult aResult) {
+  switch (aResult) {
     case UCOL_LESS:
       return -1;
     case UCOL_EQUAL:
@@ -43,6 +40,25 @@ int32_t Collator::CompareStrings(Span<const char16_t> aSource,
   return 0;
 }
 
+int32_t Collator::CompareStrings(Span<const char16_t> aSource,
+                                 Span<const char16_t> aTarget) const {
+  return ToCompareResult(ucol_strcoll(
+      mCollator.GetConst(), aSource.data(),
+      static_cast<int32_t>(aSource.size()), aTarget.data(),
+      static_cast<int32_t>(aTarget.size())));
+}
+
+int32_t Collator::CompareStringsUTF8(Span<const char> aSource,
+                                     Span<const char> aTarget) const {
+  UErrorCode status = U_ZERO_ERROR;
+  UCollationResult result = ucol_strcollUTF8(
+      mCollator.GetConst(), aSource.data(),
+      static_cast<int32_t>(aSource.size()), aTarget.data(),
+      static_cast<int32_t>(aTarget.size()), &status);
+  MOZ_ASSERT(U_SUCCESS(status), "ucol_strcollUTF8 only fails on bad input");
+  return ToCompareResult(result);
+}
+
 int32_t Collator::CompareSortKeys(Span<const uint8_t> aKey1,
                                   Span<const uint8_t> aKey2) const {
   size_t minLength = std::min(aKey1.Length(), aKey2.Length());
@@ -9,12 +9,15 @@
 #define js_CompilationAndEvaluation_h
 
 #include <stddef.h>  // size_t
+#include <stdint.h>  // uint32_t
 #include <stdio.h>   // FILE
 
 #include "jstypes.h"  // JS_PUBLIC_API
 
-#include "js/RootingAPI.h"  // JS::Handle, JS::MutableHandle
+#include "js/AllocPolicy.h"  // js::SystemAllocPolicy
+#include "js/RootingAPI.h"   // JS::Handle, JS::MutableHandle
 #include "js/TypeDecls.h"
+#include "js/Vector.h"  // js::Vector
 
 struct JS_PUBLIC_API JSContext;
 class JS_PUBLIC_API JSFunction;
@@ -230,6 +233,22 @@ extern JS_PUBLIC_API bool UpdateDebugMetadata(
     HandleValue privateValue, HandleString elementAttributeName,
     HandleScript introScript, HandleScript scriptOrModule);
 
+using DelazificationOrderVector =
+    js::Vector<uint32_t, 0, js::SystemAllocPolicy>;
+
+/*
+ * Append to |offsets| the source start offsets of the functions of the source
+ * of |script| which have been delazified on demand so far, in the order in
+ * which they were delazified. This is the order in which these functions were
+ * first called.
+ *
+ * The result can be given to CompileOptions::setDelazificationOrder when
+ * compiling the same source again, such that helper threads delazify these
+ * functions ahead of their use.
+ */
+extern JS_PUBLIC_API bool GetDelazificationOrder(
+    JSContext* cx, Handle<JSScript*> script, DelazificationOrderVector& offsets);
+
 } /* namespace JS */
 
 #endif /* js_CompilationAndEvaluation_h */
@@ -69,10 +69,14 @@
 
 namespace js {
 class FrontendContext;
+namespace frontend {
+struct InitialStencilAndDelazifications;
+}  // namespace frontend
 }  // namespace js
 
 namespace JS {
 using FrontendContext = js::FrontendContext;
+using Stencil = js::frontend::InitialStencilAndDelazifications;
 
 enum class AsmJSOption : uint8_t {
   Enabled,
@@ -103,6 +107,20 @@ enum class AsmJSOption : uint8_t {
    */                                                                          \
   _(ConcurrentLargeFirst)                                                      \
                                                                                \
+  /*                                                                           \
+   * Delazify only the functions listed by CompileOptions::                    \
+   * setDelazificationOrder, in that order.                                    \
+   */                                                                          \
+  _(ConcurrentRecordedOrder)                                                   \
+                                                                               \
+  /*                                                                           \
+   * Parse top-level functions lazily, then delazify all functions on          \
+   * helper threads, splitting the top-level functions between multiple        \
+   * tasks. Compilations on the main thread wait for all delazifications,      \
+   * such that the resulting Stencil is fully parsed.                          \
+   */                                                                          \
+  _(ParseEverythingConcurrently)                                               \
+                                                                               \
   /*                                                                           \
    * Parse everything eagerly, from the first parse.                           \
    *                                                                           \
@@ -250,6 +268,15 @@ class JS_PUBLIC_API TransitiveCompileOptions {
 
   const char16_t* sourceMapURL_ = nullptr;
 
+  // Source start offsets of the functions to delazify with the
+  // ConcurrentRecordedOrder strategy.
+  const uint32_t* delazificationOrder_ = nullptr;
+  size_t delazificationOrderLength_ = 0;
+
+  // A previous compilation of the same global script, whose functions are
+  // reused where the source text is unchanged.
+  JS::Stencil* previousStencil_ = nullptr;
+
   // POD options:
   // WARNING: When adding new fields, don't forget to add them to
   //          copyPODTransitiveOptions.
@@ -332,6 +359,18 @@ class JS_PUBLIC_API TransitiveCompileOptions {
   // called. There is currently no mechanism to release the data sooner.
   bool usePinnedBytecode = false;
 
+  // When decoding from XDR, do not hash the whole buffer to compare it against
+  // the hash recorded by the encoder. Combined with `borrowBuffer` and
+  // `usePinnedBytecode`, this makes the decoding cost proportional to the
+  // number of atoms, scopes and scripts rather than to the buffer size, such
+  // that a memory-mapped cache file can be used in place.
+  //
+  // NOTE: This must only be set when the integrity of the buffer is already
+  //       checked by the embedding. The decoder only checks reads against the
+  //       bounds of the buffer, and a corrupted buffer can yield an invalid
+  //       Stencil.
+  bool skipContentHashCheck = false;
+
   // De-optimize ES module's top-level `var`s, in order to define all of them
   // on the ModuleEnvironmentObject, instead of local slot.
   //
@@ -386,17 +425,22 @@ class JS_PUBLIC_API TransitiveCompileOptions {
   bool consumeDelazificationCache() const {
     return eagerDelazificationIsOneOf<
         DelazificationOption::ConcurrentDepthFirst,
-        DelazificationOption::ConcurrentLargeFirst>();
+        DelazificationOption::ConcurrentLargeFirst,
+        DelazificationOption::ConcurrentRecordedOrder,
+        DelazificationOption::ParseEverythingConcurrently>();
   }
   bool populateDelazificationCache() const {
     return eagerDelazificationIsOneOf<
         DelazificationOption::CheckConcurrentWithOnDemand,
         DelazificationOption::ConcurrentDepthFirst,
-        DelazificationOption::ConcurrentLargeFirst>();
+        DelazificationOption::ConcurrentLargeFirst,
+        DelazificationOption::ConcurrentRecordedOrder,
+        DelazificationOption::ParseEverythingConcurrently>();
   }
   bool waitForDelazificationCache() const {
     return eagerDelazificationIsOneOf<
-        DelazificationOption::CheckConcurrentWithOnDemand>();
+        DelazificationOption::CheckConcurrentWithOnDemand,
+        DelazificationOption::ParseEverythingConcurrently>();
   }
   bool checkDelazificationCache() const {
     return eagerDelazificationIsOneOf<
@@ -424,6 +468,11 @@ class JS_PUBLIC_API TransitiveCompileOptions {
   JS::ConstUTF8CharsZ filename() const { return filename_; }
   JS::ConstUTF8CharsZ introducerFilename() const { return introducerFilename_; }
   const char16_t* sourceMapURL() const { return sourceMapURL_; }
+  const uint32_t* delazificationOrder() const { return delazificationOrder_; }
+  size_t delazificationOrderLength() const {
+    return delazificationOrderLength_;
+  }
+  JS::Stencil* previousStencil() const { return previousStencil_; }
 
   const PrefableCompileOptions& prefableOptions() const {
     return prefableOptions_;
@@ -454,6 +503,7 @@ class JS_PUBLIC_API TransitiveCompileOptions {
     PrintFields_(topLevelAwait);
     PrintFields_(borrowBuffer);
     PrintFields_(usePinnedBytecode);
+    PrintFields_(skipContentHashCheck);
     PrintFields_(deoptimizeModuleGlobalVars);
     PrintFields_(introductionType);
     PrintFields_(introductionLineno);
@@ -612,6 +662,9 @@ class MOZ_STACK_CLASS JS_PUBLIC_API CompileOptions final
     filename_ = rhs.filename();
     introducerFilename_ = rhs.introducerFilename();
     sourceMapURL_ = rhs.sourceMapURL();
+    delazificationOrder_ = rhs.delazificationOrder();
+    delazificationOrderLength_ = rhs.delazificationOrderLength();
+    previousStencil_ = rhs.previousStencil();
   }
 
   // Construct a CompileOption in the context where JSContext is not available.
@@ -742,6 +795,27 @@ class MOZ_STACK_CLASS JS_PUBLIC_API CompileOptions final
     return *this;
   }
 
+  // Delazify off thread the functions starting at the |length| source offsets
+  // in |offsets|, in that order, typically as returned by
+  // JS::GetDelazificationOrder during an earlier run. |offsets| must outlive
+  // these options.
+  CompileOptions& setDelazificationOrder(const uint32_t* offsets,
+                                         size_t length) {
+    delazificationOrder_ = offsets;
+    delazificationOrderLength_ = length;
+    return setEagerDelazificationStrategy(
+        DelazificationOption::ConcurrentRecordedOrder);
+  }
+
+  // Compile a global script whose source text is an edit of the source text
+  // of |stencil|. Top-level functions whose text is unchanged are not parsed
+  // again, and are copied from |stencil| instead. |stencil| must have been
+  // compiled with the same options, and must outlive these options.
+  CompileOptions& setPreviousStencil(JS::Stencil* stencil) {
+    previousStencil_ = stencil;
+    return *this;
+  }
+
   CompileOptions& setForceStrictMode() {
     forceStrictMode_ = true;
     return *this;
@@ -833,6 +907,7 @@ class JS_PUBLIC_API ReadOnlyDecodeOptions {
  public:
   bool borrowBuffer = false;
   bool usePinnedBytecode = false;
+  bool skipContentHashCheck = false;
 
  protected:
   JS::ConstUTF8CharsZ introducerFilename_;
@@ -854,6 +929,7 @@ class JS_PUBLIC_API ReadOnlyDecodeOptions {
   void copyPODOptionsFrom(const T& options) {
     borrowBuffer = options.borrowBuffer;
     usePinnedBytecode = options.usePinnedBytecode;
+    skipContentHashCheck = options.skipContentHashCheck;
     introductionType = options.introductionType;
     introductionLineno = options.introductionLineno;
     introductionOffset = options.introductionOffset;
@@ -863,6 +939,7 @@ class JS_PUBLIC_API ReadOnlyDecodeOptions {
   void copyPODOptionsTo(T& options) const {
     options.borrowBuffer = borrowBuffer;
     options.usePinnedBytecode = usePinnedBytecode;
+    options.skipContentHashCheck = skipContentHashCheck;
     options.introductionType = introductionType;
     options.introductionLineno = introductionLineno;
     options.introductionOffset = introductionOffset;
@@ -494,6 +494,47 @@ typedef enum JSGCParamKey {
    * collections is less than that specified by JSGC_HIGH_FREQUENCY_TIME_LIMIT.
    */
   JSGC_HIGH_FREQUENCY_MODE = 56,
+
+  /**
+   * Whether to ask the OS to back newly allocated GC chunks, including nursery
+   * chunks, with transparent huge pages.
+   *
+   * Huge pages are larger than GC chunks so this is only effective for runs of
+   * adjacent chunks. While enabled, free arenas inside chunks that are in use
+   * are not decommitted as this would split huge pages.
+   *
+   * This is only supported on Linux. Setting it elsewhere fails.
+   *
+   * Pref: None
+   * Default: HugePagesEnabled
+   */
+  JSGC_HUGE_PAGES_ENABLED = 57,
+
+  /**
+   * Target for committed GC chunk memory in MB, or zero to disable.
+   *
+   * When committed chunk memory is above this target after a minor GC and no
+   * major GC is in progress, a background task decommits empty chunks and
+   * free arenas until the target is met. This smooths the growth in RSS that
+   * otherwise happens between major GCs.
+   *
+   * Pref: None
+   * Default: ScavengeTargetMB
+   */
+  JSGC_SCAVENGE_TARGET_MB = 58,
+
+  /**
+   * Whether to ask the OS to place newly allocated GC chunks on the NUMA node
+   * of the CPU running the main thread. The node is sampled when the parameter
+   * is set and at the start of each major GC, so chunks allocated by the
+   * background allocation task also follow the main thread.
+   *
+   * This is only supported on Linux. Setting it elsewhere fails.
+   *
+   * Pref: None
+   * Default: NumaLocalChunks
+   */
+  JSGC_NUMA_LOCAL_CHUNKS = 59,
 } JSGCParamKey;
 
 /*
@@ -607,6 +648,7 @@ namespace JS {
   D(RESET, 9)                                                          \
   D(OUT_OF_NURSERY, 10)                                                \
   D(EVICT_NURSERY, 11)                                                 \
+  D(REALM_OVER_BUDGET, 12)                                             \
   D(SHARED_MEMORY_LIMIT, 13)                                           \
   D(EAGER_NURSERY_COLLECTION, 14)                                      \
   D(BG_TASK_FINISHED, 15)                                              \
@@ -961,6 +1003,35 @@ extern JS_PUBLIC_API bool AddGCNurseryCollectionCallback(
 extern JS_PUBLIC_API void RemoveGCNurseryCollectionCallback(
     JSContext* cx, GCNurseryCollectionCallback callback, void* data);
 
+/**
+ * Realms keep an approximate count of the bytes of GC things and cell buffers
+ * allocated on their behalf since their zone was last collected. Allocations
+ * made directly by JIT code are counted per allocation site at the next minor
+ * GC, so the count lags allocation and is intended for finding which realm is
+ * responsible for allocation pressure rather than strict enforcement.
+ */
+extern JS_PUBLIC_API size_t GetRealmGCAllocBytes(JS::Realm* realm);
+
+/**
+ * Set a soft limit on a realm's allocation count. Zero means no limit.
+ *
+ * The limit is checked after each minor GC. The first time a realm is found
+ * to be over its limit after its zone has been collected, the realm over
+ * budget callback is called if set. If there is no callback, or the callback
+ * returns true, a major GC of the realm's zone is requested.
+ */
+extern JS_PUBLIC_API void SetRealmGCAllocSoftLimit(JS::Realm* realm,
+                                                   size_t limitBytes);
+
+/**
+ * Implementations of this callback MUST NOT do anything that can cause GC.
+ */
+using RealmOverBudgetCallback = bool (*)(JSContext* cx, JS::Realm* realm,
+                                         size_t allocBytes, void* data);
+
+extern JS_PUBLIC_API void SetRealmOverBudgetCallback(
+    JSContext* cx, RealmOverBudgetCallback callback, void* data);
+
 typedef void (*DoCycleCollectionCallback)(JSContext* cx);
 
 /**
@@ -1306,6 +1377,12 @@ extern JS_PUBLIC_API JSString* JS_NewMaybeExternalUCString(
  *
  * Create an external Latin1 string if the utf8 buffer contains only ASCII
  * chars, otherwise copy the chars into a non-external string.
+ *
+ * The ASCII case is zero-copy: the UTF-8 buffer is used directly as the
+ * string's Latin1 chars. Non-ASCII input is transcoded eagerly into a Latin1
+ * or TwoByte buffer owned by the engine, because linear strings must expose
+ * their chars in one of those two encodings and there is no string kind that
+ * defers inflation until the chars are first needed.
  */
 extern JS_PUBLIC_API JSString* JS_NewMaybeExternalStringUTF8(
     JSContext* cx, const JS::UTF8Chars& utf8,
@@ -1334,6 +1411,24 @@ extern JS_PUBLIC_API GCReason WantEagerMinorGC(JSRuntime* rt);
 
 extern JS_PUBLIC_API GCReason WantEagerMajorGC(JSRuntime* rt);
 
+/**
+ * Pretenuring hints identify allocation sites that have been found to
+ * allocate long-lived objects, by a hash of the script's filename, source
+ * position and the site's bytecode offset. New allocation sites that match a
+ * hint allocate directly in the tenured heap.
+ *
+ * Hints can be exported and later imported into a runtime in another process
+ * that runs the same scripts, to skip the nursery collections needed to learn
+ * them again. Hints are not recorded if JIT hints are disabled.
+ */
+using PretenuringHints = mozilla::Vector<uint32_t>;
+
+extern JS_PUBLIC_API bool GetPretenuringHints(JSContext* cx,
+                                              PretenuringHints& hintsOut);
+
+extern JS_PUBLIC_API bool AddPretenuringHints(JSContext* cx,
+                                              const PretenuringHints& hints);
+
 /**
  * Check whether the nursery should be eagerly collected as per WantEagerMajorGC
  * above, and if so run a collection.
@@ -1348,9 +1443,55 @@ extern JS_PUBLIC_API void RunNurseryCollection(
     JSRuntime* rt, JS::GCReason reason,
     mozilla::TimeDuration aSinceLastMinorGC);
 
+/**
+ * Use an idle period that ends at |deadline| to do GC work.
+ *
+ * If an incremental GC is in progress this runs a slice with a budget that
+ * ends at the deadline. Otherwise this collects the nursery if it wants eager
+ * collection and starts an incremental major GC for any zones that have
+ * reached their eager allocation thresholds, so that this work happens during
+ * the idle period rather than being triggered later by allocation.
+ *
+ * Returns whether any GC work was done.
+ */
+extern JS_PUBLIC_API bool RunIdleTimeGCWork(JSContext* cx, JS::GCReason reason,
+                                            mozilla::TimeStamp deadline);
+
+using DeferredFinalizeOp = void (*)(void* data);
+
+/**
+ * Queue |op| to be called with |data| on the main thread after background
+ * finalization for the current GC has finished.
+ *
+ * This can be called from the finalizer of a class with
+ * JSCLASS_BACKGROUND_FINALIZE, which may run on a helper thread. The finalizer
+ * can do the thread-safe part of its work immediately and defer any work that
+ * must happen on the main thread. Deferred operations are run in a batch, in
+ * the order they were queued, before the GC finishes. They must not GC or run
+ * JS.
+ *
+ * Returns false on OOM, in which case |op| will not be called.
+ */
+extern JS_PUBLIC_API bool DeferFinalizationToMainThread(GCContext* gcx,
+                                                        DeferredFinalizeOp op,
+                                                        void* data);
+
 extern JS_PUBLIC_API void SetHostCleanupFinalizationRegistryCallback(
     JSContext* cx, JSHostCleanupFinalizationRegistryCallback cb, void* data);
 
+/**
+ * Limit the time spent running a single FinalizationRegistry cleanup job. When
+ * a cleanup job exceeds the budget it stops calling the registry's cleanup
+ * callback and the remaining held values are handed back to the embedding as a
+ * new job via the host cleanup callback. This spreads the cleanup work from a
+ * large number of dead targets across several turns of the event loop.
+ *
+ * A zero budget, the default, means cleanup jobs run to completion.
+ * FinalizationRegistry.prototype.cleanupSome is not affected.
+ */
+extern JS_PUBLIC_API void SetFinalizationRegistryCleanupBudget(
+    JSContext* cx, mozilla::TimeDuration budget);
+
 /**
  * Clear kept alive objects in JS WeakRef.
  * https://tc39.es/proposal-weakrefs/#sec-clear-kept-objects
@@ -36,6 +36,13 @@ extern JS_PUBLIC_API void RunHelperThreadTask(HelperThreadTask* task);
 extern JS_PUBLIC_API const char* GetHelperThreadTaskName(
     HelperThreadTask* task);
 
+// Whether the main thread is likely to be waiting for the task to finish, for
+// example parallel GC work or a baseline compilation. Embedders can use this
+// to run such tasks ahead of their own background work. Other tasks, such as
+// delazification or source compression, are speculative and can be deferred.
+extern JS_PUBLIC_API bool IsHelperThreadTaskLatencyCritical(
+    HelperThreadTask* task);
+
 }  // namespace JS
 
 #endif  // js_HelperThreadAPI_h
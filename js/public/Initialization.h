@@ -138,7 +138,9 @@ using SelfHostedWriter = bool (*)(JSContext*, SelfHostedCache);
  * would cause an error.
  *
  * The cached content provided with the Span should remain alive until
- * JS_Shutdown is called.
+ * JS_Shutdown is called. The bytecode is used in place rather than copied, so
+ * the span can point directly into a memory-mapped file, which lets
+ * short-lived processes skip both parsing and copying the self-hosted code.
  *
  * The writer callback given as argument would be called by when the result of
  * the parser is ready to be cached. The writer is in charge of saving the
@@ -162,6 +164,22 @@ JS_PUBLIC_API bool InitSelfHostedCode(JSContext* cx,
                                       SelfHostedCache cache = nullptr,
                                       SelfHostedWriter writer = nullptr);
 
+/*
+ * Add |names| to the permanent atoms of the runtime of |cx|, in addition to
+ * the names used by the engine and by the self-hosted code. Permanent atoms
+ * are never collected, are shared with child runtimes, and are found without
+ * locking when compiled scripts are instantiated. This is meant for the
+ * identifiers which are used by most of the scripts of the embedding, for
+ * example the names of common library functions.
+ *
+ * Names which are not ASCII identifiers are ignored.
+ *
+ * This must be called before JS::InitSelfHostedCode, and |names| must remain
+ * alive until JS::InitSelfHostedCode returns.
+ */
+JS_PUBLIC_API void SetExtraPermanentAtoms(
+    JSContext* cx, mozilla::Span<const char* const> names);
+
 /*
  * Permanently disable the JIT backend for this process. This disables the JS
  * Baseline Interpreter, JIT compilers, regular expression JIT and support for
@@ -10,6 +10,7 @@
 #ifndef js_JSON_h
 #define js_JSON_h
 
+#include <stddef.h>  // size_t
 #include <stdint.h>  // uint32_t
 
 #include "jstypes.h"  // JS_PUBLIC_API
@@ -70,6 +71,36 @@ extern JS_PUBLIC_API bool ToJSON(JSContext* cx, Handle<Value> value,
                                  Handle<Value> space,
                                  JSONWriteCallback callback, void* data);
 
+/**
+ * Receives |len| bytes of UTF-8 output at |buf|. Returning false stops the
+ * serialization.
+ */
+using JSONUTF8WriteCallback = bool (*)(const char* buf, size_t len,
+                                       void* data);
+
+/**
+ * The largest number of bytes passed to a JSONUTF8WriteCallback at once.
+ */
+static constexpr size_t JSONUTF8ChunkSize = 4096;
+
+/**
+ * Performs the JSON.stringify operation like ToJSON, but writes the output as
+ * UTF-8, in chunks of at most JSONUTF8ChunkSize bytes, by any number of calls
+ * to |callback|.
+ *
+ * No string is created for the output, and most of it is written while the
+ * value is being serialized, so the whole output is not buffered for large
+ * values.
+ *
+ * In cases where JSON.stringify would return undefined, this function does not
+ * call |callback| at all.
+ */
+extern JS_PUBLIC_API bool ToJSONUTF8(JSContext* cx, Handle<Value> value,
+                                     Handle<JSObject*> replacer,
+                                     Handle<Value> space,
+                                     JSONUTF8WriteCallback callback,
+                                     void* data);
+
 } /* namespace JS */
 
 /**
@@ -113,6 +144,44 @@ extern JS_PUBLIC_API bool JS_ParseJSONWithReviver(
 
 namespace JS {
 
+class JSONChunkedParser;
+
+/**
+ * Parse JSON text which is received as a sequence of UTF-8 chunks, such as the
+ * body of a network response.
+ *
+ * Each chunk is decoded when it is appended, and can be freed by the caller
+ * right away. A UTF-8 sequence may be split across chunks. The decoded text is
+ * kept as Latin-1 as long as it is ASCII, and is parsed directly by
+ * FinishJSONChunkedParse, without creating a string for it.
+ *
+ * Malformed UTF-8 is reported as an error by AppendJSONChunk or by
+ * FinishJSONChunkedParse. The parser must be deleted with
+ * DeleteJSONChunkedParser, even after an error.
+ */
+extern JS_PUBLIC_API JSONChunkedParser* NewJSONChunkedParser(JSContext* cx);
+
+extern JS_PUBLIC_API bool AppendJSONChunk(JSContext* cx,
+                                          JSONChunkedParser* parser,
+                                          const char* bytes, size_t length);
+
+extern JS_PUBLIC_API bool FinishJSONChunkedParse(
+    JSContext* cx, JSONChunkedParser* parser,
+    JS::MutableHandle<JS::Value> vp);
+
+extern JS_PUBLIC_API void DeleteJSONChunkedParser(JSONChunkedParser* parser);
+
+/**
+ * Performs the JSON.parse operation as specified by ECMAScript on UTF-8 text,
+ * without decoding it into a string or a char16_t buffer first.
+ *
+ * String values are created directly from the UTF-8 input, and use Latin-1
+ * storage when possible. Malformed UTF-8 in a string is reported as an error.
+ */
+extern JS_PUBLIC_API bool ParseJSONUTF8(JSContext* cx, const char* bytes,
+                                        size_t length,
+                                        JS::MutableHandle<JS::Value> vp);
+
 /**
  * Returns true if the given text is valid JSON.
  */
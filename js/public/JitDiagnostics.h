@@ -0,0 +1,175 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+ * vim: set ts=8 sts=2 et sw=2 tw=80:
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * API for inspecting the state of the JITs in release builds. These functions
+ * are cheap enough to be called periodically by an embedding to find code that
+ * the JITs handle badly.
+ */
+
+#ifndef js_JitDiagnostics_h
+#define js_JitDiagnostics_h
+
+#include <stddef.h>  // size_t
+#include <stdint.h>  // uint32_t, uint64_t
+
+#include "jstypes.h"  // JS_PUBLIC_API
+
+#include "js/AllocPolicy.h"  // js::SystemAllocPolicy
+#include "js/TypeDecls.h"    // JSContext, JS::Realm
+#include "js/Utility.h"      // JS::UniqueChars
+#include "js/Vector.h"       // js::Vector
+
+namespace JS {
+
+/**
+ * Bailout and invalidation counters for a single script. Ion code for a
+ * script that keeps bailing out is invalidated and recompiled; a script with a
+ * high invalidation count relative to its Ion compile count is likely stuck in
+ * an invalidation loop.
+ *
+ * The counters live on the script's JitScript and are reset if the JitScript
+ * is discarded.
+ */
+struct JitThrashingScriptInfo {
+  JS::UniqueChars filename;
+  uint32_t lineno = 0;
+  uint32_t column = 0;  // One-origin.
+
+  uint32_t bailouts = 0;
+  uint32_t invalidations = 0;
+  uint32_t ionCompiles = 0;
+};
+
+using JitThrashingScriptVector =
+    js::Vector<JitThrashingScriptInfo, 0, js::SystemAllocPolicy>;
+
+/**
+ * Append to |scripts| up to |maxScripts| scripts in the runtime that have
+ * bailed out of Ion code, ordered by descending invalidation count and then by
+ * descending bailout count. Returns false and reports OOM on failure.
+ */
+extern JS_PUBLIC_API bool GetJitThrashingScripts(
+    JSContext* cx, size_t maxScripts, JitThrashingScriptVector& scripts);
+
+struct JitBailoutKindCount {
+  // Static string naming the bailout kind.
+  const char* kind = nullptr;
+  uint64_t count = 0;
+};
+
+using JitBailoutKindCountVector =
+    js::Vector<JitBailoutKindCount, 0, js::SystemAllocPolicy>;
+
+/**
+ * Append to |counts| the number of Ion bailouts in the runtime for every
+ * bailout kind that has occurred at least once. Returns false and reports OOM
+ * on failure.
+ */
+extern JS_PUBLIC_API bool GetJitBailoutKindCounts(
+    JSContext* cx, JitBailoutKindCountVector& counts);
+
+enum class ICHealthMode : uint8_t {
+  // The IC has at most one optimized stub.
+  Monomorphic,
+  // The IC has several optimized stubs.
+  Polymorphic,
+  // The IC has transitioned to megamorphic stubs.
+  Megamorphic,
+  // The IC failed to attach too often and only uses the generic fallback.
+  Generic
+};
+
+/**
+ * The state of a single inline cache. |pcOffset| is the bytecode offset of the
+ * IC in its script; it is not translated to a line number to keep collection
+ * cheap.
+ */
+struct ICHealthEntry {
+  uint32_t pcOffset = 0;
+  // Static string naming the bytecode op.
+  const char* op = nullptr;
+  ICHealthMode mode = ICHealthMode::Monomorphic;
+  uint32_t numStubs = 0;
+  // Failed attempts to attach a stub since the IC last changed mode.
+  uint32_t numFailures = 0;
+  // Number of times the fallback stub was entered.
+  uint32_t fallbackCount = 0;
+};
+
+using ICHealthEntryVector = js::Vector<ICHealthEntry, 0, js::SystemAllocPolicy>;
+
+struct ScriptICHealth {
+  JS::UniqueChars filename;
+  uint32_t lineno = 0;
+  uint32_t column = 0;  // One-origin.
+  uint32_t warmUpCount = 0;
+  ICHealthEntryVector entries;
+};
+
+using ScriptICHealthVector =
+    js::Vector<ScriptICHealth, 0, js::SystemAllocPolicy>;
+
+/**
+ * Append to |scripts| the state of the inline caches of every script in
+ * |realm| that has a JitScript. ICs which have never been entered are
+ * skipped, as are monomorphic ICs without failures unless |includeMonomorphic|
+ * is true. Scripts with no remaining entries are omitted. Returns false and
+ * reports OOM on failure.
+ */
+extern JS_PUBLIC_API bool GetRealmICHealth(JSContext* cx, JS::Realm* realm,
+                                           bool includeMonomorphic,
+                                           ScriptICHealthVector& scripts);
+
+struct MegamorphicCacheStats {
+  uint64_t misses = 0;
+  // Misses which replaced a valid entry for a different shape or key.
+  uint64_t evictions = 0;
+  // Number of times all entries were invalidated.
+  uint64_t invalidations = 0;
+};
+
+/**
+ * Get counters for the runtime's megamorphic property lookup cache (used for
+ * megamorphic GetProp and HasProp) and for its megamorphic SetProp cache. Hits
+ * are not counted; a high miss count relative to megamorphic IC activity
+ * suggests shapes that conflict in the cache.
+ */
+extern JS_PUBLIC_API void GetMegamorphicCacheStats(
+    JSContext* cx, MegamorphicCacheStats* getPropStats,
+    MegamorphicCacheStats* setPropStats);
+
+/**
+ * Enable or disable wasm function sampling on |cx|. While it is enabled, each
+ * interrupt taken by running wasm code (see JS_RequestInterruptCallback) is
+ * counted against the wasm function it interrupted. An embedding can sample
+ * by requesting interrupts from another thread at a fixed interval. The wasm
+ * code runs no profiling instrumentation. Wasm code checks for interrupts in
+ * function prologues and at loop headers, so that is where samples land.
+ */
+extern JS_PUBLIC_API void SetWasmFunctionSampling(JSContext* cx,
+                                                  bool enabled);
+
+struct WasmFunctionSampleCount {
+  uint32_t funcIndex = 0;
+  uint32_t samples = 0;
+};
+
+using WasmFunctionSampleVector =
+    js::Vector<WasmFunctionSampleCount, 0, js::SystemAllocPolicy>;
+
+/**
+ * Append to |samples| the sample count of every function of the
+ * WebAssembly.Instance |instance| that has been sampled at least once, in
+ * function index order. Returns false and reports an error if |instance| is
+ * not a WebAssembly.Instance or on OOM.
+ */
+extern JS_PUBLIC_API bool GetWasmFunctionSamples(
+    JSContext* cx, JSObject* instance, WasmFunctionSampleVector& samples);
+
+}  // namespace JS
+
+#endif  // js_JitDiagnostics_h
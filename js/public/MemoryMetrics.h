@@ -772,6 +772,7 @@ struct RealmStats {
   MACRO(Other, MallocHeap, baselineData)          \
   MACRO(Other, MallocHeap, allocSites)            \
   MACRO(Other, MallocHeap, ionData)               \
+  MACRO(Other, MallocHeap, ionSnapshots)          \
   MACRO(Other, MallocHeap, jitScripts)            \
   MACRO(Other, MallocHeap, realmObject)           \
   MACRO(Other, MallocHeap, realmTables)           \
@@ -903,6 +904,37 @@ struct RuntimeStats {
 #undef FOR_EACH_SIZE
 };
 
+/**
+ * A cheap summary of a runtime's memory usage, assembled from counters that
+ * the GC already maintains. Unlike CollectRuntimeStats this does not walk the
+ * heap, so its cost is proportional to the number of zones rather than the
+ * number of cells, and it does not finish an ongoing incremental GC.
+ */
+struct RuntimeSummarySizes {
+  // |gcHeapChunkTotal| includes |gcHeapUnusedChunks|. |gcHeapArenas| is the
+  // size of the allocated arenas in all zones, including unused cells and
+  // arena headers. |gcBuffers*| are only measured when no major GC is in
+  // progress or sweeping in the background, and are left at zero otherwise.
+#define FOR_EACH_SIZE(MACRO)                  \
+  MACRO(_, Ignore, gcHeapChunkTotal)          \
+  MACRO(_, GCHeapUnused, gcHeapUnusedChunks)  \
+  MACRO(_, GCHeapUsed, gcHeapArenas)          \
+  MACRO(_, MallocHeap, mallocHeap)            \
+  MACRO(_, NonHeap, jitCode)                  \
+  MACRO(_, NonHeap, nurseryCommitted)         \
+  MACRO(_, GCHeapUsed, gcBuffersUsed)         \
+  MACRO(_, GCHeapUnused, gcBuffersFree)       \
+  MACRO(_, GCHeapAdmin, gcBuffersAdmin)
+
+  RuntimeSummarySizes() = default;
+
+  FOR_EACH_SIZE(DECL_SIZE_ZERO);
+
+  size_t zoneCount = 0;
+
+#undef FOR_EACH_SIZE
+};
+
 class ObjectPrivateVisitor {
  public:
   // Within CollectRuntimeStats, this method is called for each JS object
@@ -925,6 +957,9 @@ extern JS_PUBLIC_API bool CollectRuntimeStats(JSContext* cx,
                                               ObjectPrivateVisitor* opv,
                                               bool anonymize);
 
+extern JS_PUBLIC_API void CollectRuntimeSummarySizes(
+    JSContext* cx, RuntimeSummarySizes* sizes);
+
 extern JS_PUBLIC_API size_t SystemCompartmentCount(JSContext* cx);
 extern JS_PUBLIC_API size_t UserCompartmentCount(JSContext* cx);
 
@@ -16,7 +16,9 @@
 #include "js/AllocPolicy.h"     // js::SystemAllocPolicy
 #include "js/ColumnNumber.h"    // JS::ColumnNumberOneOrigin
 #include "js/CompileOptions.h"  // JS::ReadOnlyCompileOptions
+#include "js/GCVector.h"        // JS::StackGCVector
 #include "js/RootingAPI.h"      // JS::{Mutable,}Handle
+#include "js/Utility.h"         // JS::UniqueChars
 #include "js/Value.h"           // JS::Value
 #include "js/Vector.h"          // js::Vector
 
@@ -34,6 +36,10 @@ namespace mozilla {
 union Utf8Unit;
 }
 
+namespace js {
+class ModuleGraphCompilation;
+}  // namespace js
+
 namespace JS {
 
 // This enum is used to index into an array, and we assume that we have
@@ -335,6 +341,89 @@ extern JS_PUBLIC_API void ClearModuleEnvironment(JSObject* moduleObj);
 
 extern JS_PUBLIC_API bool ModuleIsLinked(JSObject* moduleObj);
 
+using ModuleGraphCompilation = js::ModuleGraphCompilation;
+
+/**
+ * Embedding hooks used to discover and load the modules of a module graph
+ * compiled with StartModuleGraphCompilation.
+ *
+ * |resolve| and |fetch| are called on helper threads, possibly concurrently
+ * with each other, and must not use any JSContext.
+ */
+class JS_PUBLIC_API ModuleGraphLoader {
+ public:
+  virtual ~ModuleGraphLoader() = default;
+
+  /*
+   * Set |key| to the key of the module imported by |specifier| from the
+   * module with key |referrerKey|. Requests which resolve to the same key
+   * share a single module. Return false to fail the compilation.
+   */
+  virtual bool resolve(const char* referrerKey, const char* specifier,
+                       JS::UniqueChars& key) = 0;
+
+  /*
+   * Initialize |source| with the source text of the module with key |key|.
+   * Return false to fail the compilation.
+   */
+  virtual bool fetch(const char* key,
+                     JS::SourceText<mozilla::Utf8Unit>& source) = 0;
+
+  /*
+   * Called once every module of the graph has been compiled, or as soon as
+   * the compilation failed. This is called on a helper thread, or on the
+   * thread calling StartModuleGraphCompilation if helper threads are
+   * disabled. The embedding must then call FinishModuleGraphCompilation on
+   * the thread of the context which started the compilation.
+   */
+  virtual void onFinished(ModuleGraphCompilation* compilation) = 0;
+};
+
+/**
+ * Start compiling, on helper threads, the module with key |rootKey| and all
+ * the modules it transitively imports. Every module is compiled to a stencil
+ * as soon as its importer has been compiled, so independent modules are
+ * compiled in parallel.
+ *
+ * Import attributes are not supported; a module graph using them fails to
+ * compile.
+ *
+ * |loader| must stay alive until its onFinished method is called. Returns
+ * nullptr and reports an error if the compilation could not be started, in
+ * which case onFinished is never called.
+ */
+extern JS_PUBLIC_API ModuleGraphCompilation* StartModuleGraphCompilation(
+    JSContext* cx, const ReadOnlyCompileOptions& options, const char* rootKey,
+    ModuleGraphLoader* loader);
+
+struct ModuleGraphEntry {
+  JS::UniqueChars key;
+
+  // For each of the module's requested modules, in the order used by
+  // GetRequestedModuleSpecifier, the index of the entry it resolved to.
+  js::Vector<uint32_t, 0, js::SystemAllocPolicy> requestedModules;
+};
+
+using ModuleGraphEntryVector =
+    js::Vector<ModuleGraphEntry, 0, js::SystemAllocPolicy>;
+
+/**
+ * Instantiate the stencils of a finished module graph compilation and destroy
+ * |compilation|.
+ *
+ * On success, |modules| and |entries| are filled with one module object and
+ * one entry per module of the graph, with the root module first. Linking is
+ * left to the embedding, whose module resolve hook can use |entries| to find
+ * the module each request resolved to without resolving specifiers again.
+ *
+ * Returns false and reports the error which made the compilation fail, if
+ * any.
+ */
+extern JS_PUBLIC_API bool FinishModuleGraphCompilation(
+    JSContext* cx, ModuleGraphCompilation* compilation,
+    MutableHandle<StackGCVector<JSObject*>> modules,
+    ModuleGraphEntryVector& entries);
+
 }  // namespace JS
 
 #endif  // js_Modules_h
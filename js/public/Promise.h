@@ -593,6 +593,13 @@ class JS_PUBLIC_API Dispatchable {
  * one-way transition: once the callback has rejected a runnable, it must reject
  * all subsequently submitted runnables as well.
  *
+ * Dispatchables don't need an event loop task each. An embedding that sees
+ * bursts of them, such as many concurrent asynchronous WebAssembly
+ * compilations, can append them to its own queue and only schedule a task when
+ * that queue becomes non-empty, running every queued Dispatchable (or as many
+ * as its time budget allows) from that task. The internal job queue selected
+ * by js::UseInternalJobQueues drains its queue this way.
+ *
  * To establish a DispatchToEventLoopCallback, the embedding may either call
  * InitDispatchToEventLoop to provide its own, or call js::UseInternalJobQueues
  * to select a default implementation built into SpiderMonkey. This latter
@@ -0,0 +1,102 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/* Batched property access for embedders. */
+
+#ifndef js_PropertyAccessPlan_h
+#define js_PropertyAccessPlan_h
+
+#include <stddef.h>  // size_t
+#include <stdint.h>  // uint32_t
+
+#include "jstypes.h"  // JS_PUBLIC_API
+
+#include "js/AllocPolicy.h"  // js::SystemAllocPolicy
+#include "js/Id.h"           // jsid
+#include "js/RootingAPI.h"   // JS::Handle, JS::MutableHandle
+#include "js/TypeDecls.h"    // JS::MutableHandleValueVector
+#include "js/Vector.h"       // js::Vector
+
+struct JSContext;
+class JSObject;
+class JSTracer;
+
+namespace js {
+class Shape;
+}  // namespace js
+
+namespace JS {
+
+class HandleValueArray;
+
+/**
+ * A fixed list of property keys that is read from or written to many objects
+ * with a single call, for example when converting JS objects to native
+ * structs.
+ *
+ * The plan remembers where the keys are stored for the last shape of object it
+ * was used with. If every key is a plain own data property of such objects,
+ * later calls on objects with the same shape load or store the slots directly
+ * instead of looking up each key. In all other cases each key goes through the
+ * normal [[Get]] or [[Set]].
+ *
+ * A plan holds GC pointers and must be rooted, e.g. with
+ * JS::PersistentRooted<JS::PropertyAccessPlan>.
+ */
+class JS_PUBLIC_API PropertyAccessPlan {
+  js::Vector<jsid, 8, js::SystemAllocPolicy> ids_;
+
+  // The slots of |ids_| on objects with shape |shape_|, or no shape if
+  // nothing is cached.
+  js::Vector<uint32_t, 8, js::SystemAllocPolicy> slots_;
+  js::Shape* shape_ = nullptr;
+
+  // Whether every cached slot can be written without further checks.
+  bool slotsWritable_ = false;
+
+  friend JS_PUBLIC_API bool GetProperties(
+      JSContext* cx, Handle<JSObject*> obj,
+      MutableHandle<PropertyAccessPlan> plan, MutableHandleValueVector vp);
+  friend JS_PUBLIC_API bool SetProperties(
+      JSContext* cx, Handle<JSObject*> obj,
+      MutableHandle<PropertyAccessPlan> plan, const HandleValueArray& values);
+
+  void updateCache(JSObject* obj);
+
+ public:
+  PropertyAccessPlan() = default;
+
+  // Set the keys of the plan. This clears any cached shape.
+  [[nodiscard]] bool init(JSContext* cx, const char* const* names,
+                          size_t count);
+  [[nodiscard]] bool init(JSContext* cx, const jsid* ids, size_t count);
+
+  size_t length() const { return ids_.length(); }
+  jsid id(size_t i) const { return ids_[i]; }
+
+  void trace(JSTracer* trc);
+};
+
+/**
+ * Get every property in |plan| from |obj|, storing the values in |vp| in the
+ * order of the plan's keys. This is equivalent to calling JS_GetPropertyById
+ * for each key.
+ */
+extern JS_PUBLIC_API bool GetProperties(JSContext* cx, Handle<JSObject*> obj,
+                                        MutableHandle<PropertyAccessPlan> plan,
+                                        MutableHandleValueVector vp);
+
+/**
+ * Set every property in |plan| on |obj| to the corresponding value in
+ * |values|, whose length must equal the plan's. This is equivalent to calling
+ * JS_SetPropertyById for each key.
+ */
+extern JS_PUBLIC_API bool SetProperties(JSContext* cx, Handle<JSObject*> obj,
+                                        MutableHandle<PropertyAccessPlan> plan,
+                                        const HandleValueArray& values);
+
+}  // namespace JS
+
+#endif /* js_PropertyAccessPlan_h */
@@ -404,7 +404,8 @@ namespace detail {
 // Proxy slot layout
 // -----------------
 //
-// Every proxy has a ProxyValueArray that contains the following Values:
+// Every proxy has a ProxyValueArray that contains the proxy's unique ID, if it
+// has one, followed by the following Values:
 //
 // - The expando slot. This is used to hold private fields should they be
 //   stamped into a non-forwarding proxy type.
@@ -441,11 +442,15 @@ struct ProxyReservedSlots {
 };
 
 struct ProxyValueArray {
+  // Storage for the unique ID used to hash the proxy, or zero. This is stored
+  // here rather than in the zone's unique ID table so it moves with the proxy.
+  uint64_t maybeUniqueId;
   JS::Value expandoSlot;
   JS::Value privateSlot;
   ProxyReservedSlots reservedSlots;
 
   void init(size_t nreserved) {
+    maybeUniqueId = 0;
     expandoSlot = JS::ObjectOrNullValue(nullptr);
     privateSlot = JS::UndefinedValue();
     reservedSlots.init(nreserved);
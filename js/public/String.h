@@ -378,6 +378,19 @@ JS_PUBLIC_API mozilla::Maybe<std::tuple<size_t, size_t>>
 JS_EncodeStringToUTF8BufferPartial(JSContext* cx, JSString* str,
                                    mozilla::Span<char> buffer);
 
+/**
+ * Like the above, but starts encoding at code unit |start| of |str|, which
+ * must not exceed JS_GetStringLength(str).
+ *
+ * Passing the total number of code units read by earlier calls as |start|
+ * encodes a string into a series of fixed-size buffers without flattening it
+ * or allocating a copy. The number of code units read is counted from
+ * |start|.
+ */
+JS_PUBLIC_API mozilla::Maybe<std::tuple<size_t, size_t>>
+JS_EncodeStringToUTF8BufferPartial(JSContext* cx, JSString* str, size_t start,
+                                   mozilla::Span<char> buffer);
+
 namespace JS {
 
 /**
@@ -92,6 +92,19 @@ inline bool IsTranscodingBytecodeAligned(const void* offset) {
 extern JS_PUBLIC_API bool CheckCompileOptionsMatch(
     const ReadOnlyCompileOptions& options, JSScript* script);
 
+// Encode the runtime's JIT hints, which record the scripts that reached the
+// Baseline and Ion tiers along with their inlining and pretenuring decisions,
+// so they can be decoded into a runtime in a later process that loads the same
+// scripts. Hints are keyed by filename and source position.
+//
+// Nothing is encoded or decoded if JIT hints are disabled. Decoding returns
+// Failure_BadDecode if the buffer was not produced by a compatible build.
+extern JS_PUBLIC_API bool EncodeJitHints(JSContext* cx,
+                                         TranscodeBuffer& buffer);
+
+extern JS_PUBLIC_API TranscodeResult DecodeJitHints(JSContext* cx,
+                                                    const TranscodeRange& range);
+
 }  // namespace JS
 
 #endif /* js_Transcoding_h */
@@ -80,6 +80,12 @@ namespace ubi {
 //      error occurs. A false return value terminates the traversal
 //      immediately, and causes BreadthFirst<Handler>::traverse to return
 //      false.
+//
+// Since the visitor is called as each edge is found, a handler can write nodes
+// and edges out to a stream as it goes rather than building a copy of the
+// graph; with an empty |NodeData| the only memory proportional to the heap is
+// the |visited| table. The traversal requires that no GC happen while it is
+// alive, so it can't be spread across GC slices.
 template <typename Handler>
 struct BreadthFirst {
   // Construct a breadth-first traversal object that reports the nodes it
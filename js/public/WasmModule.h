@@ -11,8 +11,10 @@
 
 #include "jstypes.h"  // JS_PUBLIC_API
 
-#include "js/RefCounted.h"  // AtomicRefCounted
-#include "js/TypeDecls.h"   // HandleObject
+#include "js/AllocPolicy.h"  // js::SystemAllocPolicy
+#include "js/RefCounted.h"   // AtomicRefCounted
+#include "js/TypeDecls.h"    // HandleObject
+#include "js/Vector.h"       // js::Vector
 
 namespace JS {
 
@@ -41,6 +43,44 @@ extern JS_PUBLIC_API bool IsWasmModuleObject(HandleObject obj);
 
 extern JS_PUBLIC_API RefPtr<WasmModule> GetWasmModule(HandleObject obj);
 
+/**
+ * Lazy-tiering state of a function defined by a wasm instance. Calls and loop
+ * iterations in baseline code count |hotnessCounter| down from an estimate of
+ * the function's Ion compilation cost; tier-up is requested once it goes below
+ * zero.
+ */
+struct WasmFunctionHotness {
+  uint32_t funcIndex = 0;
+  int32_t hotnessCounter = 0;
+  // Set if optimized code was requested for the function. Such functions are
+  // good candidates for early tier-up in later instantiations.
+  bool tierUpRequested = false;
+};
+
+using WasmFunctionHotnessVector =
+    js::Vector<WasmFunctionHotness, 0, js::SystemAllocPolicy>;
+
+/**
+ * Append to |funcs| the hotness of every function defined by the
+ * WebAssembly.Instance |instanceObj|. Nothing is appended if the instance's
+ * code doesn't use lazy tiering. Returns false and reports OOM on failure.
+ */
+extern JS_PUBLIC_API bool GetWasmInstanceHotness(
+    JSContext* cx, HandleObject instanceObj, WasmFunctionHotnessVector& funcs);
+
+/**
+ * Set the hotness counter of function |funcIndex| of the WebAssembly.Instance
+ * |instanceObj|, for example to tier up functions that were hot in a previous
+ * instantiation sooner. Negative counters are clamped to zero, which requests
+ * tier-up on the next call. Returns false without reporting an error if the
+ * instance doesn't use lazy tiering or |funcIndex| isn't a function defined by
+ * the module.
+ */
+extern JS_PUBLIC_API bool SetWasmFunctionHotness(JSContext* cx,
+                                                 HandleObject instanceObj,
+                                                 uint32_t funcIndex,
+                                                 int32_t hotnessCounter);
+
 }  // namespace JS
 
 #endif /* js_WasmModule_h */
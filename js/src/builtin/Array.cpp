@@ -8,6 +8,7 @@
 
 #include "mozilla/CheckedInt.h"
 #include "mozilla/DebugOnly.h"
+#include "mozilla/FloatingPoint.h"
 #include "mozilla/MathAlgorithms.h"
 #include "mozilla/Maybe.h"
 #include "mozilla/ScopeExit.h"
@@ -1831,26 +1832,7 @@ static const ComparatorNumeric SortComparatorNumerics[] = {
     nullptr, nullptr, ComparatorNumericLeftMinusRight,
     ComparatorNumericRightMinusLeft};
 
-static bool ComparatorInt32LeftMinusRight(const Value& a, const Value& b,
-                                          bool* lessOrEqualp) {
-  *lessOrEqualp = (a.toInt32() <= b.toInt32());
-  return true;
-}
-
-static bool ComparatorInt32RightMinusLeft(const Value& a, const Value& b,
-                                          bool* lessOrEqualp) {
-  *lessOrEqualp = (b.toInt32() <= a.toInt32());
-  return true;
-}
-
-using ComparatorInt32 = bool (*)(const Value&, const Value&, bool*);
-
-static const ComparatorInt32 SortComparatorInt32s[] = {
-    nullptr, nullptr, ComparatorInt32LeftMinusRight,
-    ComparatorInt32RightMinusLeft};
-
-// Note: Values for this enum must match up with SortComparatorNumerics
-// and SortComparatorInt32s.
+// Note: Values for this enum must match up with SortComparatorNumerics.
 enum ComparatorMatchResult {
   Match_Failure = 0,
   Match_None,
@@ -2000,6 +1982,41 @@ static bool SortLexicographically(JSContext* cx,
                         SortComparatorStringifiedElements(cx, sb), vec);
 }
 
+/*
+ * Sort Int32 Values as numbers.
+ *
+ * Equal Int32 values are indistinguishable, so the sort doesn't need to be
+ * stable. Sort the unboxed integers with std::sort instead of merge sorting the
+ * Values through a comparator function.
+ */
+static bool SortInt32sNumerically(JSContext* cx,
+                                  MutableHandle<GCVector<Value>> vec,
+                                  size_t len, ComparatorMatchResult comp) {
+  MOZ_ASSERT(vec.length() >= len);
+  MOZ_ASSERT(comp == Match_LeftMinusRight || comp == Match_RightMinusLeft);
+
+  Vector<int32_t, 0, TempAllocPolicy> ints(cx);
+  if (!ints.resize(len)) {
+    return false;
+  }
+
+  for (size_t i = 0; i < len; i++) {
+    ints[i] = vec[i].toInt32();
+  }
+
+  if (comp == Match_LeftMinusRight) {
+    std::sort(ints.begin(), ints.end());
+  } else {
+    std::sort(ints.begin(), ints.end(),
+              [](int32_t a, int32_t b) { return b < a; });
+  }
+
+  for (size_t i = 0; i < len; i++) {
+    vec[i].setInt32(ints[i]);
+  }
+  return true;
+}
+
 /*
  * Sort Values as numbers.
  *
@@ -2205,9 +2222,7 @@ static bool ArraySortWithoutComparator(JSContext* cx, Handle<JSObject*> obj,
       }
     } else {
       if (allInts) {
-        MOZ_ALWAYS_TRUE(vec.resize(n * 2));
-        if (!MergeSort(vec.begin(), n, vec.begin() + n,
-                       SortComparatorInt32s[comp])) {
+        if (!SortInt32sNumerically(cx, &vec, n, comp)) {
           return false;
         }
       } else {
@@ -4351,6 +4366,31 @@ enum class SearchKind {
   Includes,
 };
 
+// Returns true if every dense element which matches |val| for the given search
+// kind has the same raw bits as |val|, so that the elements can be scanned
+// with a bitwise comparison.
+template <SearchKind Kind>
+static bool CanUseBitwiseSearch(const Value& val) {
+  if (CanUseBitwiseCompareForStrictlyEqual(val)) {
+    // |includes| treats hole values as |undefined|.
+    return Kind == SearchKind::IndexOf || !val.isUndefined();
+  }
+  if (val.isDouble()) {
+    // NaN is canonicalized when boxed, so all NaN elements have the same bits.
+    // |indexOf| never matches NaN, which the generic path handles.
+    double d = val.toDouble();
+    if (std::isnan(d)) {
+      return Kind == SearchKind::Includes;
+    }
+
+    // Doubles which aren't equal to an int32 value (including -0) can't be
+    // stored as Int32 values, so they only have a single representation.
+    int32_t unused;
+    return !mozilla::NumberEqualsInt32(d, &unused);
+  }
+  return false;
+}
+
 template <SearchKind Kind, typename Iter>
 static bool SearchElementDense(JSContext* cx, HandleValue val, Iter iterator,
                                MutableHandleValue rval) {
@@ -4503,7 +4543,8 @@ bool js::array_indexOf(JSContext* cx, unsigned argc, Value* vp) {
         std::min(nobj->getDenseInitializedLength(), uint32_t(len));
     const Value* elements = nobj->getDenseElements();
 
-    if (CanUseBitwiseCompareForStrictlyEqual(searchElement) && length > start) {
+    if (CanUseBitwiseSearch<SearchKind::IndexOf>(searchElement) &&
+        length > start) {
       const uint64_t* elementsAsBits =
           reinterpret_cast<const uint64_t*>(elements);
       const uint64_t* res = SIMD::memchr64(
@@ -4750,10 +4791,8 @@ bool js::array_includes(JSContext* cx, unsigned argc, Value* vp) {
       return true;
     }
 
-    // For |includes| we need to treat hole values as |undefined| so we use a
-    // different path if searching for |undefined|.
-    if (CanUseBitwiseCompareForStrictlyEqual(searchElement) &&
-        !searchElement.isUndefined() && length > start) {
+    if (CanUseBitwiseSearch<SearchKind::Includes>(searchElement) &&
+        length > start) {
       if (SIMD::memchr64(reinterpret_cast<const uint64_t*>(elements) + start,
                          searchElement.asRawBits(), length - start)) {
         args.rval().setBoolean(true);
@@ -261,6 +261,8 @@ function ArrayReduce(callbackfn /*, initialValue*/) {
   /* Step 10. */
   return accumulator;
 }
+// Inlining this enables inlining of the callback function.
+SetIsInlinableLargeFunction(ArrayReduce);
 
 /* ES5 15.4.4.22. */
 function ArrayReduceRight(callbackfn /*, initialValue*/) {
@@ -331,6 +333,8 @@ function ArrayReduceRight(callbackfn /*, initialValue*/) {
   /* Step 10. */
   return accumulator;
 }
+// Inlining this enables inlining of the callback function.
+SetIsInlinableLargeFunction(ArrayReduceRight);
 
 /* ES6 draft 2013-05-14 15.4.3.23. */
 function ArrayFind(predicate /*, thisArg*/) {
@@ -812,6 +816,20 @@ function ArrayFrom(items, mapfn = undefined, thisArg = undefined) {
       ThrowTypeError(JSMSG_NOT_ITERABLE, DecompileArg(0, items));
     }
 
+    // Fast path for copying a packed array into a plain Array. Iterating a
+    // packed array with the default iterator has no observable side effects,
+    // so we can copy its elements directly.
+    if (
+      !mapping &&
+      C === GetBuiltinConstructor("Array") &&
+      IsObject(items) &&
+      usingIterator === $ArrayValues &&
+      IsPackedArray(items) &&
+      ArrayIteratorPrototypeOptimizable()
+    ) {
+      return ArrayCopyPacked(items);
+    }
+
     // Steps 5.a-b.
     var A = IsConstructor(C) ? constructContentFunction(C, C) : [];
 
@@ -18,14 +18,13 @@ function BigInt_toLocaleString() {
 
   // Step 2.
   var numberFormat;
-  if (locales === undefined && options === undefined) {
-    // This cache only optimizes when no explicit locales and options
-    // arguments were supplied.
-    if (!intl_IsRuntimeDefaultLocale(numberFormatCache.runtimeDefaultLocale)) {
-      numberFormatCache.numberFormat = intl_NumberFormat(locales, options);
-      numberFormatCache.runtimeDefaultLocale = intl_RuntimeDefaultLocale();
-    }
-    numberFormat = numberFormatCache.numberFormat;
+  if (
+    (locales === undefined || typeof locales === "string") &&
+    options === undefined
+  ) {
+    // This cache only optimizes when no options and at most a single locale
+    // string were supplied.
+    numberFormat = GetCachedNumberFormat(locales);
   } else {
     numberFormat = intl_NumberFormat(locales, options);
   }
@@ -9,6 +9,7 @@
 #include "builtin/FinalizationRegistryObject.h"
 
 #include "mozilla/ScopeExit.h"
+#include "mozilla/TimeStamp.h"
 
 #include "jsapi.h"
 
@@ -809,7 +810,25 @@ bool FinalizationQueueObject::doCleanup(JSContext* cx, unsigned argc,
       cx, &value.toObject().as<FinalizationQueueObject>());
 
   queue->setQueuedForCleanup(false);
-  return cleanupQueuedRecords(cx, queue);
+
+  mozilla::TimeDuration budget =
+      cx->runtime()->gc.finalizationRegistryCleanupBudget();
+  if (budget.IsZero()) {
+    return cleanupQueuedRecords(cx, queue);
+  }
+
+  mozilla::TimeStamp deadline = mozilla::TimeStamp::Now() + budget;
+  if (!cleanupQueuedRecords(cx, queue, nullptr, deadline)) {
+    return false;
+  }
+
+  // If we ran out of time, ask the embedding to schedule another job to finish
+  // the work.
+  if (!queue->recordsToBeCleanedUp()->empty()) {
+    cx->runtime()->gc.queueFinalizationRegistryForCleanup(queue);
+  }
+
+  return true;
 }
 
 // CleanupFinalizationRegistry ( finalizationRegistry [ , callback ] )
@@ -817,7 +836,7 @@ bool FinalizationQueueObject::doCleanup(JSContext* cx, unsigned argc,
 /* static */
 bool FinalizationQueueObject::cleanupQueuedRecords(
     JSContext* cx, HandleFinalizationQueueObject queue,
-    HandleObject callbackArg) {
+    HandleObject callbackArg, mozilla::TimeStamp deadline) {
   MOZ_ASSERT(cx->compartment() == queue->compartment());
 
   // 2. If callback is undefined, set callback to
@@ -856,6 +875,10 @@ bool FinalizationQueueObject::cleanupQueuedRecords(
     if (!Call(cx, callback, UndefinedHandleValue, heldValue, &rval)) {
       return false;
     }
+
+    if (deadline && mozilla::TimeStamp::Now() >= deadline) {
+      break;
+    }
   }
 
   return true;
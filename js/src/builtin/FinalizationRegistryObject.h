@@ -86,6 +86,8 @@
 #ifndef builtin_FinalizationRegistryObject_h
 #define builtin_FinalizationRegistryObject_h
 
+#include "mozilla/TimeStamp.h"
+
 #include "gc/Barrier.h"
 #include "js/GCVector.h"
 #include "vm/NativeObject.h"
@@ -256,9 +258,12 @@ class FinalizationQueueObject : public NativeObject {
   static FinalizationQueueObject* create(JSContext* cx,
                                          HandleObject cleanupCallback);
 
-  static bool cleanupQueuedRecords(JSContext* cx,
-                                   HandleFinalizationQueueObject registry,
-                                   HandleObject callback = nullptr);
+  // Call the cleanup callback for queued records. If |deadline| is set, stop
+  // once it has passed.
+  static bool cleanupQueuedRecords(
+      JSContext* cx, HandleFinalizationQueueObject registry,
+      HandleObject callback = nullptr,
+      mozilla::TimeStamp deadline = mozilla::TimeStamp());
 
  private:
   static const JSClassOps classOps_;
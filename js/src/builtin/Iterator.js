@@ -301,6 +301,13 @@ function IteratorHelperReturn() {
 // if the `return` method is called on the IteratorHelper before `next` has been
 // called, we can catch them in the try and use the finally block to close the
 // underlying iterator.
+//
+// Chained helpers (e.g. `iter.map(f).filter(g)`) are not fused: each stage
+// looks up `next` on its underlying iterator once, but closing a stage looks
+// up `return` on the previous stage, and both lookups are observable when the
+// underlying iterator is another IteratorHelper. Fusing a chain into a single
+// loop would have to guard that neither %IteratorHelperPrototype%.next nor
+// %IteratorHelperPrototype%.return has been modified.
 
 /**
  * Iterator.prototype.map ( mapper )
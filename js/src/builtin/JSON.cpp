@@ -21,8 +21,10 @@
 #include "builtin/BigInt.h"
 #include "builtin/ParseRecordObject.h"
 #include "builtin/RawJSONObject.h"
+#include "js/CharacterEncoding.h"     // JS::UTF8Chars
 #include "js/friend/ErrorMessages.h"  // js::GetErrorMessage, JSMSG_*
 #include "js/friend/StackLimits.h"    // js::AutoCheckRecursionLimit
+#include "js/HashTable.h"             // js::HashMap
 #include "js/Object.h"                // JS::GetBuiltinClass
 #include "js/Prefs.h"                 // JS::Prefs
 #include "js/ProfilingCategory.h"
@@ -239,6 +241,7 @@ class StringifyContext {
   const RootedIdVector& propertyList;
   uint32_t depth;
   bool maybeSafely;
+  StringifySink* sink = nullptr;
 };
 
 } /* anonymous namespace */
@@ -246,6 +249,15 @@ class StringifyContext {
 static bool SerializeJSONProperty(JSContext* cx, const Value& v,
                                   StringifyContext* scx);
 
+// Hand the output so far over to the sink, if there is one and enough output
+// has accumulated. This is only called after a complete member was written.
+static bool MaybeFlush(JSContext* cx, StringifyContext* scx) {
+  if (!scx->sink || scx->sb.length() < StringifySink::FlushThreshold) {
+    return true;
+  }
+  return scx->sink->flush(cx, scx->sb);
+}
+
 static bool WriteIndent(StringifyContext* scx, uint32_t limit) {
   if (!scx->gap.empty()) {
     if (!scx->sb.append('\n')) {
@@ -549,7 +561,8 @@ static bool SerializeJSONObject(JSContext* cx, HandleObject obj,
 
     if (!QuoteJSONString(cx, scx->sb, s) || !scx->sb.append(':') ||
         !(scx->gap.empty() || scx->sb.append(' ')) ||
-        !SerializeJSONProperty(cx, outputValue, scx)) {
+        !SerializeJSONProperty(cx, outputValue, scx) ||
+        !MaybeFlush(cx, scx)) {
       return false;
     }
   }
@@ -679,6 +692,9 @@ static bool SerializeJSONArray(JSContext* cx, HandleObject obj,
           return false;
         }
       }
+      if (!MaybeFlush(cx, scx)) {
+        return false;
+      }
 
       /* Steps 3, 4, 10b(i). */
       if (i < length - 1) {
@@ -1156,6 +1172,120 @@ static bool PreprocessFastValue(JSContext* cx, Value* vp, StringifyContext* scx,
   return true;
 }
 
+// Quoted property names, followed by ':', for the shapes seen by one call to
+// FastSerializeJSONProperty. Arrays of records usually contain many objects
+// with the same shape, and their keys only need to be quoted and escaped once.
+// After that, each key is copied into the output with a single append.
+//
+// The cache holds unrooted Shape pointers, which is fine because nothing can GC
+// while FastSerializeJSONProperty runs. Only Latin-1 keys are cached, two-byte
+// keys are quoted again every time.
+class MOZ_STACK_CLASS FastKeyCache {
+ public:
+  static constexpr uint32_t NoKeys = UINT32_MAX;
+
+ private:
+  // Stop caching new shapes after this many, or after this many characters of
+  // keys, to bound the memory used for inputs that don't repeat shapes.
+  static constexpr size_t MaxShapes = 256;
+  static constexpr size_t MaxChars = 64 * 1024;
+
+  struct CachedKey {
+    uint32_t start;
+    // Zero for keys which are not cached.
+    uint32_t length;
+  };
+
+  struct ShapeKeys {
+    // Index of the shape's first key in |keys|, or NoKeys.
+    uint32_t first;
+    // Length of all the shape's cached keys.
+    uint32_t length;
+  };
+
+  using ShapeMap =
+      HashMap<Shape*, ShapeKeys, DefaultHasher<Shape*>, TempAllocPolicy>;
+
+  JSContext* cx;
+  StringBuilder chars;
+  Vector<CachedKey> keys;
+  ShapeMap shapes;
+
+ public:
+  explicit FastKeyCache(JSContext* cx)
+      : cx(cx), chars(cx), keys(cx), shapes(cx) {}
+
+  // Find the keys for |nobj|'s shape, quoting all of them if the shape is seen
+  // for the first time. Sets |*firstKey| to NoKeys if they are not cached, and
+  // |*keysLength| to the length of the cached keys.
+  [[nodiscard]] bool lookup(NativeObject* nobj, uint32_t* firstKey,
+                            size_t* keysLength);
+
+  // Append the key at |index| followed by ':', or set |*cached| to false if the
+  // caller needs to quote the key itself.
+  [[nodiscard]] bool append(StringBuilder& sb, uint32_t index,
+                            bool* cached) const {
+    const CachedKey& key = keys[index];
+    if (key.length == 0) {
+      *cached = false;
+      return true;
+    }
+    *cached = true;
+    const Latin1Char* begin = chars.rawLatin1Begin() + key.start;
+    return sb.append(begin, begin + key.length);
+  }
+};
+
+bool FastKeyCache::lookup(NativeObject* nobj, uint32_t* firstKey,
+                          size_t* keysLength) {
+  ShapeMap::AddPtr p = shapes.lookupForAdd(nobj->shape());
+  if (p) {
+    *firstKey = p->value().first;
+    *keysLength = p->value().length;
+    return true;
+  }
+
+  *firstKey = NoKeys;
+  *keysLength = 0;
+  if (shapes.count() >= MaxShapes || chars.length() >= MaxChars) {
+    return true;
+  }
+
+  // Quote every key which OwnNonIndexKeysIterForJSON will return, in the same
+  // order. If the shape can't be serialized on the fast path, record that it
+  // has no keys and let the caller bail out as usual.
+  ShapeKeys shapeKeys{uint32_t(keys.length()), 0};
+  size_t start = chars.length();
+  OwnNonIndexKeysIterForJSON iter(nobj);
+  while (!iter.done()) {
+    PropertyKey id = iter.next().key();
+    MOZ_ASSERT(id.isString());
+    JSLinearString* name = id.toLinearString();
+    CachedKey key{uint32_t(chars.length()), 0};
+    if (name->hasLatin1Chars()) {
+      if (!QuoteJSONString(cx, chars, name) || !chars.append(':')) {
+        return false;
+      }
+      key.length = chars.length() - key.start;
+    }
+    if (!keys.append(key)) {
+      return false;
+    }
+  }
+  if (iter.cannotFastStringify() != BailReason::NO_REASON) {
+    shapeKeys.first = NoKeys;
+  } else {
+    shapeKeys.length = chars.length() - start;
+  }
+
+  if (!shapes.add(p, nobj->shape(), shapeKeys)) {
+    return false;
+  }
+  *firstKey = shapeKeys.first;
+  *keysLength = shapeKeys.length;
+  return true;
+}
+
 // FastSerializeJSONProperty maintains an explicit stack to handle nested
 // objects. For each object, first the dense elements are iterated, then the
 // named properties (included sparse indexes, which will cause
@@ -1168,6 +1298,10 @@ struct FastStackEntry {
   NativeObject* nobj;
   Variant<DenseElementsIteratorForJSON, OwnNonIndexKeysIterForJSON> iter;
   bool isArray;  // Cached nobj->is<ArrayObject>()
+  // Index of the first key of nobj's shape in the FastKeyCache, and of the next
+  // named property to be iterated.
+  uint32_t firstKey = FastKeyCache::NoKeys;
+  uint32_t keyIndex = 0;
 
   // Given an object, a FastStackEntry starts with the dense elements. The
   // caller is expected to inspect the variant to use it differently based on
@@ -1179,13 +1313,19 @@ struct FastStackEntry {
 
   // Called by Vector when moving data around.
   FastStackEntry(FastStackEntry&& other) noexcept
-      : nobj(other.nobj), iter(std::move(other.iter)), isArray(other.isArray) {}
+      : nobj(other.nobj),
+        iter(std::move(other.iter)),
+        isArray(other.isArray),
+        firstKey(other.firstKey),
+        keyIndex(other.keyIndex) {}
 
   // Move assignment, called when updating the `top` entry.
   void operator=(FastStackEntry&& other) noexcept {
     nobj = other.nobj;
     iter = std::move(other.iter);
     isArray = other.isArray;
+    firstKey = other.firstKey;
+    keyIndex = other.keyIndex;
   }
 
   // Advance from dense elements to the named properties.
@@ -1273,6 +1413,7 @@ static bool FastSerializeJSONProperty(JSContext* cx, Handle<Value> v,
   // https://262.ecma-international.org/14.0/#sec-serializejsonarray step 7-8.
   FastStackEntry top(&v.toObject().as<NativeObject>());
   bool wroteMember = false;
+  FastKeyCache keyCache(cx);
 
   if (!CanFastStringifyObject(top.nobj)) {
     *whySlow = BailReason::INELIGIBLE_OBJECT;
@@ -1359,6 +1500,17 @@ static bool FastSerializeJSONProperty(JSContext* cx, Handle<Value> v,
         MOZ_ASSERT(!top.nobj->isIndexed() || IsPackedArray(top.nobj));
       } else {
         top.advanceToProperties();
+
+        // The keys are usually most of the output for an object, so make room
+        // for all of them at once.
+        size_t keysLength;
+        if (!keyCache.lookup(top.nobj, &top.firstKey, &keysLength)) {
+          return false;
+        }
+        if (keysLength > 0 &&
+            !scx->sb.reserve(scx->sb.length() + keysLength)) {
+          return false;
+        }
       }
     }
 
@@ -1374,6 +1526,7 @@ static bool FastSerializeJSONProperty(JSContext* cx, Handle<Value> v,
         }
 
         PropertyInfoWithKey prop = iter.next();
+        uint32_t keyIndex = top.keyIndex++;
 
         // A non-Array with indexed elements would need to sort the indexes
         // numerically, which this code does not support. These objects are
@@ -1401,13 +1554,17 @@ static bool FastSerializeJSONProperty(JSContext* cx, Handle<Value> v,
         }
         wroteMember = true;
 
-        MOZ_ASSERT(prop.key().isString());
-        if (!QuoteJSONString(cx, scx->sb, prop.key().toString())) {
+        bool cached = false;
+        if (top.firstKey != FastKeyCache::NoKeys &&
+            !keyCache.append(scx->sb, top.firstKey + keyIndex, &cached)) {
           return false;
         }
-
-        if (!scx->sb.append(':')) {
-          return false;
+        if (!cached) {
+          MOZ_ASSERT(prop.key().isString());
+          if (!QuoteJSONString(cx, scx->sb, prop.key().toString()) ||
+              !scx->sb.append(':')) {
+            return false;
+          }
         }
         if (val.isObject()) {
           if (JSString* rawJSON = MaybeGetRawJSON(cx, &val.toObject())) {
@@ -1457,7 +1614,7 @@ static bool FastSerializeJSONProperty(JSContext* cx, Handle<Value> v,
 /* https://262.ecma-international.org/14.0/#sec-json.stringify */
 bool js::Stringify(JSContext* cx, MutableHandleValue vp, JSObject* replacer_,
                    const Value& space_, StringBuilder& sb,
-                   StringifyBehavior stringifyBehavior) {
+                   StringifyBehavior stringifyBehavior, StringifySink* sink) {
   RootedObject replacer(cx, replacer_);
   RootedValue space(cx, space_);
 
@@ -1465,6 +1622,8 @@ bool js::Stringify(JSContext* cx, MutableHandleValue vp, JSObject* replacer_,
                 space.isNull());
   MOZ_ASSERT_IF(stringifyBehavior == StringifyBehavior::RestrictedSafe,
                 vp.isObject());
+  MOZ_ASSERT_IF(sink, stringifyBehavior == StringifyBehavior::Normal ||
+                          stringifyBehavior == StringifyBehavior::SlowOnly);
   /**
    * This uses MOZ_ASSERT, since it's actually asserting something jsapi
    * consumers could get wrong, so needs a better error message.
@@ -1671,6 +1830,7 @@ bool js::Stringify(JSContext* cx, MutableHandleValue vp, JSObject* replacer_,
 
   StringifyContext scx(cx, sb, gap, replacer, propertyList,
                        stringifyBehavior == StringifyBehavior::RestrictedSafe);
+  scx.sink = sink;
   if (!PreprocessValue(cx, wrapper, HandleId(emptyId), vp, &scx)) {
     return false;
   }
@@ -1937,6 +2097,17 @@ template bool js::ParseJSONWithReviver(
     JSContext* cx, const mozilla::Range<const char16_t> chars,
     HandleValue reviver, MutableHandleValue vp);
 
+bool js::ParseJSONFromUTF8(JSContext* cx, const JS::UTF8Chars& utf8,
+                           MutableHandleValue vp) {
+  js::AutoGeckoProfilerEntry pseudoFrame(cx, "parse JSON",
+                                         JS::ProfilingCategoryPair::JS_Parsing);
+  mozilla::Range<const Latin1Char> chars(utf8.begin().get(), utf8.length());
+  Rooted<JSONParser<Latin1Char>> parser(
+      cx, cx, chars, JSONParser<Latin1Char>::ParseType::JSONParse);
+  parser.setUTF8Input();
+  return parser.parse(vp);
+}
+
 static bool json_toSource(JSContext* cx, unsigned argc, Value* vp) {
   CallArgs args = CallArgsFromVp(argc, vp);
   args.rval().setString(cx->names().JSON);
@@ -13,6 +13,10 @@
 
 #include "js/RootingAPI.h"
 
+namespace JS {
+class UTF8Chars;
+}  // namespace JS
+
 namespace js {
 
 class StringBuilder;
@@ -44,20 +48,45 @@ enum class StringifyBehavior {
   Compare
 };
 
+// Consumer of Stringify's output while it is being produced.
+class StringifySink {
+ public:
+  // Output is handed over once the StringBuilder holds at least this many
+  // characters.
+  static constexpr size_t FlushThreshold = 16 * 1024;
+
+  // Consume the contents of |sb|, and clear it.
+  virtual bool flush(JSContext* cx, StringBuilder& sb) = 0;
+
+ protected:
+  ~StringifySink() = default;
+};
+
 /**
  * If stringifyBehavior is RestrictedSafe, Stringify will attempt to assert the
  * API requirements of JS::ToJSONMaybeSafely as it traverses the graph, and will
  * not try to invoke .toJSON on things as it goes.
+ *
+ * If |sink| is given, the slow path flushes |sb| to it between members, so
+ * that large outputs don't have to be buffered in full. The fast path may
+ * still bail out and start over, so it never flushes. Whatever is left in |sb|
+ * when Stringify returns must be flushed by the caller.
  */
 extern bool Stringify(JSContext* cx, js::MutableHandleValue vp,
                       JSObject* replacer, const Value& space, StringBuilder& sb,
-                      StringifyBehavior stringifyBehavior);
+                      StringifyBehavior stringifyBehavior,
+                      StringifySink* sink = nullptr);
 
 template <typename CharT>
 extern bool ParseJSONWithReviver(JSContext* cx,
                                  const mozilla::Range<const CharT> chars,
                                  HandleValue reviver, MutableHandleValue vp);
 
+// Parse UTF-8 JSON text without decoding it first, see
+// JSONParser::setUTF8Input.
+extern bool ParseJSONFromUTF8(JSContext* cx, const JS::UTF8Chars& utf8,
+                              MutableHandleValue vp);
+
 }  // namespace js
 
 #endif /* builtin_JSON_h */
@@ -712,6 +712,11 @@ void SyntheticModuleFields::trace(JSTracer* trc) { exportNames.trace(trc); }
 // https://tc39.es/ecma262/#sec-cyclic-module-records
 class js::CyclicModuleFields {
  public:
+  using ResolvedExportMap =
+      mozilla::HashMap<PreBarriered<jsid>, HeapPtr<ResolvedBindingObject*>,
+                       mozilla::DefaultHasher<PreBarriered<jsid>>,
+                       CellAllocPolicy>;
+
   ModuleStatus status = ModuleStatus::Unlinked;
 
   bool hasTopLevelAwait : 1;
@@ -741,13 +746,14 @@ class js::CyclicModuleFields {
   ImportEntryVector importEntries;
   ExportEntryVector exportEntries;
   IndirectBindingMap importBindings;
+  ResolvedExportMap resolvedExports;
   UniquePtr<FunctionDeclarationVector> functionDeclarations;
   HeapPtr<PromiseObject*> topLevelCapability;
   HeapPtr<ListObject*> asyncParentModules;
   HeapPtr<ModuleObject*> cycleRoot;
 
  public:
-  CyclicModuleFields();
+  explicit CyclicModuleFields(Zone* zone);
 
   void trace(JSTracer* trc);
 
@@ -774,12 +780,13 @@ class js::CyclicModuleFields {
   Maybe<uint32_t> maybePendingAsyncDependencies() const;
 };
 
-CyclicModuleFields::CyclicModuleFields()
+CyclicModuleFields::CyclicModuleFields(Zone* zone)
     : hasTopLevelAwait(false),
       hasDfsIndex(false),
       hasDfsAncestorIndex(false),
       isAsyncEvaluating(false),
-      hasPendingAsyncDependencies(false) {}
+      hasPendingAsyncDependencies(false),
+      resolvedExports(zone) {}
 
 void CyclicModuleFields::trace(JSTracer* trc) {
   TraceEdge(trc, &evaluationError, "CyclicModuleFields::evaluationError");
@@ -790,6 +797,13 @@ void CyclicModuleFields::trace(JSTracer* trc) {
   importEntries.trace(trc);
   exportEntries.trace(trc);
   importBindings.trace(trc);
+  for (ResolvedExportMap::Enum e(resolvedExports); !e.empty(); e.popFront()) {
+    TraceEdge(trc, &e.front().value(), "CyclicModuleFields::resolvedExports");
+    mozilla::DebugOnly<jsid> prev(e.front().key());
+    TraceEdge(trc, &e.front().mutableKey(),
+              "CyclicModuleFields::resolvedExports name");
+    MOZ_ASSERT(e.front().key() == prev);
+  }
   TraceNullableEdge(trc, &topLevelCapability,
                     "CyclicModuleFields::topLevelCapability");
   TraceNullableEdge(trc, &asyncParentModules,
@@ -959,7 +973,7 @@ void ModuleObject::initFunctionDeclarations(
 /* static */
 ModuleObject* ModuleObject::create(JSContext* cx) {
   Rooted<UniquePtr<CyclicModuleFields>> fields(cx);
-  fields = cx->make_unique<CyclicModuleFields>();
+  fields = cx->make_unique<CyclicModuleFields>(cx->zone());
   if (!fields) {
     return nullptr;
   }
@@ -1034,6 +1048,23 @@ IndirectBindingMap& ModuleObject::importBindings() {
   return cyclicModuleFields()->importBindings;
 }
 
+ResolvedBindingObject* ModuleObject::lookupResolvedExport(
+    JSAtom* exportName) const {
+  const auto& map = cyclicModuleFields()->resolvedExports;
+  auto ptr = map.lookup(AtomToId(exportName));
+  return ptr ? ptr->value().get() : nullptr;
+}
+
+bool ModuleObject::putResolvedExport(JSContext* cx, JSAtom* exportName,
+                                     ResolvedBindingObject* binding) {
+  auto& map = cyclicModuleFields()->resolvedExports;
+  if (!map.put(AtomToId(exportName), binding)) {
+    ReportOutOfMemory(cx);
+    return false;
+  }
+  return true;
+}
+
 ModuleNamespaceObject* ModuleObject::namespace_() {
   Value value = getReservedSlot(NamespaceSlot);
   if (value.isUndefined()) {
@@ -410,6 +410,13 @@ class ModuleObject : public NativeObject {
 
   IndirectBindingMap& importBindings();
 
+  // Cache of successful ResolveExport results for this module. The result of
+  // resolving an export only depends on the loaded module graph, so it can be
+  // reused by every module importing the same name.
+  ResolvedBindingObject* lookupResolvedExport(JSAtom* exportName) const;
+  bool putResolvedExport(JSContext* cx, JSAtom* exportName,
+                         ResolvedBindingObject* binding);
+
   void setStatus(ModuleStatus newStatus);
   void setDfsIndex(uint32_t index);
   void setDfsAncestorIndex(uint32_t index);
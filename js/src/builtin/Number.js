@@ -3,8 +3,51 @@
  * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #if JS_HAS_INTL_API
+// Cache of NumberFormat objects for toLocaleString calls without options.
+// It holds the formatter for the default locale and the formatter for the
+// most recently used explicit locale string. Both are only valid for the
+// runtime default locale they were created with, because requested locales
+// which aren't supported resolve to the default locale.
 var numberFormatCache = new_Record();
 
+/**
+ * Get a cached NumberFormat object, created like so:
+ *
+ *   intl_NumberFormat(locales, undefined);
+ *
+ * |locales| must be either undefined or a string.
+ */
+function GetCachedNumberFormat(locales) {
+  assert(
+    locales === undefined || typeof locales === "string",
+    "only undefined and string locales are cached"
+  );
+
+  if (!intl_IsRuntimeDefaultLocale(numberFormatCache.runtimeDefaultLocale)) {
+    numberFormatCache.numberFormat = undefined;
+    numberFormatCache.locale = undefined;
+    numberFormatCache.localeNumberFormat = undefined;
+    numberFormatCache.runtimeDefaultLocale = intl_RuntimeDefaultLocale();
+  }
+
+  if (locales === undefined) {
+    var numberFormat = numberFormatCache.numberFormat;
+    if (numberFormat === undefined) {
+      numberFormat = numberFormatCache.numberFormat = intl_NumberFormat(
+        undefined,
+        undefined
+      );
+    }
+    return numberFormat;
+  }
+
+  if (numberFormatCache.locale !== locales) {
+    numberFormatCache.localeNumberFormat = intl_NumberFormat(locales, undefined);
+    numberFormatCache.locale = locales;
+  }
+  return numberFormatCache.localeNumberFormat;
+}
+
 /**
  * Format this Number object into a string, using the locale and formatting options
  * provided.
@@ -22,14 +65,13 @@ function Number_toLocaleString() {
 
   // Step 4.
   var numberFormat;
-  if (locales === undefined && options === undefined) {
-    // This cache only optimizes for the old ES5 toLocaleString without
-    // locales and options.
-    if (!intl_IsRuntimeDefaultLocale(numberFormatCache.runtimeDefaultLocale)) {
-      numberFormatCache.numberFormat = intl_NumberFormat(locales, options);
-      numberFormatCache.runtimeDefaultLocale = intl_RuntimeDefaultLocale();
-    }
-    numberFormat = numberFormatCache.numberFormat;
+  if (
+    (locales === undefined || typeof locales === "string") &&
+    options === undefined
+  ) {
+    // This cache only optimizes for calls without options and with at most
+    // a single locale string.
+    numberFormat = GetCachedNumberFormat(locales);
   } else {
     numberFormat = intl_NumberFormat(locales, options);
   }
@@ -1576,6 +1576,52 @@ static bool TryEnumerableOwnPropertiesNative(JSContext* cx, HandleObject obj,
   // quadratic behaviour marking stack rooted |properties| vector.
   AutoSelectGCHeap gcHeap(cx, 1);
 
+  if (kind == EnumerableOwnPropertiesKind::Values ||
+      kind == EnumerableOwnPropertiesKind::KeysAndValues) {
+    // The shape's iterator cache can also be used when the cached iterator
+    // has valid property indices (see GetIteratorWithIndices). In that case
+    // every key is an enumerable own data property, so the values can be read
+    // directly from the slots.
+    Rooted<PropertyIteratorObject*> piter(cx,
+                                          LookupInShapeIteratorCache(cx, nobj));
+    if (piter) {
+      NativeIterator* ni = piter->getNativeIterator();
+      if (!ni->mayHavePrototypeProperties() && ni->hasValidIndices()) {
+        if (!properties.reserve(ni->numKeys())) {
+          return false;
+        }
+        for (size_t i = 0; i < ni->numKeys(); i++) {
+          PropertyIndex index = ni->indicesBegin()[i];
+          MOZ_ASSERT(index.kind() == PropertyIndex::Kind::FixedSlot ||
+                     index.kind() == PropertyIndex::Kind::DynamicSlot);
+          uint32_t slot = index.index();
+          if (index.kind() == PropertyIndex::Kind::DynamicSlot) {
+            slot += nobj->numFixedSlots();
+          }
+          value.set(nobj->getSlot(slot));
+
+          if (kind == EnumerableOwnPropertiesKind::KeysAndValues) {
+            key.setString(ni->propertiesBegin()[i].get());
+            if (!NewValuePair(cx, key, value, &value, gcHeap)) {
+              return false;
+            }
+          }
+
+          properties.infallibleAppend(value);
+        }
+
+        JSObject* array =
+            NewDenseCopiedArray(cx, properties.length(), properties.begin());
+        if (!array) {
+          return false;
+        }
+
+        rval.setObject(*array);
+        return true;
+      }
+    }
+  }
+
   // We have ensured |nobj| contains no extra indexed properties, so the
   // only indexed properties we need to handle here are dense and typed
   // array elements.
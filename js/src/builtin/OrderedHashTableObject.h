@@ -316,6 +316,11 @@ class MOZ_STACK_CLASS OrderedHashTableImpl {
   using HashCodeScrambler = mozilla::HashCodeScrambler;
   static constexpr size_t SlotCount = OrderedHashTableObject::SlotCount;
 
+  // Entries are stored in insertion order. Each hash bucket points to the most
+  // recently added entry with that hash, and |chain| links to the previous
+  // one. JIT code walks these chains directly (see
+  // MacroAssembler::orderedHashTableLookup), so changes to this layout or to
+  // the bucket array must be mirrored there.
   struct Data {
     T element;
     Data* chain;
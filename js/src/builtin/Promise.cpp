@@ -1580,6 +1580,12 @@ static bool PromiseReactionJob(JSContext* cx, unsigned argc, Value* vp);
   // Step 1. Let job be a new Job Abstract Closure with no parameters that
   //         captures reaction and argument and performs the following steps
   //         when called:
+  //
+  // NOTE: The job has to be a callable object: the embedder's job queue owns
+  //       ordering between promise jobs and its own tasks, and it runs each
+  //       job with JS::Call. An engine-internal queue of (reaction, argument)
+  //       pairs would bypass that ordering, so the job function is the only
+  //       per-reaction allocation here besides the reaction record itself.
   Handle<PropertyName*> funName = cx->names().empty_;
   RootedFunction job(
       cx, NewNativeFunction(cx, PromiseReactionJob, 0, funName,
@@ -5661,18 +5667,25 @@ template <typename T>
                                         PromiseHandler onRejected,
                                         T extraStep) {
   // Step 2. Let promise be ? PromiseResolve(%Promise%, value).
-  RootedObject promise(cx, PromiseObject::unforgeableResolve(cx, value));
-  if (!promise) {
-    return false;
-  }
+  //
+  // For primitive values, PromiseResolve creates a fresh promise which is
+  // already fulfilled with `value`, and nothing but the debugger (through its
+  // onNewPromise and onPromiseSettled hooks) can observe it. Skip creating it
+  // and enqueue the fulfill job directly below.
+  Rooted<PromiseObject*> unwrappedPromise(cx);
+  if (value.isObject() || cx->realm()->isDebuggee()) {
+    RootedObject promise(cx, PromiseObject::unforgeableResolve(cx, value));
+    if (!promise) {
+      return false;
+    }
 
-  // This downcast is safe because unforgeableResolve either returns `value`
-  // (only if it is already a possibly-wrapped promise) or creates a new
-  // promise using the Promise constructor.
-  Rooted<PromiseObject*> unwrappedPromise(
-      cx, UnwrapAndDowncastObject<PromiseObject>(cx, promise));
-  if (!unwrappedPromise) {
-    return false;
+    // This downcast is safe because unforgeableResolve either returns `value`
+    // (only if it is already a possibly-wrapped promise) or creates a new
+    // promise using the Promise constructor.
+    unwrappedPromise = UnwrapAndDowncastObject<PromiseObject>(cx, promise);
+    if (!unwrappedPromise) {
+      return false;
+    }
   }
 
   // Steps 3-6 for creating onFulfilled/onRejected are done by caller.
@@ -5689,6 +5702,12 @@ template <typename T>
     return false;
   }
   extraStep(reaction);
+
+  if (!unwrappedPromise) {
+    // PerformPromiseThen steps 10.b-c for the elided fulfilled promise.
+    return EnqueuePromiseReactionJob(cx, reaction, value,
+                                     JS::PromiseState::Fulfilled);
+  }
   return PerformPromiseThenWithReaction(cx, unwrappedPromise, reaction);
 }
 
@@ -746,6 +746,66 @@ static char16_t Final_Sigma(const char16_t* chars, size_t length,
   return unicode::GREEK_SMALL_LETTER_SIGMA;
 }
 
+// Latin-1 strings are often pure ASCII, which can be case mapped eight
+// characters at a time by operating on 64-bit words.
+enum class ASCIICase { Lower, Upper };
+
+static constexpr uint64_t ASCIIWordOnes = 0x0101'0101'0101'0101;
+static constexpr uint64_t ASCIIWordHighBits = 0x8080'8080'8080'8080;
+
+// Return a mask with the high bit set in each byte of the all-ASCII word
+// |word| which changes when converted to |Case|.
+template <ASCIICase Case>
+static inline uint64_t ASCIIWordChangesMask(uint64_t word) {
+  MOZ_ASSERT((word & ASCIIWordHighBits) == 0);
+
+  constexpr uint8_t first = Case == ASCIICase::Lower ? 'A' : 'a';
+  constexpr uint8_t last = Case == ASCIICase::Lower ? 'Z' : 'z';
+
+  // The sums can't carry into the next byte, because all bytes are ASCII.
+  uint64_t geFirst = word + ASCIIWordOnes * (0x80 - first);
+  uint64_t gtLast = word + ASCIIWordOnes * (0x80 - last - 1);
+  return geFirst & ~gtLast & ASCIIWordHighBits;
+}
+
+// Return the number of leading characters in |chars| which don't change when
+// converted to |Case|, counted in whole all-ASCII words.
+template <ASCIICase Case>
+static size_t ASCIIWordsUnchangedByCase(const Latin1Char* chars,
+                                        size_t length) {
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, chars + i, sizeof(word));
+    if ((word & ASCIIWordHighBits) || ASCIIWordChangesMask<Case>(word)) {
+      break;
+    }
+  }
+  return i;
+}
+
+// Convert the leading all-ASCII words of |src| to |Case| and write them to
+// |dest|. Return the number of characters converted.
+template <ASCIICase Case>
+static size_t ConvertASCIIWordsCase(Latin1Char* dest, const Latin1Char* src,
+                                    size_t length) {
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, src + i, sizeof(word));
+    if (word & ASCIIWordHighBits) {
+      break;
+    }
+
+    // Upper and lower case ASCII letters differ only in bit 0x20. The mask has
+    // 0x80 set in each changing byte, so shift it into place.
+    uint64_t caseBits = ASCIIWordChangesMask<Case>(word) >> 2;
+    word = Case == ASCIICase::Lower ? (word | caseBits) : (word & ~caseBits);
+    memcpy(dest + i, &word, sizeof(word));
+  }
+  return i;
+}
+
 // If |srcLength == destLength| is true, the destination buffer was allocated
 // with the same size as the source buffer. When we append characters which
 // have special casing mappings, we test |srcLength == destLength| to decide
@@ -765,6 +825,16 @@ static size_t ToLowerCaseImpl(CharT* destChars, const CharT* srcChars,
 
   size_t j = startIndex;
   for (size_t i = startIndex; i < srcLength; i++) {
+    if constexpr (std::is_same_v<CharT, Latin1Char>) {
+      size_t n = ConvertASCIIWordsCase<ASCIICase::Lower>(
+          destChars + j, srcChars + i, srcLength - i);
+      i += n;
+      j += n;
+      if (i == srcLength) {
+        break;
+      }
+    }
+
     CharT c = srcChars[i];
     if constexpr (!std::is_same_v<CharT, Latin1Char>) {
       if (unicode::IsLeadSurrogate(c) && i + 1 < srcLength) {
@@ -858,6 +928,13 @@ static JSLinearString* ToLowerCase(JSContext* cx, JSLinearString* str) {
     // Look for the first character that changes when lowercased.
     size_t i = 0;
     for (; i < length; i++) {
+      if constexpr (std::is_same_v<CharT, Latin1Char>) {
+        i += ASCIIWordsUnchangedByCase<ASCIICase::Lower>(chars + i, length - i);
+        if (i == length) {
+          break;
+        }
+      }
+
       CharT c = chars[i];
       if constexpr (!std::is_same_v<CharT, Latin1Char>) {
         if (unicode::IsLeadSurrogate(c) && i + 1 < length) {
@@ -1132,6 +1209,16 @@ static size_t ToUpperCaseImpl(DestChar* destChars, const SrcChar* srcChars,
 
   size_t j = startIndex;
   for (size_t i = startIndex; i < srcLength; i++) {
+    if constexpr (std::is_same_v<DestChar, Latin1Char>) {
+      size_t n = ConvertASCIIWordsCase<ASCIICase::Upper>(
+          destChars + j, srcChars + i, srcLength - i);
+      i += n;
+      j += n;
+      if (i == srcLength) {
+        break;
+      }
+    }
+
     char16_t c = srcChars[i];
     if constexpr (!std::is_same_v<DestChar, Latin1Char>) {
       if (unicode::IsLeadSurrogate(c) && i + 1 < srcLength) {
@@ -1249,6 +1336,13 @@ static JSLinearString* ToUpperCase(JSContext* cx, JSLinearString* str) {
     // Look for the first character that changes when uppercased.
     size_t i = 0;
     for (; i < length; i++) {
+      if constexpr (std::is_same_v<CharT, Latin1Char>) {
+        i += ASCIIWordsUnchangedByCase<ASCIICase::Upper>(chars + i, length - i);
+        if (i == length) {
+          break;
+        }
+      }
+
       CharT c = chars[i];
       if constexpr (!std::is_same_v<CharT, Latin1Char>) {
         if (unicode::IsLeadSurrogate(c) && i + 1 < length) {
@@ -3368,9 +3462,26 @@ static bool ReplaceAllInternal(const AutoCheckCannotGC& nogc,
 
   uint32_t dollarIndex = FindDollarIndex(repChars, replaceLength);
 
-  // If it's true, we are sure that the result's length is, at least, the same
-  // length as |str->length()|.
-  if (replaceLength >= searchLength) {
+  if (dollarIndex == UINT32_MAX) {
+    // Without substitution patterns every match is replaced by the same
+    // number of characters, so count the matches up front and reserve the
+    // exact result length.
+    size_t matchCount = 0;
+    int32_t position = startPosition;
+    do {
+      matchCount++;
+      position = StringMatch(string, searchString, position + searchLength);
+    } while (position >= 0);
+
+    CheckedInt<uint32_t> length = stringLength;
+    length -= CheckedInt<uint32_t>(matchCount) * searchLength;
+    length += CheckedInt<uint32_t>(matchCount) * replaceLength;
+    if (length.isValid() && !result.reserve(length.value())) {
+      return false;
+    }
+  } else if (replaceLength >= searchLength) {
+    // If it's true, we are sure that the result's length is, at least, the
+    // same length as |str->length()|.
     if (!result.reserve(stringLength)) {
       return false;
     }
@@ -3655,86 +3766,83 @@ static ArrayObject* SplitHelper(JSContext* cx, Handle<JSLinearString*> str,
     return SingleElementStringArray(cx, str);
   }
 
-  // Step 3 (reordered).
-  Rooted<ArrayObject*> substrings(cx, NewDenseEmptyArray(cx));
-  if (!substrings) {
-    return nullptr;
-  }
-
-  // Switch to allocating in the tenured heap if we fill the nursery.
-  AutoSelectGCHeap gcHeap(cx);
-
-  // Step 8 (reordered).
-  size_t lastEndIndex = 0;
-
-  // Step 13.
+  // Steps 13-14, first pass.
+  //
+  // Record the start of every separator match before allocating anything, so
+  // the result array can be allocated once with its final length instead of
+  // being grown element by element. The separator is non-empty, so each match
+  // ends strictly after the previous one and step 14.c.i can never apply.
+  //
+  // Our match algorithm differs from the spec in that it returns the next
+  // index at which a match happens. If no match happens we're done.
+  Vector<uint32_t, 32> matches(cx);
   size_t index = 0;
-
-  // Step 14.
-  while (index != strLength) {
+  while (index != strLength && matches.length() < limit) {
     // Step 14.a.
     int match = StringMatch(str, sep, index);
 
     // Step 14.b.
-    //
-    // Our match algorithm differs from the spec in that it returns the
-    // next index at which a match happens.  If no match happens we're
-    // done.
-    //
-    // But what if the match is at the end of the string (and the string is
-    // not empty)?  Per 14.c.i this shouldn't be a match, so we have to
-    // specially exclude it.  Thus this case should hold:
-    //
-    //   var a = "abc".split(/\b/);
-    //   assertEq(a.length, 1);
-    //   assertEq(a[0], "abc");
     if (match == -1) {
       break;
     }
 
     // Step 14.c.
-    size_t endIndex = match + sepLength;
-
-    // Step 14.c.i.
-    if (endIndex == lastEndIndex) {
-      index++;
-      continue;
+    MOZ_ASSERT(size_t(match) >= index);
+    if (!matches.append(uint32_t(match))) {
+      return nullptr;
     }
 
-    // Step 14.c.ii.
-    MOZ_ASSERT(lastEndIndex < endIndex);
-    MOZ_ASSERT(sepLength <= strLength);
-    MOZ_ASSERT(lastEndIndex + sepLength <= endIndex);
+    // Step 14.c.ii.6.
+    index = match + sepLength;
+  }
+
+  // Step 14.c.ii.5.
+  //
+  // Once |limit| substrings have been collected the tail isn't added.
+  bool addTail = matches.length() < limit;
+  uint32_t count = matches.length() + uint32_t(addTail);
 
-    // Step 14.c.ii.1.
-    size_t subLength = size_t(endIndex - sepLength - lastEndIndex);
+  // Step 3 (reordered).
+  Rooted<ArrayObject*> substrings(cx, NewDenseFullyAllocatedArray(cx, count));
+  if (!substrings) {
+    return nullptr;
+  }
+  substrings->ensureDenseInitializedLength(0, count);
+
+  // Switch to allocating in the tenured heap if we fill the nursery.
+  AutoSelectGCHeap gcHeap(cx);
+
+  // Step 8 (reordered).
+  size_t lastEndIndex = 0;
+
+  // Steps 14.c.ii.1-4 and 14.c.ii.7, second pass.
+  for (size_t i = 0; i < matches.length(); i++) {
+    size_t match = matches[i];
+    MOZ_ASSERT(lastEndIndex <= match);
+    MOZ_ASSERT(match + sepLength <= strLength);
+
+    size_t subLength = match - lastEndIndex;
     JSString* sub =
         NewDependentString(cx, str, lastEndIndex, subLength, gcHeap);
-
-    // Steps 14.c.ii.2-4.
-    if (!sub || !NewbornArrayPush(cx, substrings, StringValue(sub))) {
+    if (!sub) {
       return nullptr;
     }
+    substrings->initDenseElement(i, StringValue(sub));
 
-    // Step 14.c.ii.5.
-    if (substrings->length() == limit) {
-      return substrings;
-    }
-
-    // Step 14.c.ii.6.
-    index = endIndex;
-
-    // Step 14.c.ii.7.
-    lastEndIndex = index;
+    lastEndIndex = match + sepLength;
   }
 
-  // Step 15.
-  size_t subLength = strLength - lastEndIndex;
-  JSString* sub = NewDependentString(cx, str, lastEndIndex, subLength, gcHeap);
+  if (addTail) {
+    // Step 15.
+    size_t subLength = strLength - lastEndIndex;
+    JSString* sub =
+        NewDependentString(cx, str, lastEndIndex, subLength, gcHeap);
+    if (!sub) {
+      return nullptr;
+    }
 
-  // Steps 16-17.
-  if (!sub || !NewbornArrayPush(cx, substrings, StringValue(sub))) {
-    return nullptr;
+    // Steps 16-17.
+    substrings->initDenseElement(matches.length(), StringValue(sub));
   }
 
   // Step 18.
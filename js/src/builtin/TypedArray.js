@@ -619,6 +619,8 @@ function TypedArrayReduce(callbackfn /*, initialValue*/) {
   // Step 11.
   return accumulator;
 }
+// Inlining this enables inlining of the callback function.
+SetIsInlinableLargeFunction(TypedArrayReduce);
 
 // ES2021 draft rev 190d474c3d8728653fbf8a5a37db1de34b9c1472
 // Plus <https://github.com/tc39/ecma262/pull/2221>
@@ -673,6 +675,8 @@ function TypedArrayReduceRight(callbackfn /*, initialValue*/) {
   // Step 11.
   return accumulator;
 }
+// Inlining this enables inlining of the callback function.
+SetIsInlinableLargeFunction(TypedArrayReduceRight);
 
 // ES2017 draft rev 6859bb9ccaea9c6ede81d71e5320e3833b92cb3e
 // 22.2.3.24 %TypedArray%.prototype.slice ( start, end )
@@ -423,6 +423,24 @@ static bool intl_CompareStrings(JSContext* cx, mozilla::intl::Collator* coll,
     return true;
   }
 
+  // ASCII strings are also valid UTF-8, so they can be compared without
+  // inflating them to two-byte strings first.
+  if (!str1->ensureLinear(cx) || !str2->ensureLinear(cx)) {
+    return false;
+  }
+  JSLinearString* linear1 = &str1->asLinear();
+  JSLinearString* linear2 = &str2->asLinear();
+  if (linear1->hasLatin1Chars() && linear2->hasLatin1Chars() &&
+      StringIsAscii(linear1) && StringIsAscii(linear2)) {
+    JS::AutoCheckCannotGC nogc;
+    auto chars1 = mozilla::AsChars(
+        mozilla::Span(linear1->latin1Chars(nogc), linear1->length()));
+    auto chars2 = mozilla::AsChars(
+        mozilla::Span(linear2->latin1Chars(nogc), linear2->length()));
+    result.setInt32(coll->CompareStringsUTF8(chars1, chars2));
+    return true;
+  }
+
   AutoStableStringChars stableChars1(cx);
   if (!stableChars1.initTwoByte(cx, str1)) {
     return false;
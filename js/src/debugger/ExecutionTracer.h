@@ -356,6 +356,10 @@ class ExecutionTracer {
   static mozilla::Vector<ExecutionTracer*> globalInstances;
 
   // The buffers below should only be accessed while we hold the lock.
+  //
+  // Each tracer is only written by its own context's thread, so the lock is
+  // uncontended except while getNativeTrace is copying the buffers out, and
+  // tracing one thread never blocks on another.
   Mutex bufferLock_ MOZ_UNANNOTATED;
 
   // This holds the actual entries, one for each push or pop of a frame or label
@@ -2088,6 +2088,11 @@ struct DebuggerScript::SetBreakpointMatcher {
     // not already a debuggee, trying to ensure observability after setting
     // the breakpoint (and thus marking the script as a debuggee) will skip
     // actually ensuring observability.
+    //
+    // Only |script| itself is affected: its Baseline code is recompiled with
+    // debug instrumentation and Ion code for it, including copies inlined
+    // into other scripts, is invalidated. The rest of the realm keeps its JIT
+    // code, so breakpoints used as logpoints are cheap outside their script.
     if (!dbg_->ensureExecutionObservabilityOfScript(cx_, script)) {
       return false;
     }
@@ -111,3 +111,26 @@ void SparseBitmap::bitwiseOrInto(DenseBitmap& other) const {
     }
   }
 }
+
+void SparseBitmap::bitwiseOrWordRangeInto(DenseBitmap& other, size_t wordStart,
+                                          size_t numWords) const {
+  MOZ_ASSERT(wordStart + numWords <= other.numWords());
+
+  size_t wordEnd = wordStart + numWords;
+  size_t blockWord = blockStartWord(wordStart);
+  for (; blockWord < wordEnd; blockWord += WordsInBlock) {
+    const BitBlock* block =
+        readonlyThreadsafeGetBlock(blockWord / WordsInBlock);
+    if (!block) {
+      continue;
+    }
+
+    size_t start = std::max(blockWord, wordStart);
+    size_t end = std::min(blockWord + WordsInBlock, wordEnd);
+    const uintptr_t* source = &(*block)[start - blockWord];
+    uintptr_t* target = &other.word(start);
+    for (size_t i = 0; i < end - start; i++) {
+      target[i] |= source[i];
+    }
+  }
+}
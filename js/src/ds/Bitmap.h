@@ -162,6 +162,15 @@ class SparseBitmap {
   void bitwiseOrWith(const SparseBitmap& other);
   void bitwiseOrInto(DenseBitmap& other) const;
 
+  bool isEmpty() const { return data.empty(); }
+
+  // Bitwise-or the words in [wordStart, wordStart + numWords) into |other|.
+  // Unlike bitwiseOrInto this only reads the table, so it may be called from
+  // several threads at once provided the bitmap is not being modified and the
+  // target ranges do not overlap.
+  void bitwiseOrWordRangeInto(DenseBitmap& other, size_t wordStart,
+                              size_t numWords) const;
+
   // Currently, the following APIs only supports a range of words that is in a
   // single bit block.
 
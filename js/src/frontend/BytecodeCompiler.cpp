@@ -17,9 +17,12 @@
 #include "frontend/CompilationStencil.h"  // ExtensibleCompilationStencil, ExtraBindingInfoVector, CompilationInput, CompilationGCOutput
 #include "frontend/EitherParser.h"
 #include "frontend/FrontendContext.h"  // AutoReportFrontendContext
+#include "frontend/FrontendLifoAllocCache.h"  // AutoFrontendLifoAlloc
+#include "frontend/IncrementalReparse.h"  // IncrementalReparse
 #include "frontend/ModuleSharedContext.h"
 #include "frontend/ParserAtom.h"     // ParserAtomsTable, TaggedParserAtomIndex
 #include "frontend/SharedContext.h"  // SharedContext, GlobalSharedContext
+#include "frontend/SharedDelazificationCache.h"  // SharedDelazificationCache
 #include "frontend/Stencil.h"        // ParserBindingIter
 #include "frontend/UsedNameTracker.h"  // UsedNameTracker, UsedNameMap
 #include "js/AllocPolicy.h"        // js::SystemAllocPolicy, ReportOutOfMemory
@@ -423,12 +426,14 @@ static already_AddRefed<JS::Stencil> CompileGlobalScriptToStencilImpl(
       options.nonSyntacticScope ? ScopeKind::NonSyntactic : ScopeKind::Global;
 
   NoScopeBindingCache scopeCache;
-  js::LifoAlloc tempLifoAlloc(JSContext::TEMP_LIFO_ALLOC_PRIMARY_CHUNK_SIZE,
-                              js::BackgroundMallocArena);
+  AutoFrontendLifoAlloc tempLifoAlloc;
+  if (!tempLifoAlloc.init(fc)) {
+    return nullptr;
+  }
   CompilationInput compilationInput(options);
   RefPtr<InitialStencilAndDelazifications> stencils;
   if (!CompileGlobalScriptToStencilAndMaybeInstantiate(
-          nullptr, fc, tempLifoAlloc, compilationInput, &scopeCache, srcBuf,
+          nullptr, fc, tempLifoAlloc.get(), compilationInput, &scopeCache, srcBuf,
           scopeKind, NoExtraBindings, NoInitialStencilOut,
           getter_AddRefs(stencils), NoGCOutput)) {
     JS_HAZ_VALUE_IS_GC_SAFE(compilationInput);
@@ -964,6 +969,22 @@ bool ScriptCompiler<Unit>::compile(JSContext* maybeCx, SharedContext* sc) {
     return false;
   }
 
+  // When compiling an edited script, the functions whose text is unchanged are
+  // copied from the previous compilation. The free names of these functions
+  // are not noted, thus this is not used when looking for extra bindings.
+  const auto& options = compilationState_.input.options;
+  Maybe<IncrementalReparse> incrementalReparse;
+  if (options.previousStencil() && sc->isGlobalContext() &&
+      !options.nonSyntacticScope &&
+      !compilationState_.input.hasExtraBindings()) {
+    incrementalReparse.emplace(*options.previousStencil()->getInitial());
+    if (!incrementalReparse->init(sc->fc_, sourceBuffer_.units(),
+                                  sourceBuffer_.length())) {
+      return false;
+    }
+    compilationState_.incrementalReparse = incrementalReparse.ptr();
+  }
+
   ParseNode* pn;
   {
     Maybe<AutoGeckoProfilerEntry> pseudoFrame;
@@ -977,6 +998,7 @@ bool ScriptCompiler<Unit>::compile(JSContext* maybeCx, SharedContext* sc) {
       pn = parser->globalBody(sc->asGlobalContext()).unwrapOr(nullptr);
     }
   }
+  compilationState_.incrementalReparse = nullptr;
 
   if (!pn) {
     // Global and eval scripts don't get reparsed after a new directive was
@@ -1266,10 +1288,12 @@ static already_AddRefed<JS::Stencil> CompileModuleScriptToStencilImpl(
   frontend::CompilationInput compilationInput(options);
 
   NoScopeBindingCache scopeCache;
-  js::LifoAlloc tempLifoAlloc(JSContext::TEMP_LIFO_ALLOC_PRIMARY_CHUNK_SIZE,
-                              js::BackgroundMallocArena);
+  AutoFrontendLifoAlloc tempLifoAlloc;
+  if (!tempLifoAlloc.init(fc)) {
+    return nullptr;
+  }
   RefPtr<CompilationStencil> stencil = ParseModuleToStencilImpl(
-      nullptr, fc, tempLifoAlloc, compilationInput, &scopeCache, srcBuf);
+      nullptr, fc, tempLifoAlloc.get(), compilationInput, &scopeCache, srcBuf);
   if (!stencil) {
     JS_HAZ_VALUE_IS_GC_SAFE(compilationInput);
     return nullptr;
@@ -1376,7 +1400,8 @@ static bool CompileLazyFunctionToStencilMaybeInstantiate(
     JSContext* maybeCx, FrontendContext* fc, js::LifoAlloc& tempLifoAlloc,
     CompilationInput& input, ScopeBindingCache* scopeCache, const Unit* units,
     size_t length, InitialStencilAndDelazifications* stencils,
-    const CompilationStencil** borrowOut) {
+    const CompilationStencil** borrowOut,
+    SharedDelazificationCache::Key* sharedKey = nullptr) {
   MOZ_ASSERT(input.source);
 
   AutoAssertReportedException assertException(maybeCx, fc);
@@ -1469,7 +1494,7 @@ static bool CompileLazyFunctionToStencilMaybeInstantiate(
     *borrowOut = stencils->storeDelazification(std::move(stencil));
   } else {
     MOZ_ASSERT(maybeCx);
-    if (stencils) {
+    if (stencils || sharedKey) {
       auto extensibleStencil =
           maybeCx->make_unique<frontend::ExtensibleCompilationStencil>(
               std::move(compilationState));
@@ -1483,8 +1508,15 @@ static bool CompileLazyFunctionToStencilMaybeInstantiate(
         return false;
       }
 
-      const CompilationStencil* borrowed =
-          stencils->storeDelazification(std::move(stencil));
+      if (sharedKey) {
+        maybeCx->caches().sharedDelazificationCache.put(std::move(*sharedKey),
+                                                        stencil);
+      }
+
+      const CompilationStencil* borrowed = stencil;
+      if (stencils) {
+        borrowed = stencils->storeDelazification(std::move(stencil));
+      }
 
       if (!InstantiateLazyFunction(maybeCx, input, *borrowed)) {
         return false;
@@ -1515,6 +1547,11 @@ static bool DelazifyCanonicalScriptedFunctionImpl(JSContext* cx,
 
   AutoIncrementalTimer timer(cx->realm()->timers.delazificationTime);
 
+  // Functions are delazified on the main thread the first time they are
+  // called. Remember the order so that embeddings can replay it with
+  // JS::DelazificationOption::ConcurrentRecordedOrder.
+  ss->recordDelazification(lazy->sourceStart());
+
   JS::CompileOptions options(cx);
   options.setMutedErrors(lazy->mutedErrors())
       .setFileAndLine(lazy->filename(), lazy->lineno())
@@ -1554,9 +1591,24 @@ static bool DelazifyCanonicalScriptedFunctionImpl(JSContext* cx,
     return false;
   }
 
+  // Reuse the stencil of a function with the same source text and context in
+  // another script if any, otherwise share ours. Within the same source, the
+  // stencil is only reused when delazifying the same function again.
+  SharedDelazificationCache::Key sharedKey;
+  bool isShareable = sharedKey.init(lazy, units.get(), sourceLength);
+  if (isShareable) {
+    const CompilationStencil* shared =
+        cx->caches().sharedDelazificationCache.lookup(sharedKey);
+    auto functionKey = input.get().extent().toFunctionKey();
+    if (shared &&
+        (shared->source != ss || shared->functionKey == functionKey)) {
+      return InstantiateLazyFunction(cx, input.get(), *shared);
+    }
+  }
+
   return CompileLazyFunctionToStencilMaybeInstantiate(
       cx, fc, cx->tempLifoAlloc(), input.get(), scopeCache, units.get(),
-      sourceLength, stencils, nullptr);
+      sourceLength, stencils, nullptr, isShareable ? &sharedKey : nullptr);
 }
 
 bool frontend::DelazifyCanonicalScriptedFunction(JSContext* cx,
@@ -1673,7 +1725,8 @@ static JSFunction* CompileStandaloneFunction(
     JSContext* cx, const JS::ReadOnlyCompileOptions& options,
     JS::SourceText<char16_t>& srcBuf, const Maybe<uint32_t>& parameterListEnd,
     FunctionSyntaxKind syntaxKind, GeneratorKind generatorKind,
-    FunctionAsyncKind asyncKind, JS::Handle<Scope*> enclosingScope = nullptr) {
+    FunctionAsyncKind asyncKind, JS::Handle<Scope*> enclosingScope = nullptr,
+    CompilationStencil** stencilOut = nullptr) {
   JS::Rooted<JSFunction*> fun(cx);
   {
     AutoReportFrontendContext fc(cx);
@@ -1709,7 +1762,28 @@ static JSFunction* CompileStandaloneFunction(
 
     Rooted<CompilationGCOutput> gcOutput(cx);
     RefPtr<ScriptSource> source;
-    {
+    if (stencilOut && !compiler.stencil().asmJS) {
+      auto extensibleStencil =
+          fc.getAllocator()->make_unique<ExtensibleCompilationStencil>(
+              std::move(compiler.stencil()));
+      if (!extensibleStencil) {
+        return nullptr;
+      }
+
+      RefPtr<CompilationStencil> stencil =
+          fc.getAllocator()->new_<CompilationStencil>(
+              std::move(extensibleStencil));
+      if (!stencil) {
+        return nullptr;
+      }
+
+      if (!CompilationStencil::instantiateStencils(cx, input.get(), *stencil,
+                                                   gcOutput.get())) {
+        return nullptr;
+      }
+      source = stencil->source;
+      stencil.forget(stencilOut);
+    } else {
       BorrowingCompilationStencil borrowingStencil(compiler.stencil());
       if (!CompilationStencil::instantiateStencils(
               cx, input.get(), borrowingStencil, gcOutput.get())) {
@@ -1748,37 +1822,73 @@ static JSFunction* CompileStandaloneFunction(
 JSFunction* frontend::CompileStandaloneFunction(
     JSContext* cx, const JS::ReadOnlyCompileOptions& options,
     JS::SourceText<char16_t>& srcBuf, const Maybe<uint32_t>& parameterListEnd,
-    FunctionSyntaxKind syntaxKind) {
+    FunctionSyntaxKind syntaxKind, CompilationStencil** stencilOut) {
   return CompileStandaloneFunction(cx, options, srcBuf, parameterListEnd,
                                    syntaxKind, GeneratorKind::NotGenerator,
-                                   FunctionAsyncKind::SyncFunction);
+                                   FunctionAsyncKind::SyncFunction,
+                                   /* enclosingScope = */ nullptr, stencilOut);
 }
 
 JSFunction* frontend::CompileStandaloneGenerator(
     JSContext* cx, const JS::ReadOnlyCompileOptions& options,
     JS::SourceText<char16_t>& srcBuf, const Maybe<uint32_t>& parameterListEnd,
-    FunctionSyntaxKind syntaxKind) {
+    FunctionSyntaxKind syntaxKind, CompilationStencil** stencilOut) {
   return CompileStandaloneFunction(cx, options, srcBuf, parameterListEnd,
                                    syntaxKind, GeneratorKind::Generator,
-                                   FunctionAsyncKind::SyncFunction);
+                                   FunctionAsyncKind::SyncFunction,
+                                   /* enclosingScope = */ nullptr, stencilOut);
 }
 
 JSFunction* frontend::CompileStandaloneAsyncFunction(
     JSContext* cx, const ReadOnlyCompileOptions& options,
     JS::SourceText<char16_t>& srcBuf, const Maybe<uint32_t>& parameterListEnd,
-    FunctionSyntaxKind syntaxKind) {
+    FunctionSyntaxKind syntaxKind, CompilationStencil** stencilOut) {
   return CompileStandaloneFunction(cx, options, srcBuf, parameterListEnd,
                                    syntaxKind, GeneratorKind::NotGenerator,
-                                   FunctionAsyncKind::AsyncFunction);
+                                   FunctionAsyncKind::AsyncFunction,
+                                   /* enclosingScope = */ nullptr, stencilOut);
 }
 
 JSFunction* frontend::CompileStandaloneAsyncGenerator(
     JSContext* cx, const ReadOnlyCompileOptions& options,
     JS::SourceText<char16_t>& srcBuf, const Maybe<uint32_t>& parameterListEnd,
-    FunctionSyntaxKind syntaxKind) {
+    FunctionSyntaxKind syntaxKind, CompilationStencil** stencilOut) {
   return CompileStandaloneFunction(cx, options, srcBuf, parameterListEnd,
                                    syntaxKind, GeneratorKind::Generator,
-                                   FunctionAsyncKind::AsyncFunction);
+                                   FunctionAsyncKind::AsyncFunction,
+                                   /* enclosingScope = */ nullptr, stencilOut);
+}
+
+JSFunction* frontend::InstantiateStandaloneFunction(
+    JSContext* cx, const ReadOnlyCompileOptions& options,
+    const CompilationStencil& stencil) {
+  JS::Rooted<JSFunction*> fun(cx);
+  {
+    AutoReportFrontendContext fc(cx);
+    AutoAssertReportedException assertException(cx, &fc);
+
+    Rooted<CompilationInput> input(cx, CompilationInput(options));
+    if (!input.get().initForStandaloneFunction(cx, &fc)) {
+      return nullptr;
+    }
+
+    Rooted<CompilationGCOutput> gcOutput(cx);
+    if (!CompilationStencil::instantiateStencils(cx, input.get(), stencil,
+                                                 gcOutput.get())) {
+      return nullptr;
+    }
+
+    fun = gcOutput.get().getFunctionNoBaseIndex(
+        CompilationStencil::TopLevelIndex);
+    MOZ_ASSERT(fun->hasBytecode());
+
+    const JS::InstantiateOptions instantiateOptions(options);
+    Rooted<JSScript*> script(cx, gcOutput.get().script);
+    FireOnNewScript(cx, instantiateOptions, script);
+
+    assertException.reset();
+  }
+  return fun;
 }
 
 JSFunction* frontend::CompileStandaloneFunctionInNonSyntacticScope(
@@ -203,29 +203,44 @@ ModuleObject* CompileModule(JSContext* cx, FrontendContext* fc,
 //     Function("/*", "*/x) {")
 //     Function("x){ if (3", "return x;}")
 //
+// If stencilOut is non-null, the stencil used to instantiate the function is
+// returned there with a reference added, so that the function can be
+// instantiated again without reparsing. No stencil is returned for asm.js
+// modules.
+//
 [[nodiscard]] JSFunction* CompileStandaloneFunction(
     JSContext* cx, const JS::ReadOnlyCompileOptions& options,
     JS::SourceText<char16_t>& srcBuf,
     const mozilla::Maybe<uint32_t>& parameterListEnd,
-    frontend::FunctionSyntaxKind syntaxKind);
+    frontend::FunctionSyntaxKind syntaxKind,
+    CompilationStencil** stencilOut = nullptr);
 
 [[nodiscard]] JSFunction* CompileStandaloneGenerator(
     JSContext* cx, const JS::ReadOnlyCompileOptions& options,
     JS::SourceText<char16_t>& srcBuf,
     const mozilla::Maybe<uint32_t>& parameterListEnd,
-    frontend::FunctionSyntaxKind syntaxKind);
+    frontend::FunctionSyntaxKind syntaxKind,
+    CompilationStencil** stencilOut = nullptr);
 
 [[nodiscard]] JSFunction* CompileStandaloneAsyncFunction(
     JSContext* cx, const JS::ReadOnlyCompileOptions& options,
     JS::SourceText<char16_t>& srcBuf,
     const mozilla::Maybe<uint32_t>& parameterListEnd,
-    frontend::FunctionSyntaxKind syntaxKind);
+    frontend::FunctionSyntaxKind syntaxKind,
+    CompilationStencil** stencilOut = nullptr);
 
 [[nodiscard]] JSFunction* CompileStandaloneAsyncGenerator(
     JSContext* cx, const JS::ReadOnlyCompileOptions& options,
     JS::SourceText<char16_t>& srcBuf,
     const mozilla::Maybe<uint32_t>& parameterListEnd,
-    frontend::FunctionSyntaxKind syntaxKind);
+    frontend::FunctionSyntaxKind syntaxKind,
+    CompilationStencil** stencilOut = nullptr);
+
+// Instantiate a function previously compiled by one of the functions above
+// with a non-null |stencilOut|, in the current global.
+[[nodiscard]] JSFunction* InstantiateStandaloneFunction(
+    JSContext* cx, const JS::ReadOnlyCompileOptions& options,
+    const CompilationStencil& stencil);
 
 // Compile a single function in given enclosing non-syntactic scope.
 [[nodiscard]] JSFunction* CompileStandaloneFunctionInNonSyntacticScope(
@@ -2473,6 +2473,10 @@ bool BytecodeEmitter::emitScript(ParseNode* body) {
 
 js::UniquePtr<ImmutableScriptData>
 BytecodeEmitter::createImmutableScriptData() {
+  if (!bytecodeSection().threadJumps(fc)) {
+    return nullptr;
+  }
+
   uint32_t nslots;
   if (!getNslots(&nslots)) {
     return nullptr;
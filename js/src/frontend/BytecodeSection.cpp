@@ -6,12 +6,14 @@
 
 #include "frontend/BytecodeSection.h"
 
-#include "mozilla/Assertions.h"  // MOZ_ASSERT
+#include "mozilla/Assertions.h"    // MOZ_ASSERT
+#include "mozilla/BinarySearch.h"  // mozilla::BinarySearch
 
 #include "frontend/AbstractScopePtr.h"    // ScopeIndex
 #include "frontend/CompilationStencil.h"  // CompilationStencil
 #include "frontend/FrontendContext.h"     // FrontendContext
 #include "frontend/SharedContext.h"       // FunctionBox
+#include "frontend/SourceNotes.h"         // SrcNoteIterator
 #include "js/ColumnNumber.h"              // JS::LimitedColumnNumberOneOrigin
 #include "vm/BytecodeUtil.h"              // INDEX_LIMIT, StackUses, StackDefs
 #include "vm/GlobalObject.h"
@@ -186,6 +188,67 @@ void BytecodeSection::updateDepth(JSOp op, BytecodeOffset target) {
   }
 }
 
+// Bound the number of Gotos a single jump is threaded through.
+static constexpr size_t MaxJumpThreadingHops = 8;
+
+bool BytecodeSection::threadJumps(FrontendContext* fc) {
+  // Breakpoints and stepping are keyed on source notes, so a JumpTarget or
+  // Goto with a note attached must keep being executed.
+  Vector<uint32_t, 64> notedOffsets(fc);
+  uint32_t noteOffset = 0;
+  for (SrcNoteIterator iter(notes_.begin(), notes_.end()); !iter.atEnd();
+       ++iter) {
+    noteOffset += (*iter)->delta();
+    if (!notedOffsets.empty() && notedOffsets.back() == noteOffset) {
+      continue;
+    }
+    if (!notedOffsets.append(noteOffset)) {
+      return false;
+    }
+  }
+
+  auto hasNote = [&](uint32_t offset) {
+    size_t unused;
+    return mozilla::BinarySearch(notedOffsets, 0, notedOffsets.length(),
+                                 offset, &unused);
+  };
+
+  jsbytecode* start = code_.begin();
+  jsbytecode* end = code_.end();
+  for (jsbytecode* pc = start; pc < end; pc += GetBytecodeLength(pc)) {
+    JSOp op = JSOp(*pc);
+    if (!IsJumpOpcode(op)) {
+      continue;
+    }
+
+    jsbytecode* target = pc + GET_JUMP_OFFSET(pc);
+    for (size_t hops = 0; hops < MaxJumpThreadingHops; hops++) {
+      if (JSOp(*target) != JSOp::JumpTarget) {
+        break;
+      }
+      jsbytecode* gotoPC = target + JSOpLength_JumpTarget;
+      if (gotoPC >= end || JSOp(*gotoPC) != JSOp::Goto) {
+        break;
+      }
+      if (hasNote(target - start) || hasNote(gotoPC - start)) {
+        break;
+      }
+
+      // Backward Gotos target a LoopHead, and a forward jump must not become
+      // a second backedge of the loop.
+      jsbytecode* next = gotoPC + GET_JUMP_OFFSET(gotoPC);
+      if (JSOp(*next) != JSOp::JumpTarget || next == target) {
+        break;
+      }
+      target = next;
+    }
+
+    SET_JUMP_OFFSET(pc, int32_t(target - pc));
+  }
+
+  return true;
+}
+
 PerScriptData::PerScriptData(FrontendContext* fc,
                              frontend::CompilationState& compilationState)
     : gcThingList_(fc, compilationState),
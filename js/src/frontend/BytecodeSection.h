@@ -218,6 +218,11 @@ class BytecodeSection {
 
   void updateDepth(JSOp op, BytecodeOffset target);
 
+  // Retarget each jump whose target is a JumpTarget immediately followed by a
+  // Goto, so that it jumps to the Goto's own destination. Bytecode offsets are
+  // left unchanged, so notes and lists indexed by offset stay valid.
+  [[nodiscard]] bool threadJumps(FrontendContext* fc);
+
   // ---- Try notes ----
 
   CGTryNoteList& tryNoteList() { return tryNoteList_; };
@@ -78,6 +78,7 @@ struct PreallocatedCompilationGCOutput;
 class ScriptStencilIterable;
 struct InputName;
 class ScopeBindingCache;
+class IncrementalReparse;
 
 // When delazifying modules' inner functions, the actual global scope is used.
 // However, when doing a delazification the global scope is not available. We
@@ -1651,6 +1652,10 @@ struct MOZ_RAII CompilationState : public ExtensibleCompilationStencil {
   CompilationInput& input;
   CompilationSyntaxParseCache previousParseCache;
 
+  // When compiling an edited global script, the previous compilation whose
+  // unchanged top-level functions are reused by the parser.
+  const IncrementalReparse* incrementalReparse = nullptr;
+
   // The number of functions that *will* have bytecode.
   // This doesn't count top-level non-function script.
   //
@@ -0,0 +1,98 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+ * vim: set ts=8 sts=2 et sw=2 tw=80:
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "frontend/DynamicFunctionCache.h"
+
+#include "mozilla/ArrayUtils.h"  // mozilla::ArrayEqual
+#include "mozilla/Assertions.h"  // MOZ_ASSERT
+
+#include <utility>  // std::move
+
+#include "frontend/CompilationStencil.h"  // CompilationStencil
+
+using namespace js;
+using namespace js::frontend;
+
+using mozilla::AddToHash;
+using mozilla::HashString;
+
+DynamicFunctionCache::Lookup::Lookup(JS::Realm* realm, JSScript* callerScript,
+                                     uint32_t pcOffset, const char16_t* chars,
+                                     size_t length)
+    : realm(realm),
+      callerScript(callerScript),
+      pcOffset(pcOffset),
+      chars(chars),
+      length(length),
+      hash(AddToHash(HashString(chars, length), realm, callerScript,
+                     pcOffset)) {}
+
+bool DynamicFunctionCache::Key::init(const Lookup& lookup) {
+  realm_ = lookup.realm;
+  callerScript_ = lookup.callerScript;
+  pcOffset_ = lookup.pcOffset;
+  hash_ = lookup.hash;
+  return chars_.append(lookup.chars, lookup.length);
+}
+
+bool DynamicFunctionCache::Key::matches(const Lookup& lookup) const {
+  return hash_ == lookup.hash && realm_ == lookup.realm &&
+         callerScript_ == lookup.callerScript &&
+         pcOffset_ == lookup.pcOffset && chars_.length() == lookup.length &&
+         mozilla::ArrayEqual(chars_.begin(), lookup.chars, lookup.length);
+}
+
+DynamicFunctionCache::DynamicFunctionCache() = default;
+DynamicFunctionCache::~DynamicFunctionCache() = default;
+
+CompilationStencil* DynamicFunctionCache::lookup(const Lookup& l) const {
+  if (!map_) {
+    return nullptr;
+  }
+  if (auto p = map_->lookup(l)) {
+    return p->value().get();
+  }
+  return nullptr;
+}
+
+void DynamicFunctionCache::put(const Lookup& l, CompilationStencil* stencil) {
+  MOZ_ASSERT(stencil->isInitialStencil());
+  MOZ_ASSERT(!stencil->asmJS);
+
+  if (keyChars_ + l.length > MaxKeyChars) {
+    return;
+  }
+
+  if (!map_) {
+    map_ = MakeUnique<Map>();
+    if (!map_) {
+      return;
+    }
+  }
+
+  if (map_->count() >= MaxEntries) {
+    return;
+  }
+
+  auto p = map_->lookupForAdd(l);
+  if (p) {
+    return;
+  }
+
+  Key key;
+  if (!key.init(l)) {
+    return;
+  }
+  if (!map_->add(p, std::move(key), stencil)) {
+    return;
+  }
+  keyChars_ += l.length;
+}
+
+void DynamicFunctionCache::purge() {
+  map_ = nullptr;
+  keyChars_ = 0;
+}
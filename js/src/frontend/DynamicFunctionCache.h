@@ -0,0 +1,105 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+ * vim: set ts=8 sts=2 et sw=2 tw=80:
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef frontend_DynamicFunctionCache_h
+#define frontend_DynamicFunctionCache_h
+
+#include "mozilla/HashFunctions.h"  // mozilla::HashNumber
+#include "mozilla/RefPtr.h"         // RefPtr
+
+#include <stddef.h>  // size_t
+#include <stdint.h>  // uint32_t
+
+#include "js/AllocPolicy.h"  // SystemAllocPolicy
+#include "js/HashTable.h"    // HashMap
+#include "js/TypeDecls.h"    // JS::Realm, JSScript
+#include "js/UniquePtr.h"    // UniquePtr
+#include "js/Vector.h"       // Vector
+
+namespace js {
+namespace frontend {
+
+struct CompilationStencil;
+
+// Runtime-wide cache of the stencils compiled by the Function constructor and
+// its generator and async variants. Template engines and RPC layers often
+// build the same function from the same strings over and over again; with
+// this cache only the first call parses, and later calls instantiate a new
+// function from the cached stencil.
+//
+// The stencil depends on the function text and on the CompileOptions, which
+// are derived from the calling script and pc. Both are part of the key, as is
+// the realm of the Function constructor, so that realm-specific options such
+// as discardSource always match.
+//
+// Keys refer to realms and scripts by address and cached stencils keep their
+// ScriptSource alive, so the whole cache is purged on GC.
+class DynamicFunctionCache {
+ public:
+  struct Lookup {
+    JS::Realm* realm;
+    JSScript* callerScript;
+    uint32_t pcOffset;
+    const char16_t* chars;
+    size_t length;
+    mozilla::HashNumber hash;
+
+    Lookup(JS::Realm* realm, JSScript* callerScript, uint32_t pcOffset,
+           const char16_t* chars, size_t length);
+  };
+
+ private:
+  class Key {
+    JS::Realm* realm_ = nullptr;
+    JSScript* callerScript_ = nullptr;
+    uint32_t pcOffset_ = 0;
+    mozilla::HashNumber hash_ = 0;
+    Vector<char16_t, 0, SystemAllocPolicy> chars_;
+
+   public:
+    Key() = default;
+    Key(Key&& other) = default;
+    Key& operator=(Key&& other) = default;
+
+    [[nodiscard]] bool init(const Lookup& lookup);
+
+    size_t length() const { return chars_.length(); }
+    bool matches(const Lookup& lookup) const;
+  };
+
+  struct KeyHasher {
+    using Lookup = DynamicFunctionCache::Lookup;
+    static mozilla::HashNumber hash(const Lookup& l) { return l.hash; }
+    static bool match(const Key& k, const Lookup& l) { return k.matches(l); }
+  };
+
+  using Map = HashMap<Key, RefPtr<CompilationStencil>, KeyHasher,
+                      SystemAllocPolicy>;
+
+  // Limits on the number of cached functions and on the size of their keys,
+  // which hold a copy of the function text.
+  static constexpr size_t MaxEntries = 256;
+  static constexpr size_t MaxKeyChars = 1024 * 1024;
+
+  UniquePtr<Map> map_;
+  size_t keyChars_ = 0;
+
+ public:
+  DynamicFunctionCache();
+  ~DynamicFunctionCache();
+
+  CompilationStencil* lookup(const Lookup& l) const;
+
+  // Cache the |stencil| compiled for |l|. Failures are ignored.
+  void put(const Lookup& l, CompilationStencil* stencil);
+
+  void purge();
+};
+
+}  // namespace frontend
+}  // namespace js
+
+#endif  // frontend_DynamicFunctionCache_h
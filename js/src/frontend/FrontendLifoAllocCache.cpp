@@ -0,0 +1,77 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+ * vim: set ts=8 sts=2 et sw=2 tw=80:
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "frontend/FrontendLifoAllocCache.h"
+
+#include <utility>  // std::move, std::swap
+
+#include "ds/LifoAlloc.h"              // LifoAlloc
+#include "frontend/FrontendContext.h"  // FrontendContext
+#include "js/Utility.h"                // js::BackgroundMallocArena
+#include "threading/LockGuard.h"       // js::LockGuard
+#include "vm/JSContext.h"  // JSContext::TEMP_LIFO_ALLOC_PRIMARY_CHUNK_SIZE
+#include "vm/MutexIDs.h"   // mutexid
+
+using namespace js;
+using namespace js::frontend;
+
+MOZ_RUNINIT js::Mutex FrontendLifoAllocCache::lock_(
+    mutexid::FrontendLifoAllocCache);
+
+MOZ_RUNINIT FrontendLifoAllocCache::LifoAllocVector
+    FrontendLifoAllocCache::cache_;
+
+UniquePtr<LifoAlloc> FrontendLifoAllocCache::take() {
+  LockGuard<Mutex> guard(lock_);
+  if (cache_.empty()) {
+    return nullptr;
+  }
+  UniquePtr<LifoAlloc> alloc = std::move(cache_.back());
+  cache_.popBack();
+  return alloc;
+}
+
+void FrontendLifoAllocCache::put(UniquePtr<LifoAlloc> alloc) {
+  // Don't keep large LifoAllocs alive. They are freed once |alloc| goes out of
+  // scope, outside of the lock.
+  if (alloc->computedSizeOfExcludingThis() > MaxCachedLifoAllocSize) {
+    return;
+  }
+  alloc->releaseAll();
+
+  LockGuard<Mutex> guard(lock_);
+  if (cache_.length() < MaxCachedLifoAllocs) {
+    // This can't fail because the cache doesn't exceed its inline capacity.
+    cache_.infallibleAppend(std::move(alloc));
+  }
+}
+
+void FrontendLifoAllocCache::purge() {
+  LifoAllocVector cache;
+  {
+    LockGuard<Mutex> guard(lock_);
+    std::swap(cache, cache_);
+  }
+}
+
+AutoFrontendLifoAlloc::~AutoFrontendLifoAlloc() {
+  if (alloc_) {
+    FrontendLifoAllocCache::put(std::move(alloc_));
+  }
+}
+
+bool AutoFrontendLifoAlloc::init(FrontendContext* fc) {
+  MOZ_ASSERT(!alloc_);
+
+  alloc_ = FrontendLifoAllocCache::take();
+  if (alloc_) {
+    return true;
+  }
+
+  alloc_ = fc->getAllocator()->make_unique<LifoAlloc>(
+      JSContext::TEMP_LIFO_ALLOC_PRIMARY_CHUNK_SIZE, js::BackgroundMallocArena);
+  return !!alloc_;
+}
@@ -0,0 +1,79 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+ * vim: set ts=8 sts=2 et sw=2 tw=80:
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef frontend_FrontendLifoAllocCache_h
+#define frontend_FrontendLifoAllocCache_h
+
+#include "mozilla/Attributes.h"  // MOZ_RAII
+
+#include <stddef.h>  // size_t
+
+#include "js/AllocPolicy.h"   // SystemAllocPolicy
+#include "js/UniquePtr.h"     // UniquePtr
+#include "js/Vector.h"        // Vector
+#include "threading/Mutex.h"  // js::Mutex
+
+namespace js {
+
+class FrontendContext;
+class LifoAlloc;
+
+namespace frontend {
+
+// Process-wide cache of the LifoAlloc used to allocate parse nodes by the
+// compilations which are not running on the thread of a JSContext, and which
+// therefore cannot use JSContext::tempLifoAlloc.
+//
+// Off-thread compilations and delazifications are frequent and mostly small.
+// Reusing the chunks released by previous compilations avoids a malloc and a
+// free of every chunk for each of them. A LifoAlloc is taken out of the cache
+// for the duration of a compilation, such that the cache holds about as many
+// LifoAlloc as there are concurrent compilations.
+//
+// The cache is purged when the main runtime is collected, and at shutdown.
+class FrontendLifoAllocCache {
+  // Bound the number and the size of the cached LifoAlloc. Larger ones are
+  // freed instead of being cached.
+  static constexpr size_t MaxCachedLifoAllocs = 8;
+  static constexpr size_t MaxCachedLifoAllocSize = 4 * 1024 * 1024;
+
+  using LifoAllocVector =
+      Vector<UniquePtr<LifoAlloc>, MaxCachedLifoAllocs, SystemAllocPolicy>;
+
+  static js::Mutex lock_;
+  static LifoAllocVector cache_;
+
+ public:
+  // Return a cached LifoAlloc, or nullptr if the cache is empty.
+  static UniquePtr<LifoAlloc> take();
+
+  // Release all the allocations of |alloc| and keep its chunks for the next
+  // compilation.
+  static void put(UniquePtr<LifoAlloc> alloc);
+
+  static void purge();
+};
+
+// Borrow a LifoAlloc from the FrontendLifoAllocCache, for the duration of a
+// compilation.
+class MOZ_RAII AutoFrontendLifoAlloc {
+  UniquePtr<LifoAlloc> alloc_;
+
+ public:
+  AutoFrontendLifoAlloc() = default;
+  ~AutoFrontendLifoAlloc();
+
+  // Take a LifoAlloc out of the cache, or allocate a new one. Returns false
+  // and reports on OOM.
+  [[nodiscard]] bool init(FrontendContext* fc);
+
+  LifoAlloc& get() { return *alloc_; }
+};
+
+}  // namespace frontend
+}  // namespace js
+
+#endif  // frontend_FrontendLifoAllocCache_h
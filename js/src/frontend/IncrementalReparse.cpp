@@ -0,0 +1,140 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+ * vim: set ts=8 sts=2 et sw=2 tw=80:
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "frontend/IncrementalReparse.h"
+
+#include "mozilla/BinarySearch.h"  // mozilla::BinarySearchIf
+#include "mozilla/Utf8.h"          // mozilla::Utf8Unit
+
+#include <algorithm>  // std::min, std::sort
+
+#include "frontend/CompilationStencil.h"  // CompilationStencil
+#include "frontend/FrontendContext.h"     // FrontendContext
+#include "frontend/Stencil.h"  // ScriptStencil, ScriptStencilExtra, TaggedScriptThingIndex
+#include "vm/JSScript.h"  // ScriptSource
+
+using namespace js;
+using namespace js::frontend;
+
+template <typename Unit>
+bool IncrementalReparse::init(FrontendContext* fc, const Unit* units,
+                              size_t length) {
+  MOZ_ASSERT(functions_.empty());
+
+  if (previous_.isModule()) {
+    return true;
+  }
+
+  ScriptSource* ss = previous_.source.get();
+  if (!ss || !ss->hasSourceText() || !ss->hasSourceType<Unit>()) {
+    return true;
+  }
+
+  // Source which has already been compressed is not decompressed, as this
+  // might cost as much as parsing it again.
+  const ScriptStencilExtra& topLevelExtra =
+      previous_.scriptExtra[CompilationStencil::TopLevelIndex];
+  size_t previousLength = topLevelExtra.extent.sourceEnd;
+  ScriptSource::PinnedUnitsIfUncompressed<Unit> previousUnits(ss, 0,
+                                                              previousLength);
+  if (!previousUnits.get()) {
+    return true;
+  }
+
+  MOZ_ASSERT(length <= UINT32_MAX);
+  previousLength_ = previousLength;
+  length_ = length;
+
+  size_t commonLength = std::min(previousLength, length);
+  const Unit* previousChars = previousUnits.get();
+
+  size_t prefix = 0;
+  while (prefix < commonLength && previousChars[prefix] == units[prefix]) {
+    prefix++;
+  }
+  size_t suffix = 0;
+  while (suffix < commonLength - prefix &&
+         previousChars[previousLength - suffix - 1] ==
+             units[length - suffix - 1]) {
+    suffix++;
+  }
+  prefixLength_ = prefix;
+  suffixLength_ = suffix;
+
+  const ScriptStencil& topLevel =
+      previous_.scriptData[CompilationStencil::TopLevelIndex];
+  for (TaggedScriptThingIndex thing : topLevel.gcthings(previous_)) {
+    if (!thing.isFunction()) {
+      continue;
+    }
+
+    // Functions which were compiled eagerly, such as IIFEs or asm.js modules,
+    // have no syntax parse to reuse.
+    ScriptIndex index = thing.toFunction();
+    if (previous_.scriptData[index].hasSharedData()) {
+      continue;
+    }
+
+    if (!functions_.append(index)) {
+      ReportOutOfMemory(fc);
+      return false;
+    }
+  }
+
+  std::sort(functions_.begin(), functions_.end(),
+            [this](ScriptIndex a, ScriptIndex b) {
+              return previous_.scriptExtra[a].extent.toStringStart <
+                     previous_.scriptExtra[b].extent.toStringStart;
+            });
+  return true;
+}
+
+template bool IncrementalReparse::init(FrontendContext* fc,
+                                       const mozilla::Utf8Unit* units,
+                                       size_t length);
+template bool IncrementalReparse::init(FrontendContext* fc,
+                                       const char16_t* units, size_t length);
+
+bool IncrementalReparse::lookup(uint32_t toStringStart,
+                                ReusableFunction* result) const {
+  // Map the position to the previous source, and compute the bounds of the
+  // unchanged text around it.
+  uint32_t previousToStringStart;
+  uint32_t previousEnd;
+  if (toStringStart < prefixLength_) {
+    previousToStringStart = toStringStart;
+    previousEnd = prefixLength_;
+  } else if (toStringStart >= length_ - suffixLength_) {
+    previousToStringStart = toStringStart - length_ + previousLength_;
+    previousEnd = previousLength_;
+  } else {
+    return false;
+  }
+
+  size_t match;
+  if (!mozilla::BinarySearchIf(
+          functions_, 0, functions_.length(),
+          [&](ScriptIndex index) {
+            uint32_t start = previous_.scriptExtra[index].extent.toStringStart;
+            if (previousToStringStart == start) {
+              return 0;
+            }
+            return previousToStringStart < start ? -1 : 1;
+          },
+          &match)) {
+    return false;
+  }
+
+  ScriptIndex index = functions_[match];
+  if (previous_.scriptExtra[index].extent.toStringEnd > previousEnd) {
+    return false;
+  }
+
+  result->index = index;
+  result->previousToStringStart = previousToStringStart;
+  result->toStringStart = toStringStart;
+  return true;
+}
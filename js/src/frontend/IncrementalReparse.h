@@ -0,0 +1,90 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+ * vim: set ts=8 sts=2 et sw=2 tw=80:
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef frontend_IncrementalReparse_h
+#define frontend_IncrementalReparse_h
+
+#include "mozilla/Attributes.h"  // MOZ_STACK_CLASS
+
+#include <stddef.h>  // size_t
+#include <stdint.h>  // uint32_t
+
+#include "frontend/ScriptIndex.h"  // ScriptIndex
+#include "js/AllocPolicy.h"        // SystemAllocPolicy
+#include "js/Vector.h"             // Vector
+
+namespace js {
+
+class FrontendContext;
+
+namespace frontend {
+
+struct CompilationStencil;
+
+// Reuse the lazy functions of a previous compilation of the same global
+// script, after the source text has been edited.
+//
+// The edit is described by the length of the text which is common to the
+// start and to the end of both the previous and the new source. Function
+// declarations at the top level of the script whose text entirely lies in
+// either of these regions have the same syntax parse as in the previous
+// compilation, such that the parser can copy their stencils instead of parsing
+// them again. Functions which lie in the common suffix are shifted by the
+// difference of length between both sources.
+//
+// Only top-level functions of global scripts are reused, as their free names
+// are resolved dynamically, and need not be noted by the parser of the
+// enclosing script.
+class MOZ_STACK_CLASS IncrementalReparse {
+  const CompilationStencil& previous_;
+
+  uint32_t previousLength_ = 0;
+  uint32_t length_ = 0;
+
+  // Length of the text which is common to the start and to the end of both
+  // sources. These never overlap.
+  uint32_t prefixLength_ = 0;
+  uint32_t suffixLength_ = 0;
+
+  // Top-level lazy functions of the previous compilation, ordered by their
+  // toStringStart position.
+  Vector<ScriptIndex, 0, SystemAllocPolicy> functions_;
+
+ public:
+  explicit IncrementalReparse(const CompilationStencil& previous)
+      : previous_(previous) {}
+
+  // Compare the previous source to the |length| code units of the new source.
+  // If the previous source text is no longer available, or has a different
+  // unit type, no function is reused. Returns false on OOM.
+  template <typename Unit>
+  [[nodiscard]] bool init(FrontendContext* fc, const Unit* units,
+                          size_t length);
+
+  const CompilationStencil& previous() const { return previous_; }
+
+  // A top-level function of the previous compilation, which has the same text
+  // as a function of the new source.
+  struct ReusableFunction {
+    ScriptIndex index;
+    uint32_t previousToStringStart = 0;
+    uint32_t toStringStart = 0;
+
+    // Map a position within the previous function to the new source.
+    uint32_t toNewPosition(uint32_t previousPosition) const {
+      return previousPosition - previousToStringStart + toStringStart;
+    }
+  };
+
+  // Find the previous function with the same text as the function starting at
+  // |toStringStart| in the new source.
+  bool lookup(uint32_t toStringStart, ReusableFunction* result) const;
+};
+
+}  // namespace frontend
+}  // namespace js
+
+#endif  // frontend_IncrementalReparse_h
@@ -3157,6 +3157,187 @@ bool Parser<FullParseHandler, Unit>::advancePastSyntaxParsedFunction(
   return true;
 }
 
+template <typename Unit>
+void Parser<FullParseHandler, Unit>::copyPreviousExtent(
+    const IncrementalReparse::ReusableFunction& previousFunction,
+    SourceExtent& extent) {
+  extent.sourceStart = previousFunction.toNewPosition(extent.sourceStart);
+  extent.sourceEnd = previousFunction.toNewPosition(extent.sourceEnd);
+  extent.toStringStart = previousFunction.toNewPosition(extent.toStringStart);
+  extent.toStringEnd = previousFunction.toNewPosition(extent.toStringEnd);
+
+  // Lines and columns may differ even when the text of the function does not,
+  // and are computed again from the new source.
+  tokenStream.computeLineAndColumn(extent.sourceStart, &extent.lineno,
+                                   &extent.column);
+}
+
+template <typename Unit>
+bool Parser<FullParseHandler, Unit>::copyPreviousInnerFunctions(
+    const IncrementalReparse& reparse,
+    const IncrementalReparse::ReusableFunction& previousFunction,
+    ScriptIndex previousIndex, ScriptIndex index) {
+  const CompilationStencil& previous = reparse.previous();
+
+  // The previous and new index of the functions whose inner functions and
+  // closed-over bindings remain to be copied.
+  Vector<std::pair<ScriptIndex, ScriptIndex>, 8> worklist(fc_);
+  if (!worklist.emplaceBack(previousIndex, index)) {
+    return false;
+  }
+
+  while (!worklist.empty()) {
+    auto [previousScript, script] = worklist.popCopy();
+
+    auto previousThings =
+        previous.scriptData[previousScript].gcthings(previous);
+    if (previousThings.empty()) {
+      continue;
+    }
+
+    // Appending the inner functions below does not reallocate gcThingData.
+    TaggedScriptThingIndex* cursor = nullptr;
+    if (!this->compilationState_.allocateGCThingsUninitialized(
+            fc_, script, previousThings.size(), &cursor)) {
+      return false;
+    }
+
+    // Lazy functions only refer to their inner functions, and to the atoms of
+    // their closed-over bindings. See the SyntaxParseHandler version of
+    // PerHandlerParser::finishFunction.
+    for (TaggedScriptThingIndex thing : previousThings) {
+      void* raw = &(*cursor++);
+
+      if (thing.isNull()) {
+        new (raw) TaggedScriptThingIndex();
+        continue;
+      }
+
+      if (thing.isAtom()) {
+        TaggedParserAtomIndex atom =
+            this->parserAtoms().internExternalParserAtomIndex(fc_, previous,
+                                                              thing.toAtom());
+        if (!atom) {
+          return false;
+        }
+        this->parserAtoms().markUsedByStencil(atom, ParserAtom::Atomize::Yes);
+        new (raw) TaggedScriptThingIndex(atom);
+        continue;
+      }
+
+      MOZ_ASSERT(thing.isFunction());
+      ScriptIndex previousInner = thing.toFunction();
+      ScriptIndex inner =
+          ScriptIndex(this->compilationState_.scriptData.length());
+      if (uint32_t(inner) >= TaggedScriptThingIndex::IndexLimit) {
+        ReportAllocationOverflow(fc_);
+        return false;
+      }
+      if (!this->compilationState_.appendScriptStencilAndData(fc_)) {
+        return false;
+      }
+
+      const ScriptStencil& previousData = previous.scriptData[previousInner];
+      MOZ_ASSERT(!previousData.hasSharedData());
+
+      ScriptStencil& data = this->compilationState_.scriptData[inner];
+      if (previousData.functionAtom) {
+        TaggedParserAtomIndex atom =
+            this->parserAtoms().internExternalParserAtomIndex(
+                fc_, previous, previousData.functionAtom);
+        if (!atom) {
+          return false;
+        }
+        this->parserAtoms().markUsedByStencil(atom, ParserAtom::Atomize::Yes);
+        data.functionAtom = atom;
+      }
+      data.functionFlags = previousData.functionFlags;
+
+      ScriptStencilExtra& extra = this->compilationState_.scriptExtra[inner];
+      extra = previous.scriptExtra[previousInner];
+      copyPreviousExtent(previousFunction, extra.extent);
+
+      new (raw) TaggedScriptThingIndex(inner);
+
+      if (!worklist.emplaceBack(previousInner, inner)) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+template <typename Unit>
+bool Parser<FullParseHandler, Unit>::reusePreviousFunction(
+    FunctionNode* funNode, const IncrementalReparse& reparse,
+    const IncrementalReparse::ReusableFunction& previousFunction,
+    TaggedParserAtomIndex explicitName, FunctionFlags flags,
+    GeneratorKind generatorKind, FunctionAsyncKind asyncKind,
+    Directives inheritedDirectives, bool* reused) {
+  MOZ_ASSERT(this->compilationState_.isInitialStencil());
+  MOZ_ASSERT(pc_->atGlobalLevel());
+
+  const CompilationStencil& previous = reparse.previous();
+  const ScriptStencil& previousData =
+      previous.scriptData[previousFunction.index];
+  const ScriptStencilExtra& previousExtra =
+      previous.scriptExtra[previousFunction.index];
+
+  // The syntax parse of the function also depends on the strictness of the
+  // enclosing script, which might have been changed by the edit.
+  *reused = false;
+  if (previousExtra.strict() != inheritedDirectives.strict() ||
+      previousExtra.generatorKind() != generatorKind ||
+      previousExtra.asyncKind() != asyncKind ||
+      previousData.functionFlags.toRaw() !=
+          FunctionFlags::clearMutableflags(flags).toRaw() ||
+      !previousData.functionAtom ||
+      !this->parserAtoms().isEqualToExternalParserAtomIndex(
+          explicitName, previous, previousData.functionAtom)) {
+    return true;
+  }
+
+  FunctionBox* funbox =
+      newFunctionBox(funNode, explicitName, flags,
+                     previousFunction.toStringStart, inheritedDirectives,
+                     generatorKind, asyncKind);
+  if (!funbox) {
+    return false;
+  }
+
+  // Lines and columns of the copied functions are computed by the token
+  // stream, which needs to have seen their source.
+  uint32_t sourceEnd =
+      previousFunction.toNewPosition(previousExtra.extent.sourceEnd);
+  if (!tokenStream.advance(sourceEnd)) {
+    return false;
+  }
+
+  ScriptStencilExtra extra = previousExtra;
+  copyPreviousExtent(previousFunction, extra.extent);
+  funbox->initFromScriptStencilExtra(extra);
+  funbox->setArgCount(extra.nargs);
+
+  ScriptStencil& script = funbox->functionStencil();
+  funbox->copyFunctionFields(script);
+
+  ScriptStencilExtra& scriptExtra = funbox->functionExtraStencil();
+  funbox->copyFunctionExtraFields(scriptExtra);
+  funbox->copyScriptExtraFields(scriptExtra);
+
+  PropagateTransitiveParseFlags(funbox, pc_->sc());
+
+  if (!copyPreviousInnerFunctions(reparse, previousFunction,
+                                  previousFunction.index, funbox->index())) {
+    return false;
+  }
+
+  funNode->pn_pos.end = anyChars.currentToken().pos.end;
+  *reused = true;
+  return true;
+}
+
 template <typename Unit>
 bool Parser<FullParseHandler, Unit>::trySyntaxParseInnerFunction(
     FunctionNode** funNode, TaggedParserAtomIndex explicitName,
@@ -3181,6 +3362,27 @@ bool Parser<FullParseHandler, Unit>::trySyntaxParseInnerFunction(
       break;
     }
 
+    // When compiling an edited script, top-level functions whose text did not
+    // change are copied from the previous compilation. Their free names are
+    // not needed, as these are resolved dynamically in global scripts.
+    if (const IncrementalReparse* reparse =
+            this->compilationState_.incrementalReparse) {
+      IncrementalReparse::ReusableFunction previousFunction;
+      if (kind == FunctionSyntaxKind::Statement && !tryAnnexB &&
+          pc_->atGlobalLevel() &&
+          reparse->lookup(toStringStart, &previousFunction)) {
+        bool reused;
+        if (!reusePreviousFunction(*funNode, *reparse, previousFunction,
+                                   explicitName, flags, generatorKind,
+                                   asyncKind, inheritedDirectives, &reused)) {
+          return false;
+        }
+        if (reused) {
+          return true;
+        }
+      }
+    }
+
     UsedNameTracker::RewindToken token = usedNames_.getRewindToken();
     auto statePosition = this->compilationState_.getPosition();
 
@@ -176,6 +176,7 @@
 #include "frontend/ErrorReporter.h"
 #include "frontend/FullParseHandler.h"
 #include "frontend/FunctionSyntaxKind.h"  // FunctionSyntaxKind
+#include "frontend/IncrementalReparse.h"  // IncrementalReparse
 #include "frontend/IteratorKind.h"
 #include "frontend/NameAnalysisTypes.h"
 #include "frontend/ParseContext.h"
@@ -1815,6 +1816,23 @@ class MOZ_STACK_CLASS Parser<FullParseHandler, Unit> final
   bool skipLazyInnerFunction(FunctionNodeType funNode, uint32_t toStringStart,
                              bool tryAnnexB);
 
+  // Copy a function of the previous compilation of an edited script, instead
+  // of syntax parsing it. Sets |*reused| to false if the function cannot be
+  // copied and must be parsed.
+  bool reusePreviousFunction(
+      FunctionNodeType funNode, const IncrementalReparse& reparse,
+      const IncrementalReparse::ReusableFunction& previousFunction,
+      TaggedParserAtomIndex explicitName, FunctionFlags flags,
+      GeneratorKind generatorKind, FunctionAsyncKind asyncKind,
+      Directives inheritedDirectives, bool* reused);
+  bool copyPreviousInnerFunctions(
+      const IncrementalReparse& reparse,
+      const IncrementalReparse::ReusableFunction& previousFunction,
+      ScriptIndex previousIndex, ScriptIndex index);
+  void copyPreviousExtent(
+      const IncrementalReparse::ReusableFunction& previousFunction,
+      SourceExtent& extent);
+
   // Functions present only in Parser<FullParseHandler, Unit>.
 
   // Parse the body of an eval.
@@ -948,10 +948,17 @@ double ParserAtomsTable::toNumber(TaggedParserAtomIndex index) const {
 
 UniqueChars ParserAtomsTable::toNewUTF8CharsZ(
     FrontendContext* fc, TaggedParserAtomIndex index) const {
+  return toNewUTF8CharsZ(fc, entries_, index);
+}
+
+/* static */
+UniqueChars ParserAtomsTable::toNewUTF8CharsZ(
+    FrontendContext* fc, mozilla::Span<ParserAtom* const> entries,
+    TaggedParserAtomIndex index) {
   auto* alloc = fc->getAllocator();
 
   if (index.isParserAtomIndex()) {
-    const auto* atom = getParserAtom(index.toParserAtomIndex());
+    const auto* atom = entries[index.toParserAtomIndex()];
     return UniqueChars(
         atom->hasLatin1Chars()
             ? JS::CharsToNewUTF8CharsZ(alloc, atom->latin1Range()).c_str()
@@ -776,6 +776,10 @@ class ParserAtomsTable {
   double toNumber(TaggedParserAtomIndex index) const;
   UniqueChars toNewUTF8CharsZ(FrontendContext* fc,
                               TaggedParserAtomIndex index) const;
+  // Same as above, for the atoms of a CompilationStencil.
+  static UniqueChars toNewUTF8CharsZ(FrontendContext* fc,
+                                     mozilla::Span<ParserAtom* const> entries,
+                                     TaggedParserAtomIndex index);
   UniqueChars toPrintableString(TaggedParserAtomIndex index) const;
   UniqueChars toQuotedString(TaggedParserAtomIndex index) const;
   JSAtom* toJSAtom(JSContext* cx, FrontendContext* fc,
@@ -225,13 +225,13 @@ class NoScopeBindingCache final : public ScopeBindingCache {
 // StencilScopeBindingCache provides an interface to cache the bindings provided
 // by a CompilationStencilMerger.
 //
-// This cache lives on the stack and its content would be invalidated once going
-// out of scope. The constructor expects a reference to a
-// CompilationStencilMerger, that is expected to:
+// This cache is held by the DelazificationContext next to the merger, and its
+// content would be invalidated once destroyed. The constructor expects a
+// reference to a CompilationStencilMerger, that is expected to:
 //   - out-live this class.
 //   - contain the enclosing scope which are manipulated by this class.
 //   - be the receiver of delazified functions.
-class MOZ_STACK_CLASS StencilScopeBindingCache final
+class StencilScopeBindingCache final
     : public ScopeBindingCache {
   ScopeBindingMap<TaggedParserAtomIndex> scopeMap;
 #ifdef DEBUG
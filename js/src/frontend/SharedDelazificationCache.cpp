@@ -0,0 +1,204 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+ * vim: set ts=8 sts=2 et sw=2 tw=80:
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "frontend/SharedDelazificationCache.h"
+
+#include "mozilla/Assertions.h"  // MOZ_ASSERT
+#include "mozilla/Utf8.h"        // mozilla::Utf8Unit
+
+#include <string.h>  // memcmp
+#include <utility>   // std::move
+
+#include "frontend/CompilationStencil.h"  // CompilationStencil
+#include "vm/BindingKind.h"               // BindingLocation
+#include "vm/FunctionFlags.h"             // FunctionFlags
+#include "vm/JSFunction.h"                // JSFunction
+#include "vm/JSScript.h"                  // BaseScript
+#include "vm/Scope.h"                     // Scope, BindingIter
+
+using namespace js;
+using namespace js::frontend;
+
+// Flags which do not affect the bytecode, and which may be set on a function
+// once it has been used.
+static constexpr uint16_t IgnoredFunctionFlags =
+    uint16_t(FunctionFlags::Flags::HAS_INFERRED_NAME) |
+    uint16_t(FunctionFlags::Flags::HAS_GUESSED_ATOM) |
+    uint16_t(FunctionFlags::Flags::MUTABLE_FLAGS);
+
+// Bound the cost of describing global scopes of large scripts.
+static constexpr size_t MaxEnclosingBindings = 256;
+
+static bool IsCacheableEnclosingScope(ScopeKind kind) {
+  switch (kind) {
+    case ScopeKind::Function:
+    case ScopeKind::FunctionBodyVar:
+    case ScopeKind::Lexical:
+    case ScopeKind::SimpleCatch:
+    case ScopeKind::Catch:
+    case ScopeKind::NamedLambda:
+    case ScopeKind::StrictNamedLambda:
+    case ScopeKind::FunctionLexical:
+    case ScopeKind::Global:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool SharedDelazificationCache::Key::appendEnclosingScopes(BaseScript* lazy) {
+  size_t numBindings = 0;
+  for (Scope* scope = lazy->enclosingScope(); scope;
+       scope = scope->enclosing()) {
+    if (!IsCacheableEnclosingScope(scope->kind())) {
+      return false;
+    }
+
+    if (!append(uint8_t(scope->kind())) ||
+        !append(uint8_t(scope->hasEnvironment()))) {
+      return false;
+    }
+
+    // Whether `this`, `arguments`, `new.target` and `super` are available is
+    // decided by the enclosing functions.
+    if (scope->is<FunctionScope>()) {
+      JSFunction* fun = scope->as<FunctionScope>().canonicalFunction();
+      if (!append(uint16_t(fun->flags().toRaw() & ~IgnoredFunctionFlags)) ||
+          !append(uint32_t(fun->baseScript()->immutableFlags()))) {
+        return false;
+      }
+    }
+
+    for (BindingIter bi(scope); bi; bi++) {
+      if (++numBindings > MaxEnclosingBindings) {
+        return false;
+      }
+
+      BindingLocation loc = bi.location();
+      uint32_t slot = 0;
+      if (loc.kind() == BindingLocation::Kind::Frame ||
+          loc.kind() == BindingLocation::Kind::Environment) {
+        slot = loc.slot();
+      } else if (loc.kind() == BindingLocation::Kind::Argument) {
+        slot = loc.argumentSlot();
+      }
+
+      if (!append(bi.name()) || !append(uint8_t(bi.kind())) ||
+          !append(uint8_t(bi.closedOver())) || !append(uint8_t(loc.kind())) ||
+          !append(slot)) {
+        return false;
+      }
+    }
+
+    // Terminate the list of bindings of this scope.
+    if (!append(static_cast<JSAtom*>(nullptr))) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+template <typename Unit>
+bool SharedDelazificationCache::Key::init(BaseScript* lazy, const Unit* units,
+                                          size_t length) {
+  MOZ_ASSERT(bytes_.empty());
+  MOZ_ASSERT(!lazy->hasBytecode());
+
+  JSFunction* fun = lazy->function();
+
+  // The code of class constructors and of synthesized field initializers also
+  // depends on the source of the rest of the class.
+  if (fun->isClassConstructor() || fun->isSyntheticFunction()) {
+    return false;
+  }
+
+  // Source notes hold line numbers relative to the function, but columns are
+  // absolute.
+  if (!bytes_.reserve(sizeof(Unit) * length + 64) ||
+      !append(uint8_t(sizeof(Unit))) ||
+      !append(uint16_t(fun->flags().toRaw() & ~IgnoredFunctionFlags)) ||
+      !append(uint32_t(lazy->immutableFlags())) ||
+      !append(lazy->column().oneOriginValue()) ||
+      !append(uint32_t(lazy->sourceStart() - lazy->toStringStart())) ||
+      !append(uint32_t(length)) ||
+      !bytes_.append(reinterpret_cast<const uint8_t*>(units),
+                     sizeof(Unit) * length)) {
+    return false;
+  }
+
+  if (!appendEnclosingScopes(lazy)) {
+    return false;
+  }
+
+  hash_ = mozilla::HashBytes(bytes_.begin(), bytes_.length());
+  return true;
+}
+
+template bool SharedDelazificationCache::Key::init(
+    BaseScript* lazy, const mozilla::Utf8Unit* units, size_t length);
+template bool SharedDelazificationCache::Key::init(BaseScript* lazy,
+                                                   const char16_t* units,
+                                                   size_t length);
+
+bool SharedDelazificationCache::Key::operator==(const Key& other) const {
+  return hash_ == other.hash_ && bytes_.length() == other.bytes_.length() &&
+         memcmp(bytes_.begin(), other.bytes_.begin(), bytes_.length()) == 0;
+}
+
+SharedDelazificationCache::SharedDelazificationCache() = default;
+SharedDelazificationCache::~SharedDelazificationCache() = default;
+
+const CompilationStencil* SharedDelazificationCache::lookup(
+    const Key& key) const {
+  if (!map_) {
+    return nullptr;
+  }
+  if (auto p = map_->lookup(key)) {
+    return p->value().get();
+  }
+  return nullptr;
+}
+
+void SharedDelazificationCache::put(Key&& key, CompilationStencil* stencil) {
+  MOZ_ASSERT(!stencil->isInitialStencil());
+
+  // Instantiating asm.js modules from another source is not supported.
+  if (stencil->asmJS) {
+    return;
+  }
+
+  if (keyBytes_ + key.length() > MaxKeyBytes) {
+    return;
+  }
+
+  if (!map_) {
+    map_ = MakeUnique<Map>();
+    if (!map_) {
+      return;
+    }
+  }
+
+  if (map_->count() >= MaxEntries) {
+    return;
+  }
+
+  auto p = map_->lookupForAdd(key);
+  if (p) {
+    return;
+  }
+
+  size_t length = key.length();
+  if (!map_->add(p, std::move(key), stencil)) {
+    return;
+  }
+  keyBytes_ += length;
+}
+
+void SharedDelazificationCache::purge() {
+  map_ = nullptr;
+  keyBytes_ = 0;
+}
@@ -0,0 +1,104 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+ * vim: set ts=8 sts=2 et sw=2 tw=80:
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef frontend_SharedDelazificationCache_h
+#define frontend_SharedDelazificationCache_h
+
+#include "mozilla/HashFunctions.h"  // mozilla::HashNumber
+#include "mozilla/RefPtr.h"         // RefPtr
+
+#include <stddef.h>  // size_t
+#include <stdint.h>  // uint8_t
+
+#include "js/AllocPolicy.h"  // SystemAllocPolicy
+#include "js/HashTable.h"    // HashMap
+#include "js/UniquePtr.h"    // UniquePtr
+#include "js/Vector.h"       // Vector
+
+namespace js {
+
+class BaseScript;
+
+namespace frontend {
+
+struct CompilationStencil;
+
+// Runtime-wide cache of the stencils produced by delazifying functions on the
+// main thread, shared between functions with the same source text. Scripts
+// which embed the same library get to parse each of its functions once, and
+// the resulting JSScripts share their SharedImmutableScriptData.
+//
+// The stencil of a delazified function only depends on its source text, on
+// the flags and position of its lazy script, and on the bindings of its
+// enclosing scopes. These are all encoded in the Key. Functions enclosed by
+// scopes whose lookups cannot be described by their bindings (with, eval,
+// class bodies, modules and non-syntactic scopes) are not cached.
+//
+// Keys refer to atoms by address and cached stencils keep their ScriptSource
+// alive, so the whole cache is purged on GC.
+class SharedDelazificationCache {
+ public:
+  class Key {
+    Vector<uint8_t, 0, SystemAllocPolicy> bytes_;
+    mozilla::HashNumber hash_ = 0;
+
+    template <typename T>
+    [[nodiscard]] bool append(const T& value) {
+      return bytes_.append(reinterpret_cast<const uint8_t*>(&value),
+                           sizeof(T));
+    }
+    [[nodiscard]] bool appendEnclosingScopes(BaseScript* lazy);
+
+   public:
+    Key() = default;
+    Key(Key&& other) = default;
+    Key& operator=(Key&& other) = default;
+
+    // Describe the lazy function whose source text is |units|. Returns false
+    // if the function cannot be cached, or on OOM. Errors are not reported.
+    template <typename Unit>
+    [[nodiscard]] bool init(BaseScript* lazy, const Unit* units,
+                            size_t length);
+
+    mozilla::HashNumber hash() const { return hash_; }
+    size_t length() const { return bytes_.length(); }
+    bool operator==(const Key& other) const;
+  };
+
+ private:
+  struct KeyHasher {
+    using Lookup = Key;
+    static mozilla::HashNumber hash(const Lookup& l) { return l.hash(); }
+    static bool match(const Key& k, const Lookup& l) { return k == l; }
+  };
+
+  using Map = HashMap<Key, RefPtr<CompilationStencil>, KeyHasher,
+                      SystemAllocPolicy>;
+
+  // Limits on the number of cached functions and on the size of their keys,
+  // which hold a copy of their source text.
+  static constexpr size_t MaxEntries = 1024;
+  static constexpr size_t MaxKeyBytes = 4 * 1024 * 1024;
+
+  UniquePtr<Map> map_;
+  size_t keyBytes_ = 0;
+
+ public:
+  SharedDelazificationCache();
+  ~SharedDelazificationCache();
+
+  const CompilationStencil* lookup(const Key& key) const;
+
+  // Cache the delazification |stencil|. Failures are ignored.
+  void put(Key&& key, CompilationStencil* stencil);
+
+  void purge();
+};
+
+}  // namespace frontend
+}  // namespace js
+
+#endif  // frontend_SharedDelazificationCache_h
@@ -2692,8 +2692,11 @@ bool CompilationStencil::instantiateStencilAfterPreparation(
 
     // FunctionKey is used when caching to map a delazification stencil to a
     // specific lazy script. It is not used by instantiation, but we should
-    // ensure it is correctly defined.
-    MOZ_ASSERT(stencil.functionKey == input.extent().toFunctionKey());
+    // ensure it is correctly defined. Stencils from the
+    // SharedDelazificationCache may have been compiled for a function of
+    // another source.
+    MOZ_ASSERT_IF(stencil.source == input.source,
+                  stencil.functionKey == input.extent().toFunctionKey());
 
     FunctionsFromExistingLazy(input, gcOutput);
     MOZ_ASSERT(gcOutput.functions.length() == stencil.scriptData.size());
@@ -206,6 +206,13 @@ class CompilationGCThingType {};
 using CompilationGCThingIndex = TypedIndex<CompilationGCThingType>;
 
 // A syntax-checked regular expression string.
+//
+// Only the pattern and flags are stored. Compiling the pattern to irregexp
+// bytecode needs the JSContext's irregexp isolate and produces data owned by
+// a zone's RegExpShared, neither of which is available during off-thread
+// stencil compilation, so that still happens on first execution. Literals
+// with the same source and flags share a zone's RegExpShared while it is
+// alive, so repeated patterns are not recompiled.
 class RegExpStencil {
   friend class StencilXDR;
 
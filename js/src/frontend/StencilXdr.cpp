@@ -1530,10 +1530,14 @@ XDRResult XDRStencilDecoder::codeStencil(
 
   const uint8_t* contentBegin;
   MOZ_TRY(peekArray(length, &contentBegin));
-  uint32_t actualHash = mozilla::HashBytes(contentBegin, length);
 
-  if (MOZ_UNLIKELY(actualHash != hash)) {
-    return fail(JS::TranscodeResult::Failure_BadDecode);
+  // Hashing touches every byte of the buffer, which is what borrowing and
+  // pinning the buffer otherwise avoid.
+  if (!options.skipContentHashCheck) {
+    uint32_t actualHash = mozilla::HashBytes(contentBegin, length);
+    if (MOZ_UNLIKELY(actualHash != hash)) {
+      return fail(JS::TranscodeResult::Failure_BadDecode);
+    }
   }
 
   MOZ_TRY(frontend::StencilXDR::codeSource(this, &options, stencil.source));
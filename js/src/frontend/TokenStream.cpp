@@ -25,6 +25,7 @@
 #include <stdarg.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 #include <type_traits>
 #include <utility>
 
@@ -2256,9 +2257,65 @@ static const uint8_t firstCharKinds[] = {
 static_assert(LastCharKind < (1 << (sizeof(firstCharKinds[0]) * 8)),
               "Elements of firstCharKinds[] are too small");
 
+namespace {
+
+// Helpers to classify all the code units in a uint64_t at once, without
+// branching on each unit.
+template <typename Unit>
+struct CodeUnitWord {
+  static constexpr size_t UnitBits = sizeof(Unit) * 8;
+  static constexpr size_t UnitsPerWord = sizeof(uint64_t) / sizeof(Unit);
+
+  static constexpr uint64_t UnitMask = (uint64_t(1) << UnitBits) - 1;
+
+  // The lowest bit of each code unit.
+  static constexpr uint64_t LowBits = UINT64_MAX / UnitMask;
+
+  // The highest bit of each code unit.
+  static constexpr uint64_t HighBits = LowBits << (UnitBits - 1);
+
+  // The bits of each code unit which are only set for non-ASCII units.
+  static constexpr uint64_t NonAsciiBits = LowBits * (UnitMask & ~0x7f);
+
+  static uint64_t load(const Unit* units) {
+    uint64_t word;
+    memcpy(&word, units, sizeof(word));
+    return word;
+  }
+
+  static bool hasNonAscii(uint64_t word) { return word & NonAsciiBits; }
+
+  // Whether any code unit in |word| is |c|. A code unit is equal to |c| iff it
+  // is zero after the xor below, and subtracting one from a zero code unit
+  // borrows into its high bit.
+  static bool hasUnit(uint64_t word, char c) {
+    uint64_t x = word ^ (LowBits * uint8_t(c));
+    return (x - LowBits) & ~x & HighBits;
+  }
+};
+
+}  // namespace
+
+template <typename Unit>
+template <typename... Excluded>
+void SourceUnits<Unit>::consumeAsciiWordsExcept(Excluded... excluded) {
+  MOZ_ASSERT(!isPoisoned(), "shouldn't use poisoned SourceUnits");
+
+  using Word = CodeUnitWord<Unit>;
+  while (size_t(limit_ - ptr) >= Word::UnitsPerWord) {
+    uint64_t word = Word::load(ptr);
+    if (Word::hasNonAscii(word) || (Word::hasUnit(word, excluded) || ...)) {
+      return;
+    }
+    ptr += Word::UnitsPerWord;
+  }
+}
+
 template <>
 void SourceUnits<char16_t>::consumeRestOfSingleLineComment() {
   while (MOZ_LIKELY(!atEnd())) {
+    consumeAsciiWordsExcept('\r', '\n');
+
     char16_t unit = peekCodeUnit();
     if (IsLineTerminator(unit)) {
       return;
@@ -2271,6 +2328,8 @@ void SourceUnits<char16_t>::consumeRestOfSingleLineComment() {
 template <>
 void SourceUnits<Utf8Unit>::consumeRestOfSingleLineComment() {
   while (MOZ_LIKELY(!atEnd())) {
+    consumeAsciiWordsExcept('\r', '\n');
+
     const Utf8Unit unit = peekCodeUnit();
     if (IsSingleUnitLineTerminator(unit)) {
       return;
@@ -3146,6 +3205,9 @@ template <typename Unit, class AnyCharsAccess>
           unsigned linenoBefore = anyChars.lineno;
 
           do {
+            this->sourceUnits.consumeAsciiWordsExcept('*', '@', '#', '\r',
+                                                      '\n');
+
             int32_t unit = getCodeUnit();
             if (unit == EOF) {
               error(JSMSG_UNTERMINATED_COMMENT);
@@ -3268,7 +3330,23 @@ bool TokenStreamSpecific<Unit, AnyCharsAccess>::getStringOrTemplateToken(
   // equivalents), \\, EOF.  Because we detect EOL sequences here and
   // put them back immediately, we can use getCodeUnit().
   int32_t unit;
-  while ((unit = getCodeUnit()) != untilChar) {
+  while (true) {
+    // Copy runs of code units which need no special handling directly.
+    const Unit* plainStart = this->sourceUnits.addressOfNextCodeUnit();
+    this->sourceUnits.consumeAsciiWordsExcept(untilChar, '\\', '$', '\r',
+                                              '\n');
+    const Unit* plainEnd = this->sourceUnits.addressOfNextCodeUnit();
+    if (plainStart != plainEnd &&
+        !FillCharBufferFromSourceNormalizingAsciiLineBreaks(
+            this->charBuffer, plainStart, plainEnd)) {
+      return false;
+    }
+
+    unit = getCodeUnit();
+    if (unit == untilChar) {
+      break;
+    }
+
     if (unit == EOF) {
       ReportPrematureEndOfLiteral(JSMSG_EOF_BEFORE_END_OF_LITERAL);
       return false;
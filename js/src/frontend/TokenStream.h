@@ -1459,6 +1459,19 @@ class SourceUnits {
    */
   void consumeRestOfSingleLineComment();
 
+  /**
+   * Consume code units, as long as they are ASCII and none of |excluded|.
+   * This examines whole machine words at a time and stops at the start of the
+   * first word that contains a code unit it cannot consume, so the caller
+   * must still consume the remaining units using the usual one-unit-at-a-time
+   * functions.
+   *
+   * The caller must exclude '\r' and '\n', as the consumed units aren't
+   * subject to line number tracking.
+   */
+  template <typename... Excluded>
+  void consumeAsciiWordsExcept(Excluded... excluded);
+
   /**
    * The maximum radius of code around the location of an error that should
    * be included in a syntax error message -- this many code units to either
@@ -134,6 +134,15 @@ static inline void MajorGCIfRequested(JSContext* cx) {
   }
 }
 
+// Charge a tenured allocation made from the main thread to the current realm.
+// Cells allocated by JIT code and during GC are not counted here.
+static inline void* CountRealmAlloc(JSContext* cx, void* ptr, AllocKind kind) {
+  if (ptr && cx->realm()) {
+    cx->realm()->addGCAllocBytes(Arena::thingSize(kind));
+  }
+  return ptr;
+}
+
 template <AllowGC allowGC>
 MOZ_NEVER_INLINE void* gc::CellAllocator::AllocTenuredCellForNurseryAlloc(
     JSContext* cx, gc::AllocKind kind) {
@@ -141,7 +150,8 @@ MOZ_NEVER_INLINE void* gc::CellAllocator::AllocTenuredCellForNurseryAlloc(
     MajorGCIfRequested(cx);
   }
 
-  return AllocTenuredCellUnchecked<allowGC>(cx->zone(), kind);
+  void* ptr = AllocTenuredCellUnchecked<allowGC>(cx->zone(), kind);
+  return CountRealmAlloc(cx, ptr, kind);
 }
 template void* gc::CellAllocator::AllocTenuredCellForNurseryAlloc<NoGC>(
     JSContext*, AllocKind);
@@ -175,7 +185,8 @@ void* gc::CellAllocator::AllocTenuredCell(JSContext* cx, gc::AllocKind kind) {
     MajorGCIfRequested(cx);
   }
 
-  return AllocTenuredCellUnchecked<allowGC>(cx->zone(), kind);
+  void* ptr = AllocTenuredCellUnchecked<allowGC>(cx->zone(), kind);
+  return CountRealmAlloc(cx, ptr, kind);
 }
 template void* gc::CellAllocator::AllocTenuredCell<NoGC>(JSContext*, AllocKind);
 template void* gc::CellAllocator::AllocTenuredCell<CanGC>(JSContext*,
@@ -649,6 +660,15 @@ void* ArenaChunk::allocate(GCRuntime* gc, StallAndRetry stallAndRetry) {
     return nullptr;
   }
 
+  if (gc->isHugePagesEnabled()) {
+    MarkPagesHugeHint(chunk, ChunkSize);
+  }
+
+  int32_t node = gc->preferredChunkNumaNode();
+  if (node >= 0) {
+    MarkPagesPreferredNumaNode(chunk, ChunkSize, node);
+  }
+
   gc->stats().count(gcstats::COUNT_NEW_CHUNK);
   return chunk;
 }
@@ -6,9 +6,12 @@
 
 #include "gc/AtomMarking-inl.h"
 
+#include <algorithm>
 #include <type_traits>
 
+#include "gc/ParallelWork.h"
 #include "gc/PublicIterators.h"
+#include "vm/HelperThreads.h"
 
 #include "gc/GC-inl.h"
 #include "gc/Heap-inl.h"
@@ -158,6 +161,55 @@ static void BitwiseOrIntoChunkMarkBits(Zone* atomsZone, Bitmap& bitmap) {
   }
 }
 
+// A range of words of the union bitmap to compute from the atom bitmaps of the
+// uncollected zones. Each slice writes a disjoint range of |target| so slices
+// can be processed in parallel.
+struct AtomBitmapUnionSlice {
+  const Vector<const SparseBitmap*, 0, SystemAllocPolicy>* zoneBitmaps =
+      nullptr;
+  DenseBitmap* target = nullptr;
+  size_t wordStart = 0;
+  size_t numWords = 0;
+};
+
+class AtomBitmapUnionSlices {
+  const Vector<const SparseBitmap*, 0, SystemAllocPolicy>& zoneBitmaps;
+  DenseBitmap& target;
+  size_t wordStart = 0;
+
+ public:
+  // The number of words in each slice. A slice is large enough to amortize the
+  // block lookups in each zone bitmap.
+  static constexpr size_t SliceWords = 16 * 1024;
+
+  AtomBitmapUnionSlices(
+      const Vector<const SparseBitmap*, 0, SystemAllocPolicy>& zoneBitmaps,
+      DenseBitmap& target)
+      : zoneBitmaps(zoneBitmaps), target(target) {}
+
+  bool done() const { return wordStart >= target.numWords(); }
+
+  AtomBitmapUnionSlice get() const {
+    MOZ_ASSERT(!done());
+    size_t numWords = std::min(SliceWords, target.numWords() - wordStart);
+    return {&zoneBitmaps, &target, wordStart, numWords};
+  }
+
+  void next() {
+    MOZ_ASSERT(!done());
+    wordStart += SliceWords;
+  }
+};
+
+static size_t UnionAtomBitmapSlice(GCRuntime* gc,
+                                   const AtomBitmapUnionSlice& slice) {
+  for (const SparseBitmap* bitmap : *slice.zoneBitmaps) {
+    bitmap->bitwiseOrWordRangeInto(*slice.target, slice.wordStart,
+                                   slice.numWords);
+  }
+  return slice.numWords;
+}
+
 void AtomMarkingRuntime::markAtomsUsedByUncollectedZones(
     GCRuntime* gc, size_t uncollectedZones) {
   MOZ_ASSERT(CurrentThreadIsPerformingGC());
@@ -167,13 +219,28 @@ void AtomMarkingRuntime::markAtomsUsedByUncollectedZones(
     return;
   }
 
+  // Gather the bitmaps of uncollected zones, skipping zones that have never
+  // marked an atom. Atoms which are referenced by collected zones have already
+  // been marked.
+  Vector<const SparseBitmap*, 0, SystemAllocPolicy> zoneBitmaps;
+  bool gathered = zoneBitmaps.reserve(uncollectedZones);
+  if (gathered) {
+    for (ZonesIter zone(gc, SkipAtoms); !zone.done(); zone.next()) {
+      if (!zone->isCollecting() && !zone->markedAtoms().isEmpty()) {
+        zoneBitmaps.infallibleAppend(&zone->markedAtoms());
+      }
+    }
+    if (zoneBitmaps.empty()) {
+      return;
+    }
+  }
+
   // If there is more than one zone then try to compute a simple union of the
   // zone atom bitmaps before updating the chunk mark bitmaps. If there is only
   // one zone or this allocation fails then update the chunk mark bitmaps
   // separately for each zone.
 
-  DenseBitmap markedUnion;
-  if (uncollectedZones == 1 || !markedUnion.ensureSpace(allocatedWords)) {
+  if (!gathered) {
     for (ZonesIter zone(gc, SkipAtoms); !zone.done(); zone.next()) {
       if (!zone->isCollecting()) {
         BitwiseOrIntoChunkMarkBits(gc->atomsZone(), zone->markedAtoms());
@@ -182,12 +249,28 @@ void AtomMarkingRuntime::markAtomsUsedByUncollectedZones(
     return;
   }
 
-  for (ZonesIter zone(gc, SkipAtoms); !zone.done(); zone.next()) {
-    // We only need to update the chunk mark bits for zones which were
-    // not collected in the current GC. Atoms which are referenced by
-    // collected zones have already been marked.
-    if (!zone->isCollecting()) {
-      zone->markedAtoms().bitwiseOrInto(markedUnion);
+  DenseBitmap markedUnion;
+  if (zoneBitmaps.length() == 1 || !markedUnion.ensureSpace(allocatedWords)) {
+    for (const SparseBitmap* bitmap : zoneBitmaps) {
+      BitwiseOrIntoChunkMarkBits(gc->atomsZone(), *bitmap);
+    }
+    return;
+  }
+
+  // Compute the union in slices of the word range. When there are helper
+  // threads available and more than one slice, split the slices between them.
+  AtomBitmapUnionSlices slices(zoneBitmaps, markedUnion);
+  if (gc->parallelWorkerCount() > 1 &&
+      allocatedWords > AtomBitmapUnionSlices::SliceWords) {
+    AutoLockHelperThreadState lock;
+    AutoRunParallelWork runWork(gc, UnionAtomBitmapSlice,
+                                gcstats::PhaseKind::UPDATE_ATOMS_BITMAP,
+                                GCUse::Unspecified, slices,
+                                JS::SliceBudget::unlimited(), lock);
+    AutoUnlockHelperThreadState unlock(lock);
+  } else {
+    for (; !slices.done(); slices.next()) {
+      UnionAtomBitmapSlice(gc, slices.get());
     }
   }
 
@@ -145,6 +145,11 @@ struct BufferChunk : public ChunkBase,
   MainThreadData<bool> hasNurseryOwnedAllocs;
   MainThreadOrGCTaskData<bool> hasNurseryOwnedAllocsAfterSweep;
 
+  // Set while this chunk is waiting to be swept, or has been swept but not yet
+  // merged back, as part of a minor GC. Only accessed on the main thread so it
+  // can be checked without taking the lock.
+  MainThreadData<bool> isMinorSweeping;
+
   static BufferChunk* from(void* alloc) {
     ChunkBase* chunk = js::gc::detail::GetGCAddressChunkBase(alloc);
     MOZ_ASSERT(chunk->kind == ChunkKind::MediumBuffers);
@@ -864,6 +869,11 @@ bool BufferAllocator::startMinorSweeping(LargeAllocList& largeAllocsToFree) {
     return BufferChunk::from(region)->hasNurseryOwnedAllocs;
   });
 
+  for (BufferChunk* chunk : mediumMixedChunks.ref()) {
+    MOZ_ASSERT(!chunk->isMinorSweeping);
+    chunk->isMinorSweeping = true;
+  }
+
   mediumMixedChunksToSweep.ref() = std::move(mediumMixedChunks.ref());
 
   minorState = State::Sweeping;
@@ -1096,7 +1106,9 @@ void BufferAllocator::mergeSweptData(const AutoLock& lock) {
   while (!sweptMediumMixedChunks.ref().isEmpty()) {
     BufferChunk* chunk = sweptMediumMixedChunks.ref().popLast();
     MOZ_ASSERT(chunk->hasNurseryOwnedAllocs);
+    MOZ_ASSERT(chunk->isMinorSweeping);
     chunk->hasNurseryOwnedAllocs = chunk->hasNurseryOwnedAllocsAfterSweep;
+    chunk->isMinorSweeping = false;
 
     MOZ_ASSERT_IF(
         majorState == State::NotCollecting && !majorFinishedWhileMinorSweeping,
@@ -1842,21 +1854,19 @@ void BufferAllocator::freeMedium(void* alloc) {
 }
 
 bool BufferAllocator::isSweepingChunk(BufferChunk* chunk) {
-  if (minorState == State::Sweeping && chunk->hasNurseryOwnedAllocs) {
-    // TODO: We could set a flag for nursery chunks allocated during minor
-    // collection to allow operations on chunks that are not being swept here.
+  // Chunks that gained nursery owned allocations after minor sweeping started
+  // are not being swept, so this doesn't need to take the lock for them.
+  if (minorState == State::Sweeping && chunk->isMinorSweeping) {
+    MOZ_ASSERT(chunk->hasNurseryOwnedAllocs);
 
     if (!sweptChunksAvailable) {
       // We are currently sweeping nursery owned allocations.
       return true;
     }
 
-    // Merge swept data, which may update hasNurseryOwnedAllocs.
-    //
-    // TODO: It would be good to know how often this helps and if it is
-    // worthwhile.
+    // Merge swept data, which clears isMinorSweeping for swept chunks.
     mergeSweptData();
-    if (chunk->hasNurseryOwnedAllocs) {
+    if (chunk->isMinorSweeping) {
       // We are currently sweeping nursery owned allocations.
       return true;
     }
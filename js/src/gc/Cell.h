@@ -730,6 +730,11 @@ class alignas(gc::CellAlignBytes) TenuredCellWithFlags : public TenuredCell {
   void clearHeaderFlagBits(uintptr_t flags) {
     header_.set(header_.get() & ~flags);
   }
+
+ public:
+  static constexpr size_t offsetOfHeaderFlags() {
+    return offsetof(TenuredCellWithFlags, header_);
+  }
 };
 
 // Base class for GC things that have a tenured GC pointer as their first word.
@@ -706,6 +706,22 @@ void GCRuntime::updateCellPointers(Zone* zone, AllocKinds kinds) {
   for (; !fgArenas.done(); fgArenas.next()) {
     UpdateArenaListSegmentPointers(this, fgArenas.get());
   }
+
+  // Rather than blocking until the helper threads have finished, help them
+  // with the remaining background work. This shortens the pause when there is
+  // more background work than foreground work, which is the common case.
+  for (;;) {
+    ArenaListSegment segment;
+    {
+      AutoLockHelperThreadState helperLock;
+      if (bgArenas.done()) {
+        break;
+      }
+      segment = bgArenas.get();
+      bgArenas.next();
+    }
+    UpdateArenaListSegmentPointers(this, segment);
+  }
 }
 
 // After cells have been relocated any pointers to a cell's old locations must
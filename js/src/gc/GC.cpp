@@ -209,6 +209,7 @@
 #include "jstypes.h"
 
 #include "debugger/DebugAPI.h"
+#include "frontend/FrontendLifoAllocCache.h"
 #include "gc/ClearEdgesTracer.h"
 #include "gc/GCContext.h"
 #include "gc/GCInternals.h"
@@ -220,6 +221,7 @@
 #include "gc/WeakMap.h"
 #include "jit/ExecutableAllocator.h"
 #include "jit/JitCode.h"
+#include "jit/JitOptions.h"
 #include "jit/JitRuntime.h"
 #include "jit/ProcessExecutableMemory.h"
 #include "js/HeapAPI.h"  // JS::GCCellPtr
@@ -480,6 +482,9 @@ GCRuntime::GCRuntime(JSRuntime* rt)
       compactingEnabled(TuningDefaults::CompactingEnabled),
       nurseryEnabled(TuningDefaults::NurseryEnabled),
       parallelMarkingEnabled(TuningDefaults::ParallelMarkingEnabled),
+      hugePagesEnabled(TuningDefaults::HugePagesEnabled),
+      scavengeTargetBytes(TuningDefaults::ScavengeTargetMB * 1024 * 1024),
+      preferredNumaNode(-1),
       rootsRemoved(false),
 #ifdef JS_GC_ZEAL
       zealModeBits(0),
@@ -491,6 +496,7 @@ GCRuntime::GCRuntime(JSRuntime* rt)
 #endif
       fullCompartmentChecks(false),
       gcCallbackDepth(0),
+      realmAllocLimitsEnabled(false),
       alwaysPreserveCode(false),
       lowMemoryState(false),
       lock(mutexid::GCLock),
@@ -503,6 +509,7 @@ GCRuntime::GCRuntime(JSRuntime* rt)
       sweepTask(this),
       freeTask(this),
       decommitTask(this),
+      scavengeTask(this),
       nursery_(this),
       storeBuffer_(rt),
       lastAllocRateUpdateTime(TimeStamp::Now()) {
@@ -985,6 +992,8 @@ void GCRuntime::finish() {
   freeTask.join();
   allocTask.cancelAndWait();
   decommitTask.cancelAndWait();
+  scavengeTask.cancelAndWait();
+  runDeferredFinalizers();
 #ifdef DEBUG
   {
     MOZ_ASSERT(dispatchedParallelTasks == 0);
@@ -1157,6 +1166,24 @@ bool GCRuntime::setParameter(JSGCParamKey key, uint32_t value,
     case JSGC_MIN_EMPTY_CHUNK_COUNT:
       setMinEmptyChunkCount(value, lock);
       break;
+    case JSGC_HUGE_PAGES_ENABLED:
+      if (value && !HugePagesSupported()) {
+        return false;
+      }
+      hugePagesEnabled = value != 0;
+      break;
+    case JSGC_SCAVENGE_TARGET_MB:
+      scavengeTargetBytes = size_t(value) * 1024 * 1024;
+      break;
+    case JSGC_NUMA_LOCAL_CHUNKS:
+      if (value && !NumaPlacementSupported()) {
+        return false;
+      }
+      preferredNumaNode = -1;
+      if (value) {
+        preferredNumaNode = std::max(CurrentThreadNumaNode(), 0);
+      }
+      break;
     default:
       if (IsGCThreadParameter(key)) {
         return setThreadParameter(key, value, lock);
@@ -1249,6 +1276,15 @@ void GCRuntime::resetParameter(JSGCParamKey key, AutoLockGC& lock) {
     case JSGC_MIN_EMPTY_CHUNK_COUNT:
       setMinEmptyChunkCount(TuningDefaults::MinEmptyChunkCount, lock);
       break;
+    case JSGC_HUGE_PAGES_ENABLED:
+      hugePagesEnabled = TuningDefaults::HugePagesEnabled;
+      break;
+    case JSGC_SCAVENGE_TARGET_MB:
+      scavengeTargetBytes = TuningDefaults::ScavengeTargetMB * 1024 * 1024;
+      break;
+    case JSGC_NUMA_LOCAL_CHUNKS:
+      preferredNumaNode = -1;
+      break;
     default:
       if (IsGCThreadParameter(key)) {
         resetThreadParameter(key, lock);
@@ -1328,6 +1364,12 @@ uint32_t GCRuntime::getParameter(JSGCParamKey key, const AutoLockGC& lock) {
       return marker().incrementalWeakMapMarkingEnabled;
     case JSGC_SEMISPACE_NURSERY_ENABLED:
       return nursery().semispaceEnabled();
+    case JSGC_HUGE_PAGES_ENABLED:
+      return hugePagesEnabled;
+    case JSGC_SCAVENGE_TARGET_MB:
+      return uint32_t(scavengeTargetBytes / 1024 / 1024);
+    case JSGC_NUMA_LOCAL_CHUNKS:
+      return preferredNumaNode >= 0;
     case JSGC_CHUNK_BYTES:
       return ChunkSize;
     case JSGC_HELPER_THREAD_RATIO:
@@ -1634,6 +1676,25 @@ void GCRuntime::callObjectsTenuredCallback() {
   }
 }
 
+bool GCRuntime::deferFinalizer(JS::DeferredFinalizeOp op, void* data) {
+  AutoLockGC lock(this);
+  return deferredFinalizers.ref().append(DeferredFinalizer{op, data});
+}
+
+void GCRuntime::runDeferredFinalizers() {
+  MOZ_ASSERT(CurrentThreadCanAccessRuntime(rt));
+
+  DeferredFinalizerVector finalizers;
+  {
+    AutoLockGC lock(this);
+    std::swap(finalizers, deferredFinalizers.ref());
+  }
+
+  for (const DeferredFinalizer& finalizer : finalizers) {
+    finalizer.op(finalizer.data);
+  }
+}
+
 bool GCRuntime::addFinalizeCallback(JSFinalizeCallback callback, void* data) {
   return finalizeCallbacks.ref().append(
       Callback<JSFinalizeCallback>(callback, data));
@@ -1731,6 +1792,11 @@ JS::DoCycleCollectionCallback GCRuntime::setDoCycleCollectionCallback(
   return prior.op;
 }
 
+void GCRuntime::setRealmOverBudgetCallback(
+    JS::RealmOverBudgetCallback callback, void* data) {
+  realmOverBudgetCallback.ref() = {callback, data};
+}
+
 void GCRuntime::callDoCycleCollectionCallback(JSContext* cx) {
   const auto& callback = gcDoCycleCollectionCallback.ref();
   if (callback.op) {
@@ -1992,6 +2058,32 @@ bool GCRuntime::triggerZoneGC(Zone* zone, JS::GCReason reason, size_t used,
   return true;
 }
 
+// Called after a minor GC, once per-site nursery allocation counts have been
+// charged to their realms.
+void GCRuntime::checkRealmAllocLimits() {
+  MOZ_ASSERT(CurrentThreadCanAccessRuntime(rt));
+
+  if (!realmAllocLimitsEnabled) {
+    return;
+  }
+
+  JSContext* cx = rt->mainContextFromOwnThread();
+  const auto& callback = realmOverBudgetCallback.ref();
+  for (RealmsIter realm(rt); !realm.done(); realm.next()) {
+    if (!realm->checkGCAllocSoftLimit()) {
+      continue;
+    }
+
+    if (callback.op &&
+        !callback.op(cx, realm, realm->gcAllocBytes, callback.data)) {
+      continue;
+    }
+
+    triggerZoneGC(realm->zone(), JS::GCReason::REALM_OVER_BUDGET,
+                  realm->gcAllocBytes, realm->gcAllocSoftLimit);
+  }
+}
+
 void GCRuntime::maybeGC() {
   MOZ_ASSERT(CurrentThreadCanAccessRuntime(rt));
 
@@ -2133,7 +2225,12 @@ void js::gc::BackgroundDecommitTask::run(AutoLockHelperThreadState& lock) {
 
       if (DecommitEnabled()) {
         gc->decommitEmptyChunks(cancel_, gcLock);
-        gc->decommitFreeArenas(cancel_, gcLock);
+
+        // Decommitting individual arenas would split any huge pages backing
+        // chunks that are still in use.
+        if (!gc->hugePagesEnabled) {
+          gc->decommitFreeArenas(cancel_, gcLock);
+        }
       }
     }
   }
@@ -2212,6 +2309,121 @@ void GCRuntime::decommitFreeArenas(const bool& cancel, AutoLockGC& lock) {
   }
 }
 
+// Return the amount of chunk memory that is currently committed, ignoring
+// chunk headers.
+size_t GCRuntime::committedChunkBytes(const AutoLockGC& lock) {
+  size_t bytes = fullChunks(lock).count() * ChunkSize;
+  for (ChunkPool::Iter chunk(availableChunks(lock)); !chunk.done();
+       chunk.next()) {
+    size_t decommitted =
+        chunk->info.numArenasFree - chunk->info.numArenasFreeCommitted;
+    bytes += ChunkSize - decommitted * ArenaSize;
+  }
+  for (ChunkPool::Iter chunk(emptyChunks(lock)); !chunk.done(); chunk.next()) {
+    bytes += chunk->info.numArenasFreeCommitted * ArenaSize;
+  }
+  return bytes;
+}
+
+// Called on the main thread after a minor GC to start the background scavenger
+// if committed chunk memory has grown past the target since the last major GC.
+void GCRuntime::maybeStartBackgroundScavenge() {
+  MOZ_ASSERT(CurrentThreadCanAccessRuntime(rt));
+
+  size_t target = scavengeTargetBytes;
+  if (!target || !DecommitEnabled() || !useBackgroundThreads ||
+      isIncrementalGCInProgress() || scavengeTask.wasStarted()) {
+    return;
+  }
+
+  {
+    AutoLockGC lock(this);
+    if (committedChunkBytes(lock) <= target) {
+      return;
+    }
+  }
+
+  scavengeTask.start();
+}
+
+// Resample the main thread's NUMA node so that chunk placement follows it if
+// the OS moves it to another node.
+void GCRuntime::updatePreferredNumaNode() {
+  MOZ_ASSERT(CurrentThreadCanAccessRuntime(rt));
+
+  if (preferredNumaNode < 0) {
+    return;
+  }
+
+  int32_t node = CurrentThreadNumaNode();
+  if (node >= 0) {
+    preferredNumaNode = node;
+  }
+}
+
+BackgroundScavengeTask::BackgroundScavengeTask(GCRuntime* gc)
+    : GCParallelTask(gc, gcstats::PhaseKind::NONE) {}
+
+void js::gc::BackgroundScavengeTask::run(AutoLockHelperThreadState& lock) {
+  AutoUnlockHelperThreadState unlock(lock);
+  AutoLockGC gcLock(gc);
+  gc->scavengeToTarget(cancel_, gcLock);
+}
+
+// Called from a background thread to decommit free memory until committed
+// chunk memory is below the scavenging target. Releases the GC lock.
+void GCRuntime::scavengeToTarget(const bool& cancel, AutoLockGC& lock) {
+  MOZ_ASSERT(DecommitEnabled());
+
+  decommitEmptyChunks(cancel, lock);
+
+  // Decommitting individual arenas would split any huge pages backing chunks
+  // that are still in use.
+  if (hugePagesEnabled) {
+    return;
+  }
+
+  size_t target = scavengeTargetBytes;
+  size_t committed = committedChunkBytes(lock);
+  if (committed <= target) {
+    return;
+  }
+
+  // Chunks are allocated from the head of the available list, which is kept
+  // sorted by usage, so the least used chunks at the end are the coldest. As
+  // in decommitFreeArenas, visit an explicit list since the lock is released.
+  Vector<ArenaChunk*, 0, SystemAllocPolicy> chunksToDecommit;
+  for (ChunkPool::Iter chunk(availableChunks(lock)); !chunk.done();
+       chunk.next()) {
+    if (chunk->info.numArenasFreeCommitted != 0 &&
+        !chunksToDecommit.append(chunk)) {
+      return;
+    }
+  }
+
+  for (size_t i = chunksToDecommit.length(); i != 0; i--) {
+    ArenaChunk* chunk = chunksToDecommit[i - 1];
+    if (cancel || committed <= target) {
+      break;
+    }
+
+    // Check whether the chunk has become full or empty while the lock was
+    // released. Chunks are not freed while this task is running.
+    if (!chunk->hasAvailableArenas() || chunk->unused()) {
+      continue;
+    }
+
+    MOZ_ASSERT(availableChunks(lock).contains(chunk));
+    size_t freeCommitted = chunk->info.numArenasFreeCommitted;
+    chunk->decommitFreeArenas(this, cancel, lock);
+    if (chunk->info.numArenasFreeCommitted < freeCommitted) {
+      size_t bytes =
+          (freeCommitted - chunk->info.numArenasFreeCommitted) * ArenaSize;
+      committed -= std::min(committed, bytes);
+    }
+  }
+}
+
 // Do all possible decommit immediately from the current thread without
 // releasing the GC lock or allocating any memory.
 void GCRuntime::decommitFreeArenasWithoutUnlocking(const AutoLockGC& lock) {
@@ -2459,11 +2671,16 @@ void GCRuntime::purgeRuntime() {
   queueUnusedLifoBlocksForFree(&cx->tempLifoAlloc());
   cx->interpreterStack().purge(rt);
   cx->frontendCollectionPool().purge();
+#ifdef ENABLE_WASM_JSPI
+  cx->wasm().promiseIntegration.purgeStacks(
+      isShrinkingGC() ? 0 : jit::JitOptions.wasmSuspendableStackPoolLowWater);
+#endif
 
   rt->caches().purge();
 
   if (rt->isMainRuntime()) {
     SharedImmutableStringsCache::getSingleton().purge();
+    frontend::FrontendLifoAllocCache::purge();
   }
 
   MOZ_ASSERT(marker().unmarkGrayStack.empty());
@@ -2727,9 +2944,14 @@ void GCRuntime::maybeDiscardJitCodeForGC() {
       options.resetNurseryAllocSites = resetNurserySites;
       options.resetPretenuredAllocSites = resetPretenuredSites;
       zone->forceDiscardJitCode(rt->gcContext(), options);
-    } else if (resetNurserySites || resetPretenuredSites) {
-      zone->resetAllocSitesAndInvalidate(resetNurserySites,
-                                         resetPretenuredSites);
+    } else {
+      if (resetNurserySites || resetPretenuredSites) {
+        zone->resetAllocSitesAndInvalidate(resetNurserySites,
+                                           resetPretenuredSites);
+      }
+      if (jit::JitOptions.coldIonCodeDiscardSeconds) {
+        zone->discardColdIonCode(TimeStamp::Now());
+      }
     }
 
     if (resetNurserySites) {
@@ -2983,6 +3205,9 @@ void GCRuntime::endPreparePhase(JS::GCReason reason) {
       relazifyFunctionsForShrinkingGC();
       purgePropMapTablesForShrinkingGC();
       purgeSourceURLsForShrinkingGC();
+      if (rt->hasJitRuntime()) {
+        rt->jitRuntime()->purgeIonLifoAllocCache();
+      }
     }
 
     if (isShutdownGC()) {
@@ -3460,6 +3685,9 @@ void GCRuntime::finishCollection(JS::GCReason reason) {
     zone->notifyObservingDebuggers();
     zone->gcNextGraphNode = nullptr;
     zone->gcNextGraphComponent = nullptr;
+    for (RealmsInZoneIter realm(zone); !realm.done(); realm.next()) {
+      realm->resetGCAllocBytes();
+    }
   }
 
 #ifdef JS_GC_ZEAL
@@ -4021,9 +4249,13 @@ void GCRuntime::incrementalSlice(SliceBudget& budget, JS::GCReason reason,
       }
 
       {
+        gcstats::AutoPhase ap1(stats(), gcstats::PhaseKind::SWEEP);
+
+        // Run finalizer work that had to wait for the main thread.
+        runDeferredFinalizers();
+
         // Sweep the zones list now that background finalization is finished to
         // remove and free dead zones, compartments and realms.
-        gcstats::AutoPhase ap1(stats(), gcstats::PhaseKind::SWEEP);
         gcstats::AutoPhase ap2(stats(), gcstats::PhaseKind::DESTROY);
         sweepZones(rt->gcContext(), destroyingRuntime);
       }
@@ -4462,6 +4694,13 @@ MOZ_NEVER_INLINE GCRuntime::IncrementalResult GCRuntime::gcCycle(
   // that's OK because chunk pools are protected by the GC lock.
   bool firstSlice = !isIncrementalGCInProgress();
   if (firstSlice) {
+    // The background scavenger can run between major GCs. Stop it so that it
+    // doesn't run concurrently with the GC freeing chunks.
+    scavengeTask.cancelAndWait();
+
+    nursery().clearTenuredStringDeDupSet();
+    updatePreferredNumaNode();
+
     assertBackgroundSweepingFinished();
     MOZ_ASSERT(decommitTask.isIdle());
   }
@@ -4898,6 +5137,7 @@ void GCRuntime::onOutOfMallocMemory() {
 
   // Make sure we release anything queued for release.
   decommitTask.join();
+  scavengeTask.join();
   nursery().joinDecommitTask();
 
   // Wait for background free of nursery huge slots to finish.
@@ -4951,6 +5191,9 @@ void GCRuntime::minorGC(JS::GCReason reason, gcstats::PhaseKind phase) {
     maybeTriggerGCAfterAlloc(zone);
     maybeTriggerGCAfterMalloc(zone);
   }
+
+  checkRealmAllocLimits();
+  maybeStartBackgroundScavenge();
 }
 
 void GCRuntime::collectNursery(JS::GCOptions options, JS::GCReason reason,
@@ -5033,6 +5276,46 @@ bool GCRuntime::gcIfRequestedImpl(bool eagerOk) {
   return true;
 }
 
+bool GCRuntime::runIdleTimeWork(JS::GCReason reason, TimeStamp deadline) {
+  MOZ_ASSERT(CurrentThreadCanAccessRuntime(rt));
+
+  TimeStamp now = TimeStamp::Now();
+  if (now >= deadline) {
+    return false;
+  }
+
+  // Finish any in-progress incremental GC first, since otherwise its slices
+  // will be triggered by allocation while the mutator is running.
+  if (isIncrementalGCInProgress()) {
+    if (majorGCRequested()) {
+      reason = majorGCTriggerReason;
+    }
+    gcSlice(reason, SliceBudget(TimeBudget(deadline - now)));
+    return true;
+  }
+
+  bool didWork = false;
+  if (nursery().minorGCRequested() || nursery().wantEagerCollection()) {
+    minorGC(nursery().minorGCRequested() ? nursery().minorGCTriggerReason()
+                                         : reason);
+    didWork = true;
+
+    now = TimeStamp::Now();
+    if (now >= deadline) {
+      return true;
+    }
+  }
+
+  JS::GCReason majorReason = wantMajorGC(/* eagerOk = */ true);
+  if (majorReason != JS::GCReason::NO_REASON) {
+    startGC(JS::GCOptions::Normal, majorReason,
+            SliceBudget(TimeBudget(deadline - now)));
+    didWork = true;
+  }
+
+  return didWork;
+}
+
 void js::gc::FinishGC(JSContext* cx, JS::GCReason reason) {
   // Calling this when GC is suppressed won't have any effect.
   MOZ_ASSERT(!cx->suppressGC);
@@ -5307,6 +5590,7 @@ void GCRuntime::checkHashTablesAfterMovingGC() {
   for (CompartmentsIter c(this); !c.done(); c.next()) {
     for (RealmsInCompartmentIter r(c); !r.done(); r.next()) {
       r->dtoaCache.checkCacheAfterMovingGC();
+      r->int32ToStringCache.checkCacheAfterMovingGC();
       if (r->debugEnvs()) {
         r->debugEnvs()->checkHashTablesAfterMovingGC();
       }
@@ -88,7 +88,10 @@ class ArenaChunk;
   _("systemPageSizeKB", JSGC_SYSTEM_PAGE_SIZE_KB, false)                    \
   _("semispaceNurseryEnabled", JSGC_SEMISPACE_NURSERY_ENABLED, true)        \
   _("generateMissingAllocSites", JSGC_GENERATE_MISSING_ALLOC_SITES, true)   \
-  _("highFrequencyMode", JSGC_HIGH_FREQUENCY_MODE, false)
+  _("highFrequencyMode", JSGC_HIGH_FREQUENCY_MODE, false)                   \
+  _("hugePagesEnabled", JSGC_HUGE_PAGES_ENABLED, true)                      \
+  _("scavengeTargetMB", JSGC_SCAVENGE_TARGET_MB, true)                      \
+  _("numaLocalChunks", JSGC_NUMA_LOCAL_CHUNKS, true)
 
 // Get the key and writability give a GC parameter name.
 extern bool GetGCParameterInfo(const char* name, JSGCParamKey* keyOut,
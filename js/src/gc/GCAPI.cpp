@@ -15,6 +15,8 @@
 
 #include "gc/GC.h"
 #include "gc/PublicIterators.h"
+#include "jit/JitHints.h"
+#include "jit/JitRuntime.h"
 #include "jit/JitZone.h"
 #include "js/HeapAPI.h"
 #include "js/Value.h"
@@ -417,6 +419,76 @@ JS_PUBLIC_API JS::DoCycleCollectionCallback JS::SetDoCycleCollectionCallback(
   return cx->runtime()->gc.setDoCycleCollectionCallback(callback);
 }
 
+JS_PUBLIC_API size_t JS::GetRealmGCAllocBytes(JS::Realm* realm) {
+  return realm->gcAllocBytes;
+}
+
+JS_PUBLIC_API void JS::SetRealmGCAllocSoftLimit(JS::Realm* realm,
+                                                size_t limitBytes) {
+  MOZ_ASSERT(CurrentThreadCanAccessRuntime(realm->runtimeFromAnyThread()));
+  realm->gcAllocSoftLimit = limitBytes;
+  realm->gcAllocSoftLimitReported = false;
+  if (limitBytes) {
+    realm->runtimeFromMainThread()->gc.enableRealmAllocLimits();
+  }
+}
+
+JS_PUBLIC_API void JS::SetRealmOverBudgetCallback(
+    JSContext* cx, JS::RealmOverBudgetCallback callback, void* data) {
+  CHECK_THREAD(cx);
+  cx->runtime()->gc.setRealmOverBudgetCallback(callback, data);
+}
+
+JS_PUBLIC_API bool JS::GetPretenuringHints(JSContext* cx,
+                                           PretenuringHints& hintsOut) {
+  CHECK_THREAD(cx);
+  MOZ_ASSERT(hintsOut.empty());
+
+  JSRuntime* rt = cx->runtime();
+  if (!rt->hasJitRuntime() || !rt->jitRuntime()->hasJitHintsMap()) {
+    return true;
+  }
+
+  jit::JitHintsMap* hints = rt->jitRuntime()->getJitHintsMap();
+  if (!hints->forEachPretenureHintKey(
+          [&](HashNumber key) { return hintsOut.append(key); })) {
+    ReportOutOfMemory(cx);
+    return false;
+  }
+
+  return true;
+}
+
+JS_PUBLIC_API bool JS::AddPretenuringHints(JSContext* cx,
+                                           const PretenuringHints& hints) {
+  CHECK_THREAD(cx);
+
+  JSRuntime* rt = cx->runtime();
+  if (!rt->hasJitRuntime() && !rt->createJitRuntime(cx)) {
+    return false;
+  }
+  if (!rt->jitRuntime()->hasJitHintsMap()) {
+    return true;
+  }
+
+  jit::JitHintsMap* map = rt->jitRuntime()->getJitHintsMap();
+  for (uint32_t key : hints) {
+    if (key && !map->addPretenureHintKey(key)) {
+      ReportOutOfMemory(cx);
+      return false;
+    }
+  }
+
+  return true;
+}
+
+JS_PUBLIC_API bool JS::DeferFinalizationToMainThread(JS::GCContext* gcx,
+                                                     DeferredFinalizeOp op,
+                                                     void* data) {
+  MOZ_ASSERT(gcx->isFinalizing());
+  return gcx->runtimeFromAnyThread()->gc.deferFinalizer(op, data);
+}
+
 JS_PUBLIC_API bool JS::AddGCNurseryCollectionCallback(
     JSContext* cx, GCNurseryCollectionCallback callback, void* data) {
   return cx->runtime()->gc.addNurseryCollectionCallback(callback, data);
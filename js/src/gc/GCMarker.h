@@ -194,6 +194,10 @@ class MarkStack {
   TaggedPtr popPtr();
   SlotsOrElementsRange popSlotsOrElementsRange();
 
+  // Prefetch the cell referred to by the top entry, if any, so that it is
+  // more likely to be in cache by the time it is popped.
+  void prefetchTop() const;
+
   void clearAndResetCapacity();
   void clearAndFreeStack();
 
@@ -375,6 +379,7 @@ class GCMarker {
   bool isDrained() const { return stack.isEmpty() && otherStack.isEmpty(); }
 
   bool hasEntriesForCurrentColor() { return stack.hasEntries(); }
+  size_t stackPositionForCurrentColor() const { return stack.position(); }
   bool hasBlackEntries() const { return hasEntries(gc::MarkColor::Black); }
   bool hasGrayEntries() const { return hasEntries(gc::MarkColor::Gray); }
   bool hasEntries(gc::MarkColor color) const;
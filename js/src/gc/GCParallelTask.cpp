@@ -218,6 +218,12 @@ void GCParallelTask::runTask(JS::GCContext* gcx,
   run(lock);
   duration_ = TimeSince(timeStart);
 
+  // Trace events are written from the thread that ran the task so that they
+  // show up on the right track in the timeline.
+  if (phaseKind != gcstats::PhaseKind::NONE && gc->stats().traceEnabled()) {
+    gc->stats().traceParallelTask(phaseKind, timeStart, duration_);
+  }
+
   if (maybeQueueTime_) {
     TimeDuration delay = timeStart - maybeQueueTime_;
     gc->rt->metrics().GC_TASK_START_DELAY_US(delay);
@@ -193,6 +193,14 @@ class BackgroundDecommitTask : public GCParallelTask {
   void run(AutoLockHelperThreadState& lock) override;
 };
 
+// Decommit free memory between major GCs until committed chunk memory is
+// below the JSGC_SCAVENGE_TARGET_MB target.
+class BackgroundScavengeTask : public GCParallelTask {
+ public:
+  explicit BackgroundScavengeTask(GCRuntime* gc);
+  void run(AutoLockHelperThreadState& lock) override;
+};
+
 template <typename F>
 struct Callback {
   F op;
@@ -339,6 +347,12 @@ class GCRuntime {
   // Return whether a major GC was performed or started.
   bool gcIfRequestedImpl(bool eagerOk);
 
+  // Use an idle period ending at |deadline| for GC work. This runs an
+  // incremental slice if a GC is in progress, otherwise collects the nursery
+  // and starts a major GC if the eager thresholds have been reached. Returns
+  // whether any work was done.
+  bool runIdleTimeWork(JS::GCReason reason, mozilla::TimeStamp deadline);
+
   void gc(JS::GCOptions options, JS::GCReason reason);
   void startGC(JS::GCOptions options, JS::GCReason reason,
                const JS::SliceBudget& budget);
@@ -446,6 +460,9 @@ class GCRuntime {
   bool isPerZoneGCEnabled() const { return perZoneGCEnabled; }
   bool isCompactingGCEnabled() const;
   bool isParallelMarkingEnabled() const { return parallelMarkingEnabled; }
+  bool isHugePagesEnabled() const { return hugePagesEnabled; }
+  int32_t preferredChunkNumaNode() const { return preferredNumaNode; }
+  void updatePreferredNumaNode();
 
   bool isIncrementalGCInProgress() const {
     return state() != State::NotActive && !isVerifyPreBarriersEnabled();
@@ -472,6 +489,10 @@ class GCRuntime {
   void callGCCallback(JSGCStatus status, JS::GCReason reason) const;
   void setObjectsTenuredCallback(JSObjectsTenuredCallback callback, void* data);
   void callObjectsTenuredCallback();
+  // Queue finalizer work to run on the main thread after background
+  // finalization. May be called from any thread.
+  [[nodiscard]] bool deferFinalizer(JS::DeferredFinalizeOp op, void* data);
+
   [[nodiscard]] bool addFinalizeCallback(JSFinalizeCallback callback,
                                          void* data);
   void removeFinalizeCallback(JSFinalizeCallback callback);
@@ -479,6 +500,12 @@ class GCRuntime {
       JSHostCleanupFinalizationRegistryCallback callback, void* data);
   void callHostCleanupFinalizationRegistryCallback(JSFunction* doCleanup,
                                                    JSObject* hostDefinedData);
+  void setFinalizationRegistryCleanupBudget(mozilla::TimeDuration budget) {
+    finalizationCleanupBudget = budget;
+  }
+  mozilla::TimeDuration finalizationRegistryCleanupBudget() const {
+    return finalizationCleanupBudget;
+  }
   [[nodiscard]] bool addWeakPointerZonesCallback(
       JSWeakPointerZonesCallback callback, void* data);
   void removeWeakPointerZonesCallback(JSWeakPointerZonesCallback callback);
@@ -493,6 +520,8 @@ class GCRuntime {
                                        void* data);
   JS::DoCycleCollectionCallback setDoCycleCollectionCallback(
       JS::DoCycleCollectionCallback callback);
+  void setRealmOverBudgetCallback(JS::RealmOverBudgetCallback callback,
+                                  void* data);
   void callNurseryCollectionCallbacks(JS::GCNurseryProgress progress,
                                       JS::GCReason reason);
 
@@ -723,6 +752,7 @@ class GCRuntime {
    * Must be called either during the GC or with the GC lock taken.
    */
   friend class BackgroundDecommitTask;
+  friend class BackgroundScavengeTask;
   bool tooManyEmptyChunks(const AutoLockGC& lock);
   ChunkPool expireEmptyChunkPool(const AutoLockGC& lock);
   void freeEmptyChunks(const AutoLockGC& lock);
@@ -942,6 +972,11 @@ class GCRuntime {
   void decommitEmptyChunks(const bool& cancel, AutoLockGC& lock);
   void decommitFreeArenas(const bool& cancel, AutoLockGC& lock);
   void decommitFreeArenasWithoutUnlocking(const AutoLockGC& lock);
+  size_t committedChunkBytes(const AutoLockGC& lock);
+  void maybeStartBackgroundScavenge();
+  void enableRealmAllocLimits() { realmAllocLimitsEnabled = true; }
+  void checkRealmAllocLimits();
+  void scavengeToTarget(const bool& cancel, AutoLockGC& lock);
 
   // Compacting GC. Implemented in Compacting.cpp.
   bool shouldCompact();
@@ -995,6 +1030,7 @@ class GCRuntime {
 #endif
 
   void callFinalizeCallbacks(JS::GCContext* gcx, JSFinalizeStatus status) const;
+  void runDeferredFinalizers();
   void callWeakPointerZonesCallbacks(JSTracer* trc) const;
   void callWeakPointerCompartmentCallbacks(JSTracer* trc,
                                            JS::Compartment* comp) const;
@@ -1330,6 +1366,31 @@ class GCRuntime {
    */
   MainThreadData<bool> parallelMarkingEnabled;
 
+  /*
+   * Whether new chunks should be backed by huge pages. This is read when
+   * allocating chunks, which can happen on a helper thread.
+   *
+   * JSGC_HUGE_PAGES_ENABLED
+   */
+  mozilla::Atomic<bool, mozilla::Relaxed> hugePagesEnabled;
+
+  /*
+   * Target for committed chunk memory used by the background scavenger, or
+   * zero if disabled. This is read by the scavenge task.
+   *
+   * JSGC_SCAVENGE_TARGET_MB
+   */
+  mozilla::Atomic<size_t, mozilla::Relaxed> scavengeTargetBytes;
+
+  /*
+   * NUMA node that new chunks should be placed on, or -1 if chunk placement is
+   * left to the OS. This is read when allocating chunks, which can happen on a
+   * helper thread.
+   *
+   * JSGC_NUMA_LOCAL_CHUNKS
+   */
+  mozilla::Atomic<int32_t, mozilla::Relaxed> preferredNumaNode;
+
   MainThreadData<bool> rootsRemoved;
 
   /*
@@ -1379,9 +1440,24 @@ class GCRuntime {
   MainThreadData<Callback<JS::DoCycleCollectionCallback>>
       gcDoCycleCollectionCallback;
   MainThreadData<Callback<JSObjectsTenuredCallback>> tenuredCallback;
+  MainThreadData<Callback<JS::RealmOverBudgetCallback>>
+      realmOverBudgetCallback;
+  // Set once any realm has been given an allocation soft limit.
+  MainThreadData<bool> realmAllocLimitsEnabled;
   MainThreadData<CallbackVector<JSFinalizeCallback>> finalizeCallbacks;
+
+  // Work queued by finalizers with JS::DeferFinalizationToMainThread.
+  struct DeferredFinalizer {
+    JS::DeferredFinalizeOp op;
+    void* data;
+  };
+  using DeferredFinalizerVector =
+      Vector<DeferredFinalizer, 0, SystemAllocPolicy>;
+  GCLockData<DeferredFinalizerVector> deferredFinalizers;
   MainThreadOrGCTaskData<Callback<JSHostCleanupFinalizationRegistryCallback>>
       hostCleanupFinalizationRegistryCallback;
+  // Time limit for a single cleanup job, or zero for no limit.
+  MainThreadData<mozilla::TimeDuration> finalizationCleanupBudget;
   MainThreadData<CallbackVector<JSWeakPointerZonesCallback>>
       updateWeakPointerZonesCallbacks;
   MainThreadData<CallbackVector<JSWeakPointerCompartmentCallback>>
@@ -1440,6 +1516,7 @@ class GCRuntime {
   BackgroundSweepTask sweepTask;
   BackgroundFreeTask freeTask;
   BackgroundDecommitTask decommitTask;
+  BackgroundScavengeTask scavengeTask;
 
   MainThreadData<Nursery> nursery_;
 
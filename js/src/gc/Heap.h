@@ -404,6 +404,7 @@ class alignas(ArenaSize) Arena {
 
   template <typename T>
   size_t finalize(JS::GCContext* gcx, AllocKind thingKind, size_t thingSize);
+  size_t sweepWithoutFinalizers(AllocKind thingKind, size_t thingSize);
 
   static void staticAsserts();
   static void checkLookupTables();
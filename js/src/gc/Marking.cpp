@@ -25,6 +25,7 @@
 #include "jit/JitCode.h"
 #include "js/GCTypeMacros.h"  // JS_FOR_EACH_PUBLIC_{,TAGGED_}GC_POINTER_TYPE
 #include "js/SliceBudget.h"
+#include "util/Memory.h"
 #include "util/Poison.h"
 #include "vm/GeneratorObject.h"
 
@@ -1538,6 +1539,10 @@ inline bool GCMarker::processMarkStackTop(SliceBudget& budget) {
 
   {
     MarkStack::TaggedPtr ptr = stack.popPtr();
+
+    // Start loading the next entry's cell while we scan this one.
+    stack.prefetchTop();
+
     switch (ptr.tag()) {
       case MarkStack::ObjectTag: {
         obj = ptr.as<JSObject>();
@@ -2090,6 +2095,14 @@ inline MarkStack::Tag MarkStack::peekTag() const {
   return peekPtr().tag();
 }
 
+inline void MarkStack::prefetchTop() const {
+  // Every entry's top word is a tagged pointer to a cell, including slots or
+  // elements ranges where it points to the object.
+  if (!isEmpty()) {
+    PrefetchForRead(reinterpret_cast<void*>(at(topIndex_ - 1) & ~TagMask));
+  }
+}
+
 inline MarkStack::TaggedPtr MarkStack::popPtr() {
   MOZ_ASSERT(!isEmpty());
   MOZ_ASSERT(!TagIsRangeTag(peekTag()));
@@ -2424,14 +2437,21 @@ IncrementalProgress JS::Zone::enterWeakMarkingMode(GCMarker* marker,
 
   MOZ_ASSERT(gcNurseryEphemeronEdges().count() == 0);
 
-  for (auto r = gcEphemeronEdges().all(); !r.empty(); r.popFront()) {
-    Cell* src = r.front().key();
+  // Entries whose edges have all been marked are removed as we go, as is done
+  // in markImplicitEdges, so that they are not rescanned if we have to leave
+  // and re-enter weak marking mode. This is safe because marking the edges
+  // only pushes onto the mark stack and does not touch this table.
+  for (auto e = gcEphemeronEdges().modIter(); !e.done(); e.next()) {
+    Cell* src = e.get().key();
     CellColor srcColor = gc::detail::GetEffectiveColor(marker, src);
-    auto& edges = r.front().value();
+    auto& edges = e.get().value();
 
     if (IsMarked(srcColor) && edges.length() > 0) {
       uint32_t steps = edges.length();
       marker->markEphemeronEdges(edges, AsMarkColor(srcColor));
+      if (edges.empty()) {
+        e.remove();
+      }
       budget.step(steps);
       if (budget.isOverBudget()) {
         return NotFinished;
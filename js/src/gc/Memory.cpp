@@ -38,6 +38,10 @@
 #    include <sys/types.h>
 #  endif  // !defined(__wasi__)
 
+#  if defined(XP_LINUX)
+#    include <sys/syscall.h>
+#  endif
+
 #endif  // !XP_WIN
 
 #if defined(XP_WIN) && !defined(MOZ_MEMORY)
@@ -879,6 +883,72 @@ static void CheckDecommit(void* region, size_t length) {
   MOZ_RELEASE_ASSERT(length % pageSize == 0);
 }
 
+bool HugePagesSupported() {
+#if defined(XP_LINUX) && defined(MADV_HUGEPAGE)
+  return true;
+#else
+  return false;
+#endif
+}
+
+void MarkPagesHugeHint(void* region, size_t length) {
+  MOZ_ASSERT(HugePagesSupported());
+  MOZ_RELEASE_ASSERT(OffsetFromAligned(region, pageSize) == 0);
+  MOZ_RELEASE_ASSERT(length % pageSize == 0);
+
+#if defined(XP_LINUX) && defined(MADV_HUGEPAGE)
+  // Failure is not fatal: the memory will be backed by normal pages.
+  (void)madvise(region, length, MADV_HUGEPAGE);
+#endif
+}
+
+#if defined(XP_LINUX) && defined(SYS_mbind) && defined(SYS_getcpu)
+#  define JS_GC_NUMA_PLACEMENT
+// MPOL_PREFERRED from linux/mempolicy.h.
+static constexpr int LinuxPreferredMemPolicy = 1;
+#endif
+
+bool NumaPlacementSupported() {
+#ifdef JS_GC_NUMA_PLACEMENT
+  return true;
+#else
+  return false;
+#endif
+}
+
+int32_t CurrentThreadNumaNode() {
+#ifdef JS_GC_NUMA_PLACEMENT
+  unsigned cpu;
+  unsigned node;
+  if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) {
+    return int32_t(node);
+  }
+#endif
+  return -1;
+}
+
+void MarkPagesPreferredNumaNode(void* region, size_t length, int32_t node) {
+  MOZ_ASSERT(NumaPlacementSupported());
+  MOZ_ASSERT(node >= 0);
+  MOZ_RELEASE_ASSERT(OffsetFromAligned(region, pageSize) == 0);
+  MOZ_RELEASE_ASSERT(length % pageSize == 0);
+
+#ifdef JS_GC_NUMA_PLACEMENT
+  constexpr size_t MaxNodes = 1024;
+  constexpr size_t BitsPerWord = sizeof(unsigned long) * 8;
+  unsigned long nodeMask[MaxNodes / BitsPerWord] = {};
+  if (size_t(node) >= MaxNodes) {
+    return;
+  }
+  nodeMask[node / BitsPerWord] = 1ul << (node % BitsPerWord);
+
+  // The kernel expects the mask size in bits plus one. Failure is not fatal:
+  // the memory will be placed according to the default policy.
+  (void)syscall(SYS_mbind, region, length, LinuxPreferredMemPolicy, nodeMask,
+                MaxNodes + 1, 0);
+#endif
+}
+
 bool MarkPagesUnusedSoft(void* region, size_t length) {
   MOZ_ASSERT(DecommitEnabled());
   CheckDecommit(region, length);
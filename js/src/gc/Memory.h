@@ -61,6 +61,24 @@ bool DecommitEnabled();
 // InitMemorySubsystem.
 void DisableDecommit();
 
+// Whether the OS supports backing GC memory with transparent huge pages.
+bool HugePagesSupported();
+
+// Ask the OS to back the given region with huge pages where possible. This is
+// only a hint and may be a no-op.
+void MarkPagesHugeHint(void* region, size_t length);
+
+// Whether the OS supports requesting the NUMA node used to back GC memory.
+bool NumaPlacementSupported();
+
+// Return the NUMA node of the CPU the current thread is running on, or -1 if
+// this is not known.
+int32_t CurrentThreadNumaNode();
+
+// Ask the OS to back the given region, which must not have been touched yet,
+// with memory from the given NUMA node where possible. This is only a hint.
+void MarkPagesPreferredNumaNode(void* region, size_t length, int32_t node);
+
 // Tell the OS that the given pages are not in use, so they should not be
 // written to a paging file. This may be a no-op on some platforms.
 bool MarkPagesUnusedSoft(void* region, size_t length);
@@ -15,6 +15,7 @@
 #include "js/TracingAPI.h"
 #include "vm/JSContext.h"
 #include "vm/NativeObject.h"
+#include "vm/Realm.h"
 #include "vm/StringType.h"
 
 namespace js {
@@ -311,6 +312,13 @@ static inline T* AllocNurseryOrMallocBuffer(Nursery& nursery, gc::Cell* cell,
       cell->zone(), cell, nbytes, js::MallocArena));
 }
 
+// Charge a cell buffer allocated from the main thread to the current realm.
+static inline void CountRealmBufferAlloc(JSContext* cx, size_t nbytes) {
+  if (cx->realm()) {
+    cx->realm()->addGCAllocBytes(nbytes);
+  }
+}
+
 template <typename T>
 static inline T* AllocNurseryOrMallocBuffer(JSContext* cx, gc::Cell* cell,
                                             uint32_t count) {
@@ -320,6 +328,7 @@ static inline T* AllocNurseryOrMallocBuffer(JSContext* cx, gc::Cell* cell,
     return nullptr;
   }
 
+  CountRealmBufferAlloc(cx, count * sizeof(T));
   return buffer;
 }
 
@@ -341,6 +350,7 @@ static inline T* AllocateCellBuffer(JSContext* cx, gc::Cell* cell,
     return nullptr;
   }
 
+  CountRealmBufferAlloc(cx, count * sizeof(T));
   return buffer;
 }
 
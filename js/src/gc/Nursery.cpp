@@ -1656,6 +1656,15 @@ js::Nursery::CollectionResult js::Nursery::doCollection(AutoGCSession& session,
   }
 #endif
 
+  bool keepStringDeDupSet = !gc->isIncrementalGCInProgress() &&
+                            options != JS::GCOptions::Shutdown;
+  if (!keepStringDeDupSet) {
+    tenuredStringDeDupSet_.reset();
+  } else if (tenuredStringDeDupSet_) {
+    mover.useStringDeDupSet(std::move(tenuredStringDeDupSet_.ref()));
+    tenuredStringDeDupSet_.reset();
+  }
+
   // Trace everything considered as a root by a minor GC.
   traceRoots(session, mover);
 
@@ -1675,6 +1684,15 @@ js::Nursery::CollectionResult js::Nursery::doCollection(AutoGCSession& session,
   mover.collectToStringFixedPoint();
   endProfile(ProfileKey::CollectToStrFP);
 
+  if (keepStringDeDupSet) {
+    MOZ_ASSERT(!tenuredStringDeDupSet_);
+    tenuredStringDeDupSet_ = mover.takeStringDeDupSet();
+    if (tenuredStringDeDupSet_ &&
+        tenuredStringDeDupSet_->count() > MaxTenuredStringDeDupSetCount) {
+      tenuredStringDeDupSet_.reset();
+    }
+  }
+
 #ifdef JS_GC_ZEAL
   if (reportPromotion_ && options != JS::GCOptions::Shutdown) {
     JSContext* cx = runtime()->mainContextFromOwnThread();
@@ -1723,6 +1741,8 @@ js::Nursery::CollectionResult js::Nursery::doCollection(AutoGCSession& session,
   runtime()->caches().stringToAtomCache.purge();
   endProfile(ProfileKey::PurgeStringToAtomCache);
 
+  runtime()->caches().regExpExecCache.purge();
+
   // Make sure hashtables have been updated after the collection.
   startProfile(ProfileKey::CheckHashTables);
 #ifdef JS_GC_ZEAL
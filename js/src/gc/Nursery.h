@@ -21,6 +21,7 @@
 #include "gc/Heap.h"
 #include "gc/MallocedBlockCache.h"
 #include "gc/Pretenuring.h"
+#include "gc/Tenuring.h"
 #include "js/AllocPolicy.h"
 #include "js/Class.h"
 #include "js/GCAPI.h"
@@ -362,6 +363,10 @@ class Nursery {
   void joinSweepTask();
   void joinDecommitTask();
 
+  // Called at the start of a major GC, after which the strings in the set may
+  // be swept or marked gray.
+  void clearTenuredStringDeDupSet() { tenuredStringDeDupSet_.reset(); }
+
 #ifdef DEBUG
   bool sweepTaskIsIdle();
 #endif
@@ -783,6 +788,14 @@ class Nursery {
   UniquePtr<NurserySweepTask> sweepTask;
   UniquePtr<NurseryDecommitTask> decommitTask;
 
+  // Strings tenured by previous collections, used to deduplicate newly
+  // tenured strings against them as well as against each other. This is only
+  // kept while no major GC is in progress, since until the next major GC
+  // starts every tenured string is safe to add an edge to: they can't be
+  // swept and they have no gray mark bits.
+  mozilla::Maybe<gc::StringDeDupSet> tenuredStringDeDupSet_;
+  static constexpr size_t MaxTenuredStringDeDupSetCount = 32 * 1024;
+
   // A cache of small C++-heap allocated blocks associated with this Nursery.
   // This provided so as to provide cheap allocation/deallocation of
   // out-of-line storage areas as used by WasmStructObject and
@@ -70,16 +70,12 @@ bool ParallelMarker::markOneColor(MarkColor color, SliceBudget& sliceBudget) {
   for (size_t i = 0; i < workerCount(); i++) {
     GCMarker* marker = gc->markers[i].get();
     tasks[i].emplace(this, marker, color, sliceBudget);
-
-    // Attempt to populate empty mark stacks.
-    //
-    // TODO: When tuning for more than two markers we may need to adopt a more
-    // sophisticated approach.
-    if (!marker->hasEntriesForCurrentColor() && gc->marker().canDonateWork()) {
-      GCMarker::moveWork(marker, &gc->marker(), false);
-    }
   }
 
+  // This must happen after all tasks have been created so that every marker
+  // has its mark color set.
+  distributeInitialWork();
+
   AutoLockHelperThreadState lock;
 
   MOZ_ASSERT(activeTasks == 0);
@@ -113,6 +109,42 @@ bool ParallelMarker::markOneColor(MarkColor color, SliceBudget& sliceBudget) {
   return !hasWork(color);
 }
 
+void ParallelMarker::distributeInitialWork() {
+  // Attempt to populate empty mark stacks before starting the tasks.
+  //
+  // At the start of marking all work is on the main thread's marker, but when
+  // a previous slice ran out of budget the remaining work can be spread across
+  // any of the markers. Take work from whichever marker has the most so that
+  // as many tasks as possible start with something to do, rather than relying
+  // on donation after they have started.
+  for (size_t i = 0; i < workerCount(); i++) {
+    GCMarker* marker = gc->markers[i].get();
+    if (marker->hasEntriesForCurrentColor()) {
+      continue;
+    }
+
+    GCMarker* donor = findWorkDonor();
+    if (!donor) {
+      return;
+    }
+
+    GCMarker::moveWork(marker, donor, false);
+  }
+}
+
+GCMarker* ParallelMarker::findWorkDonor() const {
+  GCMarker* best = nullptr;
+  for (const auto& marker : gc->markers) {
+    if (marker->canDonateWork() &&
+        (!best || marker->stackPositionForCurrentColor() >
+                      best->stackPositionForCurrentColor())) {
+      best = marker.get();
+    }
+  }
+
+  return best;
+}
+
 bool ParallelMarker::hasWork(MarkColor color) const {
   for (const auto& marker : gc->markers) {
     if (marker->hasEntries(color)) {
@@ -50,6 +50,9 @@ class MOZ_STACK_CLASS ParallelMarker {
 
   bool hasWork(MarkColor color) const;
 
+  void distributeInitialWork();
+  GCMarker* findWorkDonor() const;
+
   void addTask(ParallelMarkTask* task, const AutoLockHelperThreadState& lock);
 
   void addTaskToWaitingList(ParallelMarkTask* task,
@@ -13,6 +13,8 @@
 #include "gc/PublicIterators.h"
 #include "jit/BaselineJIT.h"
 #include "jit/Invalidation.h"
+#include "jit/JitHints.h"
+#include "jit/JitRuntime.h"
 #include "js/Prefs.h"
 
 #include "gc/Marking-inl.h"
@@ -57,6 +59,21 @@ static constexpr size_t HighNurserySurvivalOptimizedAllocThreshold = 10000;
 // that must occur before recovery is attempted.
 static constexpr size_t HighNurserySurvivalCountBeforeRecovery = 2;
 
+// Nursery allocations are charged to their realm per site rather than per
+// cell, using a representative cell size for each trace kind.
+static size_t EstimatedNurseryCellSize(JS::TraceKind kind) {
+  switch (kind) {
+    case JS::TraceKind::Object:
+      return Arena::thingSize(AllocKind::OBJECT4);
+    case JS::TraceKind::String:
+      return Arena::thingSize(AllocKind::STRING);
+    case JS::TraceKind::BigInt:
+      return Arena::thingSize(AllocKind::BIGINT);
+    default:
+      MOZ_CRASH("Unexpected nursery trace kind");
+  }
+}
+
 AllocSite* const AllocSite::EndSentinel = reinterpret_cast<AllocSite*>(1);
 JSScript* const AllocSite::WasmScript =
     reinterpret_cast<JSScript*>(AllocSite::STATE_MASK + 1);
@@ -117,6 +134,11 @@ size_t PretenuringNursery::doPretenuring(GCRuntime* gc, JS::GCReason reason,
     if (site->isNormal()) {
       sitesActive++;
       updateTotalAllocCounts(site);
+      if (site->hasScript()) {
+        site->script()->realm()->addGCAllocBytes(
+            site->nurseryAllocCount *
+            EstimatedNurseryCellSize(site->traceKind()));
+      }
       auto result =
           site->processSite(gc, NormalSiteAttentionThreshold, reportFilter);
       if (result == AllocSite::WasPretenured ||
@@ -194,6 +216,12 @@ AllocSite::SiteResult AllocSite::processSite(
     updateStateOnMinorGC(promotionRate);
     AllocSite::State newState = state();
 
+    if ((prevState == AllocSite::State::LongLived) !=
+            (newState == AllocSite::State::LongLived) &&
+        isNormal() && hasScript()) {
+      updatePretenuringHint(gc);
+    }
+
     if (prevState == AllocSite::State::Unknown &&
         newState == AllocSite::State::LongLived) {
       result = WasPretenured;
@@ -218,6 +246,24 @@ AllocSite::SiteResult AllocSite::processSite(
   return result;
 }
 
+void AllocSite::updatePretenuringHint(GCRuntime* gc) {
+  // Record whether this site is long-lived in the JIT hints so that the same
+  // location in future scripts can start out pretenured.
+  MOZ_ASSERT(isNormal() && hasScript());
+
+  JSRuntime* rt = gc->rt;
+  if (!rt->hasJitRuntime() || !rt->jitRuntime()->hasJitHintsMap()) {
+    return;
+  }
+
+  jit::JitHintsMap* hints = rt->jitRuntime()->getJitHintsMap();
+  if (state() == State::LongLived) {
+    hints->setPretenuredAllocSiteHint(script(), pcOffset());
+  } else {
+    hints->clearPretenuredAllocSiteHint(script(), pcOffset());
+  }
+}
+
 void AllocSite::processMissingSite(const AllocSiteFilter& reportFilter) {
   MOZ_ASSERT(isMissing());
   MOZ_ASSERT(nurseryAllocCount >= nurseryPromotedCount);
@@ -185,6 +185,14 @@ class AllocSite {
     traceKind_ = uint32_t(JS::TraceKind::Object);
   }
 
+  // Start a new site in the long-lived state based on a hint that the same
+  // location was previously found to allocate long-lived objects.
+  void initStateFromPretenuringHint() {
+    MOZ_ASSERT(isNormal() && hasScript());
+    MOZ_ASSERT(state() == State::Unknown);
+    setState(State::LongLived);
+  }
+
   void assertUninitialized() {
 #ifdef DEBUG
     MOZ_ASSERT(!zone_);
@@ -311,6 +319,8 @@ class AllocSite {
     scriptAndState = rawScript() | uintptr_t(newState);
   }
 
+  void updatePretenuringHint(GCRuntime* gc);
+
   const char* stateName() const;
 };
 
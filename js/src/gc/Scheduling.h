@@ -547,6 +547,15 @@ static const bool IncrementalWeakMapMarkingEnabled = true;
 /* JSGC_SEMISPACE_NURSERY_ENABLED */
 static const bool SemispaceNurseryEnabled = false;
 
+/* JSGC_HUGE_PAGES_ENABLED */
+static const bool HugePagesEnabled = false;
+
+/* JSGC_SCAVENGE_TARGET_MB */
+static const size_t ScavengeTargetMB = 0;
+
+/* JSGC_NUMA_LOCAL_CHUNKS */
+static const bool NumaLocalChunks = false;
+
 /* JSGC_HELPER_THREAD_RATIO */
 static const double HelperThreadRatio = 0.5;
 
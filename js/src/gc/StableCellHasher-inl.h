@@ -16,6 +16,7 @@
 #include "gc/Zone.h"
 #include "vm/JSObject.h"
 #include "vm/NativeObject.h"
+#include "vm/ProxyObject.h"
 #include "vm/Runtime.h"
 
 namespace js {
@@ -39,6 +40,15 @@ inline bool MaybeGetUniqueId(Cell* cell, uint64_t* uidp) {
       *uidp = nobj->uniqueId();
       return true;
     }
+    if (obj->is<ProxyObject>()) {
+      auto* proxy = &obj->as<ProxyObject>();
+      if (!proxy->hasUniqueId()) {
+        return false;
+      }
+
+      *uidp = proxy->uniqueId();
+      return true;
+    }
   }
 
   // Get an existing uid, if one has been set.
@@ -72,6 +82,15 @@ inline bool GetOrCreateUniqueId(Cell* cell, uint64_t* uidp) {
 
       return CreateUniqueIdForNativeObject(nobj, uidp);
     }
+    if (obj->is<ProxyObject>()) {
+      auto* proxy = &obj->as<ProxyObject>();
+      if (!proxy->hasUniqueId()) {
+        proxy->setUniqueId(NextCellUniqueId(proxy->runtimeFromAnyThread()));
+      }
+
+      *uidp = proxy->uniqueId();
+      return true;
+    }
   }
 
   // Get an existing uid, if one has been set.
@@ -93,6 +112,10 @@ inline bool SetOrUpdateUniqueId(JSContext* cx, Cell* cell, uint64_t uid) {
       auto* nobj = &obj->as<NativeObject>();
       return nobj->setOrUpdateUniqueId(cx, uid);
     }
+    if (obj->is<ProxyObject>()) {
+      obj->as<ProxyObject>().setUniqueId(uid);
+      return true;
+    }
   }
 
   // If the cell was in the nursery, hopefully unlikely, then we need to
@@ -125,6 +148,9 @@ inline bool HasUniqueId(Cell* cell) {
     if (obj->is<NativeObject>()) {
       return obj->as<NativeObject>().hasUniqueId();
     }
+    if (obj->is<ProxyObject>()) {
+      return obj->as<ProxyObject>().hasUniqueId();
+    }
   }
 
   return cell->zone()->uniqueIds().has(cell);
@@ -6,6 +6,7 @@
 
 #include "gc/Statistics.h"
 
+#include "mozilla/BaseProfilerUtils.h"  // profiler_current_thread_id
 #include "mozilla/DebugOnly.h"
 #include "mozilla/Sprintf.h"
 #include "mozilla/TimeStamp.h"
@@ -785,6 +786,8 @@ Statistics::Statistics(GCRuntime* gc)
     : gc(gc),
       gcTimerFile(nullptr),
       gcDebugFile(nullptr),
+      gcProfileFile(nullptr),
+      gcTraceFile(nullptr),
       nonincrementalReason_(GCAbortReason::None),
       creationTime_(TimeStamp::Now()),
       tenuredAllocsSinceMinorGC(0),
@@ -827,6 +830,12 @@ Statistics::Statistics(GCRuntime* gc)
   gcTimerFile = MaybeOpenFileFromEnv("MOZ_GCTIMER");
   gcDebugFile = MaybeOpenFileFromEnv("JS_GC_DEBUG");
   gcProfileFile = MaybeOpenFileFromEnv("JS_GC_PROFILE_FILE", stderr);
+  gcTraceFile = MaybeOpenFileFromEnv("JS_GC_TRACE_FILE");
+  if (gcTraceFile && ftell(gcTraceFile) <= 0) {
+    // The trailing ']' is optional in the JSON Array Format so the file is
+    // loadable by about:tracing and Perfetto even if we exit abnormally.
+    fputs("[\n", gcTraceFile);
+  }
 
   gc::ReadProfileEnv("JS_GC_PROFILE",
                      "Report major GCs taking more than N milliseconds for "
@@ -844,6 +853,9 @@ Statistics::~Statistics() {
   if (gcDebugFile && gcDebugFile != stdout && gcDebugFile != stderr) {
     fclose(gcDebugFile);
   }
+  if (gcTraceFile && gcTraceFile != stdout && gcTraceFile != stderr) {
+    fclose(gcTraceFile);
+  }
 }
 
 /* static */
@@ -1257,6 +1269,17 @@ void Statistics::endSlice() {
 
     log("end slice");
 
+    if (gcTraceFile) {
+      char args[200];
+      SprintfLiteral(
+          args,
+          "{\"reason\":\"%s\",\"initial_state\":\"%s\","
+          "\"final_state\":\"%s\",\"major_gc_number\":%" PRIu64 "}",
+          ExplainGCReason(slice.reason), gc::StateName(slice.initialState),
+          gc::StateName(slice.finalState), startingMajorGCNumber);
+      writeTraceEvent("GC slice", slice.start, slice.duration(), args);
+    }
+
     sendSliceTelemetry(slice);
 
     sliceCount_++;
@@ -1526,6 +1549,11 @@ void Statistics::recordPhaseEnd(Phase phase) {
     slices_.back().phaseTimes[phase] += t;
   }
   phaseTimes[phase] += t;
+
+  if (gcTraceFile && phase != Phase::MUTATOR) {
+    writeTraceEvent(phases[phase].name, phaseStartTimes[phase], t);
+  }
+
   phaseStartTimes[phase] = TimeStamp();
 
 #ifdef DEBUG
@@ -1565,6 +1593,35 @@ void Statistics::recordParallelPhase(PhaseKind phaseKind,
   maxTime = std::max(maxTime, duration);
 }
 
+void Statistics::traceParallelTask(PhaseKind phaseKind, TimeStamp start,
+                                   TimeDuration duration) const {
+  MOZ_ASSERT(gcTraceFile);
+  writeTraceEvent(phaseKinds[phaseKind].name, start, duration);
+}
+
+void Statistics::writeTraceEvent(const char* name, TimeStamp start,
+                                 TimeDuration duration,
+                                 const char* args) const {
+  // Emit a complete ("X") event in the Chrome Trace Event format. Each event
+  // is written with a single call so that events from different threads are
+  // not interleaved.
+  MOZ_ASSERT(gcTraceFile);
+
+  TimeDuration ts = TimeBetween(TimeStamp::FirstTimeStamp(), start);
+  uint64_t tid =
+      mozilla::baseprofiler::profiler_current_thread_id().ToNumber();
+
+  char buffer[400];
+  SprintfLiteral(buffer,
+                 "{\"name\":\"%s\",\"cat\":\"gc\",\"ph\":\"X\","
+                 "\"ts\":%.3f,\"dur\":%.3f,\"pid\":%zu,\"tid\":%" PRIu64
+                 "%s%s},\n",
+                 name, ts.ToMicroseconds(), duration.ToMicroseconds(),
+                 size_t(getpid()), tid, args ? ",\"args\":" : "",
+                 args ? args : "");
+  fputs(buffer, gcTraceFile);
+}
+
 TimeStamp Statistics::beginSCC() { return TimeStamp::Now(); }
 
 void Statistics::endSCC(unsigned scc, TimeStamp start) {
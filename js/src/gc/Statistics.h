@@ -162,6 +162,12 @@ struct Statistics {
   void endPhase(PhaseKind phaseKind);
   void recordParallelPhase(PhaseKind phaseKind, TimeDuration duration);
 
+  // Write a Chrome Trace Event for a parallel task to the JS_GC_TRACE_FILE
+  // output, if enabled. This may be called from any thread.
+  void traceParallelTask(PhaseKind phaseKind, TimeStamp start,
+                         TimeDuration duration) const;
+  bool traceEnabled() const { return gcTraceFile; }
+
   // Occasionally, we may be in the middle of something that is tracked by
   // this class, and we need to do something unusual (eg evict the nursery)
   // that doesn't normally nest within the current phase. Suspend the
@@ -343,6 +349,9 @@ struct Statistics {
   /* File used for JS_GC_PROFILE output. */
   FILE* gcProfileFile;
 
+  /* File used for JS_GC_TRACE_FILE output in Chrome Trace Event format. */
+  FILE* gcTraceFile;
+
   ZoneGCStats zoneStats;
 
   JS::GCOptions gcOptions = JS::GCOptions::Normal;
@@ -478,6 +487,9 @@ struct Statistics {
   void sccDurations(TimeDuration* total, TimeDuration* maxPause) const;
   void printStats();
 
+  void writeTraceEvent(const char* name, TimeStamp start, TimeDuration duration,
+                       const char* args = nullptr) const;
+
   template <typename Fn>
   void reportLongestPhaseInMajorGC(PhaseKind longest, Fn reportFn);
 
@@ -578,7 +578,27 @@ class StoreBuffer {
   }
   void unputCell(JSObject** strp) { unput(bufObjCell, ObjectPtrEdge(strp)); }
 
+  // Element edges are recorded at the granularity of cards of this many
+  // elements. See putSlot.
+  static constexpr uint32_t ElementCardSize = 128;
+  static_assert((ElementCardSize & (ElementCardSize - 1)) == 0,
+                "ElementCardSize must be a power of two");
+
   void putSlot(NativeObject* obj, int kind, uint32_t start, uint32_t count) {
+    // Widen element ranges to cover whole cards. This over-approximates the
+    // elements that need to be traced (tracing clamps to the initialized
+    // length) but means that a burst of writes to a large array results in
+    // at most one entry per card, which the buffer's hash set deduplicates,
+    // instead of one entry per element written.
+    if (kind == SlotsEdge::ElementKind) {
+      uint32_t end = start + count;
+      start &= ~(ElementCardSize - 1);
+      if (end <= UINT32_MAX - (ElementCardSize - 1)) {
+        end = (end + ElementCardSize - 1) & ~(ElementCardSize - 1);
+      }
+      count = end - start;
+    }
+
     SlotsEdge edge(obj, kind, start, count);
     if (bufferSlot.last_.touches(edge)) {
       bufferSlot.last_.merge(edge);
@@ -17,6 +17,7 @@
  */
 
 #include "mozilla/DebugOnly.h"
+#include "mozilla/MathAlgorithms.h"
 #include "mozilla/Maybe.h"
 #include "mozilla/ScopeExit.h"
 #include "mozilla/TimeStamp.h"
@@ -46,6 +47,7 @@
 #include "vm/Time.h"
 #include "vm/WrapperObject.h"
 
+#include "gc/Heap-inl.h"
 #include "gc/PrivateIterators-inl.h"
 #include "vm/GeckoProfiler-inl.h"
 #include "vm/JSObject-inl.h"
@@ -102,6 +104,98 @@ static constexpr FinalizePhase BackgroundFinalizePhases[] = {
       AllocKind::COMPACT_PROP_MAP, AllocKind::NORMAL_PROP_MAP,
       AllocKind::DICT_PROP_MAP}}};
 
+// Cell types whose finalize method does nothing. Arenas of these kinds can be
+// swept from their mark bits alone.
+template <typename T>
+static constexpr bool HasTrivialFinalizer =
+    std::is_same_v<T, SmallBuffer> || std::is_same_v<T, BaseShape> ||
+    std::is_same_v<T, JS::Symbol>;
+
+// Return the index of the first set bit at or after |bit| in an arena's mark
+// bits, or ArenaBitmapBits if there is none.
+static size_t FindNextMarkBit(const MarkBitmapWord* words, size_t bit) {
+  size_t word = bit / JS_BITS_PER_WORD;
+  if (word >= ArenaBitmapWords) {
+    return ArenaBitmapBits;
+  }
+
+  uintptr_t bits =
+      uintptr_t(words[word]) & (uintptr_t(-1) << (bit % JS_BITS_PER_WORD));
+  while (!bits) {
+    word++;
+    if (word == ArenaBitmapWords) {
+      return ArenaBitmapBits;
+    }
+    bits = uintptr_t(words[word]);
+  }
+
+  return word * JS_BITS_PER_WORD + mozilla::CountTrailingZeroes(bits);
+}
+
+// Sweep an arena whose cells have no finalizers by scanning its mark bits a
+// word at a time. Only the black and gray bits of a live cell are ever set,
+// and both lie within the cell, so the next set bit always identifies the
+// next live cell. Runs of dead cells are poisoned with a single call and
+// turned into free spans without visiting each cell.
+size_t Arena::sweepWithoutFinalizers(AllocKind thingKind, size_t thingSize) {
+  MOZ_ASSERT(allocated());
+  MOZ_ASSERT(thingKind == getAllocKind());
+  MOZ_ASSERT(thingSize == getThingSize());
+  MOZ_ASSERT(!onDelayedMarkingList_);
+
+  static_assert(ArenaBitmapBits == ArenaBitmapWords * JS_BITS_PER_WORD,
+                "Each arena's mark bits must occupy whole words");
+
+  const MarkBitmapWord* words = chunk()->markBits.arenaBits(this);
+  size_t firstThing = firstThingOffset(thingKind);
+
+  uint_fast16_t freeStart = firstThing;
+  FreeSpan* newListTail = &firstFreeSpan;
+  size_t nmarked = 0;
+
+  while (freeStart < ArenaSize) {
+    size_t bit = FindNextMarkBit(words, freeStart / CellBytesPerMarkBit);
+    if (bit == ArenaBitmapBits) {
+      break;
+    }
+
+    size_t offset = bit * CellBytesPerMarkBit;
+    MOZ_ASSERT(offset >= freeStart);
+    uint_fast16_t thing =
+        firstThing + ((offset - firstThing) / thingSize) * thingSize;
+    MOZ_ASSERT(
+        reinterpret_cast<TenuredCell*>(address() + thing)->isMarkedAny());
+
+    if (thing != freeStart) {
+      AlwaysPoison(reinterpret_cast<void*>(address() + freeStart),
+                   JS_SWEPT_TENURED_PATTERN, thing - freeStart,
+                   MemCheckKind::MakeUndefined);
+      newListTail->initBounds(freeStart, thing - thingSize, this);
+      newListTail = newListTail->nextSpanUnchecked(this);
+    }
+    freeStart = thing + thingSize;
+    nmarked++;
+  }
+
+  isNewlyCreated_ = 0;
+
+  if (freeStart == ArenaSize) {
+    newListTail->initAsEmpty();
+  } else {
+    AlwaysPoison(reinterpret_cast<void*>(address() + freeStart),
+                 JS_SWEPT_TENURED_PATTERN, ArenaSize - freeStart,
+                 MemCheckKind::MakeUndefined);
+    newListTail->initFinal(freeStart, ArenaSize - thingSize, this);
+  }
+
+#ifdef DEBUG
+  size_t nfree = numFreeThings(thingSize);
+  MOZ_ASSERT(nfree + nmarked == thingsPerArena(thingKind));
+#endif
+
+  return nmarked;
+}
+
 template <typename T>
 inline size_t Arena::finalize(JS::GCContext* gcx, AllocKind thingKind,
                               size_t thingSize) {
@@ -115,6 +209,10 @@ inline size_t Arena::finalize(JS::GCContext* gcx, AllocKind thingKind,
   MOZ_ASSERT(thingSize == getThingSize());
   MOZ_ASSERT(!onDelayedMarkingList_);
 
+  if constexpr (HasTrivialFinalizer<T>) {
+    return sweepWithoutFinalizers(thingKind, thingSize);
+  }
+
   uint_fast16_t freeStart = firstThingOffset(thingKind);
 
   // Update the free list as we go along. The cell iterator will always be ahead
@@ -18,6 +18,7 @@
 #include "jit/JitCode.h"
 #include "js/TypeDecls.h"
 #include "proxy/Proxy.h"
+#include "util/Memory.h"
 #include "vm/BigIntType.h"
 #include "vm/JSScript.h"
 #include "vm/NativeObject.h"
@@ -1073,6 +1074,13 @@ void js::gc::TenuringTracer::collectToObjectFixedPoint() {
     objHead = objHead->next();
     auto* obj = static_cast<JSObject*>(p->forwardingAddress());
 
+    // The promoted objects are spread throughout the tenured heap so tracing
+    // is dominated by cache misses. Start loading the next object while we
+    // trace this one.
+    if (objHead) {
+      PrefetchForRead(objHead->forwardingAddress());
+    }
+
     MOZ_ASSERT_IF(IsInsideNursery(obj), !nursery().inCollectedRegion(obj));
 
     AutoPromotedAnyToNursery promotedAnyToNursery(*this);
@@ -1089,6 +1097,9 @@ void js::gc::TenuringTracer::collectToStringFixedPoint() {
     stringHead = stringHead->next();
 
     auto* str = static_cast<JSString*>(p->forwardingAddress());
+    if (stringHead) {
+      PrefetchForRead(stringHead->forwardingAddress());
+    }
     MOZ_ASSERT_IF(IsInsideNursery(str), !nursery().inCollectedRegion(str));
 
     // To ensure the NON_DEDUP_BIT was reset properly.
@@ -44,6 +44,9 @@ struct DeduplicationStringHasher {
   static MOZ_ALWAYS_INLINE bool match(const Key& key, const Lookup& lookup);
 };
 
+using StringDeDupSet =
+    HashSet<JSString*, DeduplicationStringHasher<JSString*>, SystemAllocPolicy>;
+
 class TenuringTracer final : public JSTracer {
   Nursery& nursery_;
 
@@ -58,13 +61,10 @@ class TenuringTracer final : public JSTracer {
   gc::RelocationOverlay* objHead = nullptr;
   gc::StringRelocationOverlay* stringHead = nullptr;
 
-  using StringDeDupSet =
-      HashSet<JSString*, DeduplicationStringHasher<JSString*>,
-              SystemAllocPolicy>;
-
   // deDupSet is emplaced at the beginning of the nursery collection and reset
-  // at the end of the nursery collection. It can also be reset during nursery
-  // collection when out of memory to insert new entries.
+  // at the end of the nursery collection, unless the nursery keeps it for use
+  // by the next collection. It can also be reset during nursery collection
+  // when out of memory to insert new entries.
   mozilla::Maybe<StringDeDupSet> stringDeDupSet;
 
   bool tenureEverything;
@@ -102,6 +102,16 @@ class TenuringTracer final : public JSTracer {
   size_t getPromotedSize() const;
   size_t getPromotedCells() const;
 
+  // Deduplicate against strings tenured by previous nursery collections, and
+  // hand back the set afterwards so they can be used by the next collection.
+  void useStringDeDupSet(StringDeDupSet&& set) {
+    stringDeDupSet.reset();
+    stringDeDupSet.emplace(std::move(set));
+  }
+  mozilla::Maybe<StringDeDupSet> takeStringDeDupSet() {
+    return std::move(stringDeDupSet);
+  }
+
   void traverse(JS::Value* thingp);
   void traverse(wasm::AnyRef* thingp);
 
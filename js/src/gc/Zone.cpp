@@ -18,6 +18,7 @@
 #include "jit/BaselineIC.h"
 #include "jit/BaselineJIT.h"
 #include "jit/Invalidation.h"
+#include "jit/JitOptions.h"
 #include "jit/JitScript.h"
 #include "jit/JitZone.h"
 #include "vm/Runtime.h"
@@ -524,6 +525,37 @@ void JS::Zone::resetAllocSitesAndInvalidate(bool resetNurserySites,
       });
 }
 
+void JS::Zone::discardColdIonCode(mozilla::TimeStamp now) {
+  MOZ_ASSERT(jit::JitOptions.coldIonCodeDiscardSeconds);
+
+  if (!jitZone()) {
+    return;
+  }
+
+  // Only Ion code is discarded. The BaselineScript must stay because Ion code
+  // that inlined this script may still bail out into it.
+  mozilla::TimeDuration maxAge = mozilla::TimeDuration::FromSeconds(
+      jit::JitOptions.coldIonCodeDiscardSeconds);
+
+  JSContext* cx = runtime_->mainContextFromOwnThread();
+  jitZone()->forEachJitScript<jit::IncludeDyingScripts>(
+      [&](jit::JitScript* jitScript) {
+        JSScript* script = jitScript->owningScript();
+        if (!script->hasIonScript()) {
+          return;
+        }
+        jit::IonScript* ion = script->ionScript();
+        if (now - ion->sampleLastEntryTime(now) < maxAge) {
+          return;
+        }
+        // Keep the warm-up count so the script recompiles quickly if it
+        // becomes hot again.
+        jit::Invalidate(cx, script,
+                        /* resetUses = */ false,
+                        /* cancelOffThread = */ true);
+      });
+}
+
 void JS::Zone::traceWeakJitScripts(JSTracer* trc) {
   if (jitZone()) {
     jitZone()->forEachJitScript(
@@ -582,6 +582,10 @@ class Zone : public js::ZoneAllocator, public js::gc::GraphNodeBase<JS::Zone> {
   void resetAllocSitesAndInvalidate(bool resetNurserySites,
                                     bool resetPretenuredSites);
 
+  // Invalidate Ion code that has not been entered for
+  // JitOptions.coldIonCodeDiscardSeconds. Baseline code is kept.
+  void discardColdIonCode(mozilla::TimeStamp now);
+
   void traceWeakJitScripts(JSTracer* trc);
 
   bool registerObjectWithWeakPointers(JSObject* obj);
@@ -49,7 +49,7 @@
 #include "vm/Interpreter.h"       // js::TypeOfObject
 #include "vm/NativeObject.h"      // js::NativeObject
 #include "vm/RegExpShared.h"      // js::ExecuteRegExpAtomRaw
-#include "vm/TypedArrayObject.h"  // js::TypedArraySortFromJit
+#include "vm/TypedArrayObject.h"  // js::TypedArray{SetSameType,Sort}FromJit
 #include "wasm/WasmBuiltins.h"    // js::wasm::*
 
 #include "builtin/Boolean-inl.h"  // js::EmulatesUndefined
@@ -196,6 +196,7 @@ namespace jit {
   _(js::RoundFloat16)                                                 \
   _(js::SetIteratorObject::next)                                      \
   _(js::StringToNumberPure)                                           \
+  _(js::TypedArraySetSameTypeFromJit)                                 \
   _(js::TypedArraySortFromJit)                                        \
   _(js::TypeOfObject)                                                 \
   _(mozilla::SIMD::memchr16)                                          \
@@ -3353,18 +3353,20 @@ bool BacktrackingAllocator::chooseBundleSplit(LiveBundle* bundle, bool hasCall,
     return splitAcrossCalls(bundle);
   }
 
-  if (!trySplitBeforeFirstRegisterUse(bundle, conflict, &success)) {
-    return false;
-  }
-  if (success) {
-    return true;
-  }
+  if (!fastMode) {
+    if (!trySplitBeforeFirstRegisterUse(bundle, conflict, &success)) {
+      return false;
+    }
+    if (success) {
+      return true;
+    }
 
-  if (!trySplitAfterLastRegisterUse(bundle, conflict, &success)) {
-    return false;
-  }
-  if (success) {
-    return true;
+    if (!trySplitAfterLastRegisterUse(bundle, conflict, &success)) {
+      return false;
+    }
+    if (success) {
+      return true;
+    }
   }
 
   // Split at all register uses.
@@ -3757,7 +3759,8 @@ bool BacktrackingAllocator::processBundle(const MIRGenerator* mir,
 
       // If that didn't work, but we have one or more non-call bundles known to
       // be conflicting, maybe we can evict them and try again.
-      if ((attempt < MAX_ATTEMPTS || minimalBundle(bundle)) && !hasCall &&
+      size_t maxAttempts = fastMode ? 0 : MAX_ATTEMPTS;
+      if ((attempt < maxAttempts || minimalBundle(bundle)) && !hasCall &&
           !conflicting.empty() &&
           maximumSpillWeight(conflicting) < computeSpillWeight(bundle)) {
         for (size_t i = 0; i < conflicting.length(); i++) {
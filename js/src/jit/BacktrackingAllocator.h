@@ -670,6 +670,11 @@ class BacktrackingAllocator : protected RegisterAllocator {
   // This flag is set when testing new allocator modifications.
   bool testbed;
 
+  // This flag is set for very large graphs. Bundles are not evicted unless
+  // they are minimal, and bundles which can't be allocated are split at all
+  // register uses without searching for a better split position.
+  bool fastMode;
+
   using VirtualRegBitSet = SparseBitSet<BackgroundSystemAllocPolicy>;
   Vector<VirtualRegBitSet, 0, JitAllocPolicy> liveIn;
   Vector<VirtualRegister, 0, JitAllocPolicy> vregs;
@@ -917,9 +922,10 @@ class BacktrackingAllocator : protected RegisterAllocator {
   // visible bit.
  public:
   BacktrackingAllocator(MIRGenerator* mir, LIRGenerator* lir, LIRGraph& graph,
-                        bool testbed)
+                        bool testbed, bool fastMode = false)
       : RegisterAllocator(mir, lir, graph),
         testbed(testbed),
+        fastMode(fastMode),
         liveIn(mir->alloc()),
         vregs(mir->alloc()) {}
 
@@ -1755,6 +1755,23 @@ static void InvalidateAfterBailout(JSContext* cx, HandleScript outerScript,
     jitHints->recordInvalidation(outerScript);
   }
 
+  // If this script keeps getting invalidated, stop compiling it with Ion for a
+  // while so that it runs in Baseline instead of looping between Ion
+  // compilation, bailouts and invalidation.
+  JitScript* jitScript = outerScript->jitScript();
+  jitScript->incNumBailoutInvalidations();
+  if (JitOptions.thrashingInvalidationThreshold &&
+      jitScript->numBailoutInvalidations() >=
+          JitOptions.thrashingInvalidationThreshold) {
+    JitSpew(JitSpew_BaselineBailouts,
+            "Suspending Ion compilation for %u ms after %u invalidations",
+            JitOptions.thrashingBackoffMs,
+            jitScript->numBailoutInvalidations());
+    jitScript->setIonBackoffEnd(
+        mozilla::TimeStamp::Now() +
+        mozilla::TimeDuration::FromMilliseconds(JitOptions.thrashingBackoffMs));
+  }
+
   MOZ_ASSERT(!outerScript->ionScript()->invalidated());
 
   JitSpew(JitSpew_BaselineBailouts, "Invalidating due to %s", reason);
@@ -1992,6 +2009,9 @@ bool jit::FinishBailoutToBaseline(BaselineBailoutInfo* bailoutInfoArg) {
           innerScript->column().oneOriginValue(), innerScript->getWarmUpCount(),
           (unsigned)bailoutKind);
 
+  outerScript->jitScript()->incNumBailouts();
+  cx->runtime()->jitRuntime()->incBailoutKindCount(bailoutKind);
+
   BailoutAction action = BailoutAction::InvalidateImmediately;
   DebugOnly<bool> saveFailedICHash = false;
   switch (bailoutKind) {
@@ -3060,8 +3060,10 @@ void BaselineCacheIRCompiler::pushArrayArguments(Register argcReg,
                                                  Register scratch,
                                                  Register scratch2,
                                                  bool isJitCall,
-                                                 bool isConstructing) {
+                                                 bool isConstructing,
+                                                 Register boundCalleeReg) {
   MOZ_ASSERT(enteredStubFrame_);
+  MOZ_ASSERT_IF(boundCalleeReg != InvalidReg, isJitCall && !isConstructing);
 
   // Pull the array off the stack before aligning.
   Register startReg = scratch;
@@ -3102,10 +3104,15 @@ void BaselineCacheIRCompiler::pushArrayArguments(Register argcReg,
   masm.jump(&copyStart);
   masm.bind(&copyDone);
 
-  // Push |this|.
-  size_t thisvOffset =
-      BaselineStubFrameLayout::Size() + (1 + isConstructing) * sizeof(Value);
-  masm.pushValue(Address(FramePointer, thisvOffset));
+  // Push |this|. Calls to a bound function use its bound |this| instead.
+  if (boundCalleeReg != InvalidReg) {
+    masm.pushValue(
+        Address(boundCalleeReg, BoundFunctionObject::offsetOfBoundThisSlot()));
+  } else {
+    size_t thisvOffset =
+        BaselineStubFrameLayout::Size() + (1 + isConstructing) * sizeof(Value);
+    masm.pushValue(Address(FramePointer, thisvOffset));
+  }
 
   // Push |callee| if needed.
   if (!isJitCall) {
@@ -3277,6 +3284,18 @@ void BaselineCacheIRCompiler::pushBoundFunctionArguments(
     Register argcReg, Register calleeReg, Register scratch, Register scratch2,
     CallFlags flags, uint32_t numBoundArgs, bool isJitCall) {
   bool isConstructing = flags.isConstructing();
+
+  if (flags.getArgFormat() == CallFlags::Spread) {
+    // Spread calls are only attached for bound functions without bound
+    // arguments, so the array elements are passed through unchanged.
+    MOZ_ASSERT(!isConstructing);
+    MOZ_ASSERT(numBoundArgs == 0);
+    pushArrayArguments(argcReg, scratch, scratch2, isJitCall,
+                       /* isConstructing = */ false, calleeReg);
+    return;
+  }
+  MOZ_ASSERT(flags.getArgFormat() == CallFlags::Standard);
+
   uint32_t additionalArgc = 1 + isConstructing;  // |this| and newTarget
 
   // Calculate total number of Values to push.
@@ -4011,6 +4030,10 @@ bool BaselineCacheIRCompiler::emitCallBoundScriptedFunction(
   bool isConstructing = flags.isConstructing();
   bool isSameRealm = flags.isSameRealm();
 
+  if (!updateArgc(flags, argcReg, scratch)) {
+    return false;
+  }
+
   allocator.discardStack(masm);
 
   // Push a stub frame so that we can perform a non-tail call.
@@ -81,7 +81,8 @@ class MOZ_RAII BaselineCacheIRCompiler : public CacheIRCompiler {
                              Register scratch2, uint32_t argcFixed,
                              bool isJitCall, bool isConstructing);
   void pushArrayArguments(Register argcReg, Register scratch, Register scratch2,
-                          bool isJitCall, bool isConstructing);
+                          bool isJitCall, bool isConstructing,
+                          Register boundCalleeReg = InvalidReg);
   void pushFunCallArguments(Register argcReg, Register calleeReg,
                             Register scratch, Register scratch2,
                             uint32_t argcFixed, bool isJitCall);
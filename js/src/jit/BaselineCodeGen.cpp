@@ -390,6 +390,13 @@ bool BaselineCompiler::finishCompile(JSContext* cx) {
   vtune::MarkScript(code, script, "baseline");
 #endif
 
+#ifdef JS_STRUCTURED_SPEW
+  // Baseline compilation may have run off-thread, so no compile time is
+  // recorded here.
+  JitSpewCompileEvent(cx, script, "compile", "baseline",
+                      mozilla::TimeDuration(), code->instructionsSize());
+#endif
+
   return true;
 }
 
@@ -912,6 +919,10 @@ bool BaselineInterpreterCodeGen::emitIsDebuggeeCheck() {
   return handler.addDebugInstrumentationOffset(toggleOffset);
 }
 
+// Code coverage counters live in the script's PCCounts, one per jump target,
+// i.e. per basic block. Baseline code bumps them with a single inline 64-bit
+// increment, so scripts being covered still run in the Baseline JIT rather
+// than the interpreter.
 static void MaybeIncrementCodeCoverageCounter(MacroAssembler& masm,
                                               JSScript* script,
                                               jsbytecode* pc) {
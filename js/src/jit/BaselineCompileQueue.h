@@ -45,6 +45,19 @@ class BaselineCompileQueue {
   }
 
   bool isEmpty() const { return numQueued_ == 0; }
+  bool isFull() const {
+    return numQueued_ >= JitOptions.baselineQueueCapacity;
+  }
+
+  void push(JSScript* script) {
+    // Scripts are normally queued by the baseline interpreter's warm-up check.
+    // This is the equivalent for scripts queued from C++.
+    MOZ_ASSERT(!isFull());
+    assertInvariants();
+    queue_[numQueued_] = script;
+    numQueued_++;
+    assertInvariants();
+  }
 
   MOZ_ALWAYS_INLINE
   void assertInvariants() const {
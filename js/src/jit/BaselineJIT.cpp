@@ -476,6 +476,11 @@ static MethodStatus CanEnterBaselineJIT(JSContext* cx, HandleScript script,
     return Method_Skipped;
   }
 
+  // The script will be compiled when the realm's queue is dispatched.
+  if (script->hasJitScript() && script->jitScript()->isBaselineQueued()) {
+    return Method_Skipped;
+  }
+
   // If a hint is available, skip the warmup count threshold.
   bool mightHaveEagerBaselineHint = false;
   if (!JitOptions.disableJitHints && !script->noEagerBaselineHint() &&
@@ -516,6 +521,25 @@ static MethodStatus CanEnterBaselineJIT(JSContext* cx, HandleScript script,
   if (osrSourceFrame && osrSourceFrame.isDebuggee()) {
     options.setFlag(BaselineOption::ForceDebugInstrumentation);
   }
+
+  // Scripts compiled because of a hint tend to arrive in large bursts during
+  // startup. Add them to the realm's batch queue instead of dispatching one
+  // off-thread task per script.
+  if (mightHaveEagerBaselineHint &&
+      !options.hasFlag(BaselineOption::ForceDebugInstrumentation) &&
+      script->hasJitScript() && cx->realm() == script->realm() &&
+      OffThreadBaselineCompilationAvailable(cx, script)) {
+    BaselineCompileQueue& queue = cx->realm()->baselineCompileQueue();
+    if (!queue.isFull()) {
+      script->jitScript()->setIsBaselineQueued(script);
+      queue.push(script);
+      if (queue.isFull() && !DispatchOffThreadBaselineBatch(cx)) {
+        return Method_Error;
+      }
+      return Method_Skipped;
+    }
+  }
+
   return BaselineCompile(cx, script, options);
 }
 
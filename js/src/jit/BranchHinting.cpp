@@ -59,3 +59,36 @@ bool jit::BranchHinting(const MIRGenerator* mir, MIRGraph& graph) {
 
   return true;
 }
+
+// JS has no branch hints, but blocks which leave the function by throwing are
+// known to be cold: they end in MUnreachable after an MThrow or similar
+// instruction. As for unlikely wasm blocks, move them to the end of the
+// function so that they don't split up the hot code. Such blocks have no
+// successors, so this can't create a backedge.
+bool jit::MoveColdBlocksToEnd(const MIRGenerator* mir, MIRGraph& graph) {
+  JitSpew(JitSpew_BranchHint, "Beginning MoveColdBlocksToEnd pass");
+
+  mozilla::Vector<MBasicBlock*, 0> toBeMoved;
+
+  for (MBasicBlock* block : graph) {
+    if (block->loopDepth() == 0 && block->hasLastIns() &&
+        block->lastIns()->isUnreachable() && block->numPredecessors() > 0) {
+      if (!toBeMoved.append(block)) {
+        return false;
+      }
+    }
+  }
+
+  for (MBasicBlock* block : toBeMoved) {
+#ifdef JS_JITSPEW
+    JitSpew(JitSpew_BranchHint, "Moving cold block%u to the end", block->id());
+#endif
+    graph.moveBlockToEnd(block);
+  }
+
+  if (!toBeMoved.empty()) {
+    RenumberBlocks(graph);
+  }
+
+  return true;
+}
@@ -7,7 +7,8 @@
 #ifndef jit_BranchHinting_h
 #define jit_BranchHinting_h
 
-// This file represents the wasm Branch Hinting optimization pass
+// This file represents the wasm Branch Hinting optimization pass, and the
+// equivalent layout pass for JS, which has no explicit hints.
 
 namespace js::jit {
 
@@ -16,6 +17,9 @@ class MIRGraph;
 
 [[nodiscard]] bool BranchHinting(const MIRGenerator* mir, MIRGraph& graph);
 
+[[nodiscard]] bool MoveColdBlocksToEnd(const MIRGenerator* mir,
+                                       MIRGraph& graph);
+
 }  // namespace js::jit
 
 #endif /* jit_BranchHinting_h */
@@ -11239,6 +11239,84 @@ AttachDecision InlinableNativeIRGenerator::tryAttachTypedArrayLength(
   return AttachDecision::Attach;
 }
 
+AttachDecision InlinableNativeIRGenerator::tryAttachTypedArraySet() {
+  // Ensure |this| is a fixed-length TypedArrayObject.
+  if (!thisval_.isObject() ||
+      !thisval_.toObject().is<FixedLengthTypedArrayObject>()) {
+    return AttachDecision::NoAction;
+  }
+
+  // Expected arguments: source (typed array), optional offset (number).
+  if (args_.length() < 1 || args_.length() > 2) {
+    return AttachDecision::NoAction;
+  }
+  if (!args_[0].isObject()) {
+    return AttachDecision::NoAction;
+  }
+
+  auto* target = &thisval_.toObject().as<TypedArrayObject>();
+
+  // Only optimize copies between typed arrays with the same element type, which
+  // don't require any conversions. Using the same class also ensures the source
+  // is a fixed-length typed array.
+  JSObject* sourceObj = &args_[0].toObject();
+  if (sourceObj->getClass() != target->getClass()) {
+    return AttachDecision::NoAction;
+  }
+  auto* source = &sourceObj->as<TypedArrayObject>();
+
+  int64_t offsetInt64 = 0;
+  if (args_.length() > 1 && !ValueIsInt64Index(args_[1], &offsetInt64)) {
+    return AttachDecision::NoAction;
+  }
+
+  // Detached buffers and out-of-bounds offsets throw an exception.
+  if (target->hasDetachedBuffer() || source->hasDetachedBuffer()) {
+    return AttachDecision::NoAction;
+  }
+  size_t targetLength = target->length().valueOr(0);
+  size_t sourceLength = source->length().valueOr(0);
+  if (offsetInt64 < 0 || sourceLength > targetLength ||
+      uint64_t(offsetInt64) > targetLength - sourceLength) {
+    return AttachDecision::NoAction;
+  }
+
+  // Initialize the input operand.
+  Int32OperandId argcId = initializeInputOperand();
+
+  // Guard callee is the 'set' native function.
+  ObjOperandId calleeId = emitNativeCalleeGuard(argcId);
+
+  // Guard |this| is a TypedArrayObject with the expected class.
+  ValOperandId thisValId = loadThis(calleeId);
+  ObjOperandId objId = writer.guardToObject(thisValId);
+  writer.guardAnyClass(objId, target->getClass());
+
+  // Guard the source has the same class.
+  ValOperandId sourceValId = loadArgument(calleeId, ArgumentKind::Arg0);
+  ObjOperandId sourceId = writer.guardToObject(sourceValId);
+  writer.guardAnyClass(sourceId, target->getClass());
+
+  writer.guardHasAttachedArrayBuffer(objId);
+  writer.guardHasAttachedArrayBuffer(sourceId);
+
+  IntPtrOperandId intPtrOffsetId;
+  if (args_.length() > 1) {
+    ValOperandId offsetId = loadArgument(calleeId, ArgumentKind::Arg1);
+    intPtrOffsetId =
+        guardToIntPtrIndex(args_[1], offsetId, /* supportOOB = */ false);
+  } else {
+    Int32OperandId zeroId = writer.loadInt32Constant(0);
+    intPtrOffsetId = writer.int32ToIntPtr(zeroId);
+  }
+
+  writer.typedArraySetResult(objId, sourceId, intPtrOffsetId);
+  writer.returnFromIC();
+
+  trackAttached("TypedArraySet");
+  return AttachDecision::Attach;
+}
+
 AttachDecision InlinableNativeIRGenerator::tryAttachArrayBufferByteLength(
     bool isPossiblyWrapped) {
   // Self-hosted code calls this with a single, possibly wrapped,
@@ -12644,6 +12722,8 @@ AttachDecision InlinableNativeIRGenerator::tryAttachStub() {
     // TypedArray intrinsics.
     case InlinableNative::TypedArrayConstructor:
       return AttachDecision::NoAction;  // Not callable.
+    case InlinableNative::TypedArraySet:
+      return tryAttachTypedArraySet();
     case InlinableNative::IntrinsicIsTypedArray:
       return tryAttachIsTypedArray(/* isPossiblyWrapped = */ false);
     case InlinableNative::IntrinsicIsPossiblyWrappedTypedArray:
@@ -13119,9 +13199,16 @@ AttachDecision CallIRGenerator::tryAttachBoundFunction(
   bool isSpread = IsSpreadPC(pc_);
   bool isConstructing = IsConstructPC(pc_);
 
-  // Spread calls are not supported yet.
+  // Spread calls are only supported for bound functions without bound
+  // arguments. This covers wrappers that forward their rest arguments to a
+  // bound function without copying them into a new array in the VM.
   if (isSpread) {
-    return AttachDecision::NoAction;
+    if (isConstructing || calleeObj->numBoundArgs() > 0) {
+      return AttachDecision::NoAction;
+    }
+    if (args_.length() > JIT_ARGS_LENGTH_MAX) {
+      return AttachDecision::NoAction;
+    }
   }
 
   Rooted<JSFunction*> target(cx_, &calleeObj->getTarget()->as<JSFunction>());
@@ -464,9 +464,9 @@ enum class AttachDecision {
     }                                                       \
   } while (0)
 
-// Set of arguments supported by GetIndexOfArgument.
-// Support for higher argument indices can be added easily, but is currently
-// unneeded.
+// Set of arguments supported by GetIndexOfArgument. The number of argument
+// kinds bounds wasm::MaxArgsForJitInlineCall. Support for higher argument
+// indices can be added easily, but is currently unneeded.
 enum class ArgumentKind : uint8_t {
   Callee,
   This,
@@ -479,6 +479,14 @@ enum class ArgumentKind : uint8_t {
   Arg5,
   Arg6,
   Arg7,
+  Arg8,
+  Arg9,
+  Arg10,
+  Arg11,
+  Arg12,
+  Arg13,
+  Arg14,
+  Arg15,
   NumKinds
 };
 
@@ -550,6 +558,22 @@ inline int32_t GetIndexOfArgument(ArgumentKind kind, CallFlags flags,
       return flags.isConstructing() + hasArgumentArray - 7;
     case ArgumentKind::Arg7:
       return flags.isConstructing() + hasArgumentArray - 8;
+    case ArgumentKind::Arg8:
+      return flags.isConstructing() + hasArgumentArray - 9;
+    case ArgumentKind::Arg9:
+      return flags.isConstructing() + hasArgumentArray - 10;
+    case ArgumentKind::Arg10:
+      return flags.isConstructing() + hasArgumentArray - 11;
+    case ArgumentKind::Arg11:
+      return flags.isConstructing() + hasArgumentArray - 12;
+    case ArgumentKind::Arg12:
+      return flags.isConstructing() + hasArgumentArray - 13;
+    case ArgumentKind::Arg13:
+      return flags.isConstructing() + hasArgumentArray - 14;
+    case ArgumentKind::Arg14:
+      return flags.isConstructing() + hasArgumentArray - 15;
+    case ArgumentKind::Arg15:
+      return flags.isConstructing() + hasArgumentArray - 16;
     case ArgumentKind::NewTarget:
       MOZ_ASSERT(flags.isConstructing());
       *addArgc = false;
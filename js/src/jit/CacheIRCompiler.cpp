@@ -44,6 +44,7 @@
 #include "vm/GeneratorObject.h"
 #include "vm/GetterSetter.h"
 #include "vm/Interpreter.h"
+#include "vm/TypedArrayObject.h"
 #include "vm/TypeofEqOperand.h"  // TypeofEqOperand
 #include "vm/Uint8Clamped.h"
 
@@ -7566,6 +7567,50 @@ bool CacheIRCompiler::emitLoadDataViewValueResult(
   return true;
 }
 
+bool CacheIRCompiler::emitTypedArraySetResult(ObjOperandId targetId,
+                                              ObjOperandId sourceId,
+                                              IntPtrOperandId offsetId) {
+  JitSpew(JitSpew_Codegen, "%s", __FUNCTION__);
+
+  AutoOutputRegister output(*this);
+  Register target = allocator.useRegister(masm, targetId);
+  Register source = allocator.useRegister(masm, sourceId);
+  Register offset = allocator.useRegister(masm, offsetId);
+  AutoScratchRegisterMaybeOutput scratch1(allocator, masm, output);
+  AutoScratchRegisterMaybeOutputType scratch2(allocator, masm, output);
+
+  FailurePath* failure;
+  if (!addFailurePath(&failure)) {
+    return false;
+  }
+
+  // Fail if the source doesn't fit into the target at |offset|. A negative
+  // offset compares as a large unsigned value.
+  masm.loadArrayBufferViewLengthIntPtr(target, scratch1);
+  masm.loadArrayBufferViewLengthIntPtr(source, scratch2);
+  masm.branchPtr(Assembler::Above, scratch2, scratch1, failure->label());
+  masm.subPtr(scratch2, scratch1);
+  masm.branchPtr(Assembler::Above, offset, scratch1, failure->label());
+
+  LiveRegisterSet save = liveVolatileRegs();
+  save.takeUnchecked(output.valueReg());
+  save.takeUnchecked(scratch1);
+  save.takeUnchecked(scratch2);
+  masm.PushRegsInMask(save);
+
+  using Fn = void (*)(TypedArrayObject*, TypedArrayObject*, intptr_t);
+  masm.setupUnalignedABICall(scratch1);
+  masm.passABIArg(target);
+  masm.passABIArg(source);
+  masm.passABIArg(offset);
+  masm.callWithABI<Fn, js::TypedArraySetSameTypeFromJit>();
+
+  masm.PopRegsInMask(save);
+
+  masm.moveValue(UndefinedValue(), output.valueReg());
+  return true;
+}
+
 bool CacheIRCompiler::emitStoreDataViewValueResult(
     ObjOperandId objId, IntPtrOperandId offsetId, uint32_t valueId,
     BooleanOperandId littleEndianId, Scalar::Type elementType,
@@ -9226,6 +9271,16 @@ bool CacheIRCompiler::emitMegamorphicLoadSlotResult(ObjOperandId objId,
 
   masm.branchIfNonNativeObj(obj, scratch1, failure->label());
 
+#ifndef JS_CODEGEN_X86
+  // Dictionary-mode objects used as hash maps often miss in the megamorphic
+  // cache. Probe the object's first property map before calling into C++.
+  Label notInDictionaryMap;
+  masm.emitDictionaryPropMapLookup(obj, idReg, scratch1, scratch2,
+                                   output.valueReg(), &notInDictionaryMap);
+  masm.jump(&cacheHit);
+  masm.bind(&notInDictionaryMap);
+#endif
+
   masm.Push(UndefinedValue());
   masm.moveStackPtrTo(idReg.get());
 
@@ -10903,6 +10958,9 @@ bool CacheIRCompiler::emitMapSetResult(ObjOperandId mapId, ValOperandId keyId,
                                        ValOperandId valId) {
   JitSpew(JitSpew_Codegen, "%s", __FUNCTION__);
 
+  // Unlike the has/get ops, this always calls into the VM: adding an entry can
+  // reallocate the table, and storing the key and value needs pre- and
+  // post-barriers that depend on whether the map is tenured.
   AutoCallVM callvm(masm, this, allocator);
 
   Register map = allocator.useRegister(masm, mapId);
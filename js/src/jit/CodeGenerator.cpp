@@ -4564,6 +4564,13 @@ void CodeGenerator::visitMegamorphicLoadSlot(LMegamorphicLoadSlot* lir) {
   Label bail;
   masm.branchIfNonNativeObj(obj, temp0, &bail);
 
+  Label notInDictionaryMap;
+  masm.movePropertyKey(lir->mir()->name(), temp3);
+  masm.emitDictionaryPropMapLookup(obj, temp3, temp0, temp1, output,
+                                   &notInDictionaryMap);
+  masm.jump(&cacheHit);
+  masm.bind(&notInDictionaryMap);
+
   masm.Push(UndefinedValue());
   masm.moveStackPtrTo(temp3);
 
@@ -18748,6 +18755,39 @@ void CodeGenerator::visitStoreTypedArrayElementHoleInt64(
   masm.bind(&skip);
 }
 
+void CodeGenerator::visitTypedArraySet(LTypedArraySet* lir) {
+  Register target = ToRegister(lir->target());
+  Register source = ToRegister(lir->source());
+  Register offset = ToRegister(lir->offset());
+  Register targetLength = ToRegister(lir->temp0());
+  Register sourceLength = ToRegister(lir->temp1());
+
+  // Bail out if the source doesn't fit into the target at |offset|. A negative
+  // offset compares as a large unsigned value.
+  Label bail;
+  masm.loadArrayBufferViewLengthIntPtr(target, targetLength);
+  masm.loadArrayBufferViewLengthIntPtr(source, sourceLength);
+  masm.branchPtr(Assembler::Above, sourceLength, targetLength, &bail);
+  masm.subPtr(sourceLength, targetLength);
+  masm.branchPtr(Assembler::Above, offset, targetLength, &bail);
+  bailoutFrom(&bail, lir->snapshot());
+
+  auto volatileRegs = liveVolatileRegs(lir);
+  volatileRegs.takeUnchecked(targetLength);
+  volatileRegs.takeUnchecked(sourceLength);
+
+  masm.PushRegsInMask(volatileRegs);
+
+  using Fn = void (*)(TypedArrayObject*, TypedArrayObject*, intptr_t);
+  masm.setupAlignedABICall();
+  masm.passABIArg(target);
+  masm.passABIArg(source);
+  masm.passABIArg(offset);
+  masm.callWithABI<Fn, js::TypedArraySetSameTypeFromJit>();
+
+  masm.PopRegsInMask(volatileRegs);
+}
+
 void CodeGenerator::visitMemoryBarrier(LMemoryBarrier* ins) {
   masm.memoryBarrier(ins->barrier());
 }
@@ -20253,6 +20293,17 @@ void CodeGenerator::visitIncrementWarmUpCounter(LIncrementWarmUpCounter* ins) {
   incrementWarmUpCounter(warmUpCount, ins->mir()->script(), tmp);
 }
 
+void CodeGenerator::visitMarkIonScriptEntered(LMarkIonScriptEntered* lir) {
+  Register temp = ToRegister(lir->temp0());
+
+  // The IonScript pointer is patched in when linking.
+  CodeOffset label = masm.movWithPatch(ImmWord(uintptr_t(-1)), temp);
+  masm.propagateOOM(ionScriptLabels_.append(label));
+
+  masm.store8(Imm32(1),
+              Address(temp, IonScript::offsetOfEnteredSinceLastSample()));
+}
+
 void CodeGenerator::visitLexicalCheck(LLexicalCheck* ins) {
   ValueOperand inputValue = ToValue(ins->input());
   Label bail;
@@ -21597,6 +21648,34 @@ void CodeGenerator::visitWasmAnyRefJSStringLength(
   masm.loadStringLength(temp, output);
 }
 
+void CodeGenerator::visitWasmAnyRefJSStringCharAt(
+    LWasmAnyRefJSStringCharAt* lir) {
+  Register input = ToRegister(lir->input());
+  Register index = ToRegister(lir->index());
+  Register output = ToRegister(lir->output());
+  Register str = ToRegister(lir->temp0());
+  Register temp1 = ToRegister(lir->temp1());
+  Register temp2 = ToRegister(lir->temp2());
+
+  Label fail, done;
+  masm.branchWasmAnyRefIsJSString(false, input, str, &fail);
+  masm.untagWasmAnyRef(input, str, wasm::AnyRefTag::String);
+
+  // The index is unsigned; negative values are out of bounds.
+  masm.spectreBoundsCheck32(index, Address(str, JSString::offsetOfLength()),
+                            temp1, &fail);
+  if (lir->mir()->codePoint()) {
+    masm.loadStringCodePoint(str, index, output, temp1, temp2, &fail);
+  } else {
+    masm.loadStringChar(str, index, output, temp1, temp2, &fail);
+  }
+  masm.jump(&done);
+
+  masm.bind(&fail);
+  masm.move32(Imm32(-1), output);
+  masm.bind(&done);
+}
+
 void CodeGenerator::visitWasmNewI31Ref(LWasmNewI31Ref* lir) {
   if (lir->value()->isConstant()) {
     // i31ref are often created with constants. If that's the case we will
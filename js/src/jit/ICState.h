@@ -85,6 +85,7 @@ class ICState {
   Mode mode() const { return Mode(mode_); }
   size_t numOptimizedStubs() const { return numOptimizedStubs_; }
   bool hasFailures() const { return (numFailures_ != 0); }
+  size_t numFailures() const { return numFailures_; }
   bool newStubIsFirstStub() const {
     return (mode() == Mode::Specialized && numOptimizedStubs() == 0);
   }
@@ -357,6 +357,7 @@ bool js::jit::CanInlineNativeCrossRealm(InlinableNative native) {
     case InlinableNative::ObjectKeys:
     case InlinableNative::ObjectToString:
     case InlinableNative::TypedArrayConstructor:
+    case InlinableNative::TypedArraySet:
 #ifdef FUZZING_JS_FUZZILLI
     case InlinableNative::FuzzilliHash:
 #endif
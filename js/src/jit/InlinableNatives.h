@@ -248,6 +248,7 @@
   _(IntrinsicGuardToSharedArrayBuffer)             \
                                                    \
   _(TypedArrayConstructor)                         \
+  _(TypedArraySet)                                 \
   _(IntrinsicIsTypedArrayConstructor)              \
   _(IntrinsicIsTypedArray)                         \
   _(IntrinsicIsPossiblyWrappedTypedArray)          \
@@ -40,6 +40,7 @@
 #include "jit/JitcodeMap.h"
 #include "jit/JitFrames.h"
 #include "jit/JitRuntime.h"
+#include "jit/JitScript.h"
 #include "jit/JitSpewer.h"
 #include "jit/JitZone.h"
 #include "jit/LICM.h"
@@ -362,6 +363,12 @@ static bool LinkCodeGen(JSContext* cx, CodeGenerator* codegen,
     cx->metrics().ION_COMPILE_TIME(compileTime);
   }
 
+#ifdef JS_STRUCTURED_SPEW
+  JitSpewCompileEvent(cx, script, "compile", "ion",
+                      codegen->getCompilationTime(),
+                      script->ionScript()->method()->instructionsSize());
+#endif
+
   return true;
 }
 
@@ -672,7 +679,8 @@ IonScript::IonScript(IonCompilationId compilationId, uint32_t localSlotsSize,
     : localSlotsSize_(localSlotsSize),
       argumentSlotsSize_(argumentSlotsSize),
       frameSize_(frameSize),
-      compilationId_(compilationId) {}
+      compilationId_(compilationId),
+      lastEntryTime_(mozilla::TimeStamp::Now()) {}
 
 IonScript* IonScript::New(JSContext* cx, IonCompilationId compilationId,
                           uint32_t localSlotsSize, uint32_t argumentSlotsSize,
@@ -1207,6 +1215,16 @@ bool OptimizeMIR(MIRGenerator* mir) {
     if (mir->shouldCancel("BranchHinting")) {
       return false;
     }
+  } else if (!mir->compilingWasm()) {
+    if (!MoveColdBlocksToEnd(mir, graph)) {
+      return false;
+    }
+    gs.spewPass("Move Cold Blocks");
+    AssertBasicGraphCoherency(graph);
+
+    if (mir->shouldCancel("Move Cold Blocks")) {
+      return false;
+    }
   }
 
   // LICM can hoist instructions from conditional branches and
@@ -1533,9 +1551,18 @@ LIRGraph* GenerateLIR(MIRGenerator* mir) {
     IonRegisterAllocator allocator =
         mir->optimizationInfo().registerAllocator();
 
+    // Backtracking allocation time grows faster than linearly with the size
+    // of the graph, so huge functions get the cheaper allocator.
+    if (allocator == RegisterAllocator_Backtracking &&
+        JitOptions.forcedRegisterAllocator.isNothing() &&
+        lir->numInstructions() > JitOptions.fastRegAllocThreshold) {
+      allocator = RegisterAllocator_Fast;
+    }
+
     switch (allocator) {
       case RegisterAllocator_Backtracking:
-      case RegisterAllocator_Testbed: {
+      case RegisterAllocator_Testbed:
+      case RegisterAllocator_Fast: {
 #ifdef DEBUG
         if (JitOptions.fullDebugChecks) {
           if (!integrity.record()) {
@@ -1545,7 +1572,8 @@ LIRGraph* GenerateLIR(MIRGenerator* mir) {
 #endif
 
         BacktrackingAllocator regalloc(mir, &lirgen, *lir,
-                                       allocator == RegisterAllocator_Testbed);
+                                       allocator == RegisterAllocator_Testbed,
+                                       allocator == RegisterAllocator_Fast);
         if (!regalloc.go()) {
           return nullptr;
         }
@@ -1558,7 +1586,9 @@ LIRGraph* GenerateLIR(MIRGenerator* mir) {
         }
 #endif
 
-        gs.spewPass("Allocate Registers [Backtracking]");
+        gs.spewPass(allocator == RegisterAllocator_Fast
+                        ? "Allocate Registers [Fast]"
+                        : "Allocate Registers [Backtracking]");
         break;
       }
 
@@ -1638,7 +1668,38 @@ static AbortReasonOr<WarpSnapshot*> CreateWarpSnapshot(JSContext* cx,
   return result;
 }
 
+void JitRuntime::cacheIonLifoAllocs(IonFreeCompileTasks& tasks) {
+  auto& cache = ionLifoAllocCache_.ref();
+
+  size_t i = 0;
+  while (i < tasks.length() && cache.length() < MaxCachedIonLifoAllocs) {
+    IonCompileTask* task = tasks[i];
+    if (task->alloc().lifoAlloc()->isHuge()) {
+      // Don't keep 'huge' LifoAllocs alive. See tryReuseIonLifoAlloc.
+      i++;
+      continue;
+    }
+    tasks.erase(&tasks[i]);
+
+    // This can't fail because the cache doesn't exceed its inline capacity.
+    cache.infallibleAppend(FreeIonCompileTaskAndReuseLifoAlloc(task));
+  }
+}
+
+void JitRuntime::purgeIonLifoAllocCache() {
+  ionLifoAllocCache_.ref().clearAndFree();
+}
+
 UniquePtr<LifoAlloc> JitRuntime::tryReuseIonLifoAlloc() {
+  // Prefer a LifoAlloc from the cache. Its compile task has already been
+  // freed.
+  auto& cache = ionLifoAllocCache_.ref();
+  if (!cache.empty()) {
+    UniquePtr<LifoAlloc> alloc = std::move(cache.back());
+    cache.popBack();
+    return alloc;
+  }
+
   // Try to reuse the LifoAlloc of a finished Ion compilation task for a new
   // Ion compilation. If there are multiple tasks, we pick the one with the
   // largest LifoAlloc.
@@ -1927,8 +1988,15 @@ static MethodStatus Compile(JSContext* cx, HandleScript script,
     return Method_Skipped;
   }
 
+  if (script->jitScript()->isInIonBackoff(mozilla::TimeStamp::Now())) {
+    JitSpew(JitSpew_IonAbort, "Ion compilation suspended after invalidations");
+    script->resetWarmUpCounterToDelayIonCompilation();
+    return Method_Skipped;
+  }
+
   MOZ_ASSERT(!script->hasIonScript());
 
+  script->jitScript()->incNumIonCompiles();
   AbortReason reason = IonCompile(cx, script, osrPc);
   if (reason == AbortReason::Error) {
     MOZ_ASSERT(cx->isExceptionPending());
@@ -2559,6 +2627,11 @@ void jit::Invalidate(JSContext* cx, const RecompileInfoVector& invalid,
             info.script()->filename(), info.script()->lineno(),
             info.script()->column().oneOriginValue(), ionScript);
 
+#ifdef JS_STRUCTURED_SPEW
+    JitSpewCompileEvent(cx, info.script(), "invalidate", "ion",
+                        mozilla::TimeDuration(), 0);
+#endif
+
     ClearPendingInvalidationDependencies(info.script());
 
     // Keep the ion script alive during the invalidation and flag this
@@ -2703,6 +2776,16 @@ size_t jit::SizeOfIonData(JSScript* script,
   return result;
 }
 
+size_t jit::SizeOfIonSnapshots(JSScript* script) {
+  if (!script->hasIonScript()) {
+    return 0;
+  }
+
+  IonScript* ionScript = script->ionScript();
+  return ionScript->snapshotsListSize() + ionScript->snapshotsRVATableSize() +
+         ionScript->recoversSize();
+}
+
 // If you change these, please also change the comment in TempAllocator.
 /* static */ const size_t TempAllocator::BallastSize = 16 * 1024;
 /* static */ const size_t TempAllocator::PreferredLifoChunkSize = 32 * 1024;
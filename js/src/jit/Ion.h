@@ -126,6 +126,11 @@ void ForbidCompilation(JSContext* cx, JSScript* script);
 
 size_t SizeOfIonData(JSScript* script, mozilla::MallocSizeOf mallocSizeOf);
 
+// Size of the bailout snapshots, RValueAllocation table and recover
+// instructions stored in the script's IonScript. This is included in
+// SizeOfIonData.
+size_t SizeOfIonSnapshots(JSScript* script);
+
 inline bool IsIonEnabled(JSContext* cx) {
   if (MOZ_UNLIKELY(!IsBaselineJitEnabled(cx) || cx->options().disableIon())) {
     return false;
@@ -8,6 +8,7 @@
 #define jit_IonCompileTask_h
 
 #include "mozilla/LinkedList.h"
+#include "mozilla/TimeStamp.h"
 
 #include "jit/CompilationDependencyTracker.h"
 #include "jit/MIRGenerator.h"
@@ -41,6 +42,13 @@ class IonCompileTask final : public HelperThreadTask,
   // removed from the helper threads. Thus this should be safe.
   const mozilla::Atomic<bool, mozilla::ReleaseAcquire>& isExecuting_;
 
+  // The script's warm-up count and the time at which this task was added to
+  // the Ion worklist. The difference between the live warm-up count and the
+  // count at submission is used to prioritize scripts that are still running
+  // hot over those which stopped running after crossing the threshold.
+  uint32_t submitWarmUpCount_ = 0;
+  mozilla::TimeStamp submitTime_;
+
  public:
   explicit IonCompileTask(JSContext* cx, MIRGenerator& mirGen,
                           WarpSnapshot* snapshot);
@@ -53,6 +61,13 @@ class IonCompileTask final : public HelperThreadTask,
   size_t sizeOfExcludingThis(mozilla::MallocSizeOf mallocSizeOf);
   void trace(JSTracer* trc);
 
+  void setSubmitted(uint32_t warmUpCount, mozilla::TimeStamp time) {
+    submitWarmUpCount_ = warmUpCount;
+    submitTime_ = time;
+  }
+  uint32_t submitWarmUpCount() const { return submitWarmUpCount_; }
+  mozilla::TimeStamp submitTime() const { return submitTime_; }
+
   CodeGenerator* backgroundCodegen() const { return backgroundCodegen_; }
   void setBackgroundCodegen(CodeGenerator* codegen) {
     backgroundCodegen_ = codegen;
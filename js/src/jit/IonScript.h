@@ -8,6 +8,7 @@
 #define jit_IonScript_h
 
 #include "mozilla/MemoryReporting.h"  // MallocSizeOf
+#include "mozilla/TimeStamp.h"        // TimeStamp
 
 #include <stddef.h>  // size_t
 #include <stdint.h>  // uint8_t, uint32_t
@@ -111,6 +112,10 @@ class alignas(8) IonScript final : public TrailingArray<IonScript> {
   // inlined functions when we bail out.
   bool purgedICScripts_ = false;
 
+  // Set by the Ion code when it's entered and cleared when the GC samples it.
+  // Only used if JitOptions.coldIonCodeDiscardSeconds is non-zero.
+  bool enteredSinceLastSample_ = false;
+
   // Number of bytes this function reserves on the stack for slots spilled by
   // the register allocator.
   uint32_t localSlotsSize_ = 0;
@@ -132,6 +137,10 @@ class alignas(8) IonScript final : public TrailingArray<IonScript> {
   // a LOOPENTRY pc other than osrPc_.
   uint32_t osrPcMismatchCounter_ = 0;
 
+  // Approximate time this code was last entered. Updated when the GC samples
+  // enteredSinceLastSample_.
+  mozilla::TimeStamp lastEntryTime_;
+
 #ifdef DEBUG
   // A hash of the ICScripts used in this compilation.
   mozilla::HashNumber icHash_ = 0;
@@ -286,6 +295,19 @@ class alignas(8) IonScript final : public TrailingArray<IonScript> {
   static inline size_t offsetOfInvalidationCount() {
     return offsetof(IonScript, invalidationCount_);
   }
+  static inline size_t offsetOfEnteredSinceLastSample() {
+    return offsetof(IonScript, enteredSinceLastSample_);
+  }
+
+  // Return the approximate time this code was last entered, first accounting
+  // for entries since the previous call.
+  mozilla::TimeStamp sampleLastEntryTime(mozilla::TimeStamp now) {
+    if (enteredSinceLastSample_) {
+      enteredSinceLastSample_ = false;
+      lastEntryTime_ = now;
+    }
+    return lastEntryTime_;
+  }
 
  public:
   JitCode* method() const { return method_; }
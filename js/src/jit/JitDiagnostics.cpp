@@ -0,0 +1,269 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+ * vim: set ts=8 sts=2 et sw=2 tw=80:
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "js/JitDiagnostics.h"
+
+#include <algorithm>
+
+#include "gc/PublicIterators.h"
+#include "jit/BaselineIC.h"
+#include "jit/ICState.h"
+#include "jit/IonTypes.h"
+#include "jit/JitRuntime.h"
+#include "jit/JitScript.h"
+#include "jit/JitZone.h"
+#include "js/ErrorReport.h"  // JS_ReportErrorASCII
+#include "js/Wrapper.h"      // js::CheckedUnwrapStatic
+#include "util/Text.h"
+#include "vm/BytecodeUtil.h"
+#include "vm/Caches.h"
+#include "vm/JSContext.h"
+#include "vm/JSScript.h"
+#include "vm/Realm.h"
+#include "wasm/WasmInstance.h"
+#include "wasm/WasmJS.h"
+
+#include "vm/JSContext-inl.h"
+#include "wasm/WasmInstance-inl.h"
+
+using namespace js;
+using namespace js::jit;
+
+static bool HasMoreThrashing(const JitScript* a, const JitScript* b) {
+  if (a->numBailoutInvalidations() != b->numBailoutInvalidations()) {
+    return a->numBailoutInvalidations() > b->numBailoutInvalidations();
+  }
+  return a->numBailouts() > b->numBailouts();
+}
+
+JS_PUBLIC_API bool JS::GetJitThrashingScripts(
+    JSContext* cx, size_t maxScripts, JitThrashingScriptVector& scripts) {
+  CHECK_THREAD(cx);
+
+  if (maxScripts == 0) {
+    return true;
+  }
+
+  JS::AutoCheckCannotGC nogc;
+
+  Vector<JitScript*, 0, SystemAllocPolicy> candidates;
+  for (ZonesIter zone(cx->runtime(), SkipAtoms); !zone.done(); zone.next()) {
+    JitZone* jitZone = zone->jitZone();
+    if (!jitZone) {
+      continue;
+    }
+    bool ok = jitZone->forEachJitScriptFallible([&](JitScript* jitScript) {
+      if (jitScript->numBailouts() == 0) {
+        return true;
+      }
+      return candidates.append(jitScript);
+    });
+    if (!ok) {
+      ReportOutOfMemory(cx);
+      return false;
+    }
+  }
+
+  size_t count = std::min(maxScripts, candidates.length());
+  std::partial_sort(candidates.begin(), candidates.begin() + count,
+                    candidates.end(), HasMoreThrashing);
+
+  if (!scripts.reserve(scripts.length() + count)) {
+    ReportOutOfMemory(cx);
+    return false;
+  }
+
+  for (size_t i = 0; i < count; i++) {
+    JitScript* jitScript = candidates[i];
+    JSScript* script = jitScript->owningScript();
+
+    JitThrashingScriptInfo info;
+    if (const char* filename = script->filename()) {
+      info.filename = DuplicateString(filename);
+      if (!info.filename) {
+        ReportOutOfMemory(cx);
+        return false;
+      }
+    }
+    info.lineno = script->lineno();
+    info.column = script->column().oneOriginValue();
+    info.bailouts = jitScript->numBailouts();
+    info.invalidations = jitScript->numBailoutInvalidations();
+    info.ionCompiles = jitScript->numIonCompiles();
+    scripts.infallibleAppend(std::move(info));
+  }
+
+  return true;
+}
+
+JS_PUBLIC_API bool JS::GetJitBailoutKindCounts(
+    JSContext* cx, JitBailoutKindCountVector& counts) {
+  CHECK_THREAD(cx);
+
+  JSRuntime* rt = cx->runtime();
+  if (!rt->hasJitRuntime()) {
+    return true;
+  }
+
+  JitRuntime* jrt = rt->jitRuntime();
+  for (size_t i = 0; i < size_t(BailoutKind::Limit); i++) {
+    BailoutKind kind = BailoutKind(i);
+    uint64_t count = jrt->bailoutKindCount(kind);
+    if (count == 0) {
+      continue;
+    }
+    if (!counts.append(JitBailoutKindCount{BailoutKindString(kind), count})) {
+      ReportOutOfMemory(cx);
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static JS::ICHealthMode ToICHealthMode(const ICState& state) {
+  switch (state.mode()) {
+    case ICState::Mode::Specialized:
+      return state.numOptimizedStubs() > 1 ? JS::ICHealthMode::Polymorphic
+                                           : JS::ICHealthMode::Monomorphic;
+    case ICState::Mode::Megamorphic:
+      return JS::ICHealthMode::Megamorphic;
+    case ICState::Mode::Generic:
+      return JS::ICHealthMode::Generic;
+  }
+  MOZ_CRASH("Unexpected ICState mode");
+}
+
+static bool AppendScriptICHealth(JitScript* jitScript, bool includeMonomorphic,
+                                 JS::ScriptICHealthVector& scripts) {
+  JSScript* script = jitScript->owningScript();
+
+  JS::ScriptICHealth health;
+  for (size_t i = 0; i < jitScript->numICEntries(); i++) {
+    ICFallbackStub* fallback = jitScript->fallbackStub(i);
+    const ICState& state = fallback->state();
+    if (fallback->enteredCount() == 0 && state.numOptimizedStubs() == 0) {
+      continue;
+    }
+
+    JS::ICHealthMode mode = ToICHealthMode(state);
+    if (!includeMonomorphic && mode == JS::ICHealthMode::Monomorphic &&
+        !state.hasFailures()) {
+      continue;
+    }
+
+    JS::ICHealthEntry entry;
+    entry.pcOffset = fallback->pcOffset();
+    entry.op = CodeName(JSOp(*script->offsetToPC(fallback->pcOffset())));
+    entry.mode = mode;
+    entry.numStubs = state.numOptimizedStubs();
+    entry.numFailures = state.numFailures();
+    entry.fallbackCount = fallback->enteredCount();
+    if (!health.entries.append(entry)) {
+      return false;
+    }
+  }
+
+  if (health.entries.empty()) {
+    return true;
+  }
+
+  if (const char* filename = script->filename()) {
+    health.filename = DuplicateString(filename);
+    if (!health.filename) {
+      return false;
+    }
+  }
+  health.lineno = script->lineno();
+  health.column = script->column().oneOriginValue();
+  health.warmUpCount = jitScript->warmUpCount();
+  return scripts.append(std::move(health));
+}
+
+JS_PUBLIC_API bool JS::GetRealmICHealth(JSContext* cx, JS::Realm* realm,
+                                        bool includeMonomorphic,
+                                        ScriptICHealthVector& scripts) {
+  CHECK_THREAD(cx);
+
+  JitZone* jitZone = realm->zone()->jitZone();
+  if (!jitZone) {
+    return true;
+  }
+
+  JS::AutoCheckCannotGC nogc;
+
+  bool ok = jitZone->forEachJitScriptFallible([&](JitScript* jitScript) {
+    JSScript* script = jitScript->owningScript();
+    if (script->realm() != realm || script->selfHosted()) {
+      return true;
+    }
+    return AppendScriptICHealth(jitScript, includeMonomorphic, scripts);
+  });
+  if (!ok) {
+    ReportOutOfMemory(cx);
+    return false;
+  }
+
+  return true;
+}
+
+template <typename Cache>
+static void GetCacheStats(const Cache& cache,
+                          JS::MegamorphicCacheStats* stats) {
+  stats->misses = cache.numMisses();
+  stats->evictions = cache.numEvictions();
+  stats->invalidations = cache.numInvalidations();
+}
+
+JS_PUBLIC_API void JS::GetMegamorphicCacheStats(
+    JSContext* cx, MegamorphicCacheStats* getPropStats,
+    MegamorphicCacheStats* setPropStats) {
+  CHECK_THREAD(cx);
+
+  GetCacheStats(cx->caches().megamorphicCache, getPropStats);
+
+  *setPropStats = MegamorphicCacheStats();
+  if (cx->caches().megamorphicSetPropCache) {
+    GetCacheStats(*cx->caches().megamorphicSetPropCache, setPropStats);
+  }
+}
+
+JS_PUBLIC_API void JS::SetWasmFunctionSampling(JSContext* cx, bool enabled) {
+  CHECK_THREAD(cx);
+  cx->wasm().funcSampling = enabled;
+}
+
+JS_PUBLIC_API bool JS::GetWasmFunctionSamples(
+    JSContext* cx, JSObject* instance, WasmFunctionSampleVector& samples) {
+  CHECK_THREAD(cx);
+
+  JSObject* unwrapped = CheckedUnwrapStatic(instance);
+  if (!unwrapped || !unwrapped->is<WasmInstanceObject>()) {
+    JS_ReportErrorASCII(cx, "expected a WebAssembly.Instance");
+    return false;
+  }
+
+  const wasm::Instance& wasmInstance =
+      unwrapped->as<WasmInstanceObject>().instance();
+  const uint32_t* funcSamples = wasmInstance.funcSamples();
+  if (!funcSamples) {
+    return true;
+  }
+
+  size_t numFuncs = wasmInstance.codeMeta().numFuncs();
+  for (uint32_t funcIndex = 0; funcIndex < numFuncs; funcIndex++) {
+    if (funcSamples[funcIndex] == 0) {
+      continue;
+    }
+    if (!samples.append(
+            WasmFunctionSampleCount{funcIndex, funcSamples[funcIndex]})) {
+      ReportOutOfMemory(cx);
+      return false;
+    }
+  }
+
+  return true;
+}
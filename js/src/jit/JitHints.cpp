@@ -49,6 +49,53 @@ void JitHintsMap::updateAsRecentlyUsed(IonHint* hint) {
   ionHintQueue_.insertBack(hint);
 }
 
+HashNumber JitHintsMap::getAllocSiteKey(JSScript* script,
+                                        uint32_t pcOffset) const {
+  ScriptKey scriptKey = getScriptKey(script);
+  if (!scriptKey) {
+    return 0;
+  }
+
+  // Zero is used to indicate that there is no key.
+  HashNumber key = mozilla::AddToHash(scriptKey, pcOffset);
+  return key ? key : 1;
+}
+
+bool JitHintsMap::addPretenureHintKey(HashNumber key) {
+  MOZ_ASSERT(key);
+
+  if (pretenureHintSet_.count() >= PretenureHintMaxEntries) {
+    pretenureHintSet_.clear();
+  }
+
+  return pretenureHintSet_.put(key);
+}
+
+void JitHintsMap::setPretenuredAllocSiteHint(JSScript* script,
+                                             uint32_t pcOffset) {
+  if (HashNumber key = getAllocSiteKey(script, pcOffset)) {
+    // This is only a hint so ignore failure.
+    (void)addPretenureHintKey(key);
+  }
+}
+
+void JitHintsMap::clearPretenuredAllocSiteHint(JSScript* script,
+                                               uint32_t pcOffset) {
+  if (HashNumber key = getAllocSiteKey(script, pcOffset)) {
+    pretenureHintSet_.remove(key);
+  }
+}
+
+bool JitHintsMap::hasPretenuredAllocSiteHint(JSScript* script,
+                                             uint32_t pcOffset) const {
+  if (pretenureHintSet_.empty()) {
+    return false;
+  }
+
+  HashNumber key = getAllocSiteKey(script, pcOffset);
+  return key && pretenureHintSet_.has(key);
+}
+
 bool JitHintsMap::recordIonCompilation(JSScript* script) {
   ScriptKey key = getScriptKey(script);
   if (!key) {
@@ -177,3 +224,175 @@ bool JitHintsMap::hasMonomorphicInlineHintAtOffset(JSScript* script,
 
   return false;
 }
+
+// Buffer layout, with all values stored as native endian uint32_t:
+//
+//   magic, version
+//   baseline entry count, baseline filter bits
+//   Ion hint count, then for each: key, threshold, offset count, offsets
+//   pretenure hint count, then each key
+//
+// Ion hints are written in least recently used order.
+static constexpr uint32_t JitHintsMagic = 0x544e484a;  // 'JHNT'
+static constexpr uint32_t JitHintsVersion = 1;
+
+static bool WriteUint32(JS::TranscodeBuffer& buffer, uint32_t value) {
+  return buffer.append(reinterpret_cast<const uint8_t*>(&value),
+                       sizeof(value));
+}
+
+namespace {
+
+class JitHintsReader {
+  const uint8_t* cur_;
+  const uint8_t* end_;
+
+ public:
+  explicit JitHintsReader(const JS::TranscodeRange& range)
+      : cur_(range.begin().get()), end_(range.end().get()) {}
+
+  bool done() const { return cur_ == end_; }
+
+  bool readBytes(size_t length, const uint8_t** out) {
+    if (size_t(end_ - cur_) < length) {
+      return false;
+    }
+    *out = cur_;
+    cur_ += length;
+    return true;
+  }
+
+  bool readUint32(uint32_t* out) {
+    const uint8_t* bytes;
+    if (!readBytes(sizeof(uint32_t), &bytes)) {
+      return false;
+    }
+    memcpy(out, bytes, sizeof(uint32_t));
+    return true;
+  }
+};
+
+}  // namespace
+
+bool JitHintsMap::encode(JS::TranscodeBuffer& buffer) const {
+  if (!WriteUint32(buffer, JitHintsMagic) ||
+      !WriteUint32(buffer, JitHintsVersion)) {
+    return false;
+  }
+
+  if (!WriteUint32(buffer, baselineEntryCount_) ||
+      !buffer.append(baselineHintMap_.bits(), baselineHintMap_.bitsLength())) {
+    return false;
+  }
+
+  if (!WriteUint32(buffer, ionHintMap_.count())) {
+    return false;
+  }
+  for (const IonHint* hint = ionHintQueue_.getFirst(); hint;
+       hint = hint->getNext()) {
+    const auto& offsets = hint->monomorphicInlineOffsetList();
+    if (!WriteUint32(buffer, hint->key()) ||
+        !WriteUint32(buffer, hint->threshold()) ||
+        !WriteUint32(buffer, offsets.length())) {
+      return false;
+    }
+    for (uint32_t offset : offsets) {
+      if (!WriteUint32(buffer, offset)) {
+        return false;
+      }
+    }
+  }
+
+  if (!WriteUint32(buffer, pretenureHintSet_.count())) {
+    return false;
+  }
+  return forEachPretenureHintKey(
+      [&](HashNumber key) { return WriteUint32(buffer, key); });
+}
+
+JS::TranscodeResult JitHintsMap::decode(const JS::TranscodeRange& range) {
+  // The buffer may come from an untrusted cache so all values are checked.
+  // Since everything here is only a hint, a buffer that turns out to be
+  // malformed part way through leaves any hints already read in place.
+  JitHintsReader reader(range);
+
+  uint32_t magic, version;
+  if (!reader.readUint32(&magic) || !reader.readUint32(&version) ||
+      magic != JitHintsMagic || version != JitHintsVersion) {
+    return JS::TranscodeResult::Failure_BadDecode;
+  }
+
+  uint32_t baselineCount;
+  const uint8_t* baselineBits;
+  if (!reader.readUint32(&baselineCount) ||
+      !reader.readBytes(baselineHintMap_.bitsLength(), &baselineBits) ||
+      baselineCount > MaxEntries_) {
+    return JS::TranscodeResult::Failure_BadDecode;
+  }
+
+  // Merging the filters may exceed the target false positive rate, in which
+  // case start again from the decoded filter.
+  if (baselineEntryCount_ + baselineCount > MaxEntries_) {
+    baselineHintMap_.clear();
+    baselineEntryCount_ = 0;
+  }
+  baselineHintMap_.addBits(baselineBits);
+  baselineEntryCount_ += baselineCount;
+
+  uint32_t ionHintCount;
+  if (!reader.readUint32(&ionHintCount) || ionHintCount > IonHintMaxEntries) {
+    return JS::TranscodeResult::Failure_BadDecode;
+  }
+  for (uint32_t i = 0; i < ionHintCount; i++) {
+    uint32_t key, threshold, offsetCount;
+    if (!reader.readUint32(&key) || !reader.readUint32(&threshold) ||
+        !reader.readUint32(&offsetCount) || key == 0 ||
+        offsetCount > MonomorphicInlineMaxEntries) {
+      return JS::TranscodeResult::Failure_BadDecode;
+    }
+
+    // Skip hints for scripts we already know about, but still read the
+    // offsets to get to the next entry.
+    IonHint* hint = nullptr;
+    auto p = ionHintMap_.lookupForAdd(key);
+    if (!p) {
+      hint = addIonHint(key, p);
+      if (!hint) {
+        return JS::TranscodeResult::Throw;
+      }
+      hint->initThreshold(
+          std::min(threshold, JitOptions.normalIonWarmUpThreshold));
+    }
+
+    for (uint32_t j = 0; j < offsetCount; j++) {
+      uint32_t offset;
+      if (!reader.readUint32(&offset)) {
+        return JS::TranscodeResult::Failure_BadDecode;
+      }
+      if (hint && !hint->addMonomorphicInlineOffset(offset)) {
+        return JS::TranscodeResult::Throw;
+      }
+    }
+  }
+
+  uint32_t pretenureCount;
+  if (!reader.readUint32(&pretenureCount) ||
+      pretenureCount > PretenureHintMaxEntries) {
+    return JS::TranscodeResult::Failure_BadDecode;
+  }
+  for (uint32_t i = 0; i < pretenureCount; i++) {
+    uint32_t key;
+    if (!reader.readUint32(&key) || key == 0) {
+      return JS::TranscodeResult::Failure_BadDecode;
+    }
+    if (!addPretenureHintKey(key)) {
+      return JS::TranscodeResult::Throw;
+    }
+  }
+
+  if (!reader.done()) {
+    return JS::TranscodeResult::Failure_BadDecode;
+  }
+
+  return JS::TranscodeResult::Ok;
+}
@@ -11,6 +11,7 @@
 #include "mozilla/HashTable.h"
 #include "mozilla/LinkedList.h"
 #include "jit/JitOptions.h"
+#include "js/Transcoding.h"
 #include "vm/BytecodeLocation.h"
 #include "vm/JSScript.h"
 
@@ -27,6 +28,16 @@ namespace js::jit {
  * value, and if we ever encounter this script again later, e.g. during a
  * navigation, then we try to eagerly compile it into baseline and ion
  * based on its previous execution history.
+ *
+ * The whole map can be encoded into a buffer and decoded into the map of a
+ * runtime in a later process, so that scripts loaded again after a restart
+ * skip warmup in the same way. Decoded hints are merged with any that are
+ * already present, which take precedence.
+ *
+ * Only the hints are persisted and not the compiled code itself. Baseline,
+ * Ion and IC stub code embeds absolute addresses of trampolines, VM functions
+ * and per-zone state such as barrier flags, none of which is stable across
+ * processes, so code is always regenerated from the hints.
  */
 
 class JitHintsMap {
@@ -69,7 +80,7 @@ class JitHintsMap {
 
     void initThreshold(uint32_t threshold) { threshold_ = threshold; }
 
-    uint32_t threshold() { return threshold_; }
+    uint32_t threshold() const { return threshold_; }
 
     void incThreshold(uint32_t inc) {
       uint32_t newThreshold = threshold() + inc;
@@ -100,7 +111,12 @@ class JitHintsMap {
       return monomorphicInlineOffsets.append(newOffset);
     }
 
-    ScriptKey key() {
+    const Vector<uint32_t, 0, SystemAllocPolicy>& monomorphicInlineOffsetList()
+        const {
+      return monomorphicInlineOffsets;
+    }
+
+    ScriptKey key() const {
       MOZ_ASSERT(key_ != 0, "Should have valid key.");
       return key_;
     }
@@ -151,6 +167,25 @@ class JitHintsMap {
   uint32_t baselineEntryCount_ = 0;
   void incrementBaselineEntryCount();
 
+  /* Pretenuring Hints
+   * --------------------------------------------------------------------------
+   * A set of allocation sites that have been found to allocate long-lived
+   * objects, keyed on a hash of the script key and the site's bytecode offset.
+   * New allocation sites for the same location start out pretenured, which
+   * skips the minor GCs that would otherwise be needed to rediscover this.
+   *
+   * The set can be exported and imported by the embedding so that hints
+   * persist across processes. False positives from hash collisions only cause
+   * a site to be pretenured until the next minor GC in which it is found to
+   * be short-lived. The set is cleared if it reaches |PretenureHintMaxEntries|.
+   */
+  using PretenureHintSet =
+      HashSet<HashNumber, js::DefaultHasher<HashNumber>, js::SystemAllocPolicy>;
+  static constexpr uint32_t PretenureHintMaxEntries = 10000;
+  PretenureHintSet pretenureHintSet_;
+
+  HashNumber getAllocSiteKey(JSScript* script, uint32_t pcOffset) const;
+
   void updateAsRecentlyUsed(IonHint* hint);
   IonHint* addIonHint(ScriptKey key, ScriptToHintMap::AddPtr& p);
 
@@ -167,6 +202,26 @@ class JitHintsMap {
   bool hasMonomorphicInlineHintAtOffset(JSScript* script, uint32_t offset);
 
   void recordInvalidation(JSScript* script);
+
+  void setPretenuredAllocSiteHint(JSScript* script, uint32_t pcOffset);
+  void clearPretenuredAllocSiteHint(JSScript* script, uint32_t pcOffset);
+  bool hasPretenuredAllocSiteHint(JSScript* script, uint32_t pcOffset) const;
+
+  bool addPretenureHintKey(HashNumber key);
+
+  [[nodiscard]] bool encode(JS::TranscodeBuffer& buffer) const;
+
+  // Returns TranscodeResult::Throw on OOM without reporting it.
+  [[nodiscard]] JS::TranscodeResult decode(const JS::TranscodeRange& range);
+  template <typename F>
+  bool forEachPretenureHintKey(F&& f) const {
+    for (auto r = pretenureHintSet_.all(); !r.empty(); r.popFront()) {
+      if (!f(r.front())) {
+        return false;
+      }
+    }
+    return true;
+  }
 };
 
 }  // namespace js::jit
@@ -256,6 +256,16 @@ DefaultJitOptions::DefaultJitOptions() {
   // Duplicated in all.js - ensure both match.
   SET_DEFAULT(frequentBailoutThreshold, 10);
 
+  // Number of bailout-triggered invalidations of a script after which each
+  // further invalidation suspends Ion compilation of the script for
+  // thrashingBackoffMs milliseconds. Zero disables the back-off.
+  SET_DEFAULT(thrashingInvalidationThreshold, 8);
+  SET_DEFAULT(thrashingBackoffMs, 1000);
+
+  // Ion code that hasn't been entered for this many seconds is discarded on
+  // GCs that otherwise preserve JIT code. Zero disables tracking Ion entries.
+  SET_DEFAULT(coldIonCodeDiscardSeconds, 0);
+
   // Whether to run all debug checks in debug builds.
   // Disabling might make it more enjoyable to run JS in debug builds.
   SET_DEFAULT(fullDebugChecks, true);
@@ -306,6 +316,10 @@ DefaultJitOptions::DefaultJitOptions() {
     }
   }
 
+  // Number of LIR instructions above which Ion uses the fast register
+  // allocator, unless an allocator has been forced.
+  SET_DEFAULT(fastRegAllocThreshold, 100 * 1000);
+
 #if defined(JS_CODEGEN_MIPS64) || defined(JS_CODEGEN_LOONG64) || \
     defined(JS_CODEGEN_RISCV64)
   SET_DEFAULT(spectreIndexMasking, false);
@@ -370,6 +384,11 @@ DefaultJitOptions::DefaultJitOptions() {
   SET_DEFAULT(wasmBatchBaselineThreshold, 25000);
   SET_DEFAULT(wasmBatchIonThreshold, 1100);
 
+  // How many stacks of dead JSPI suspenders a context keeps for reuse, and how
+  // many of those survive a non-shrinking GC.
+  SET_DEFAULT(wasmSuspendableStackPoolMax, 8);
+  SET_DEFAULT(wasmSuspendableStackPoolLowWater, 2);
+
   // Controls how much assertion checking code is emitted
   SET_DEFAULT(lessDebugCode, false);
 
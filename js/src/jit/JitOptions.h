@@ -19,6 +19,9 @@ namespace jit {
 enum IonRegisterAllocator {
   RegisterAllocator_Backtracking,
   RegisterAllocator_Testbed,
+  // Backtracking allocator without eviction or use-based splitting, which
+  // trades some code quality for compile time on very large graphs.
+  RegisterAllocator_Fast,
 };
 
 // Which register to use as base register to access stack slots: frame pointer,
@@ -40,6 +43,9 @@ static inline mozilla::Maybe<IonRegisterAllocator> LookupRegisterAllocator(
   if (!strcmp(name, "testbed")) {
     return mozilla::Some(RegisterAllocator_Testbed);
   }
+  if (!strcmp(name, "fast")) {
+    return mozilla::Some(RegisterAllocator_Fast);
+  }
   return mozilla::Nothing();
 }
 
@@ -110,6 +116,9 @@ struct DefaultJitOptions {
 #endif
   uint32_t exceptionBailoutThreshold;
   uint32_t frequentBailoutThreshold;
+  uint32_t thrashingInvalidationThreshold;
+  uint32_t thrashingBackoffMs;
+  uint32_t coldIonCodeDiscardSeconds;
   uint32_t maxStackArgs;
   uint32_t osrPcMismatchesBeforeRecompile;
   uint32_t smallFunctionMaxBytecodeLength;
@@ -126,7 +135,10 @@ struct DefaultJitOptions {
   uint32_t ionMaxLocalsAndArgsMainThread;
   uint32_t wasmBatchBaselineThreshold;
   uint32_t wasmBatchIonThreshold;
+  uint32_t wasmSuspendableStackPoolMax;
+  uint32_t wasmSuspendableStackPoolLowWater;
   mozilla::Maybe<IonRegisterAllocator> forcedRegisterAllocator;
+  uint32_t fastRegAllocThreshold;
 #ifdef ENABLE_JS_AOT_ICS
   bool enableAOTICs;
   bool enableAOTICEnforce;
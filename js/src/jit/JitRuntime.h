@@ -134,6 +134,14 @@ class JitRuntime {
   // tasks into a single IonFreeTask.
   MainThreadData<IonFreeCompileTasks> ionFreeTaskBatch_;
 
+  // LifoAllocs of finished Ion compile tasks, kept for reuse by later
+  // compilations so that their chunks aren't returned to malloc just to be
+  // allocated again. Emptied on shrinking GCs.
+  static constexpr size_t MaxCachedIonLifoAllocs = 2;
+  using IonLifoAllocCache =
+      Vector<UniquePtr<LifoAlloc>, MaxCachedIonLifoAllocs, SystemAllocPolicy>;
+  MainThreadData<IonLifoAllocCache> ionLifoAllocCache_;
+
   // Shared exception-handler tail.
   WriteOnceData<uint32_t> exceptionTailOffset_{0};
   WriteOnceData<uint32_t> exceptionTailReturnValueCheckOffset_{0};
@@ -210,6 +218,12 @@ class JitRuntime {
   // for external profiling to identify which functions are being interpreted.
   MainThreadData<EntryTrampolineMap*> interpreterEntryMap_{nullptr};
 
+  // Number of Ion bailouts of each kind. See JS::GetJitBailoutKindCounts.
+  using BailoutKindCountArray =
+      mozilla::EnumeratedArray<BailoutKind, uint64_t,
+                               size_t(BailoutKind::Limit)>;
+  MainThreadData<BailoutKindCountArray> bailoutKindCounts_{};
+
 #ifdef DEBUG
   // The number of possible bailing places encountered before forcefully bailing
   // in that place if the counter reaches zero. Note that zero also means
@@ -337,6 +351,11 @@ class JitRuntime {
   }
   void maybeStartIonFreeTask(bool force);
 
+  // Move the LifoAllocs of some of |tasks| into the reuse cache, freeing the
+  // rest of these tasks. The tasks are removed from |tasks|.
+  void cacheIonLifoAllocs(IonFreeCompileTasks& tasks);
+  void purgeIonLifoAllocCache();
+
   UniquePtr<LifoAlloc> tryReuseIonLifoAlloc();
 
 #ifdef DEBUG
@@ -471,6 +490,13 @@ class JitRuntime {
     return jitHintsMap_;
   }
 
+  void incBailoutKindCount(BailoutKind kind) {
+    bailoutKindCounts_.ref()[kind]++;
+  }
+  uint64_t bailoutKindCount(BailoutKind kind) const {
+    return bailoutKindCounts_.ref()[kind];
+  }
+
   bool hasInterpreterEntryMap() const {
     return interpreterEntryMap_ != nullptr;
   }
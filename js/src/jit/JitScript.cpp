@@ -15,6 +15,8 @@
 #include "jit/BaselineJIT.h"
 #include "jit/BytecodeAnalysis.h"
 #include "jit/IonScript.h"
+#include "jit/JitHints.h"
+#include "jit/JitRuntime.h"
 #include "jit/JitFrames.h"
 #include "jit/JitSpewer.h"
 #include "jit/ScriptFromCalleeToken.h"
@@ -723,6 +725,26 @@ void jit::JitSpewBaselineICStats(JSScript* script, const char* dumpReason) {
   }
   spew->endList();
 }
+
+void jit::JitSpewCompileEvent(JSContext* cx, JSScript* script,
+                              const char* event, const char* tier,
+                              mozilla::TimeDuration compileTime,
+                              size_t codeSize) {
+  AutoStructuredSpewer spew(cx, SpewChannel::JitCompiles, script);
+  if (!spew) {
+    return;
+  }
+
+  spew->property("event", event);
+  spew->property("tier", tier);
+  spew->property("bytecodeLength", uint32_t(script->length()));
+  if (compileTime) {
+    spew->property("compileTime", compileTime, JSONPrinter::MICROSECONDS);
+  }
+  if (codeSize) {
+    spew->property("codeSize", uint64_t(codeSize));
+  }
+}
 #endif
 
 using StubHashMap = HashMap<ICCacheIRStub*, ICCacheIRStub*,
@@ -866,6 +888,13 @@ gc::AllocSite* ICScript::getOrCreateAllocSite(JSScript* outerScript,
 
   nursery.noteAllocSiteCreated();
 
+  JitRuntime* jitRuntime = outerScript->runtimeFromMainThread()->jitRuntime();
+  if (jitRuntime->hasJitHintsMap() &&
+      jitRuntime->getJitHintsMap()->hasPretenuredAllocSiteHint(outerScript,
+                                                               pcOffset)) {
+    site->initStateFromPretenuringHint();
+  }
+
   return site;
 }
 
@@ -14,6 +14,7 @@
 #include "mozilla/LinkedList.h"
 #include "mozilla/Maybe.h"
 #include "mozilla/MemoryReporting.h"
+#include "mozilla/TimeStamp.h"
 
 #include <stddef.h>
 #include <stdint.h>
@@ -372,6 +373,16 @@ class alignas(uintptr_t) JitScript final
   // used for Ion hints.
   uint32_t warmUpCountAtLastICStub_ = 0;
 
+  // Counters used to find scripts stuck in bailout and invalidation loops.
+  // See JS::GetJitThrashingScripts.
+  uint32_t numBailouts_ = 0;
+  uint32_t numBailoutInvalidations_ = 0;
+  uint32_t numIonCompiles_ = 0;
+
+  // If set, Ion compilation of this script is suspended until this time
+  // because its Ion code was invalidated after bailouts too often.
+  mozilla::TimeStamp ionBackoffEnd_;
+
   ICScript icScript_;
   // End of fields.
 
@@ -470,6 +481,18 @@ class alignas(uintptr_t) JitScript final
   void updateLastICStubCounter() { warmUpCountAtLastICStub_ = warmUpCount(); }
   uint32_t warmUpCountAtLastICStub() const { return warmUpCountAtLastICStub_; }
 
+  uint32_t numBailouts() const { return numBailouts_; }
+  void incNumBailouts() { numBailouts_++; }
+  uint32_t numBailoutInvalidations() const { return numBailoutInvalidations_; }
+  void incNumBailoutInvalidations() { numBailoutInvalidations_++; }
+  uint32_t numIonCompiles() const { return numIonCompiles_; }
+  void incNumIonCompiles() { numIonCompiles_++; }
+
+  void setIonBackoffEnd(mozilla::TimeStamp end) { ionBackoffEnd_ = end; }
+  bool isInIonBackoff(mozilla::TimeStamp now) const {
+    return !ionBackoffEnd_.IsNull() && now < ionBackoffEnd_;
+  }
+
  private:
   // Methods to set baselineScript_ to a BaselineScript*, nullptr, or
   // BaselineDisabledScriptPtr.
@@ -505,6 +528,10 @@ class alignas(uintptr_t) JitScript final
   bool isBaselineQueued() const {
     return baselineScript_ == BaselineQueuedScriptPtr;
   }
+  void setIsBaselineQueued(JSScript* script) {
+    MOZ_ASSERT(baselineScript_ == nullptr);
+    setBaselineScriptImpl(script, BaselineQueuedScriptPtr);
+  }
   void clearIsBaselineQueued(JSScript* script) {
     MOZ_ASSERT(isBaselineQueued());
     setBaselineScriptImpl(script, nullptr);
@@ -622,6 +649,13 @@ void MarkActiveICScriptsAndCopyStubs(Zone* zone, ICStubSpace& newStubSpace);
 
 #ifdef JS_STRUCTURED_SPEW
 void JitSpewBaselineICStats(JSScript* script, const char* dumpReason);
+
+// Emit one record on the JitCompiles channel for a compilation or
+// invalidation of |script|. |compileTime| and |codeSize| are omitted from the
+// record when zero.
+void JitSpewCompileEvent(JSContext* cx, JSScript* script, const char* event,
+                         const char* tier, mozilla::TimeDuration compileTime,
+                         size_t codeSize);
 #endif
 
 }  // namespace jit
@@ -235,11 +235,17 @@ const JitcodeGlobalEntry* JitcodeGlobalTable::lookupForSampler(
 
 JitcodeGlobalEntry* JitcodeGlobalTable::lookupInternal(void* ptr) {
   // Search for an entry containing the one-byte range starting at |ptr|.
+  JitcodeGlobalEntry*& cached = lookupCache_[lookupCacheIndex(ptr)];
+  if (cached && cached->containsPointer(ptr)) {
+    return cached;
+  }
+
   JitCodeRange range(ptr, static_cast<uint8_t*>(ptr) + 1);
 
   if (JitCodeRange** entry = tree_.maybeLookup(&range)) {
     MOZ_ASSERT((*entry)->containsPointer(ptr));
-    return static_cast<JitcodeGlobalEntry*>(*entry);
+    cached = static_cast<JitcodeGlobalEntry*>(*entry);
+    return cached;
   }
 
   return nullptr;
@@ -341,6 +347,9 @@ bool JitcodeGlobalTable::markIteratively(GCMarker* marker) {
 void JitcodeGlobalTable::traceWeak(JSRuntime* rt, JSTracer* trc) {
   AutoSuppressProfilerSampling suppressSampling(rt->mainContextFromOwnThread());
 
+  // Entries removed below may be in the lookup cache.
+  clearLookupCache();
+
   entries_.eraseIf([&](auto& entry) {
     if (!entry->zone()->isCollecting() || entry->zone()->isGCFinished()) {
       return false;
@@ -7,7 +7,8 @@
 #ifndef jit_JitcodeMap_h
 #define jit_JitcodeMap_h
 
-#include "mozilla/Assertions.h"  // MOZ_ASSERT, MOZ_ASSERT_IF, MOZ_CRASH
+#include "mozilla/Assertions.h"     // MOZ_ASSERT, MOZ_ASSERT_IF, MOZ_CRASH
+#include "mozilla/HashFunctions.h"  // mozilla::HashGeneric
 
 #include <stddef.h>  // size_t
 #include <stdint.h>  // uint8_t, uint32_t, uint64_t
@@ -448,6 +449,23 @@ class JitcodeGlobalTable {
   LifoAlloc alloc_;
   EntryTree tree_;
 
+  // Direct-mapped cache of recent lookups, in front of the AVL tree. The
+  // profiler samples the same return addresses over and over, so most sampler
+  // lookups hit here instead of walking the tree. Entries are owned by
+  // |entries_| and their addresses are stable, so the cache only has to be
+  // cleared when entries are removed.
+  static const size_t LookupCacheSize = 64;
+  JitcodeGlobalEntry* lookupCache_[LookupCacheSize] = {};
+
+  static size_t lookupCacheIndex(void* ptr) {
+    return mozilla::HashGeneric(ptr) % LookupCacheSize;
+  }
+  void clearLookupCache() {
+    for (JitcodeGlobalEntry*& entry : lookupCache_) {
+      entry = nullptr;
+    }
+  }
+
  public:
   JitcodeGlobalTable()
       : alloc_(LIFO_CHUNK_SIZE, js::BackgroundMallocArena), tree_(&alloc_) {}
@@ -3754,6 +3754,15 @@ void LIRGenerator::visitWasmAnyRefJSStringLength(
   define(lir, ins);
 }
 
+void LIRGenerator::visitWasmAnyRefJSStringCharAt(
+    MWasmAnyRefJSStringCharAt* ins) {
+  LWasmAnyRefJSStringCharAt* lir = new (alloc())
+      LWasmAnyRefJSStringCharAt(useRegister(ins->input()),
+                                useRegister(ins->index()), temp(), temp(),
+                                temp());
+  define(lir, ins);
+}
+
 void LIRGenerator::visitWasmNewI31Ref(MWasmNewI31Ref* ins) {
   // If it's a constant, it will be put directly into the register.
   LWasmNewI31Ref* lir =
@@ -5266,6 +5275,19 @@ void LIRGenerator::visitStoreTypedArrayElementHole(
   }
 }
 
+void LIRGenerator::visitTypedArraySet(MTypedArraySet* ins) {
+  MOZ_ASSERT(ins->target()->type() == MIRType::Object);
+  MOZ_ASSERT(ins->source()->type() == MIRType::Object);
+  MOZ_ASSERT(ins->offset()->type() == MIRType::IntPtr);
+
+  auto* lir = new (alloc())
+      LTypedArraySet(useRegister(ins->target()), useRegister(ins->source()),
+                     useRegister(ins->offset()), temp(), temp());
+  assignSnapshot(lir, ins->bailoutKind());
+  add(lir, ins);
+  assignSafepoint(lir, ins);
+}
+
 void LIRGenerator::visitLoadScriptedProxyHandler(
     MLoadScriptedProxyHandler* ins) {
   LLoadScriptedProxyHandler* lir = new (alloc())
@@ -7135,6 +7157,11 @@ void LIRGenerator::visitIncrementWarmUpCounter(MIncrementWarmUpCounter* ins) {
   add(lir, ins);
 }
 
+void LIRGenerator::visitMarkIonScriptEntered(MMarkIonScriptEntered* ins) {
+  auto* lir = new (alloc()) LMarkIonScriptEntered(temp());
+  add(lir, ins);
+}
+
 void LIRGenerator::visitLexicalCheck(MLexicalCheck* ins) {
   MDefinition* input = ins->input();
   MOZ_ASSERT(input->type() == MIRType::Value);
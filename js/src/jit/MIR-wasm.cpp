@@ -284,6 +284,14 @@ bool MWasmAlignmentCheck::congruentTo(const MDefinition* ins) const {
   return byteSize_ == check->byteSize() && congruentIfOperandsEqual(check);
 }
 
+bool MWasmAnyRefJSStringCharAt::congruentTo(const MDefinition* ins) const {
+  if (!ins->isWasmAnyRefJSStringCharAt()) {
+    return false;
+  }
+  const MWasmAnyRefJSStringCharAt* charAt = ins->toWasmAnyRefJSStringCharAt();
+  return codePoint() == charAt->codePoint() && congruentIfOperandsEqual(charAt);
+}
+
 MDefinition::AliasType MAsmJSLoadHeap::mightAlias(
     const MDefinition* def) const {
   if (def->isAsmJSStoreHeap()) {
@@ -705,8 +705,8 @@ class MWasmHeapReg : public MNullaryInstruction {
 class MWasmBoundsCheck : public MBinaryInstruction, public NoTypePolicy::Data {
  public:
   enum Target {
-    // Linear memory at index zero, which is the only memory allowed so far.
-    Memory0,
+    // A linear memory, identified by memoryIndex().
+    Memory,
     // Everything else.  Currently comprises tables, and arrays in the GC
     // proposal.
     Unknown
@@ -715,14 +715,17 @@ class MWasmBoundsCheck : public MBinaryInstruction, public NoTypePolicy::Data {
  private:
   wasm::TrapSiteDesc trapSiteDesc_;
   Target target_;
+  uint32_t memoryIndex_;
 
   explicit MWasmBoundsCheck(MDefinition* index, MDefinition* boundsCheckLimit,
                             const wasm::TrapSiteDesc& trapSiteDesc,
-                            Target target)
+                            Target target, uint32_t memoryIndex = 0)
       : MBinaryInstruction(classOpcode, index, boundsCheckLimit),
         trapSiteDesc_(trapSiteDesc),
-        target_(target) {
+        target_(target),
+        memoryIndex_(memoryIndex) {
     MOZ_ASSERT(index->type() == boundsCheckLimit->type());
+    MOZ_ASSERT_IF(target != Memory, memoryIndex == 0);
 
     // Bounds check is effectful: it throws for OOB.
     setGuard();
@@ -739,7 +742,11 @@ class MWasmBoundsCheck : public MBinaryInstruction, public NoTypePolicy::Data {
 
   AliasSet getAliasSet() const override { return AliasSet::None(); }
 
-  bool isMemory0() const { return target_ == MWasmBoundsCheck::Memory0; }
+  bool isMemory() const { return target_ == MWasmBoundsCheck::Memory; }
+  uint32_t memoryIndex() const {
+    MOZ_ASSERT(isMemory());
+    return memoryIndex_;
+  }
 
   bool isRedundant() const { return !isGuard(); }
 
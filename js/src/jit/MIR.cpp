@@ -5887,6 +5887,11 @@ JSObject* MObjectState::templateObjectOf(MDefinition* obj) {
     return obj->toNewObject()->templateObject();
   } else if (obj->isNewCallObject()) {
     return obj->toNewCallObject()->templateObject();
+  } else if (obj->isNewLexicalEnvironmentObject()) {
+    return &obj->toNewLexicalEnvironmentObject()
+                ->templateObj()
+                ->toConstant()
+                ->toObject();
   } else if (obj->isNewIterator()) {
     return obj->toNewIterator()->templateObject();
   }
@@ -5928,7 +5933,9 @@ void MObjectState::initFromTemplateObject(TempAllocator& alloc,
   for (size_t i = 0; i < numSlots(); i++) {
     Value val = nativeObject.getSlot(i);
     MDefinition* def = undefinedVal;
-    if (!val.isUndefined()) {
+    // Private slots can't be represented by MConstant. They are never
+    // accessed from MIR (see IsObjectEscaped) and RObjectState skips them.
+    if (!val.isUndefined() && !val.isPrivateGCThing()) {
       MConstant* ins = MConstant::New(alloc, val);
       block()->insertBefore(this, ins);
       def = ins;
@@ -6562,6 +6569,10 @@ AliasSet MArrayPush::getAliasSet() const {
   return AliasSet::Store(AliasSet::ObjectFields | AliasSet::Element);
 }
 
+AliasSet MTypedArraySet::getAliasSet() const {
+  return AliasSet::Store(AliasSet::UnboxedElement);
+}
+
 MDefinition* MGuardNumberToIntPtrIndex::foldsTo(TempAllocator& alloc) {
   MDefinition* input = this->input();
 
@@ -4340,6 +4340,8 @@ class MUrsh : public MShiftInstruction {
 
   void computeRange(TempAllocator& alloc) override;
   void collectRangeInfoPreTrunc() override;
+  bool canTruncate() const override;
+  void truncate(TruncateKind kind) override;
 
   [[nodiscard]] bool writeRecoverData(
       CompactBufferWriter& writer) const override;
@@ -3141,6 +3141,70 @@ void MacroAssembler::emitMegamorphicCacheLookupExists(
   bind(&cacheMissWithEntry);
 }
 
+void MacroAssembler::emitDictionaryPropMapLookup(Register obj, Register id,
+                                                 Register scratch1,
+                                                 Register scratch2,
+                                                 ValueOperand output,
+                                                 Label* notFound) {
+  // scratch2 = shape->propMap_. Dictionary shapes always have a map.
+  loadPtr(Address(obj, JSObject::offsetOfShape()), scratch1);
+  loadPtr(Address(scratch1, NativeShape::offsetOfPropMap()), scratch2);
+  branchTestPtr(Assembler::Zero, scratch2, scratch2, notFound);
+  branchTestPtr(Assembler::Zero,
+                Address(scratch2, PropMap::offsetOfHeaderFlags()),
+                Imm32(PropMap::isDictionaryFlag()), notFound);
+
+  // scratch1 = shape->propMapLength()
+  load32(Address(scratch1, Shape::offsetOfImmutableFlags()), scratch1);
+  and32(Imm32(NativeShape::propMapLengthMask()), scratch1);
+
+  // Compare |id| against the map's keys. Removed properties leave a void key,
+  // which never matches.
+  Label found[PropMap::Capacity];
+  for (uint32_t i = 0; i < PropMap::Capacity; i++) {
+    branch32(Assembler::BelowOrEqual, scratch1, Imm32(i), notFound);
+    Address key(scratch2, PropMap::offsetOfKeys() + i * sizeof(PropertyKey));
+    branchPtr(Assembler::Equal, key, id, &found[i]);
+  }
+  jump(notFound);
+
+  // scratch1 = propInfos[i]
+  Label loadSlot;
+  for (uint32_t i = 0; i < PropMap::Capacity; i++) {
+    bind(&found[i]);
+    load32(Address(scratch2, DictionaryPropMap::offsetOfPropInfos() +
+                                 i * sizeof(PropertyInfo)),
+           scratch1);
+    if (i + 1 < PropMap::Capacity) {
+      jump(&loadSlot);
+    }
+  }
+  bind(&loadSlot);
+
+  branchTest32(Assembler::NonZero, scratch1,
+               Imm32(PropertyInfo::nonDataPropertyFlags()), notFound);
+  rshift32(Imm32(PropertyInfo::slotShift()), scratch1);
+
+  // scratch2 = numFixedSlots
+  loadPtr(Address(obj, JSObject::offsetOfShape()), scratch2);
+  load32(Address(scratch2, Shape::offsetOfImmutableFlags()), scratch2);
+  and32(Imm32(NativeShape::fixedSlotsMask()), scratch2);
+  rshift32(Imm32(NativeShape::fixedSlotsShift()), scratch2);
+
+  Label dynamicSlot, done;
+  branch32(Assembler::AboveOrEqual, scratch1, scratch2, &dynamicSlot);
+  loadValue(BaseValueIndex(obj, scratch1, NativeObject::getFixedSlotOffset(0)),
+            output);
+  jump(&done);
+
+  bind(&dynamicSlot);
+  sub32(scratch2, scratch1);
+  loadPtr(Address(obj, NativeObject::offsetOfSlots()), scratch2);
+  loadValue(BaseValueIndex(scratch2, scratch1), output);
+
+  bind(&done);
+}
+
 void MacroAssembler::extractCurrentIndexAndKindFromIterator(Register iterator,
                                                             Register outIndex,
                                                             Register outKind) {
@@ -5844,6 +5908,42 @@ static ReturnCallTrampolineData MakeReturnCallTrampoline(MacroAssembler& masm) {
 // For cross-instance calls, the trampoline frame will be introduced
 // if the C0 callsite has no ability to restore instance registers and realm.
 
+#ifndef JS_USE_LINK_REGISTER
+// When the caller and the callee need the same amount of stack for instance
+// slots and stack arguments, the Frame and the caller instance slot are
+// already where the callee expects them. Only the stack arguments and the
+// callee instance slot have to be written before the frame is popped, and the
+// return address never has to move.
+static void CollapseWasmFrameInPlace(
+    MacroAssembler& masm, const ReturnCallAdjustmentInfo& retCallInfo) {
+  uint32_t framePushedAtStart = masm.framePushed();
+  static constexpr Register tempForFP = WasmTailCallFPScratchReg;
+
+  int32_t newArgSrc = -framePushedAtStart;
+  int32_t newArgDest = sizeof(wasm::Frame);
+  const uint32_t SlotsSize =
+      wasm::FrameWithInstances::sizeOfInstanceFieldsAndShadowStack();
+  MoveDataBlock(masm, FramePointer, newArgSrc + SlotsSize,
+                newArgDest + SlotsSize,
+                retCallInfo.newSlotsAndStackArgBytes - SlotsSize);
+
+  // Store current instance as the new callee instance slot.
+  masm.storePtr(
+      InstanceReg,
+      Address(FramePointer, newArgDest + WasmCalleeInstanceOffsetBeforeCall));
+
+  // Pop the frame, leaving RA on top of the stack, and restore FP.
+  masm.loadPtr(Address(FramePointer, wasm::Frame::callerFPOffset()), tempForFP);
+  masm.addToStackPtr(
+      Imm32(framePushedAtStart + wasm::Frame::returnAddressOffset()));
+  masm.append(wasm::CodeRangeUnwindInfo::RestoreFp, masm.currentOffset());
+  masm.movePtr(tempForFP, FramePointer);
+  // Setting framePushed to pre-collapse state, to properly set that in the
+  // following code.
+  masm.setFramePushed(framePushedAtStart);
+}
+#endif
+
 static void CollapseWasmFrameFast(MacroAssembler& masm,
                                   const ReturnCallAdjustmentInfo& retCallInfo) {
   uint32_t framePushedAtStart = masm.framePushed();
@@ -5858,6 +5958,13 @@ static void CollapseWasmFrameFast(MacroAssembler& masm,
   uint32_t oldSlotsAndStackArgBytes =
       AlignBytes(retCallInfo.oldSlotsAndStackArgBytes, WasmStackAlignment);
 
+#ifndef JS_USE_LINK_REGISTER
+  if (newSlotsAndStackArgBytes == oldSlotsAndStackArgBytes) {
+    CollapseWasmFrameInPlace(masm, retCallInfo);
+    return;
+  }
+#endif
+
   static constexpr Register tempForCaller = WasmTailCallInstanceScratchReg;
   static constexpr Register tempForFP = WasmTailCallFPScratchReg;
   static constexpr Register tempForRA = WasmTailCallRAScratchReg;
@@ -6355,20 +6462,39 @@ void MacroAssembler::wasmCallIndirect(const wasm::CallSiteDesc& desc,
   // Load the callee instance and decide whether to take the fast path or the
   // slow path.
 
-  Label fastCall;
+  Label slowCall;
   Label done;
   const Register newInstanceTemp = WasmTableCallScratchReg1;
   loadPtr(Address(calleeScratch, offsetof(wasm::FunctionTableElem, instance)),
           newInstanceTemp);
-  branchPtr(Assembler::Equal, InstanceReg, newInstanceTemp, &fastCall);
+  branchPtr(Assembler::NotEqual, InstanceReg, newInstanceTemp, &slowCall);
+
+  // Fast path: just load the code pointer and go.  The instance and heap
+  // register are the same as in the caller, and nothing will be null.
+  //
+  // (In particular, the code pointer will not be null: if it were, the instance
+  // would have been null, and then it would not have been equivalent to our
+  // current instance.  So no null check is needed on the fast path.)
+  //
+  // The fast path falls through from the instance check so that same-instance
+  // calls, which dominate in practice, keep their code dense and get the
+  // static prediction for forward conditional branches (not taken).
+
+  loadPtr(Address(calleeScratch, offsetof(wasm::FunctionTableElem, code)),
+          calleeScratch);
+
+  // We use a different type of call site for the fast call since the instance
+  // slots in the frame do not have valid values.
+
+  wasm::CallSiteDesc newDesc(desc.lineOrBytecode(),
+                             wasm::CallSiteKind::IndirectFast);
+  *fastCallOffset = call(newDesc, calleeScratch);
+  jump(&done);
 
   // Slow path: Save context, check for null, setup new context, call, restore
   // context.
-  //
-  // TODO: The slow path could usefully be out-of-line and the test above would
-  // just fall through to the fast path.  This keeps the fast-path code dense,
-  // and has correct static prediction for the branch (forward conditional
-  // branches predicted not taken, normally).
+
+  bind(&slowCall);
 
   storePtr(InstanceReg,
            Address(getStackPointer(), WasmCallerInstanceOffsetBeforeCall));
@@ -6401,26 +6527,6 @@ void MacroAssembler::wasmCallIndirect(const wasm::CallSiteDesc& desc,
           InstanceReg);
   loadWasmPinnedRegsFromInstance(mozilla::Nothing());
   switchToWasmInstanceRealm(ABINonArgReturnReg0, ABINonArgReturnReg1);
-  jump(&done);
-
-  // Fast path: just load the code pointer and go.  The instance and heap
-  // register are the same as in the caller, and nothing will be null.
-  //
-  // (In particular, the code pointer will not be null: if it were, the instance
-  // would have been null, and then it would not have been equivalent to our
-  // current instance.  So no null check is needed on the fast path.)
-
-  bind(&fastCall);
-
-  loadPtr(Address(calleeScratch, offsetof(wasm::FunctionTableElem, code)),
-          calleeScratch);
-
-  // We use a different type of call site for the fast call since the instance
-  // slots in the frame do not have valid values.
-
-  wasm::CallSiteDesc newDesc(desc.lineOrBytecode(),
-                             wasm::CallSiteKind::IndirectFast);
-  *fastCallOffset = call(newDesc, calleeScratch);
 
   bind(&done);
 }
@@ -6551,7 +6657,7 @@ void MacroAssembler::wasmCallRef(const wasm::CallSiteDesc& desc,
   // whether to take the fast path or the slow path. Register this load
   // instruction to be source of a trap -- null pointer check.
 
-  Label fastCall;
+  Label slowCall;
   Label done;
   const Register newInstanceTemp = WasmCallRefCallScratchReg1;
   size_t instanceSlotOffset = FunctionExtended::offsetOfExtendedSlot(
@@ -6562,7 +6668,28 @@ void MacroAssembler::wasmCallRef(const wasm::CallSiteDesc& desc,
   append(wasm::Trap::NullPointerDereference,
          wasm::TrapSite(wasm::TrapMachineInsnForLoadWord(), fco,
                         desc.toTrapSiteDesc()));
-  branchPtr(Assembler::Equal, InstanceReg, newInstanceTemp, &fastCall);
+  branchPtr(Assembler::NotEqual, InstanceReg, newInstanceTemp, &slowCall);
+
+  // Fast path: just load WASM_FUNC_UNCHECKED_ENTRY_SLOT value and go.
+  // The instance and pinned registers are the same as in the caller.  As for
+  // call_indirect, this path is the fall-through from the instance check.
+
+  size_t uncheckedEntrySlotOffset = FunctionExtended::offsetOfExtendedSlot(
+      FunctionExtended::WASM_FUNC_UNCHECKED_ENTRY_SLOT);
+  loadPtr(Address(calleeFnObj, uncheckedEntrySlotOffset), calleeScratch);
+
+  // We use a different type of call site for the fast call since the instance
+  // slots in the frame do not have valid values.
+
+  wasm::CallSiteDesc newDesc(desc.lineOrBytecode(),
+                             wasm::CallSiteKind::FuncRefFast);
+  *fastCallOffset = call(newDesc, calleeScratch);
+  jump(&done);
+
+  // Slow path: switch to the callee's instance and realm, call, and switch
+  // back.
+
+  bind(&slowCall);
 
   storePtr(InstanceReg,
            Address(getStackPointer(), WasmCallerInstanceOffsetBeforeCall));
@@ -6576,8 +6703,6 @@ void MacroAssembler::wasmCallRef(const wasm::CallSiteDesc& desc,
 
   // Get funcUncheckedCallEntry() from the function's
   // WASM_FUNC_UNCHECKED_ENTRY_SLOT extended slot.
-  size_t uncheckedEntrySlotOffset = FunctionExtended::offsetOfExtendedSlot(
-      FunctionExtended::WASM_FUNC_UNCHECKED_ENTRY_SLOT);
   loadPtr(Address(calleeFnObj, uncheckedEntrySlotOffset), calleeScratch);
 
   *slowCallOffset = wasmMarkedSlowCall(desc, calleeScratch);
@@ -6587,21 +6712,6 @@ void MacroAssembler::wasmCallRef(const wasm::CallSiteDesc& desc,
           InstanceReg);
   loadWasmPinnedRegsFromInstance(mozilla::Nothing());
   switchToWasmInstanceRealm(ABINonArgReturnReg0, ABINonArgReturnReg1);
-  jump(&done);
-
-  // Fast path: just load WASM_FUNC_UNCHECKED_ENTRY_SLOT value and go.
-  // The instance and pinned registers are the same as in the caller.
-
-  bind(&fastCall);
-
-  loadPtr(Address(calleeFnObj, uncheckedEntrySlotOffset), calleeScratch);
-
-  // We use a different type of call site for the fast call since the instance
-  // slots in the frame do not have valid values.
-
-  wasm::CallSiteDesc newDesc(desc.lineOrBytecode(),
-                             wasm::CallSiteKind::FuncRefFast);
-  *fastCallOffset = call(newDesc, calleeScratch);
 
   bind(&done);
 }
@@ -7276,8 +7386,9 @@ void MacroAssembler::wasmNewStructObject(Register instance, Register result,
 
   // If the alloc site is long lived, immediately fall back to the OOL path,
   // which will handle that.
-  loadPtr(Address(typeDefData, wasm::TypeDefInstanceData::offsetOfAllocSite()),
-          temp1);
+  computeEffectiveAddress(
+      Address(typeDefData, wasm::TypeDefInstanceData::offsetOfAllocSite()),
+      temp1);
   branchTestPtr(Assembler::NonZero,
                 Address(temp1, gc::AllocSite::offsetOfScriptAndState()),
                 Imm32(gc::AllocSite::LONG_LIVED_BIT), fail);
@@ -7324,8 +7435,9 @@ void MacroAssembler::wasmNewArrayObject(Register instance, Register result,
 
   // If the alloc site is long lived, immediately fall back to the OOL path,
   // which will handle that.
-  loadPtr(Address(typeDefData, wasm::TypeDefInstanceData::offsetOfAllocSite()),
-          temp);
+  computeEffectiveAddress(
+      Address(typeDefData, wasm::TypeDefInstanceData::offsetOfAllocSite()),
+      temp);
   branchTestPtr(Assembler::NonZero,
                 Address(temp, gc::AllocSite::offsetOfScriptAndState()),
                 Imm32(gc::AllocSite::LONG_LIVED_BIT), fail);
@@ -7482,8 +7594,9 @@ void MacroAssembler::wasmNewArrayObjectFixed(Register instance, Register result,
 
   // If the alloc site is long lived, immediately fall back to the OOL path,
   // which will handle that.
-  loadPtr(Address(typeDefData, wasm::TypeDefInstanceData::offsetOfAllocSite()),
-          temp1);
+  computeEffectiveAddress(
+      Address(typeDefData, wasm::TypeDefInstanceData::offsetOfAllocSite()),
+      temp1);
   branchTestPtr(Assembler::NonZero,
                 Address(temp1, gc::AllocSite::offsetOfScriptAndState()),
                 Imm32(gc::AllocSite::LONG_LIVED_BIT), fail);
@@ -5702,6 +5702,14 @@ class MacroAssembler : public MacroAssemblerSpecific {
                                         Register outEntryPtr, Register output,
                                         Label* cacheHit, bool hasOwn);
 
+  // Load the value of the own data property |id| of |obj| into |output| if
+  // |obj| is in dictionary mode and the property is in its first property map.
+  // Otherwise jump to |notFound|. |obj| must be a native object and |id| must
+  // hold the property key's bits. |output| may alias |id|.
+  void emitDictionaryPropMapLookup(Register obj, Register id,
+                                   Register scratch1, Register scratch2,
+                                   ValueOperand output, Label* notFound);
+
   // Given a PropertyIteratorObject with valid indices, extract the current
   // PropertyIndex, storing the index in |outIndex| and the kind in |outKind|
   void extractCurrentIndexAndKindFromIterator(Register iterator,
@@ -396,8 +396,10 @@ void IonPerfSpewer::recordInstruction(MacroAssembler& masm, LInstruction* ins) {
   UniqueChars opcodeStr;
 
   jsbytecode* bytecodepc = nullptr;
+  JSScript* bytecodeScript = nullptr;
   if (MDefinition* mir = ins->mirRaw()) {
     bytecodepc = mir->trackedSite()->pc();
+    bytecodeScript = mir->trackedSite()->script();
   }
 
 #ifdef JS_JITSPEW
@@ -413,7 +415,9 @@ void IonPerfSpewer::recordInstruction(MacroAssembler& masm, LInstruction* ins) {
                             static_cast<uint32_t>(op), opcodeStr, bytecodepc)) {
     opcodes_.clear();
     DisablePerfSpewer();
+    return;
   }
+  opcodes_.back().bytecodeScript = bytecodeScript;
 }
 
 #ifdef JS_JITSPEW
@@ -719,24 +723,38 @@ void PerfSpewer::saveJitCodeSourceInfo(JSScript* script, JitCode* code,
                                        AutoLockPerfSpewer& lock) {
 #ifdef JS_ION_PERF
   if (IsPerfProfiling()) {
-    const char* filename = script->filename();
-    if (!filename) {
-      return;
-    }
+    // Code inlined by Warp is attributed to the innermost inlined script, so
+    // that perf can tell inlined functions apart from their caller. Jitdump
+    // debug entries have a single source location, so the rest of the inline
+    // stack is not recorded.
+    auto entryScript = [script](const OpcodeEntry& entry) {
+      return entry.bytecodeScript ? entry.bytecodeScript : script;
+    };
 
     JitDumpDebugRecord debug_record = {};
 
     uint64_t n_records = 0;
+    uint64_t filenamesSize = 0;
     for (OpcodeEntry& entry : opcodes_) {
-      if (entry.bytecodepc) {
-        n_records++;
+      if (!entry.bytecodepc) {
+        continue;
+      }
+      const char* filename = entryScript(entry)->filename();
+      if (!filename) {
+        continue;
       }
+      n_records++;
+      filenamesSize += strlen(filename) + 1;
+    }
+
+    if (n_records == 0) {
+      return;
     }
 
     debug_record.header.id = JIT_CODE_DEBUG_INFO;
-    debug_record.header.total_size =
-        sizeof(debug_record) +
-        n_records * (sizeof(JitDumpDebugEntry) + strlen(filename) + 1);
+    debug_record.header.total_size = sizeof(debug_record) +
+                                     n_records * sizeof(JitDumpDebugEntry) +
+                                     filenamesSize;
     debug_record.header.timestamp = GetMonotonicTimestamp();
     debug_record.code_addr = uint64_t(code->raw());
     debug_record.nr_entry = n_records;
@@ -751,9 +769,14 @@ void PerfSpewer::saveJitCodeSourceInfo(JSScript* script, JitCode* code,
       if (!pc) {
         continue;
       }
+      JSScript* pcScript = entryScript(entry);
+      const char* filename = pcScript->filename();
+      if (!filename) {
+        continue;
+      }
       // We could probably make this a bit faster by caching the previous pc
       // offset, but it currently doesn't seem noticeable when testing.
-      lineno = PCToLineNumber(script, pc, &colno);
+      lineno = PCToLineNumber(pcScript, pc, &colno);
 
       WriteJitDumpDebugEntry(uint64_t(code->raw()) + entry.offset, filename,
                              lineno, colno, lock);
@@ -44,6 +44,9 @@ class PerfSpewer {
     uint32_t offset = 0;
     uint32_t opcode = 0;
     jsbytecode* bytecodepc = nullptr;
+    // The script containing |bytecodepc|, if known. For functions inlined by
+    // Warp this differs from the script the code was compiled for.
+    JSScript* bytecodeScript = nullptr;
 
     // This string is used to replace the opcode, to define things like
     // Prologue/Epilogue, or to add operand info.
@@ -73,6 +76,7 @@ class PerfSpewer {
       offset = copy.offset;
       opcode = copy.opcode;
       bytecodepc = copy.bytecodepc;
+      bytecodeScript = copy.bytecodeScript;
       str = std::move(copy.str);
     }
 
@@ -1425,7 +1425,9 @@ void MRsh::computeRange(TempAllocator& alloc) {
 }
 
 void MUrsh::computeRange(TempAllocator& alloc) {
-  if (type() != MIRType::Int32) {
+  // A Double-typed ursh returns its uint32 result as a double. The range below
+  // is exact for both result types.
+  if (type() != MIRType::Int32 && type() != MIRType::Double) {
     return;
   }
 
@@ -2134,14 +2136,19 @@ LoopIterationBound* RangeAnalysis::analyzeLoopIterationCount(
   }
 
   LinearSum iterationBound(alloc());
+  LinearSum stridedLimit(alloc());
 
-  if (lhsModified.constant == 1 && !lessEqual) {
+  int32_t stride = lhsModified.constant;
+  if (stride >= 1 && !lessEqual) {
     // The value of lhs is 'initial(lhs) + iterCount' and this will end
     // execution of the loop if 'lhs + lhsN >= rhs'. Thus, an upper bound
     // on the number of backedges executed is:
     //
     // initial(lhs) + iterCount + lhsN == rhs
     // iterCount == rhsN - initial(lhs) - lhsN
+    //
+    // If lhs increases by more than one each iteration this is still an
+    // upper bound, and within the loop 'lhs <= rhs - lhsN - 1'.
 
     if (rhs) {
       if (!iterationBound.add(rhs, 1)) {
@@ -2159,12 +2166,24 @@ LoopIterationBound* RangeAnalysis::analyzeLoopIterationCount(
     if (!iterationBound.add(lhsConstant)) {
       return nullptr;
     }
-  } else if (lhsModified.constant == -1 && lessEqual) {
+
+    if (stride != 1) {
+      if (rhs && !stridedLimit.add(rhs, 1)) {
+        return nullptr;
+      }
+      if (!stridedLimit.add(lhsConstant) || !stridedLimit.add(-1)) {
+        return nullptr;
+      }
+    }
+  } else if (stride <= -1 && lessEqual) {
     // The value of lhs is 'initial(lhs) - iterCount'. Similar to the above
     // case, an upper bound on the number of backedges executed is:
     //
     // initial(lhs) - iterCount + lhsN == rhs
     // iterCount == initial(lhs) - rhs + lhsN
+    //
+    // If lhs decreases by more than one each iteration, within the loop
+    // 'lhs >= rhs - lhsN + 1'.
 
     if (!iterationBound.add(lhsInitial, 1)) {
       return nullptr;
@@ -2177,10 +2196,27 @@ LoopIterationBound* RangeAnalysis::analyzeLoopIterationCount(
     if (!iterationBound.add(lhs.constant)) {
       return nullptr;
     }
+
+    if (stride != -1) {
+      int32_t lhsConstant;
+      if (!SafeSub(1, lhs.constant, &lhsConstant)) {
+        return nullptr;
+      }
+      if (rhs && !stridedLimit.add(rhs, 1)) {
+        return nullptr;
+      }
+      if (!stridedLimit.add(lhsConstant)) {
+        return nullptr;
+      }
+    }
   } else {
     return nullptr;
   }
 
+  if (stride != 1 && stride != -1) {
+    return new (alloc()) LoopIterationBound(test, iterationBound,
+                                            lhs.term->toPhi(), stridedLimit);
+  }
   return new (alloc()) LoopIterationBound(test, iterationBound);
 }
 
@@ -2231,16 +2267,23 @@ void RangeAnalysis::analyzeLoopPhi(const LoopIterationBound* loopBound,
   // at most loopBound - 1 times. Thus, another upper or lower bound for the
   // phi is initial(phi) + (loopBound - 1) * N, without requiring us to
   // ensure that loopBound >= 0.
+  //
+  // For the phi tested by a loop with a larger step, the test gives a bound
+  // at these points directly.
+
+  bool isStridedPhi = phi == loopBound->stridedPhi;
+  LinearSum limitSum(isStridedPhi ? loopBound->stridedLimit
+                                  : loopBound->boundSum);
+  if (!isStridedPhi) {
+    if (!limitSum.multiply(modified.constant) || !limitSum.add(initialSum)) {
+      return;
+    }
 
-  LinearSum limitSum(loopBound->boundSum);
-  if (!limitSum.multiply(modified.constant) || !limitSum.add(initialSum)) {
-    return;
-  }
-
-  int32_t negativeConstant;
-  if (!SafeSub(0, modified.constant, &negativeConstant) ||
-      !limitSum.add(negativeConstant)) {
-    return;
+    int32_t negativeConstant;
+    if (!SafeSub(0, modified.constant, &negativeConstant) ||
+        !limitSum.add(negativeConstant)) {
+      return;
+    }
   }
 
   Range* initRange = initial->range();
@@ -2670,6 +2713,25 @@ void MMul::truncate(TruncateKind kind) {
   }
 }
 
+bool MUrsh::canTruncate() const { return type() == MIRType::Double; }
+
+void MUrsh::truncate(TruncateKind kind) {
+  MOZ_ASSERT(canTruncate());
+
+  // The int32 result of an ursh without bailouts has the same bits as the
+  // uint32 result, so when all uses truncate to int32 the result doesn't need
+  // to be converted to a double. This keeps code like |(h * 31 + c) >>> 0|
+  // followed by a mask on integer paths. For TruncateAfterBailouts, results
+  // above INT32_MAX still bail out.
+  setResultType(MIRType::Int32);
+  if (kind >= TruncateKind::IndirectTruncate) {
+    bailoutsDisabled_ = true;
+    if (range()) {
+      range()->wrapAroundToInt32();
+    }
+  }
+}
+
 bool MDiv::canTruncate() const {
   return type() == MIRType::Double || type() == MIRType::Int32;
 }
@@ -45,7 +45,7 @@ enum class TruncateKind;
 // loops, this will exclude iterations that executed in the interpreter or in
 // baseline compiled code.
 struct LoopIterationBound : public TempObject {
-  // Test from which this bound was derived; after executing exactly 'bound'
+  // Test from which this bound was derived; after executing at most 'bound'
   // times this test will exit the loop. Code in the loop body which this
   // test dominates (will include the backedge) will execute at most 'bound'
   // times. Other code in the loop will execute at most '1 + Max(bound, 0)'
@@ -56,8 +56,22 @@ struct LoopIterationBound : public TempObject {
   // in this bound are all loop invariant.
   LinearSum boundSum;
 
+  // If the test's induction variable changes by more than one each iteration,
+  // |boundSum| is not exact and scaling it by the step would give a poor
+  // range for that variable. Instead, |stridedLimit| is the bound that the
+  // test itself places on |stridedPhi| at points which the test dominates.
+  const MPhi* stridedPhi = nullptr;
+  LinearSum stridedLimit;
+
   LoopIterationBound(const MTest* test, const LinearSum& boundSum)
-      : test(test), boundSum(boundSum) {}
+      : test(test), boundSum(boundSum), stridedLimit(boundSum) {}
+
+  LoopIterationBound(const MTest* test, const LinearSum& boundSum,
+                     const MPhi* stridedPhi, const LinearSum& stridedLimit)
+      : test(test),
+        boundSum(boundSum),
+        stridedPhi(stridedPhi),
+        stridedLimit(stridedLimit) {}
 };
 
 using LoopIterationBoundVector =
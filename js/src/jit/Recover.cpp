@@ -2164,6 +2164,32 @@ bool RNewCallObject::recover(JSContext* cx, SnapshotIterator& iter) const {
   return true;
 }
 
+bool MNewLexicalEnvironmentObject::writeRecoverData(
+    CompactBufferWriter& writer) const {
+  MOZ_ASSERT(canRecoverOnBailout());
+  writer.writeUnsigned(
+      uint32_t(RInstruction::Recover_NewLexicalEnvironmentObject));
+  return true;
+}
+
+RNewLexicalEnvironmentObject::RNewLexicalEnvironmentObject(
+    CompactBufferReader& reader) {}
+
+bool RNewLexicalEnvironmentObject::recover(JSContext* cx,
+                                           SnapshotIterator& iter) const {
+  auto* templateObj = &iter.readObject()->as<BlockLexicalEnvironmentObject>();
+  Rooted<LexicalScope*> scope(cx, &templateObj->scope());
+
+  JSObject* resultObject =
+      BlockLexicalEnvironmentObject::createWithoutEnclosing(cx, scope);
+  if (!resultObject) {
+    return false;
+  }
+
+  iter.storeInstructionResult(ObjectValue(*resultObject));
+  return true;
+}
+
 bool MObjectKeys::canRecoverOnBailout() const {
   // Only claim that this operation can be recovered on bailout if some other
   // optimization already marked it as such.
@@ -2209,6 +2235,11 @@ bool RObjectState::recover(JSContext* cx, SnapshotIterator& iter) const {
 
   for (size_t i = 0; i < numSlots(); i++) {
     Value val = iter.read();
+    // Private slots, such as the scope of an environment object, are not
+    // tracked by MObjectState and already hold their final value.
+    if (nativeObject->getSlot(i).isPrivateGCThing()) {
+      continue;
+    }
     nativeObject->setSlot(i, val);
   }
 
@@ -139,6 +139,7 @@ namespace jit {
   _(NewArray)                     \
   _(NewIterator)                  \
   _(NewCallObject)                \
+  _(NewLexicalEnvironmentObject)  \
   _(Lambda)                       \
   _(FunctionWithProto)            \
   _(ObjectKeys)                   \
@@ -966,6 +967,14 @@ class RNewCallObject final : public RInstruction {
                              SnapshotIterator& iter) const override;
 };
 
+class RNewLexicalEnvironmentObject final : public RInstruction {
+ public:
+  RINSTRUCTION_HEADER_NUM_OP_(NewLexicalEnvironmentObject, 1)
+
+  [[nodiscard]] bool recover(JSContext* cx,
+                             SnapshotIterator& iter) const override;
+};
+
 class RObjectKeys final : public RInstruction {
  public:
   RINSTRUCTION_HEADER_NUM_OP_(ObjectKeys, 1)
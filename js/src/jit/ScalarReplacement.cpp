@@ -111,7 +111,23 @@ bool EmulateStateOf<MemoryView>::run(MemoryView& view) {
 
 static inline bool IsOptimizableObjectInstruction(MInstruction* ins) {
   return ins->isNewObject() || ins->isNewPlainObject() ||
-         ins->isNewCallObject() || ins->isNewIterator();
+         ins->isNewCallObject() || ins->isNewLexicalEnvironmentObject() ||
+         ins->isNewIterator();
+}
+
+static inline bool IsEnvironmentObjectInstruction(MDefinition* ins) {
+  return ins->isNewCallObject() || ins->isNewLexicalEnvironmentObject();
+}
+
+// Returns true if |slot| of the object allocated by |newObject| holds a private
+// value, such as the scope of a lexical environment, which can't be tracked by
+// MObjectState.
+static bool IsPrivateTemplateSlot(MInstruction* newObject, uint32_t slot) {
+  if (newObject->isNewPlainObject()) {
+    return false;
+  }
+  JSObject* templateObj = MObjectState::templateObjectOf(newObject);
+  return templateObj->as<NativeObject>().getSlot(slot).isPrivateGCThing();
 }
 
 static bool PhiOperandEqualTo(MDefinition* operand, MInstruction* newObject) {
@@ -271,14 +287,22 @@ static bool IsObjectEscaped(MDefinition* ins, MInstruction* newObject,
     MDefinition* def = consumer->toDefinition();
     switch (def->op()) {
       case MDefinition::Opcode::StoreFixedSlot:
-      case MDefinition::Opcode::LoadFixedSlot:
-        // Not escaped if it is the first argument.
-        if (def->indexOf(*i) == 0) {
-          break;
+      case MDefinition::Opcode::LoadFixedSlot: {
+        // Escaped if it is not the first argument.
+        if (def->indexOf(*i) != 0) {
+          JitSpewDef(JitSpew_Escape, "is escaped by\n", def);
+          return true;
         }
 
-        JitSpewDef(JitSpew_Escape, "is escaped by\n", def);
-        return true;
+        uint32_t slot = def->isStoreFixedSlot()
+                            ? def->toStoreFixedSlot()->slot()
+                            : def->toLoadFixedSlot()->slot();
+        if (IsPrivateTemplateSlot(newObject, slot)) {
+          JitSpewDef(JitSpew_Escape, "accesses a private slot\n", def);
+          return true;
+        }
+        break;
+      }
 
       case MDefinition::Opcode::PostWriteBarrier:
         break;
@@ -809,14 +833,14 @@ void ObjectMemoryView::visitUnbox(MUnbox* ins) {
 }
 
 MDefinition* ObjectMemoryView::functionForCallObject(MDefinition* ins) {
-  // Return early when we don't replace MNewCallObject.
-  if (!obj_->isNewCallObject()) {
+  // Return early when we don't replace an environment object.
+  if (!IsEnvironmentObjectInstruction(obj_)) {
     return nullptr;
   }
 
   // Unwrap instructions until we found either MLambda or MFunctionWithProto.
   // Return the function instruction if their environment chain matches the
-  // MNewCallObject we're about to replace.
+  // environment object we're about to replace.
   while (true) {
     switch (ins->op()) {
       case MDefinition::Opcode::Lambda: {
@@ -847,7 +871,8 @@ MDefinition* ObjectMemoryView::functionForCallObject(MDefinition* ins) {
 }
 
 void ObjectMemoryView::visitFunctionEnvironment(MFunctionEnvironment* ins) {
-  // Skip function environment which are not aliases of the NewCallObject.
+  // Skip function environment which are not aliases of the environment
+  // object.
   if (!functionForCallObject(ins)) {
     return;
   }
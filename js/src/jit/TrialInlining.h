@@ -44,6 +44,11 @@
  * private ICScript, which is specialized for its caller.
  *
  * The same approach can be used to inline recursively.
+ *
+ * Only monomorphic call sites are inlined. Call sites with several targets
+ * would need more than one inlined ICScript per bytecode offset, and
+ * Baseline bailouts would then have to pick the callee's ICScript by target
+ * rather than by pc when they reconstruct inlined frames.
  */
 
 class JS_PUBLIC_API JSTracer;
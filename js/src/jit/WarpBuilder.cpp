@@ -467,6 +467,10 @@ bool WarpBuilder::buildPrologue() {
     return false;
   }
 
+  if (JitOptions.coldIonCodeDiscardSeconds) {
+    current->add(MMarkIonScriptEntered::New(alloc()));
+  }
+
 #ifdef JS_CACHEIR_SPEW
   if (snapshot().needsFinalWarmUpCount()) {
     MIncrementWarmUpCounter* ins =
@@ -2459,6 +2463,12 @@ bool WarpBuilder::build_Await(BytecodeLocation loc) {
 }
 bool WarpBuilder::build_Yield(BytecodeLocation loc) { return build_Await(loc); }
 
+// Generator and async function bodies are compiled like any other script,
+// but Ion code for them is only entered at the start of the script or through
+// OSR at a loop head. A suspend is compiled as a return after saving the frame
+// state in the generator object, and a resumed generator always continues in
+// Baseline (see build_AfterYield). Hot loops in resumed frames get back into
+// Ion through Baseline OSR.
 bool WarpBuilder::buildSuspend(BytecodeLocation loc, MDefinition* gen,
                                MDefinition* retVal) {
   // If required, unbox the generator object explicitly and infallibly.
@@ -3088,6 +3088,21 @@ bool WarpCacheIRTranspiler::emitStoreDataViewValueResult(
   return resumeAfter(store);
 }
 
+bool WarpCacheIRTranspiler::emitTypedArraySetResult(ObjOperandId targetId,
+                                                    ObjOperandId sourceId,
+                                                    IntPtrOperandId offsetId) {
+  MDefinition* target = getOperand(targetId);
+  MDefinition* source = getOperand(sourceId);
+  MDefinition* offset = getOperand(offsetId);
+
+  auto* ins = MTypedArraySet::New(alloc(), target, source, offset);
+  addEffectful(ins);
+
+  pushResult(constant(UndefinedValue()));
+
+  return resumeAfter(ins);
+}
+
 bool WarpCacheIRTranspiler::emitInt32IncResult(Int32OperandId inputId) {
   MDefinition* input = getOperand(inputId);
 
@@ -5763,6 +5778,30 @@ void WarpCacheIRTranspiler::updateArgumentsFromOperands() {
         case ArgumentKind::Arg7:
           callInfo_->setArg(7, getOperand(id));
           break;
+        case ArgumentKind::Arg8:
+          callInfo_->setArg(8, getOperand(id));
+          break;
+        case ArgumentKind::Arg9:
+          callInfo_->setArg(9, getOperand(id));
+          break;
+        case ArgumentKind::Arg10:
+          callInfo_->setArg(10, getOperand(id));
+          break;
+        case ArgumentKind::Arg11:
+          callInfo_->setArg(11, getOperand(id));
+          break;
+        case ArgumentKind::Arg12:
+          callInfo_->setArg(12, getOperand(id));
+          break;
+        case ArgumentKind::Arg13:
+          callInfo_->setArg(13, getOperand(id));
+          break;
+        case ArgumentKind::Arg14:
+          callInfo_->setArg(14, getOperand(id));
+          break;
+        case ArgumentKind::Arg15:
+          callInfo_->setArg(15, getOperand(id));
+          break;
         case ArgumentKind::Callee:
         case ArgumentKind::NumKinds:
           MOZ_CRASH("Unexpected argument kind");
@@ -6330,7 +6369,6 @@ bool WarpCacheIRTranspiler::emitCallBoundScriptedFunction(
   MDefinition* callee = getOperand(calleeId);
   MDefinition* target = getOperand(targetId);
 
-  MOZ_ASSERT(callInfo_->argFormat() == CallInfo::ArgFormat::Standard);
   MOZ_ASSERT(callInfo_->constructing() == flags.isConstructing());
 
   callInfo_->setCallee(target);
@@ -6338,6 +6376,33 @@ bool WarpCacheIRTranspiler::emitCallBoundScriptedFunction(
 
   WrappedFunction* wrappedTarget = maybeCallTarget(target, CallKind::Scripted);
 
+  if (flags.getArgFormat() == CallFlags::Spread) {
+    // Only bound functions without bound arguments are supported, so we can
+    // call the target with the bound |this| and the spread array. If the
+    // array is a rest parameter, scalar replacement turns this into a call
+    // which copies the arguments directly from the caller's frame.
+    MOZ_ASSERT(callInfo_->argFormat() == CallInfo::ArgFormat::Array);
+    MOZ_ASSERT(!callInfo_->constructing());
+    MOZ_ASSERT(numBoundArgs == 0);
+
+    auto* thisv = MLoadFixedSlot::New(alloc(), callee,
+                                      BoundFunctionObject::boundThisSlot());
+    add(thisv);
+    callInfo_->thisArg()->setImplicitlyUsedUnchecked();
+    callInfo_->setThis(thisv);
+
+    MInstruction* call =
+        makeSpreadCall(*callInfo_, /* needsThisCheck = */ false,
+                       flags.isSameRealm(), wrappedTarget);
+    if (!call) {
+      return false;
+    }
+    addEffectful(call);
+    pushResult(call);
+    return resumeAfter(call);
+  }
+  MOZ_ASSERT(callInfo_->argFormat() == CallInfo::ArgFormat::Standard);
+
   bool needsThisCheck = false;
   if (callInfo_->constructing()) {
     callInfo_->setNewTarget(target);
@@ -6,6 +6,8 @@
 
 #include "jit/WasmBCE.h"
 
+#include <algorithm>
+
 #include "jit/JitSpewer.h"
 #include "jit/MIRGenerator.h"
 #include "jit/MIRGraph.h"
@@ -13,13 +15,38 @@
 using namespace js;
 using namespace js::jit;
 
-using LastSeenMap = js::HashMap<uint32_t, MDefinition*, DefaultHasher<uint32_t>,
+// Bounds checks are keyed on the checked definition and the memory it was
+// checked against, see CheckKey.
+using LastSeenMap = js::HashMap<uint64_t, MDefinition*, DefaultHasher<uint64_t>,
                                 SystemAllocPolicy>;
 
+using MemoryIndexVector = Vector<uint32_t, 1, SystemAllocPolicy>;
+
+static uint64_t CheckKey(uint32_t memoryIndex, MDefinition* def) {
+  return (uint64_t(memoryIndex) << 32) | def->id();
+}
+
+static bool IsConstantBelow(MDefinition* addr, uint64_t limit) {
+  // The payload of the MConstant will be Double if the constant result is
+  // above 2^31-1, but we don't care about that for BCE.
+  if (!addr->isConstant()) {
+    return false;
+  }
+  MConstant* constant = addr->toConstant();
+  return (constant->type() == MIRType::Int32 &&
+          uint64_t(constant->toInt32()) < limit) ||
+         (constant->type() == MIRType::Int64 &&
+          uint64_t(constant->toInt64()) < limit);
+}
+
 // The Wasm Bounds Check Elimination (BCE) pass looks for bounds checks
 // on SSA values that have already been checked. (in the same block or in a
 // dominating block). These bounds checks are redundant and thus eliminated.
 //
+// Checks against different memories prove nothing about each other, so each
+// linear memory is tracked separately. This works the same way for memory32
+// and memory64. Table and GC array checks are not eliminated.
+//
 // Note: This is safe in the presense of dynamic memory sizes as long as they
 // can ONLY GROW. If we allow SHRINKING the heap, this pass should be
 // RECONSIDERED.
@@ -33,6 +60,9 @@ bool jit::EliminateBoundsChecks(const MIRGenerator* mir, MIRGraph& graph) {
   // Map for dominating block where a given definition was checked
   LastSeenMap lastSeen;
 
+  // Memories that have had at least one bounds check, for phi processing.
+  MemoryIndexVector checkedMemories;
+
   for (ReversePostorderIterator bIter(graph.rpoBegin());
        bIter != graph.rpoEnd(); bIter++) {
     MBasicBlock* block = *bIter;
@@ -44,25 +74,16 @@ bool jit::EliminateBoundsChecks(const MIRGenerator* mir, MIRGraph& graph) {
           MWasmBoundsCheck* bc = def->toWasmBoundsCheck();
           MDefinition* addr = bc->index();
 
-          // We only support bounds check elimination on wasm memory 0, not
-          // other memories or tables. See bug 1625891.
-          if (!bc->isMemory0()) {
+          // Tables and arrays are not supported. See bug 1625891.
+          if (!bc->isMemory()) {
             continue;
           }
+          uint32_t memoryIndex = bc->memoryIndex();
 
           // Eliminate constant-address memory bounds checks to addresses below
-          // the heap minimum.
-          //
-          // The payload of the MConstant will be Double if the constant
-          // result is above 2^31-1, but we don't care about that for BCE.
-
-          if (addr->isConstant() &&
-              ((addr->toConstant()->type() == MIRType::Int32 &&
-                uint64_t(addr->toConstant()->toInt32()) <
-                    mir->minWasmMemory0Length()) ||
-               (addr->toConstant()->type() == MIRType::Int64 &&
-                uint64_t(addr->toConstant()->toInt64()) <
-                    mir->minWasmMemory0Length()))) {
+          // the heap minimum. The minimum is only known for memory 0.
+          if (memoryIndex == 0 &&
+              IsConstantBelow(addr, mir->minWasmMemory0Length())) {
             bc->setRedundant();
             if (JitOptions.spectreIndexMasking) {
               bc->replaceAllUsesWith(addr);
@@ -70,7 +91,8 @@ bool jit::EliminateBoundsChecks(const MIRGenerator* mir, MIRGraph& graph) {
               MOZ_ASSERT(!bc->hasUses());
             }
           } else {
-            LastSeenMap::AddPtr ptr = lastSeen.lookupForAdd(addr->id());
+            LastSeenMap::AddPtr ptr =
+                lastSeen.lookupForAdd(CheckKey(memoryIndex, addr));
             if (ptr) {
               MDefinition* prevCheckOrPhi = ptr->value();
               if (prevCheckOrPhi->block()->dominates(block)) {
@@ -82,7 +104,12 @@ bool jit::EliminateBoundsChecks(const MIRGenerator* mir, MIRGraph& graph) {
                 }
               }
             } else {
-              if (!lastSeen.add(ptr, addr->id(), def)) {
+              if (!lastSeen.add(ptr, CheckKey(memoryIndex, addr), def)) {
+                return false;
+              }
+              if (std::find(checkedMemories.begin(), checkedMemories.end(),
+                            memoryIndex) == checkedMemories.end() &&
+                  !checkedMemories.append(memoryIndex)) {
                 return false;
               }
             }
@@ -91,38 +118,41 @@ bool jit::EliminateBoundsChecks(const MIRGenerator* mir, MIRGraph& graph) {
         }
         case MDefinition::Opcode::Phi: {
           MPhi* phi = def->toPhi();
-          bool phiChecked = true;
 
           MOZ_ASSERT(phi->numOperands() > 0);
 
           // If all incoming values to a phi node are safe (i.e. have a
-          // check that dominates this block) then we can consider this
-          // phi node checked.
+          // check against the same memory that dominates this block) then we
+          // can consider this phi node checked for that memory.
           //
           // Note that any phi that is part of a cycle
           // will not be "safe" since the value coming on the backedge
           // cannot be in lastSeen because its block hasn't been traversed yet.
-          for (int i = 0, nOps = phi->numOperands(); i < nOps; i++) {
-            MDefinition* src = phi->getOperand(i);
-
-            if (JitOptions.spectreIndexMasking) {
-              if (src->isWasmBoundsCheck()) {
-                src = src->toWasmBoundsCheck()->index();
+          for (uint32_t memoryIndex : checkedMemories) {
+            bool phiChecked = true;
+            for (int i = 0, nOps = phi->numOperands(); i < nOps; i++) {
+              MDefinition* src = phi->getOperand(i);
+
+              if (JitOptions.spectreIndexMasking) {
+                if (src->isWasmBoundsCheck()) {
+                  src = src->toWasmBoundsCheck()->index();
+                }
+              } else {
+                MOZ_ASSERT(!src->isWasmBoundsCheck());
               }
-            } else {
-              MOZ_ASSERT(!src->isWasmBoundsCheck());
-            }
 
-            LastSeenMap::Ptr checkPtr = lastSeen.lookup(src->id());
-            if (!checkPtr || !checkPtr->value()->block()->dominates(block)) {
-              phiChecked = false;
-              break;
+              LastSeenMap::Ptr checkPtr =
+                  lastSeen.lookup(CheckKey(memoryIndex, src));
+              if (!checkPtr || !checkPtr->value()->block()->dominates(block)) {
+                phiChecked = false;
+                break;
+              }
             }
-          }
 
-          if (phiChecked) {
-            if (!lastSeen.put(def->id(), def)) {
-              return false;
+            if (phiChecked) {
+              if (!lastSeen.put(CheckKey(memoryIndex, def), def)) {
+                return false;
+              }
             }
           }
 
@@ -766,3 +766,32 @@ inline bool RadixOutOfRange(uint8_t radix) {
   return true;
 }
 END_TEST(testBigIntToString_RadixOutOfRange)
+
+BEGIN_TEST(testBigIntMul_Karatsuba) {
+  JS::Rooted<JS::Value> v(cx);
+
+  // Operands with many all-ones digits stress carry propagation.
+  EVAL(
+      "var a = 2n ** 4000n - 1n;"
+      "a * a === 2n ** 8000n - 2n ** 4001n + 1n",
+      &v);
+  CHECK(v.isTrue());
+
+  // Balanced, unbalanced and odd-sized operands, checked against
+  // commutativity and the distributive law.
+  EVAL(
+      "var ok = true;"
+      "var x = 3n ** 5000n + 12345n;"
+      "for (var bits of [2600, 3200, 5000, 7919, 9000]) {"
+      "  var y = 7n ** BigInt(bits) - 1n;"
+      "  ok = ok && x * y === y * x;"
+      "  ok = ok && x * (y + 1n) === x * y + x;"
+      "  ok = ok && (-x) * y === -(x * y);"
+      "}"
+      "ok",
+      &v);
+  CHECK(v.isTrue());
+
+  return true;
+}
+END_TEST(testBigIntMul_Karatsuba)
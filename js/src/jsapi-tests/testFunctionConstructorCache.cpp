@@ -0,0 +1,70 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+ * vim: set ts=8 sts=2 et sw=2 tw=80:
+ *
+ * Test that functions created by the Function constructor from a cached
+ * stencil are independent of each other.
+ */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "js/GCAPI.h"
+#include "jsapi-tests/tests.h"
+
+BEGIN_TEST(testFunctionConstructorCache) {
+  JS::RootedValue result(cx);
+
+  // The same call site compiles the same text repeatedly. Each call must
+  // still create a distinct function with its own properties.
+  EVAL(
+      "var fns = [];\n"
+      "for (var i = 0; i < 10; i++) {\n"
+      "  var f = new Function('a', 'b', 'return a + b;');\n"
+      "  f.tag = i;\n"
+      "  fns.push(f);\n"
+      "}\n"
+      "fns.every((f, i) => f(i, 1) === i + 1 && f.tag === i) &&\n"
+      "  fns[0] !== fns[1] && fns[0].prototype !== fns[1].prototype &&\n"
+      "  fns[9].toString() === fns[0].toString()",
+      &result);
+  CHECK(result.isTrue());
+
+  // Different kinds of function with the same parameters and body.
+  EVAL(
+      "var AsyncFunction = (async function() {}).constructor;\n"
+      "var GeneratorFunction = (function*() {}).constructor;\n"
+      "var kinds = [];\n"
+      "for (var C of [Function, AsyncFunction, GeneratorFunction]) {\n"
+      "  kinds.push(Object.getPrototypeOf(new C('return 1;')));\n"
+      "}\n"
+      "kinds[0] === Function.prototype &&\n"
+      "  kinds[1] === AsyncFunction.prototype &&\n"
+      "  kinds[2] === GeneratorFunction.prototype",
+      &result);
+  CHECK(result.isTrue());
+
+  // Syntax errors are reported on every call.
+  EVAL(
+      "var errors = 0;\n"
+      "for (var i = 0; i < 3; i++) {\n"
+      "  try { new Function('return ('); } catch (e) {\n"
+      "    if (e instanceof SyntaxError) errors++;\n"
+      "  }\n"
+      "}\n"
+      "errors",
+      &result);
+  CHECK(result.isInt32(3));
+
+  // Functions instantiated after the cache is purged behave the same.
+  EXEC("function make() { return new Function('x', 'return x * 2;'); }");
+  EVAL("make()(21)", &result);
+  CHECK(result.isInt32(42));
+  JS_GC(cx);
+  EVAL("make()(21)", &result);
+  CHECK(result.isInt32(42));
+  EVAL("make()(4) + make()(5)", &result);
+  CHECK(result.isInt32(18));
+
+  return true;
+}
+END_TEST(testFunctionConstructorCache)
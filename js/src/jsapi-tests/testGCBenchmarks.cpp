@@ -0,0 +1,159 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+ * vim: set ts=8 sts=2 et sw=2 tw=80:
+ */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * Synthetic heaps that stress specific parts of the collector.
+ *
+ * By default each workload is small enough to run as part of the normal test
+ * suite. Set JSAPI_TESTS_GC_BENCH_SCALE to a larger integer to scale the heaps
+ * up and print the wall-clock time and GC counts for each one; combine with
+ * MOZ_GCTIMER=stderr to get the per-phase breakdown from gc::Statistics.
+ */
+
+#include "mozilla/TimeStamp.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "gc/GCRuntime.h"
+#include "js/GCAPI.h"
+#include "jsapi-tests/tests.h"
+#include "vm/JSContext.h"
+#include "vm/Runtime.h"
+
+using mozilla::TimeStamp;
+
+static uint32_t GCBenchScale() {
+  const char* env = getenv("JSAPI_TESTS_GC_BENCH_SCALE");
+  if (!env) {
+    return 1;
+  }
+  int scale = atoi(env);
+  return scale > 0 ? uint32_t(scale) : 1;
+}
+
+class MOZ_RAII AutoGCBenchTimer {
+  JSContext* cx_;
+  const char* name_;
+  TimeStamp start_;
+  uint64_t minorGCs_;
+  uint64_t majorGCs_;
+
+ public:
+  AutoGCBenchTimer(JSContext* cx, const char* name)
+      : cx_(cx),
+        name_(name),
+        start_(TimeStamp::Now()),
+        minorGCs_(cx->runtime()->gc.minorGCCount()),
+        majorGCs_(cx->runtime()->gc.majorGCCount()) {}
+
+  uint64_t minorGCs() const {
+    return cx_->runtime()->gc.minorGCCount() - minorGCs_;
+  }
+  uint64_t majorGCs() const {
+    return cx_->runtime()->gc.majorGCCount() - majorGCs_;
+  }
+
+  ~AutoGCBenchTimer() {
+    if (!getenv("JSAPI_TESTS_GC_BENCH_SCALE")) {
+      return;
+    }
+    fprintf(stderr, "%s: %.3f ms, %llu minor GCs, %llu major GCs\n", name_,
+            (TimeStamp::Now() - start_).ToMilliseconds(),
+            (unsigned long long)minorGCs(), (unsigned long long)majorGCs());
+  }
+};
+
+// Allocate many short-lived objects while keeping a fraction of them alive,
+// so that every minor GC promotes part of the nursery.
+BEGIN_TEST(testGCBench_NurseryPromotion) {
+  JS::RootedValue scale(cx, JS::NumberValue(GCBenchScale()));
+  CHECK(JS_SetProperty(cx, global, "scale", scale));
+
+  AutoGCBenchTimer timer(cx, "NurseryPromotion");
+  EXEC(
+      "var kept = [];\n"
+      "for (var i = 0; i < 200000 * scale; i++) {\n"
+      "  var o = {a: i, b: [i]};\n"
+      "  if (i % 10 === 0) kept.push(o);\n"
+      "}\n");
+  cx->minorGC(JS::GCReason::API);
+  CHECK(timer.minorGCs() > 0);
+  return true;
+}
+END_TEST(testGCBench_NurseryPromotion)
+
+// Build a long chain of WeakMap entries where each value is the key of the
+// next entry, which forces ephemeron marking to iterate.
+BEGIN_TEST(testGCBench_Ephemerons) {
+  JS::RootedValue scale(cx, JS::NumberValue(GCBenchScale()));
+  CHECK(JS_SetProperty(cx, global, "scale", scale));
+
+  EXEC(
+      "var maps = [new WeakMap, new WeakMap, new WeakMap, new WeakMap];\n"
+      "var head = {};\n"
+      "var key = head;\n"
+      "for (var i = 0; i < 20000 * scale; i++) {\n"
+      "  var value = {};\n"
+      "  maps[i % maps.length].set(key, value);\n"
+      "  key = value;\n"
+      "}\n");
+
+  AutoGCBenchTimer timer(cx, "Ephemerons");
+  JS_GC(cx);
+  CHECK(timer.majorGCs() > 0);
+
+  JS::RootedValue result(cx);
+  EVAL("maps[0].has(head)", &result);
+  CHECK(result.isTrue());
+  return true;
+}
+END_TEST(testGCBench_Ephemerons)
+
+// Store nursery objects into a large tenured array, generating more store
+// buffer entries than the buffer can hold between minor GCs.
+BEGIN_TEST(testGCBench_StoreBufferOverflow) {
+  JS::RootedValue scale(cx, JS::NumberValue(GCBenchScale()));
+  CHECK(JS_SetProperty(cx, global, "scale", scale));
+
+  EXEC("var big = new Array(100000).fill(null);\n");
+  JS_GC(cx);
+
+  AutoGCBenchTimer timer(cx, "StoreBufferOverflow");
+  EXEC(
+      "for (var round = 0; round < 10 * scale; round++) {\n"
+      "  for (var i = 0; i < big.length; i += 7) big[i] = {round};\n"
+      "}\n");
+  cx->minorGC(JS::GCReason::API);
+  CHECK(timer.minorGCs() > 0);
+  return true;
+}
+END_TEST(testGCBench_StoreBufferOverflow)
+
+// Fragment the tenured heap by freeing every other object, then run a
+// shrinking GC that compacts the survivors.
+BEGIN_TEST(testGCBench_Compaction) {
+  JS::RootedValue scale(cx, JS::NumberValue(GCBenchScale()));
+  CHECK(JS_SetProperty(cx, global, "scale", scale));
+
+  EXEC(
+      "var objs = [];\n"
+      "for (var i = 0; i < 100000 * scale; i++) objs.push({i});\n");
+  JS_GC(cx);
+  EXEC("for (var i = 0; i < objs.length; i += 2) objs[i] = null;\n");
+
+  AutoGCBenchTimer timer(cx, "Compaction");
+  JS::PrepareForFullGC(cx);
+  JS::NonIncrementalGC(cx, JS::GCOptions::Shrink, JS::GCReason::API);
+  CHECK(timer.majorGCs() > 0);
+
+  JS::RootedValue result(cx);
+  EVAL("objs[1].i", &result);
+  CHECK(result.isInt32(1));
+  return true;
+}
+END_TEST(testGCBench_Compaction)
@@ -4,10 +4,13 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this
  * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <algorithm>
 #include <limits>
+#include <string>
 #include <string.h>
 
-#include "js/Array.h"  // JS::IsArrayObject
+#include "js/Array.h"              // JS::IsArrayObject
+#include "js/CharacterEncoding.h"  // JS_EncodeStringToUTF8
 #include "js/Exception.h"
 #include "js/friend/ErrorMessages.h"  // JSMSG_*
 #include "js/JSON.h"
@@ -110,3 +113,68 @@ static bool UnreachedCallback(const char16_t*, uint32_t, void*) {
 }
 
 END_TEST(testToJSON_different)
+
+BEGIN_TEST(testToJSON_repeatedShapes) {
+  // Objects with the same shape reuse the quoted keys of the first one,
+  // including keys which need escaping, and skip filtered values.
+  JS::RootedValue v(cx);
+  EVAL(
+      "var records = [];\n"
+      "for (var i = 0; i < 3; i++) {\n"
+      "  records.push({a: i, 'q\"\\n': i % 2 ? undefined : 'x',\n"
+      "                '\\u20ac': null, nested: {a: [i]}});\n"
+      "}\n"
+      "JSON.stringify(records) ===\n"
+      "  '[{\"a\":0,\"q\\\\\"\\\\n\":\"x\",\"\\u20ac\":null,' +\n"
+      "  '\"nested\":{\"a\":[0]}},' +\n"
+      "  '{\"a\":1,\"\\u20ac\":null,\"nested\":{\"a\":[1]}},' +\n"
+      "  '{\"a\":2,\"q\\\\\"\\\\n\":\"x\",\"\\u20ac\":null,' +\n"
+      "  '\"nested\":{\"a\":[2]}}]';",
+      &v);
+  CHECK(v.isTrue());
+  return true;
+}
+END_TEST(testToJSON_repeatedShapes)
+
+BEGIN_TEST(testToJSON_utf8) {
+  // The getter makes the serialization take the slow path, which writes the
+  // output while it is being produced.
+  JS::RootedValue input(cx);
+  EVAL(
+      "var records = [];\n"
+      "for (var i = 0; i < 2000; i++) {\n"
+      "  records.push({id: i, name: 'caf\\u00e9 \\ud83d\\ude00',\n"
+      "                get tag() { return 'x'; }});\n"
+      "}\n"
+      "records;",
+      &input);
+
+  Output output;
+  JS::RootedObject replacer(cx);
+  JS::RootedValue space(cx);
+  CHECK(JS::ToJSONUTF8(cx, input, replacer, space, WriteChunk, &output));
+  CHECK(output.chunks > 1);
+  CHECK(output.maxChunk <= JS::JSONUTF8ChunkSize);
+
+  JS::RootedValue v(cx);
+  EVAL("JSON.stringify(records)", &v);
+  JS::UniqueChars utf8 = JS_EncodeStringToUTF8(cx, v.toString());
+  CHECK(utf8);
+  CHECK(output.bytes == std::string(utf8.get()));
+  return true;
+}
+
+struct Output {
+  std::string bytes;
+  size_t chunks = 0;
+  size_t maxChunk = 0;
+};
+
+static bool WriteChunk(const char* buf, size_t len, void* data) {
+  Output* output = static_cast<Output*>(data);
+  output->bytes.append(buf, len);
+  output->chunks++;
+  output->maxChunk = std::max(output->maxChunk, len);
+  return true;
+}
+END_TEST(testToJSON_utf8)
@@ -0,0 +1,110 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+ * vim: set ts=8 sts=2 et sw=2 tw=80:
+ */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "js/JitDiagnostics.h"
+#include "jsapi-tests/tests.h"
+
+BEGIN_TEST(testJitDiagnostics_ThrashingScripts) {
+  // Change the type of |x| after warm-up so that any Ion code bails out.
+  EXEC(
+      "function f(x) { return x + 1; }"
+      "for (var i = 0; i < 2000; i++) f(i);"
+      "for (var i = 0; i < 2000; i++) f('a');");
+
+  JS::JitThrashingScriptVector scripts;
+  CHECK(JS::GetJitThrashingScripts(cx, 0, scripts));
+  CHECK(scripts.empty());
+
+  CHECK(JS::GetJitThrashingScripts(cx, 4, scripts));
+  CHECK(scripts.length() <= 4);
+  for (size_t i = 0; i < scripts.length(); i++) {
+    CHECK(scripts[i].bailouts > 0);
+    if (i > 0) {
+      CHECK(scripts[i - 1].invalidations >= scripts[i].invalidations);
+    }
+  }
+
+  JS::JitBailoutKindCountVector counts;
+  CHECK(JS::GetJitBailoutKindCounts(cx, counts));
+  for (const JS::JitBailoutKindCount& count : counts) {
+    CHECK(count.kind);
+    CHECK(count.count > 0);
+  }
+
+  return true;
+}
+END_TEST(testJitDiagnostics_ThrashingScripts)
+
+BEGIN_TEST(testJitDiagnostics_RealmICHealth) {
+  // Give the property access in |g| many different shapes.
+  EXEC(
+      "function g(o) { return o.x; }"
+      "for (var i = 0; i < 200; i++) {"
+      "  var o = {x: i};"
+      "  o['p' + (i % 20)] = i;"
+      "  g(o);"
+      "}");
+
+  JS::ScriptICHealthVector scripts;
+  CHECK(JS::GetRealmICHealth(cx, js::GetContextRealm(cx),
+                             /* includeMonomorphic = */ true, scripts));
+  for (const JS::ScriptICHealth& script : scripts) {
+    CHECK(!script.entries.empty());
+    for (const JS::ICHealthEntry& entry : script.entries) {
+      CHECK(entry.op);
+    }
+  }
+
+  // Excluding monomorphic ICs can only remove entries.
+  JS::ScriptICHealthVector unhealthy;
+  CHECK(JS::GetRealmICHealth(cx, js::GetContextRealm(cx),
+                             /* includeMonomorphic = */ false, unhealthy));
+  CHECK(unhealthy.length() <= scripts.length());
+  for (const JS::ScriptICHealth& script : unhealthy) {
+    for (const JS::ICHealthEntry& entry : script.entries) {
+      CHECK(entry.mode != JS::ICHealthMode::Monomorphic || entry.numFailures);
+    }
+  }
+
+  return true;
+}
+END_TEST(testJitDiagnostics_RealmICHealth)
+
+BEGIN_TEST(testJitDiagnostics_MegamorphicCacheStats) {
+  JS::MegamorphicCacheStats getPropStats;
+  JS::MegamorphicCacheStats setPropStats;
+  JS::GetMegamorphicCacheStats(cx, &getPropStats, &setPropStats);
+  CHECK(getPropStats.evictions <= getPropStats.misses);
+  CHECK(setPropStats.evictions <= setPropStats.misses);
+  return true;
+}
+END_TEST(testJitDiagnostics_MegamorphicCacheStats)
+
+BEGIN_TEST(testJitDiagnostics_WasmFunctionSamples) {
+  JS::SetWasmFunctionSampling(cx, true);
+
+  JS::RootedValue v(cx);
+  EVAL("({})", &v);
+  JS::WasmFunctionSampleVector samples;
+  CHECK(!JS::GetWasmFunctionSamples(cx, &v.toObject(), samples));
+  JS_ClearPendingException(cx);
+
+  EVAL(
+      "typeof WebAssembly === 'undefined' ? null :"
+      "new WebAssembly.Instance(new WebAssembly.Module("
+      "  new Uint8Array([0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00])))",
+      &v);
+  if (v.isObject()) {
+    // No wasm code has run, so nothing has been sampled.
+    CHECK(JS::GetWasmFunctionSamples(cx, &v.toObject(), samples));
+    CHECK(samples.empty());
+  }
+
+  JS::SetWasmFunctionSampling(cx, false);
+  return true;
+}
+END_TEST(testJitDiagnostics_WasmFunctionSamples)
@@ -0,0 +1,37 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+ * vim: set ts=8 sts=2 et sw=2 tw=80:
+ */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "js/Transcoding.h"
+#include "jsapi-tests/tests.h"
+
+BEGIN_TEST(testJitHints_EncodeDecode) {
+  EXEC("function f(x) { return x + 1; } for (var i = 0; i < 100; i++) f(i);");
+
+  JS::TranscodeBuffer buffer;
+  CHECK(JS::EncodeJitHints(cx, buffer));
+  if (buffer.empty()) {
+    // JIT hints are disabled.
+    return true;
+  }
+
+  // Hints decode into the runtime that produced them.
+  JS::TranscodeRange range(buffer.begin(), buffer.length());
+  CHECK(JS::DecodeJitHints(cx, range) == JS::TranscodeResult::Ok);
+
+  // Truncated data is rejected.
+  JS::TranscodeRange truncated(buffer.begin(), buffer.length() - 1);
+  CHECK(JS::DecodeJitHints(cx, truncated) ==
+        JS::TranscodeResult::Failure_BadDecode);
+
+  // As is data with a bad header.
+  buffer[0] ^= 0xff;
+  CHECK(JS::DecodeJitHints(cx, range) ==
+        JS::TranscodeResult::Failure_BadDecode);
+
+  return true;
+}
+END_TEST(testJitHints_EncodeDecode)
@@ -54,7 +54,7 @@ static const JSClass TestProxyClasses[] = {
     PROXY_CLASS_DEF("TestProxy", JSCLASS_HAS_RESERVED_SLOTS(2)),
     PROXY_CLASS_DEF("TestProxy", JSCLASS_HAS_RESERVED_SLOTS(7)),
     PROXY_CLASS_DEF("TestProxy", JSCLASS_HAS_RESERVED_SLOTS(8)),
-    PROXY_CLASS_DEF("TestProxy", JSCLASS_HAS_RESERVED_SLOTS(14 /* Max */)),
+    PROXY_CLASS_DEF("TestProxy", JSCLASS_HAS_RESERVED_SLOTS(13 /* Max */)),
 };
 
 static const JSClass TestDOMClasses[] = {
@@ -421,7 +421,7 @@ bool CheckUniqueId(HandleObject obj, bool hasUniqueId, uint64_t uid) {
     // Swap may add a unique ID to an object.
   }
 
-  if (obj->is<NativeObject>()) {
+  if (obj->is<NativeObject>() || obj->is<ProxyObject>()) {
     CHECK(!obj->zone()->uniqueIds().has(obj));
   }
   return true;
@@ -15,6 +15,7 @@
 #include "js/MemoryFunctions.h"
 #include "js/Printf.h"
 #include "js/PropertyAndElement.h"  // JS_GetProperty
+#include "js/String.h"               // JS::StringHasLatin1Chars
 #include "jsapi-tests/tests.h"
 
 using namespace js;
@@ -357,3 +358,98 @@ inline bool TryParse(JSContext* cx, const char (&input)[N],
   return true;
 }
 END_TEST(testParseJSON_reviver)
+
+BEGIN_TEST(testParseJSON_predictedShape) {
+  // Objects at the same depth are created using the shape of the previous one
+  // when they have the same keys in the same order. Check that objects with
+  // different, reordered, duplicate or integer keys are still correct.
+  EXEC(
+      "var json = '[{\"x\":1,\"y\":{\"z\":2}},{\"x\":3,\"y\":{\"z\":4}},"
+      "{\"y\":5,\"x\":6},{\"x\":7,\"x\":8},{\"0\":9,\"x\":10},"
+      "{\"x\":11,\"y\":12},{},{}]';");
+
+  JS::RootedValue v(cx);
+  EVAL(
+      "var a = JSON.parse(json);"
+      "JSON.stringify(a) === "
+      "'[{\"x\":1,\"y\":{\"z\":2}},{\"x\":3,\"y\":{\"z\":4}},"
+      "{\"y\":5,\"x\":6},{\"x\":8},{\"0\":9,\"x\":10},"
+      "{\"x\":11,\"y\":12},{},{}]';",
+      &v);
+  CHECK(v.isTrue());
+
+  EVAL(
+      "Object.keys(a[2]).join() === 'y,x' &&"
+      "Object.keys(a[3]).join() === 'x' &&"
+      "Object.keys(a[4]).join() === '0,x';",
+      &v);
+  CHECK(v.isTrue());
+  return true;
+}
+END_TEST(testParseJSON_predictedShape)
+
+BEGIN_TEST(testParseJSON_chunked) {
+  // U+00E9 and U+1F600 are split across chunks.
+  const char* chunks[] = {"{\"a\": [1, 2", "], \"\xC3", "\xA9\": \"\xF0\x9F",
+                          "\x98", "", "\x80\"}"};
+  JS::RootedValue v(cx);
+  CHECK(ParseChunks(chunks, &v));
+  CHECK(JS_SetProperty(cx, global, "parsed", v));
+
+  EVAL(
+      "JSON.stringify(parsed) === "
+      "JSON.stringify({a: [1, 2], '\\u00e9': '\\ud83d\\ude00'})",
+      &v);
+  CHECK(v.isTrue());
+
+  // A sequence which is still incomplete at the end is malformed.
+  const char* truncated[] = {"\"\xE2\x82"};
+  CHECK(!ParseChunks(truncated, &v));
+  JS_ClearPendingException(cx);
+  return true;
+}
+
+template <size_t N>
+bool ParseChunks(const char* (&chunks)[N], JS::MutableHandleValue vp) {
+  JS::JSONChunkedParser* parser = JS::NewJSONChunkedParser(cx);
+  CHECK(parser);
+
+  bool ok = true;
+  for (const char* chunk : chunks) {
+    if (!JS::AppendJSONChunk(cx, parser, chunk, strlen(chunk))) {
+      ok = false;
+      break;
+    }
+  }
+  ok = ok && JS::FinishJSONChunkedParse(cx, parser, vp);
+  JS::DeleteJSONChunkedParser(parser);
+  return ok;
+}
+END_TEST(testParseJSON_chunked)
+
+BEGIN_TEST(testParseJSON_utf8) {
+  JS::RootedValue v(cx);
+  const char json[] =
+      "{\"caf\xC3\xA9\": \"cr\xC3\xA8me\", \"a\": [\"\xF0\x9F\x98\x80\\n\", "
+      "\"plain\"]}";
+  CHECK(JS::ParseJSONUTF8(cx, json, sizeof(json) - 1, &v));
+  CHECK(JS_SetProperty(cx, global, "parsed", v));
+
+  EVAL(
+      "JSON.stringify(parsed) === "
+      "JSON.stringify({'caf\\u00e9': 'cr\\u00e8me', "
+      "a: ['\\ud83d\\ude00\\n', 'plain']})",
+      &v);
+  CHECK(v.isTrue());
+
+  // Strings which fit in Latin-1 are stored as Latin-1.
+  EVAL("parsed['caf\\u00e9']", &v);
+  CHECK(v.isString());
+  CHECK(JS::StringHasLatin1Chars(v.toString()));
+
+  const char malformed[] = "[\"\xC3\"]";
+  CHECK(!JS::ParseJSONUTF8(cx, malformed, sizeof(malformed) - 1, &v));
+  JS_ClearPendingException(cx);
+  return true;
+}
+END_TEST(testParseJSON_utf8)
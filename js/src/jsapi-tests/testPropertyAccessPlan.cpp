@@ -0,0 +1,81 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+ * vim: set ts=8 sts=2 et sw=2 tw=80:
+ */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <iterator>  // std::size
+
+#include "js/PropertyAccessPlan.h"  // JS::PropertyAccessPlan, JS::GetProperties, JS::SetProperties
+#include "js/PropertyAndElement.h"  // JS_GetProperty
+#include "js/ValueArray.h"          // JS::RootedValueArray
+#include "jsapi-tests/tests.h"
+
+static const char* const PlanNames[] = {"x", "y", "z"};
+
+BEGIN_TEST(testPropertyAccessPlan_Get) {
+  JS::Rooted<JS::PropertyAccessPlan> plan(cx);
+  CHECK(plan.get().init(cx, PlanNames, std::size(PlanNames)));
+  CHECK(plan.get().length() == 3);
+
+  JS::RootedValue v(cx);
+  JS::RootedValueVector values(cx);
+
+  // The second object has the same shape as the first, so it is read from the
+  // cached slots.
+  for (int i = 0; i < 2; i++) {
+    EVAL("({x: 1, y: 'two', z: 3})", &v);
+    JS::RootedObject obj(cx, &v.toObject());
+    CHECK(JS::GetProperties(cx, obj, &plan, &values));
+    CHECK(values.length() == 3);
+    CHECK(values[0].isInt32(1));
+    CHECK(values[1].isString());
+    CHECK(values[2].isInt32(3));
+  }
+
+  // Missing properties and getters take the generic path.
+  EVAL("({x: 1, get y() { return 4; }})", &v);
+  JS::RootedObject obj(cx, &v.toObject());
+  CHECK(JS::GetProperties(cx, obj, &plan, &values));
+  CHECK(values[0].isInt32(1));
+  CHECK(values[1].isInt32(4));
+  CHECK(values[2].isUndefined());
+
+  return true;
+}
+END_TEST(testPropertyAccessPlan_Get)
+
+BEGIN_TEST(testPropertyAccessPlan_Set) {
+  JS::Rooted<JS::PropertyAccessPlan> plan(cx);
+  CHECK(plan.get().init(cx, PlanNames, std::size(PlanNames)));
+
+  JS::RootedValueArray<3> values(cx);
+  values[0].setInt32(10);
+  values[1].setInt32(20);
+  values[2].setInt32(30);
+
+  JS::RootedValue v(cx);
+  for (int i = 0; i < 2; i++) {
+    EVAL("({x: 1, y: 2, z: 3})", &v);
+    JS::RootedObject obj(cx, &v.toObject());
+    CHECK(JS::SetProperties(cx, obj, &plan, values));
+    CHECK(JS_GetProperty(cx, obj, "z", &v));
+    CHECK(v.isInt32(30));
+  }
+
+  // Read-only properties are never written through the cached slots.
+  for (int i = 0; i < 2; i++) {
+    EVAL("Object.defineProperty({x: 1, y: 2, z: 3}, 'y', {writable: false})",
+         &v);
+    JS::RootedObject obj(cx, &v.toObject());
+    CHECK(JS::SetProperties(cx, obj, &plan, values));
+    CHECK(JS_GetProperty(cx, obj, "x", &v));
+    CHECK(v.isInt32(10));
+    CHECK(JS_GetProperty(cx, obj, "y", &v));
+    CHECK(v.isInt32(2));
+  }
+
+  return true;
+}
+END_TEST(testPropertyAccessPlan_Set)
@@ -474,6 +474,43 @@ bool run() {
 }
 END_TEST(testScriptSourceCompression_spansMultipleMiddleChunks)
 
+BEGIN_TEST(testScriptSourceCompression_lz4) {
+  JS::SetSourceCompressionCodec(cx, JS::SourceCompressionCodec::LZ4);
+  bool ok = run<char16_t>() && run<Utf8Unit>();
+  JS::SetSourceCompressionCodec(cx, JS::SourceCompressionCodec::Zlib);
+  CHECK(ok);
+  return true;
+}
+
+template <typename Unit>
+bool run() {
+  // Three chunks, so that the function starts and ends in separately
+  // compressed LZ4 blocks.
+  constexpr size_t len = (3 * ChunkSize) / sizeof(Unit);
+  auto source = MakeSourceAllWhitespace<Unit>(cx, len);
+  CHECK(source);
+
+  constexpr size_t FunctionSize = 2 + ChunkSize / sizeof(Unit);
+
+  // Write out a 'u' or 'v' function.
+  constexpr char FunctionName = 't' + sizeof(Unit);
+  WriteFunctionOfSizeAtOffset(source, len, FunctionName, FunctionSize,
+                              ChunkSize / sizeof(Unit) - 1);
+
+  JS::Rooted<JSFunction*> fun(cx);
+  fun = EvaluateChars(cx, std::move(source), len, FunctionName, __FUNCTION__);
+  CHECK(fun);
+
+  CompressSourceSync(fun, cx);
+
+  JS::Rooted<JSString*> str(cx, DecompressSource(cx, fun));
+  CHECK(str);
+  CHECK(IsExpectedFunctionString(str, FunctionName, cx));
+
+  return true;
+}
+END_TEST(testScriptSourceCompression_lz4)
+
 BEGIN_TEST(testScriptSourceCompression_automatic) {
   constexpr size_t len = MinimumCompressibleLength + 55;
   auto chars = MakeSourceAllWhitespace<char16_t>(cx, len);
@@ -340,3 +340,120 @@ static bool TestGetBuildId(JS::BuildIdCharVector* buildId) {
   return buildId->append(buildid, sizeof(buildid));
 }
 END_TEST(testStencil_TranscodeBorrowing)
+
+BEGIN_TEST(testStencil_TranscodeSkipContentHash) {
+  JS::SetProcessBuildIdOp(TestGetBuildId);
+
+  JS::TranscodeBuffer buffer;
+
+  {
+    const char* chars =
+        "function f() { return 42; }"
+        "f();";
+
+    JS::SourceText<mozilla::Utf8Unit> srcBuf;
+    CHECK(srcBuf.init(cx, chars, strlen(chars), JS::SourceOwnership::Borrowed));
+
+    JS::CompileOptions options(cx);
+    RefPtr<JS::Stencil> stencil =
+        JS::CompileGlobalScriptToStencil(cx, options, srcBuf);
+    CHECK(stencil);
+
+    JS::TranscodeResult res = JS::EncodeStencil(cx, stencil, buffer);
+    CHECK(res == JS::TranscodeResult::Ok);
+  }
+
+  // The content length and hash immediately precede the content, which runs
+  // to the end of the buffer. Corrupt the hash.
+  size_t hashOffset = 0;
+  for (size_t i = 0; i + 8 <= buffer.length(); i++) {
+    uint32_t length;
+    memcpy(&length, buffer.begin() + i, sizeof(length));
+    if (i + 8 + length == buffer.length()) {
+      hashOffset = i + 4;
+      break;
+    }
+  }
+  CHECK(hashOffset != 0);
+  buffer[hashOffset] ^= 0xff;
+
+  JS::TranscodeRange range(buffer.begin(), buffer.length());
+  {
+    JS::DecodeOptions decodeOptions;
+    decodeOptions.borrowBuffer = true;
+    RefPtr<JS::Stencil> stencil;
+    JS::TranscodeResult res =
+        JS::DecodeStencil(cx, decodeOptions, range, getter_AddRefs(stencil));
+    CHECK(res == JS::TranscodeResult::Failure_BadDecode);
+  }
+
+  JS::RootedScript script(cx);
+  {
+    JS::DecodeOptions decodeOptions;
+    decodeOptions.borrowBuffer = true;
+    decodeOptions.skipContentHashCheck = true;
+    RefPtr<JS::Stencil> stencil;
+    JS::TranscodeResult res =
+        JS::DecodeStencil(cx, decodeOptions, range, getter_AddRefs(stencil));
+    CHECK(res == JS::TranscodeResult::Ok);
+
+    JS::InstantiateOptions instantiateOptions;
+    script = JS::InstantiateGlobalStencil(cx, instantiateOptions, stencil);
+    CHECK(script);
+  }
+
+  JS::RootedValue rval(cx);
+  CHECK(JS_ExecuteScript(cx, script, &rval));
+  CHECK(rval.isNumber() && rval.toNumber() == 42);
+
+  return true;
+}
+static bool TestGetBuildId(JS::BuildIdCharVector* buildId) {
+  const char buildid[] = "testXDR";
+  return buildId->append(buildid, sizeof(buildid));
+}
+END_TEST(testStencil_TranscodeSkipContentHash)
+
+BEGIN_TEST(testStencil_PreviousStencil) {
+  const char* previousChars =
+      "function g() { return 1; }\n"
+      "function f() { return g() + new Error().lineNumber; }\n"
+      "f.toString().startsWith('function f()') ? f() : 0;";
+
+  JS::SourceText<mozilla::Utf8Unit> previousBuf;
+  CHECK(previousBuf.init(cx, previousChars, strlen(previousChars),
+                         JS::SourceOwnership::Borrowed));
+
+  JS::CompileOptions previousOptions(cx);
+  RefPtr<JS::Stencil> previous =
+      JS::CompileGlobalScriptToStencil(cx, previousOptions, previousBuf);
+  CHECK(previous);
+
+  // |f| is copied from the previous stencil, and is shifted by one line.
+  const char* chars =
+      "var x = 39;\n"
+      "function g() { return x; }\n"
+      "function f() { return g() + new Error().lineNumber; }\n"
+      "f.toString().startsWith('function f()') ? f() : 0;";
+
+  JS::SourceText<mozilla::Utf8Unit> srcBuf;
+  CHECK(srcBuf.init(cx, chars, strlen(chars), JS::SourceOwnership::Borrowed));
+
+  JS::CompileOptions options(cx);
+  options.setPreviousStencil(previous);
+  RefPtr<JS::Stencil> stencil =
+      JS::CompileGlobalScriptToStencil(cx, options, srcBuf);
+  CHECK(stencil);
+
+  JS::InstantiateOptions instantiateOptions(options);
+  JS::RootedScript script(
+      cx, JS::InstantiateGlobalStencil(cx, instantiateOptions, stencil));
+  CHECK(script);
+
+  JS::RootedValue rval(cx);
+  CHECK(JS_ExecuteScript(cx, script, &rval));
+  CHECK(rval.isNumber() && rval.toNumber() == 42);
+
+  return true;
+}
+END_TEST(testStencil_PreviousStencil)
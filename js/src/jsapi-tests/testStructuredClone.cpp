@@ -364,3 +364,35 @@ BEGIN_TEST(testStructuredClone_SavedFrame) {
   return true;
 }
 END_TEST(testStructuredClone_SavedFrame)
+
+BEGIN_TEST(testStructuredClone_repeatedStrings) {
+  // Repeated keys and values are written once and referred to afterwards.
+  // "kind" appears as a value before it is used as a key.
+  JS::RootedValue v1(cx);
+  EVAL(
+      "var records = ['kind'];\n"
+      "for (var i = 0; i < 100; i++) {\n"
+      "  records.push({someLongPropertyName: i,\n"
+      "                kind: 'a fairly long property value'});\n"
+      "}\n"
+      "records;",
+      &v1);
+
+  JSAutoStructuredCloneBuffer buf(JS::StructuredCloneScope::DifferentProcess,
+                                  nullptr, nullptr);
+  CHECK(buf.write(cx, v1));
+  CHECK(buf.data().Size() < 100 * 64);
+
+  JS::RootedValue v2(cx);
+  CHECK(buf.read(cx, &v2));
+  CHECK(JS_SetProperty(cx, global, "cloned", v2));
+
+  JS::RootedValue same(cx);
+  EVAL(
+      "cloned !== records && "
+      "JSON.stringify(cloned) === JSON.stringify(records)",
+      &same);
+  CHECK(same.isTrue());
+  return true;
+}
+END_TEST(testStructuredClone_repeatedStrings)
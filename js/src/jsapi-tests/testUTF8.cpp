@@ -9,6 +9,9 @@
 #include "mozilla/Span.h"   // mozilla::Span
 #include "mozilla/Utf8.h"   // mozilla::ConvertUtf8toUtf16
 
+#include <iterator>  // std::size
+#include <string.h>  // memcmp, memcpy, memset
+
 #include "js/CharacterEncoding.h"
 #include "jsapi-tests/tests.h"
 
@@ -229,3 +232,91 @@ BEGIN_TEST(testUTF8_LossyConversion) {
   return true;
 }
 END_TEST(testUTF8_LossyConversion)
+
+BEGIN_TEST(testUTF8_NewStringCopyUTF8N) {
+  // Check non-ASCII input after ASCII prefixes of different lengths, so that
+  // both inline strings and strings with separate buffers are created.
+  char buf[256];
+  for (size_t prefix : {size_t(0), size_t(3), size_t(200)}) {
+    memset(buf, 'a', prefix);
+    char16_t ch;
+
+    // U+00E9 fits in Latin1.
+    memcpy(buf + prefix, "\xC3\xA9z", 3);
+    JSString* str = JS_NewStringCopyUTF8N(cx, JS::UTF8Chars(buf, prefix + 3));
+    CHECK(str);
+    CHECK(JS_GetStringLength(str) == prefix + 2);
+    CHECK(JS::StringHasLatin1Chars(str));
+    CHECK(JS_GetStringCharAt(cx, str, prefix, &ch));
+    CHECK(ch == 0xE9);
+    CHECK(JS_GetStringCharAt(cx, str, prefix + 1, &ch));
+    CHECK(ch == 'z');
+
+    // U+1F600 needs a surrogate pair.
+    memcpy(buf + prefix, "\xF0\x9F\x98\x80z", 5);
+    str = JS_NewStringCopyUTF8N(cx, JS::UTF8Chars(buf, prefix + 5));
+    CHECK(str);
+    CHECK(JS_GetStringLength(str) == prefix + 3);
+    CHECK(!JS::StringHasLatin1Chars(str));
+    CHECK(JS_GetStringCharAt(cx, str, prefix, &ch));
+    CHECK(ch == 0xD83D);
+    CHECK(JS_GetStringCharAt(cx, str, prefix + 1, &ch));
+    CHECK(ch == 0xDE00);
+    CHECK(JS_GetStringCharAt(cx, str, prefix + 2, &ch));
+    CHECK(ch == 'z');
+
+    // Malformed input after the ASCII prefix is still reported.
+    memcpy(buf + prefix, "\xC3z", 2);
+    CHECK(!JS_NewStringCopyUTF8N(cx, JS::UTF8Chars(buf, prefix + 2)));
+    CHECK(JS_IsExceptionPending(cx));
+    JS_ClearPendingException(cx);
+  }
+  return true;
+}
+END_TEST(testUTF8_NewStringCopyUTF8N)
+
+BEGIN_TEST(testUTF8_EncodeBufferPartialResume) {
+  // Split a surrogate pair across the halves of a rope. The right half is long
+  // enough that the concatenation isn't flattened into an inline string.
+  static const char16_t leftChars[] = {'a', 'b', 0xE9, 0xD83D};
+  char16_t rightChars[30];
+  rightChars[0] = 0xDE00;
+  for (size_t i = 1; i < std::size(rightChars); i++) {
+    rightChars[i] = 'c';
+  }
+  JS::RootedString left(cx, JS_NewUCStringCopyN(cx, leftChars, 4));
+  CHECK(left);
+  JS::RootedString right(
+      cx, JS_NewUCStringCopyN(cx, rightChars, std::size(rightChars)));
+  CHECK(right);
+  JS::RootedString str(cx, JS_ConcatStrings(cx, left, right));
+  CHECK(str);
+  size_t length = JS_GetStringLength(str);
+
+  char expected[64];
+  auto result = JS_EncodeStringToUTF8BufferPartial(cx, str,
+                                                   mozilla::Span(expected));
+  CHECK(result);
+  auto [expectedRead, expectedWritten] = *result;
+  CHECK(expectedRead == length);
+
+  // Encode again through four-byte buffers, resuming each time at the number
+  // of code units read so far.
+  char actual[64];
+  size_t start = 0;
+  size_t written = 0;
+  while (start < length) {
+    result = JS_EncodeStringToUTF8BufferPartial(
+        cx, str, start, mozilla::Span<char>(actual + written, 4));
+    CHECK(result);
+    auto [chunkRead, chunkWritten] = *result;
+    CHECK(chunkRead > 0);
+    start += chunkRead;
+    written += chunkWritten;
+  }
+  CHECK(start == length);
+  CHECK(written == expectedWritten);
+  CHECK(memcmp(expected, actual, written) == 0);
+  return true;
+}
+END_TEST(testUTF8_EncodeBufferPartialResume)
@@ -11,9 +11,11 @@
 #include "jsapi.h"
 
 #include "mozilla/FloatingPoint.h"
+#include "mozilla/Latin1.h"
 #include "mozilla/Maybe.h"
 #include "mozilla/PodOperations.h"
 #include "mozilla/Sprintf.h"
+#include "mozilla/Utf8.h"
 
 #include <algorithm>
 #include <cstdarg>
@@ -23,6 +25,8 @@
 #include <iterator>
 #include <stdarg.h>
 #include <string.h>
+#include <tuple>
+#include <type_traits>
 
 #include "jsexn.h"
 #include "jsfriendapi.h"
@@ -39,6 +43,7 @@
 #include "gc/GCContext.h"
 #include "gc/Marking.h"
 #include "gc/PublicIterators.h"
+#include "jit/JitRuntime.h"
 #include "jit/JitSpewer.h"
 #include "jit/TrampolineNatives.h"
 #include "js/CallAndConstruct.h"  // JS::IsCallable
@@ -49,10 +54,11 @@
 #include "js/Conversions.h"
 #include "js/Date.h"  // JS::GetReduceMicrosecondTimePrecisionCallback
 #include "js/ErrorInterceptor.h"
-#include "js/ErrorReport.h"           // JSErrorBase
-#include "js/experimental/JitInfo.h"  // JSJitInfo
-#include "js/friend/ErrorMessages.h"  // js::GetErrorMessage, JSMSG_*
-#include "js/friend/StackLimits.h"    // js::AutoCheckRecursionLimit
+#include "js/ErrorReport.h"             // JSErrorBase
+#include "js/experimental/JitInfo.h"    // JSJitInfo
+#include "js/experimental/JSStencil.h"  // JS::StencilAddRef, JS::StencilRelease
+#include "js/friend/ErrorMessages.h"    // js::GetErrorMessage, JSMSG_*
+#include "js/friend/StackLimits.h"      // js::AutoCheckRecursionLimit
 #include "js/GlobalObject.h"
 #include "js/Initialization.h"
 #include "js/Interrupt.h"
@@ -80,6 +86,7 @@
 #include "util/StringBuilder.h"
 #include "util/Text.h"
 #include "vm/BoundFunctionObject.h"
+#include "vm/Compression.h"  // js::CompressionCodec
 #include "vm/EnvironmentObject.h"
 #include "vm/ErrorObject.h"
 #include "vm/ErrorReporting.h"
@@ -101,6 +108,7 @@
 #include "vm/ToSource.h"
 #include "vm/Watchtower.h"
 #include "vm/WrapperObject.h"
+#include "wasm/WasmInstance.h"
 #include "wasm/WasmModule.h"
 #include "wasm/WasmProcess.h"
 
@@ -115,6 +123,7 @@
 #include "vm/NativeObject-inl.h"
 #include "vm/SavedStacks-inl.h"
 #include "vm/StringType-inl.h"
+#include "wasm/WasmInstance-inl.h"
 
 using namespace js;
 
@@ -1318,6 +1327,13 @@ JS_PUBLIC_API void JS::RunNurseryCollection(
   }
 }
 
+JS_PUBLIC_API bool JS::RunIdleTimeGCWork(JSContext* cx, JS::GCReason reason,
+                                         mozilla::TimeStamp deadline) {
+  AssertHeapIsIdle();
+  CHECK_THREAD(cx);
+  return cx->runtime()->gc.runIdleTimeWork(reason, deadline);
+}
+
 JS_PUBLIC_API void JS_GC(JSContext* cx, JS::GCReason reason) {
   AssertHeapIsIdle();
   JS::PrepareForFullGC(cx);
@@ -1359,6 +1375,12 @@ JS_PUBLIC_API void JS::SetHostCleanupFinalizationRegistryCallback(
   cx->runtime()->gc.setHostCleanupFinalizationRegistryCallback(cb, data);
 }
 
+JS_PUBLIC_API void JS::SetFinalizationRegistryCleanupBudget(
+    JSContext* cx, mozilla::TimeDuration budget) {
+  AssertHeapIsIdle();
+  cx->runtime()->gc.setFinalizationRegistryCleanupBudget(budget);
+}
+
 JS_PUBLIC_API void JS::ClearKeptObjects(JSContext* cx) {
   gc::GCRuntime* gc = &cx->runtime()->gc;
 
@@ -2466,6 +2488,7 @@ void JS::TransitiveCompileOptions::copyPODTransitiveOptions(
 
   borrowBuffer = rhs.borrowBuffer;
   usePinnedBytecode = rhs.usePinnedBytecode;
+  skipContentHashCheck = rhs.skipContentHashCheck;
   deoptimizeModuleGlobalVars = rhs.deoptimizeModuleGlobalVars;
 
   prefableOptions_ = rhs.prefableOptions_;
@@ -2492,10 +2515,17 @@ void JS::OwningCompileOptions::release() {
   js_free(const_cast<char*>(filename_.c_str()));
   js_free(const_cast<char16_t*>(sourceMapURL_));
   js_free(const_cast<char*>(introducerFilename_.c_str()));
+  js_free(const_cast<uint32_t*>(delazificationOrder_));
+  if (previousStencil_) {
+    JS::StencilRelease(previousStencil_);
+  }
 
   filename_ = JS::ConstUTF8CharsZ();
   sourceMapURL_ = nullptr;
   introducerFilename_ = JS::ConstUTF8CharsZ();
+  delazificationOrder_ = nullptr;
+  delazificationOrderLength_ = 0;
+  previousStencil_ = nullptr;
 }
 
 JS::OwningCompileOptions::~OwningCompileOptions() { release(); }
@@ -2503,7 +2533,8 @@ JS::OwningCompileOptions::~OwningCompileOptions() { release(); }
 size_t JS::OwningCompileOptions::sizeOfExcludingThis(
     mozilla::MallocSizeOf mallocSizeOf) const {
   return mallocSizeOf(filename_.c_str()) + mallocSizeOf(sourceMapURL_) +
-         mallocSizeOf(introducerFilename_.c_str());
+         mallocSizeOf(introducerFilename_.c_str()) +
+         mallocSizeOf(delazificationOrder_);
 }
 
 void JS::OwningCompileOptions::steal(JS::OwningCompileOptions&& rhs) {
@@ -2519,6 +2550,12 @@ void JS::OwningCompileOptions::steal(JS::OwningCompileOptions&& rhs) {
   rhs.introducerFilename_ = JS::ConstUTF8CharsZ();
   sourceMapURL_ = rhs.sourceMapURL_;
   rhs.sourceMapURL_ = nullptr;
+  delazificationOrder_ = rhs.delazificationOrder_;
+  delazificationOrderLength_ = rhs.delazificationOrderLength_;
+  rhs.delazificationOrder_ = nullptr;
+  rhs.delazificationOrderLength_ = 0;
+  previousStencil_ = rhs.previousStencil_;
+  rhs.previousStencil_ = nullptr;
 }
 
 void JS::OwningCompileOptions::steal(JS::OwningDecodeOptions&& rhs) {
@@ -2564,6 +2601,23 @@ bool JS::OwningCompileOptions::copyImpl(ContextT* cx,
     introducerFilename_ = JS::ConstUTF8CharsZ(str);
   }
 
+  if (rhs.delazificationOrder()) {
+    size_t length = rhs.delazificationOrderLength();
+    uint32_t* order = js_pod_malloc<uint32_t>(length);
+    if (!order) {
+      ReportOutOfMemory(cx);
+      return false;
+    }
+    std::copy_n(rhs.delazificationOrder(), length, order);
+    delazificationOrder_ = order;
+    delazificationOrderLength_ = length;
+  }
+
+  if (rhs.previousStencil()) {
+    previousStencil_ = rhs.previousStencil();
+    JS::StencilAddRef(previousStencil_);
+  }
+
   return true;
 }
 
@@ -3576,6 +3630,16 @@ JS_EncodeStringToUTF8BufferPartial(JSContext* cx, JSString* str,
   return str->encodeUTF8Partial(nogc, buffer);
 }
 
+JS_PUBLIC_API mozilla::Maybe<std::tuple<size_t, size_t>>
+JS_EncodeStringToUTF8BufferPartial(JSContext* cx, JSString* str, size_t start,
+                                   mozilla::Span<char> buffer) {
+  AssertHeapIsIdle();
+  CHECK_THREAD(cx);
+  MOZ_ASSERT(start <= str->length());
+  JS::AutoCheckCannotGC nogc;
+  return str->encodeUTF8Partial(nogc, buffer, start);
+}
+
 JS_PUBLIC_API JS::Symbol* JS::NewSymbol(JSContext* cx,
                                         HandleString description) {
   AssertHeapIsIdle();
@@ -3702,6 +3766,83 @@ JS_PUBLIC_API bool JS::ToJSON(JSContext* cx, HandleValue value,
   return callback(sb.rawTwoByteBegin(), sb.length(), data);
 }
 
+namespace {
+
+// Encodes the output of Stringify as UTF-8 into a fixed-size buffer, which is
+// passed to the embedding's callback whenever it fills up.
+class MOZ_STACK_CLASS UTF8JSONSink final : public StringifySink {
+  JSONUTF8WriteCallback callback_;
+  void* data_;
+  size_t length_ = 0;
+  char chunk_[JS::JSONUTF8ChunkSize];
+
+  bool writeChunk() {
+    MOZ_ASSERT(length_ > 0);
+    size_t length = length_;
+    length_ = 0;
+    return callback_(chunk_, length, data_);
+  }
+
+  template <typename CharT>
+  bool write(mozilla::Span<const CharT> chars) {
+    while (!chars.IsEmpty()) {
+      mozilla::Span<char> dest = mozilla::Span(chunk_).From(length_);
+      size_t read, written;
+      if constexpr (std::is_same_v<CharT, Latin1Char>) {
+        std::tie(read, written) =
+            mozilla::ConvertLatin1toUtf8Partial(mozilla::AsChars(chars), dest);
+      } else {
+        std::tie(read, written) =
+            mozilla::ConvertUtf16toUtf8Partial(chars, dest);
+      }
+      length_ += written;
+      chars = chars.From(read);
+
+      // The rest doesn't fit.
+      if (!chars.IsEmpty() && !writeChunk()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ public:
+  UTF8JSONSink(JSONUTF8WriteCallback callback, void* data)
+      : callback_(callback), data_(data) {}
+
+  bool flush(JSContext* cx, StringBuilder& sb) override {
+    // Stringify only flushes between members, and never writes lone
+    // surrogates, so surrogate pairs are not split.
+    bool ok = sb.isUnderlyingBufferLatin1()
+                  ? write(mozilla::Span<const Latin1Char>(sb.rawLatin1Begin(),
+                                                          sb.length()))
+                  : write(mozilla::Span<const char16_t>(sb.rawTwoByteBegin(),
+                                                        sb.length()));
+    sb.clear();
+    return ok;
+  }
+
+  bool finish() { return length_ == 0 || writeChunk(); }
+};
+
+}  // namespace
+
+JS_PUBLIC_API bool JS::ToJSONUTF8(JSContext* cx, HandleValue value,
+                                  HandleObject replacer, HandleValue space,
+                                  JSONUTF8WriteCallback callback, void* data) {
+  AssertHeapIsIdle();
+  CHECK_THREAD(cx);
+  cx->check(replacer, space);
+  StringBuilder sb(cx);
+  UTF8JSONSink sink(callback, data);
+  RootedValue v(cx, value);
+  if (!Stringify(cx, &v, replacer, space, sb, StringifyBehavior::Normal,
+                 &sink)) {
+    return false;
+  }
+  return sink.flush(cx, sb) && sink.finish();
+}
+
 JS_PUBLIC_API bool JS::ToJSONMaybeSafely(JSContext* cx, JS::HandleObject input,
                                          JSONWriteCallback callback,
                                          void* data) {
@@ -3774,6 +3915,127 @@ JS_PUBLIC_API bool JS_ParseJSONWithReviver(JSContext* cx, HandleString str,
                                     vp);
 }
 
+class JS::JSONChunkedParser {
+ public:
+  // Decoded text of the previous chunks.
+  StringBuilder text;
+
+  // Units of the UTF-8 sequence which is split at the end of the last chunk.
+  static constexpr size_t MaxPendingUnits = 4;
+  mozilla::Utf8Unit pending[MaxPendingUnits];
+  size_t pendingLength = 0;
+
+  explicit JSONChunkedParser(JSContext* cx) : text(cx) {}
+};
+
+// Return the number of units of the UTF-8 sequence starting with |lead|, or 1
+// if |lead| cannot start a sequence, in which case decoding reports an error.
+static size_t Utf8SequenceLength(mozilla::Utf8Unit lead) {
+  uint8_t unit = lead.toUint8();
+  if ((unit & 0b1110'0000) == 0b1100'0000) {
+    return 2;
+  }
+  if ((unit & 0b1111'0000) == 0b1110'0000) {
+    return 3;
+  }
+  if ((unit & 0b1111'1000) == 0b1111'0000) {
+    return 4;
+  }
+  return 1;
+}
+
+JS_PUBLIC_API JS::JSONChunkedParser* JS::NewJSONChunkedParser(JSContext* cx) {
+  AssertHeapIsIdle();
+  CHECK_THREAD(cx);
+  return cx->new_<JSONChunkedParser>(cx);
+}
+
+JS_PUBLIC_API bool JS::AppendJSONChunk(JSContext* cx,
+                                       JSONChunkedParser* parser,
+                                       const char* bytes, size_t length) {
+  AssertHeapIsIdle();
+  CHECK_THREAD(cx);
+
+  const auto* units = reinterpret_cast<const mozilla::Utf8Unit*>(bytes);
+
+  // Complete the sequence which was split at the end of the previous chunk.
+  if (parser->pendingLength > 0) {
+    size_t sequenceLength = Utf8SequenceLength(parser->pending[0]);
+    while (parser->pendingLength < sequenceLength && length > 0) {
+      parser->pending[parser->pendingLength++] = *units++;
+      length--;
+    }
+    if (parser->pendingLength < sequenceLength) {
+      return true;
+    }
+    if (!parser->text.append(parser->pending, parser->pendingLength)) {
+      return false;
+    }
+    parser->pendingLength = 0;
+  }
+
+  // Keep the last sequence of this chunk for later if it is incomplete.
+  size_t complete = length;
+  for (size_t i = 1; i < JSONChunkedParser::MaxPendingUnits && i <= length;
+       i++) {
+    mozilla::Utf8Unit unit = units[length - i];
+    if (mozilla::IsTrailingUnit(unit)) {
+      continue;
+    }
+    if (Utf8SequenceLength(unit) > i) {
+      complete = length - i;
+    }
+    break;
+  }
+
+  if (!parser->text.append(units, complete)) {
+    return false;
+  }
+
+  for (size_t i = complete; i < length; i++) {
+    parser->pending[parser->pendingLength++] = units[i];
+  }
+  return true;
+}
+
+JS_PUBLIC_API bool JS::FinishJSONChunkedParse(JSContext* cx,
+                                              JSONChunkedParser* parser,
+                                              MutableHandleValue vp) {
+  AssertHeapIsIdle();
+  CHECK_THREAD(cx);
+
+  // A sequence which is still incomplete is malformed, and is reported as
+  // such when decoded.
+  if (parser->pendingLength > 0) {
+    if (!parser->text.append(parser->pending, parser->pendingLength)) {
+      return false;
+    }
+    parser->pendingLength = 0;
+  }
+
+  StringBuilder& text = parser->text;
+  if (text.isUnderlyingBufferLatin1()) {
+    return ParseJSONWithReviver(
+        cx,
+        mozilla::Range<const Latin1Char>(text.rawLatin1Begin(), text.length()),
+        NullHandleValue, vp);
+  }
+  return ParseJSONWithReviver(
+      cx, mozilla::Range<const char16_t>(text.rawTwoByteBegin(), text.length()),
+      NullHandleValue, vp);
+}
+
+JS_PUBLIC_API void JS::DeleteJSONChunkedParser(JSONChunkedParser* parser) {
+  js_delete(parser);
+}
+
+JS_PUBLIC_API bool JS::ParseJSONUTF8(JSContext* cx, const char* bytes,
+                                     size_t length, MutableHandleValue vp) {
+  AssertHeapIsIdle();
+  CHECK_THREAD(cx);
+  return ParseJSONFromUTF8(cx, JS::UTF8Chars(bytes, length), vp);
+}
+
 /************************************************************************/
 
 JS_PUBLIC_API void JS_ReportErrorASCII(JSContext* cx, const char* format, ...) {
@@ -4269,6 +4531,55 @@ JS_PUBLIC_API void JS_SetOffthreadIonCompilationEnabled(JSContext* cx,
   cx->runtime()->setOffthreadIonCompilationEnabled(enabled);
 }
 
+JS_PUBLIC_API void JS::SetSourceCompressionCodec(JSContext* cx,
+                                                 SourceCompressionCodec codec) {
+  switch (codec) {
+    case SourceCompressionCodec::Zlib:
+      cx->runtime()->setSourceCompressionCodec(CompressionCodec::Zlib);
+      return;
+    case SourceCompressionCodec::LZ4:
+      cx->runtime()->setSourceCompressionCodec(CompressionCodec::LZ4);
+      return;
+  }
+  MOZ_CRASH("Unexpected source compression codec");
+}
+
+JS_PUBLIC_API bool JS::EncodeJitHints(JSContext* cx, TranscodeBuffer& buffer) {
+  AssertHeapIsIdle();
+  CHECK_THREAD(cx);
+
+  JSRuntime* rt = cx->runtime();
+  if (!rt->hasJitRuntime() || !rt->jitRuntime()->hasJitHintsMap()) {
+    return true;
+  }
+
+  if (!rt->jitRuntime()->getJitHintsMap()->encode(buffer)) {
+    ReportOutOfMemory(cx);
+    return false;
+  }
+  return true;
+}
+
+JS_PUBLIC_API JS::TranscodeResult JS::DecodeJitHints(
+    JSContext* cx, const TranscodeRange& range) {
+  AssertHeapIsIdle();
+  CHECK_THREAD(cx);
+
+  JSRuntime* rt = cx->runtime();
+  if (!rt->hasJitRuntime() && !rt->createJitRuntime(cx)) {
+    return TranscodeResult::Throw;
+  }
+  if (!rt->jitRuntime()->hasJitHintsMap()) {
+    return TranscodeResult::Ok;
+  }
+
+  TranscodeResult result = rt->jitRuntime()->getJitHintsMap()->decode(range);
+  if (result == TranscodeResult::Throw) {
+    ReportOutOfMemory(cx);
+  }
+  return result;
+}
+
 JS_PUBLIC_API void JS_SetGlobalJitCompilerOption(JSContext* cx,
                                                  JSJitCompilerOption opt,
                                                  uint32_t value) {
@@ -4908,6 +5219,70 @@ JS_PUBLIC_API RefPtr<JS::WasmModule> JS::GetWasmModule(HandleObject obj) {
   return const_cast<wasm::Module*>(&mobj.module());
 }
 
+static wasm::Instance* LazilyTieredWasmInstance(JSObject* obj) {
+  if (!obj->canUnwrapAs<WasmInstanceObject>()) {
+    return nullptr;
+  }
+  wasm::Instance& instance = obj->unwrapAs<WasmInstanceObject>().instance();
+  if (instance.code().mode() != wasm::CompileMode::LazyTiering) {
+    return nullptr;
+  }
+  return &instance;
+}
+
+JS_PUBLIC_API bool JS::GetWasmInstanceHotness(
+    JSContext* cx, HandleObject instanceObj, WasmFunctionHotnessVector& funcs) {
+  AssertHeapIsIdle();
+  CHECK_THREAD(cx);
+
+  wasm::Instance* instance = LazilyTieredWasmInstance(instanceObj);
+  if (!instance) {
+    return true;
+  }
+
+  const wasm::CodeMetadata& codeMeta = instance->codeMeta();
+  if (!funcs.reserve(funcs.length() + codeMeta.numFuncDefs())) {
+    ReportOutOfMemory(cx);
+    return false;
+  }
+  for (uint32_t funcIndex = codeMeta.numFuncImports;
+       funcIndex < codeMeta.numFuncs(); funcIndex++) {
+    WasmFunctionHotness hotness;
+    hotness.funcIndex = funcIndex;
+    hotness.hotnessCounter = instance->readHotnessCounter(funcIndex);
+    // Requesting tier-up resets the counter to INT32_MAX.
+    hotness.tierUpRequested = hotness.hotnessCounter == INT32_MAX;
+    funcs.infallibleAppend(hotness);
+  }
+  return true;
+}
+
+JS_PUBLIC_API bool JS::SetWasmFunctionHotness(JSContext* cx,
+                                              HandleObject instanceObj,
+                                              uint32_t funcIndex,
+                                              int32_t hotnessCounter) {
+  AssertHeapIsIdle();
+  CHECK_THREAD(cx);
+
+  wasm::Instance* instance = LazilyTieredWasmInstance(instanceObj);
+  if (!instance) {
+    return false;
+  }
+
+  const wasm::CodeMetadata& codeMeta = instance->codeMeta();
+  if (funcIndex >= codeMeta.numFuncs() || codeMeta.funcIsImport(funcIndex)) {
+    return false;
+  }
+
+  // Don't undo a tier-up request.
+  if (instance->readHotnessCounter(funcIndex) == INT32_MAX) {
+    return true;
+  }
+
+  instance->setHotnessCounter(funcIndex, std::max(hotnessCounter, 0));
+  return true;
+}
+
 JS_PUBLIC_API void JS::SetProcessLargeAllocationFailureCallback(
     JS::LargeAllocationFailureCallback lafc) {
   MOZ_ASSERT(!OnLargeAllocationFailure);
@@ -830,6 +830,27 @@ extern JS_PUBLIC_API void JS_SetOffthreadBaselineCompilationEnabled(
 extern JS_PUBLIC_API void JS_SetOffthreadIonCompilationEnabled(JSContext* cx,
                                                                bool enabled);
 
+namespace JS {
+
+enum class SourceCompressionCodec {
+  // Best compression ratio. This is the default.
+  Zlib,
+
+  // Faster compression and decompression, at the cost of larger compressed
+  // sources.
+  LZ4
+};
+
+/**
+ * Select the codec used to compress script sources that are enqueued for
+ * compression after this call. Sources that are already compressed keep
+ * their codec and can always be decompressed.
+ */
+extern JS_PUBLIC_API void SetSourceCompressionCodec(
+    JSContext* cx, SourceCompressionCodec codec);
+
+}  // namespace JS
+
 // clang-format off
 #define JIT_COMPILER_OPTIONS(Register) \
   Register(BASELINE_INTERPRETER_WARMUP_TRIGGER, "blinterp.warmup.trigger") \
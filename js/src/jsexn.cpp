@@ -221,6 +221,12 @@ struct SuppressErrorsGuard {
   ~SuppressErrorsGuard() { JS::SetWarningReporter(cx, prevReporter); }
 };
 
+// The stack is captured eagerly: recording only (script, pc) pairs and
+// materializing SavedFrames on first use of |stack| would lose the async
+// parent stacks and debugger eval links, which are only reachable through the
+// live activations. The per-(script, pc) location lookups are cached in
+// SavedStacks::pcLocationMap, and identical frames are shared through
+// SavedStacks::frames, so re-capturing the same stack mostly hits caches.
 bool js::CaptureStack(JSContext* cx, MutableHandleObject stack) {
   return CaptureCurrentStack(
       cx, stack, JS::StackCapture(JS::MaxFrames(MAX_REPORTED_STACK_DEPTH)));
@@ -544,6 +544,21 @@ extern JS_PUBLIC_API bool AllowNewWrapper(JS::Compartment* target,
 
 extern JS_PUBLIC_API bool NukedObjectRealm(JSObject* obj);
 
+/*
+ * Cut every cross-compartment wrapper into the realms of |zone| and run a
+ * non-incremental GC of that zone alone. This is meant for embedders that
+ * create a zone per sandbox and want it freed as soon as the sandbox is done
+ * with, rather than when the next full GC happens to run.
+ *
+ * Once the wrappers are nuked, other zones can no longer keep it alive. If the
+ * embedder holds no roots into the zone either, marking finds nothing live and
+ * the zone is destroyed at the end of the GC. Callers must not use |zone|
+ * afterwards.
+ *
+ * The zone must not be the atoms zone or the current zone of |cx|.
+ */
+extern JS_PUBLIC_API bool NukeAndCollectZone(JSContext* cx, JS::Zone* zone);
+
 /* Implemented in jsdate.cpp. */
 
 /** Detect whether the internal date value is NaN. */
@@ -22,15 +22,18 @@
 #include "jsapi.h"
 #include "jstypes.h"
 
+#include "builtin/Array.h"
 #include "jit/InlinableNatives.h"
 #include "js/Class.h"
 #include "js/ForOfIterator.h"
 #include "js/Prefs.h"
 #include "js/PropertySpec.h"
 #include "util/DifferentialTesting.h"
+#include "vm/ArrayObject.h"
 #include "vm/Float16.h"
 #include "vm/Interpreter.h"
 #include "vm/JSContext.h"
+#include "vm/PIC.h"
 #include "vm/Realm.h"
 #include "vm/Time.h"
 #include "xsum/xsum.h"
@@ -952,6 +955,116 @@ enum class SumPreciseState : uint8_t {
   NotANumber,
 };
 
+// Math.sumPrecise, step 7.b.vi.
+static void SumPreciseAdd(SumPreciseState* state, xsum_small_accumulator* sum,
+                          double n) {
+  if (*state == SumPreciseState::NotANumber) {
+    return;
+  }
+
+  // Step 7.b.vi.1. If n is NaN, then
+  if (std::isnan(n)) {
+    // Step 7.b.vi.1.a. Set state to not-a-number.
+    *state = SumPreciseState::NotANumber;
+  } else if (n == PositiveInfinity<double>()) {
+    // Step 7.b.vi.2. Else if n is +∞𝔽, then
+    if (*state == SumPreciseState::MinusInfinity) {
+      // Step 7.b.vi.2.a. If state is minus-infinity, set state to
+      //                  not-a-number.
+      *state = SumPreciseState::NotANumber;
+    } else {
+      // Step 7.b.vi.2.b. Else, set state to plus-infinity.
+      *state = SumPreciseState::PlusInfinity;
+    }
+  } else if (n == NegativeInfinity<double>()) {
+    // Step 7.b.vi.3. Else if n is -∞𝔽, then
+    if (*state == SumPreciseState::PlusInfinity) {
+      // Step 7.b.vi.3.a. If state is plus-infinity, set state to
+      //                  not-a-number.
+      *state = SumPreciseState::NotANumber;
+    } else {
+      // Step 7.b.vi.3.b. Else, set state to minus-infinity.
+      *state = SumPreciseState::MinusInfinity;
+    }
+  } else if (!IsNegativeZero(n) && (*state == SumPreciseState::MinusZero ||
+                                    *state == SumPreciseState::Finite)) {
+    // Step 7.b.vi.4. Else if n is not -0𝔽 and state is either minus-zero or
+    //                finite, then
+    // Step 7.b.vi.4.a. Set state to finite.
+    *state = SumPreciseState::Finite;
+
+    // Step 7.b.vi.4.b. Set sum to sum + ℝ(n).
+    xsum_small_add1(sum, n);
+  }
+}
+
+// Math.sumPrecise, steps 8-12.
+static double SumPreciseResult(SumPreciseState state,
+                               xsum_small_accumulator* sum) {
+  switch (state) {
+    case SumPreciseState::NotANumber:
+      // Step 8. If state is not-a-number, return NaN.
+      return GenericNaN();
+    case SumPreciseState::PlusInfinity:
+      // Step 9. If state is plus-infinity, return +∞𝔽.
+      return PositiveInfinity<double>();
+    case SumPreciseState::MinusInfinity:
+      // Step 10. If state is minus-infinity, return -∞𝔽.
+      return NegativeInfinity<double>();
+    case SumPreciseState::MinusZero:
+      // Step 11. If state is minus-zero, return -0𝔽.
+      return -0.0;
+    case SumPreciseState::Finite:
+      // Step 12. Return 𝔽(sum).
+      return xsum_small_round(sum);
+  }
+  MOZ_CRASH("unexpected state");
+}
+
+// Fast path for packed arrays which are iterated with the default array
+// iterator. Reading the elements has no observable side-effects, so we can
+// skip the iterator protocol and sum the elements directly. If a non-Number
+// element is found, we bail out and let the generic path report the error.
+static bool TrySumPreciseDenseArray(JSContext* cx, HandleValue items,
+                                    bool* optimized, double* result) {
+  *optimized = false;
+
+  if (!items.isObject() || !IsPackedArray(&items.toObject())) {
+    return true;
+  }
+
+  Rooted<ArrayObject*> arr(cx, &items.toObject().as<ArrayObject>());
+
+  ForOfPIC::Chain* stubChain = ForOfPIC::getOrCreate(cx);
+  if (!stubChain) {
+    return false;
+  }
+
+  bool optimizable;
+  if (!stubChain->tryOptimizeArray(cx, arr, &optimizable)) {
+    return false;
+  }
+  if (!optimizable) {
+    return true;
+  }
+
+  SumPreciseState state = SumPreciseState::MinusZero;
+  xsum_small_accumulator sum;
+  xsum_small_init(&sum);
+
+  for (uint32_t i = 0, len = arr->length(); i < len; i++) {
+    const Value& value = arr->getDenseElement(i);
+    if (!value.isNumber()) {
+      return true;
+    }
+    SumPreciseAdd(&state, &sum, value.toNumber());
+  }
+
+  *optimized = true;
+  *result = SumPreciseResult(state, &sum);
+  return true;
+}
+
 /**
  * Math.sumPrecise ( items )
  *
@@ -966,6 +1079,16 @@ static bool math_sumPrecise(JSContext* cx, unsigned argc, Value* vp) {
     return false;
   }
 
+  bool optimized;
+  double result;
+  if (!TrySumPreciseDenseArray(cx, args[0], &optimized, &result)) {
+    return false;
+  }
+  if (optimized) {
+    args.rval().setNumber(result);
+    return true;
+  }
+
   // Step 2. Let iteratorRecord be ? GetIterator(items, sync).
   JS::ForOfIterator iterator(cx);
   if (!iterator.init(args[0], JS::ForOfIterator::ThrowOnNonIterable)) {
@@ -1028,74 +1151,11 @@ static bool math_sumPrecise(JSContext* cx, unsigned argc, Value* vp) {
     }
 
     // Step 7.b.v. Let n be next.
-    double n = value.toNumber();
-
     // Step 7.b.vi. If state is not not-a-number, then
-    if (state == SumPreciseState::NotANumber) {
-      continue;
-    }
-
-    // Step 7.b.vi.1. If n is NaN, then
-    if (std::isnan(n)) {
-      // Step 7.b.vi.1.a. Set state to not-a-number.
-      state = SumPreciseState::NotANumber;
-    } else if (n == PositiveInfinity<double>()) {
-      // Step 7.b.vi.2. Else if n is +∞𝔽, then
-      if (state == SumPreciseState::MinusInfinity) {
-        // Step 7.b.vi.2.a. If state is minus-infinity, set state to
-        //                  not-a-number.
-        state = SumPreciseState::NotANumber;
-      } else {
-        // Step 7.b.vi.2.b. Else, set state to plus-infinity.
-        state = SumPreciseState::PlusInfinity;
-      }
-    } else if (n == NegativeInfinity<double>()) {
-      // Step 7.b.vi.3. Else if n is -∞𝔽, then
-      if (state == SumPreciseState::PlusInfinity) {
-        // Step 7.b.vi.3.a. If state is plus-infinity, set state to
-        //                  not-a-number.
-        state = SumPreciseState::NotANumber;
-      } else {
-        // Step 7.b.vi.3.b. Else, set state to minus-infinity.
-        state = SumPreciseState::MinusInfinity;
-      }
-    } else if (!IsNegativeZero(n) && (state == SumPreciseState::MinusZero ||
-                                      state == SumPreciseState::Finite)) {
-      // Step 7.b.vi.4. Else if n is not -0𝔽 and state is either minus-zero or
-      //                finite, then
-      // Step 7.b.vi.4.a. Set state to finite.
-      state = SumPreciseState::Finite;
-
-      // Step 7.b.vi.4.b. Set sum to sum + ℝ(n).
-      xsum_small_add1(&sum, n);
-    }
-  }
-
-  double rval;
-  switch (state) {
-    case SumPreciseState::NotANumber:
-      // Step 8. If state is not-a-number, return NaN.
-      rval = GenericNaN();
-      break;
-    case SumPreciseState::PlusInfinity:
-      // Step 9. If state is plus-infinity, return +∞𝔽.
-      rval = PositiveInfinity<double>();
-      break;
-    case SumPreciseState::MinusInfinity:
-      // Step 10. If state is minus-infinity, return -∞𝔽.
-      rval = NegativeInfinity<double>();
-      break;
-    case SumPreciseState::MinusZero:
-      // Step 11. If state is minus-zero, return -0𝔽.
-      rval = -0.0;
-      break;
-    case SumPreciseState::Finite:
-      // Step 12. Return 𝔽(sum).
-      rval = xsum_small_round(&sum);
-      break;
+    SumPreciseAdd(&state, &sum, value.toNumber());
   }
 
-  args.rval().setNumber(rval);
+  args.rval().setNumber(SumPreciseResult(state, &sum));
   return true;
 }
 
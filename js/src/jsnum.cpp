@@ -772,7 +772,7 @@ static JSLinearString* LookupInt32ToString(JSContext* cx, int32_t si) {
   if (StaticStrings::hasInt(si)) {
     return cx->staticStrings().getInt(si);
   }
-  return cx->realm()->dtoaCache.lookup(10, si);
+  return cx->realm()->int32ToStringCache.lookup(si);
 }
 
 template <AllowGC allowGC>
@@ -805,7 +805,7 @@ JSLinearString* js::Int32ToStringWithHeap(JSContext* cx, int32_t si,
     str->maybeInitializeIndexValue(si);
   }
 
-  cx->realm()->dtoaCache.cache(10, si, str);
+  cx->realm()->int32ToStringCache.cache(si, str);
   return str;
 }
 template JSLinearString* js::Int32ToStringWithHeap<CanGC>(JSContext* cx,
@@ -840,7 +840,7 @@ JSAtom* js::Int32ToAtom(JSContext* cx, int32_t si) {
     return nullptr;
   }
 
-  cx->realm()->dtoaCache.cache(10, si, atom);
+  cx->realm()->int32ToStringCache.cache(si, atom);
   return atom;
 }
 
@@ -2205,11 +2205,122 @@ bool js::ToIndexSlow(JSContext* cx, JS::HandleValue v,
   return true;
 }
 
+// Parses the longest prefix of [begin, end) which has the form
+// `[+-]digits[.digits][(e|E)[+-]digits]`, and returns true if its value can be
+// computed exactly with a single correctly rounded double operation: the
+// significand has at most 19 non-zero-leading digits and fits into 53 bits,
+// and the decimal exponent is within the range of exactly representable
+// powers of ten (Clinger's fast path).
+//
+// Most numbers in JSON and text data are short decimals which take this path,
+// so they don't have to go through the generic StringToDoubleConverter.
+template <typename CharT>
+static bool FastDecimalStrtod(const CharT* begin, const CharT* end,
+                              double* result, const CharT** dEnd) {
+  static constexpr double PowersOfTen[] = {
+      1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+  };
+  static constexpr int MaxExactPowerOfTen = std::size(PowersOfTen) - 1;
+  static constexpr size_t MaxSignificandDigits = 19;
+  static constexpr uint64_t MaxExactSignificand =
+      uint64_t(1) << (mozilla::FloatingPoint<double>::kSignificandWidth + 1);
+
+  const CharT* s = begin;
+  bool negative = false;
+  if (s < end && (*s == '-' || *s == '+')) {
+    negative = *s == '-';
+    s++;
+  }
+
+  uint64_t significand = 0;
+  size_t significandDigits = 0;
+  int exponent = 0;
+  bool sawDigit = false;
+
+  auto accumulate = [&](CharT c) {
+    sawDigit = true;
+    if (significand == 0 && c == '0') {
+      return true;
+    }
+    if (++significandDigits > MaxSignificandDigits) {
+      return false;
+    }
+    significand = significand * 10 + (c - '0');
+    return true;
+  };
+
+  for (; s < end && IsAsciiDigit(*s); s++) {
+    if (!accumulate(*s)) {
+      return false;
+    }
+  }
+  if (s < end && *s == '.') {
+    s++;
+    for (; s < end && IsAsciiDigit(*s); s++) {
+      if (!accumulate(*s)) {
+        return false;
+      }
+      exponent--;
+    }
+  }
+  if (!sawDigit) {
+    return false;
+  }
+
+  // The exponent part is only consumed if it contains at least one digit,
+  // otherwise it's trailing junk.
+  if (s < end && (*s == 'e' || *s == 'E')) {
+    const CharT* e = s + 1;
+    bool negativeExponent = false;
+    if (e < end && (*e == '-' || *e == '+')) {
+      negativeExponent = *e == '-';
+      e++;
+    }
+    if (e < end && IsAsciiDigit(*e)) {
+      int explicitExponent = 0;
+      for (; e < end && IsAsciiDigit(*e); e++) {
+        explicitExponent = explicitExponent * 10 + (*e - '0');
+        if (explicitExponent > 2 * MaxExactPowerOfTen) {
+          return false;
+        }
+      }
+      exponent += negativeExponent ? -explicitExponent : explicitExponent;
+      s = e;
+    }
+  }
+
+  if (significand > MaxExactSignificand) {
+    return false;
+  }
+
+  double d = double(significand);
+  if (significand != 0) {
+    if (exponent < -MaxExactPowerOfTen || exponent > MaxExactPowerOfTen) {
+      return false;
+    }
+    if (exponent < 0) {
+      d /= PowersOfTen[-exponent];
+    } else {
+      d *= PowersOfTen[exponent];
+    }
+  }
+
+  *result = negative ? -d : d;
+  *dEnd = s;
+  return true;
+}
+
 template <typename CharT>
 double js_strtod(const CharT* begin, const CharT* end, const CharT** dEnd) {
   const CharT* s = SkipSpace(begin, end);
   size_t length = end - s;
 
+  double fast;
+  if (FastDecimalStrtod(s, end, &fast, dEnd)) {
+    return fast;
+  }
+
   {
     // StringToDouble can make indirect calls but can't trigger a GC.
     JS::AutoSuppressGCAnalysis nogc;
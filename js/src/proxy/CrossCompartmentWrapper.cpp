@@ -7,6 +7,7 @@
 #include "builtin/FinalizationRegistryObject.h"
 #include "gc/GC.h"
 #include "gc/PublicIterators.h"
+#include "js/GCAPI.h"  // JS::PrepareZoneForGC, JS::NonIncrementalGC
 #include "js/friend/WindowProxy.h"  // js::IsWindow, js::IsWindowProxy
 #include "js/Wrapper.h"
 #include "proxy/DeadObjectProxy.h"
@@ -483,6 +484,26 @@ JS_PUBLIC_API bool js::NukedObjectRealm(JSObject* obj) {
   return obj->nonCCWRealm()->nukedIncomingWrappers;
 }
 
+JS_PUBLIC_API bool js::NukeAndCollectZone(JSContext* cx, JS::Zone* zone) {
+  CHECK_THREAD(cx);
+  MOZ_ASSERT(!zone->isAtomsZone());
+  MOZ_ASSERT(cx->zone() != zone);
+
+  for (RealmsInZoneIter realm(zone); !realm.done(); realm.next()) {
+    if (!NukeCrossCompartmentWrappers(cx, AllCompartments(), realm,
+                                      NukeWindowReferences,
+                                      NukeAllReferences)) {
+      return false;
+    }
+  }
+
+  // Only the sandbox zone is collected, so the cost of this GC is that of
+  // sweeping the zone rather than marking the whole heap.
+  JS::PrepareZoneForGC(cx, zone);
+  JS::NonIncrementalGC(cx, JS::GCOptions::Normal, JS::GCReason::API);
+  return true;
+}
+
 // Given a cross-compartment wrapper |wobj|, update it to point to
 // |newTarget|. This recomputes the wrapper with JS_WrapValue, and thus can be
 // useful even if wrapper already points to newTarget.
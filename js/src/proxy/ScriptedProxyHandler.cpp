@@ -1183,9 +1183,30 @@ void ScriptedProxyHandler::reportGetTrapValidationError(
   }
 }
 
+// Returns true if |target| may have a non-configurable property which is
+// either a non-writable data property or an accessor property, i.e. one which
+// the [[Get]] and [[Set]] trap result checks can reject.
+static bool MayNeedGetSetTrapResultValidation(JSObject* target) {
+  if (!target->is<NativeObject>()) {
+    return true;
+  }
+
+  // Resolve hooks can lazily define such properties, and frozen dense
+  // elements aren't reflected in the object flags.
+  NativeObject* nobj = &target->as<NativeObject>();
+  return nobj->getClass()->getResolve() ||
+         nobj->needsProxyGetSetResultValidation() ||
+         nobj->denseElementsAreFrozen();
+}
+
 ScriptedProxyHandler::GetTrapValidationResult
 ScriptedProxyHandler::checkGetTrapResult(JSContext* cx, HandleObject target,
                                          HandleId id, HandleValue trapResult) {
+  // Steps 9-10 can't fail if the target has no properties to check against.
+  if (!MayNeedGetSetTrapResultValidation(target)) {
+    return GetTrapValidationResult::OK;
+  }
+
   // Step 9.
   Rooted<Maybe<PropertyDescriptor>> desc(cx);
   if (!GetOwnPropertyDescriptor(cx, target, id, &desc)) {
@@ -1272,6 +1293,11 @@ bool ScriptedProxyHandler::set(JSContext* cx, HandleObject proxy, HandleId id,
     return result.fail(JSMSG_PROXY_SET_RETURNED_FALSE);
   }
 
+  // Steps 10-11 can't fail if the target has no properties to check against.
+  if (!MayNeedGetSetTrapResultValidation(target)) {
+    return result.succeed();
+  }
+
   // Step 10.
   Rooted<Maybe<PropertyDescriptor>> desc(cx);
   if (!GetOwnPropertyDescriptor(cx, target, id, &desc)) {
@@ -3706,6 +3706,105 @@ static bool StopTimingMutator(JSContext* cx, unsigned argc, Value* vp) {
   return true;
 }
 
+static bool Bench(JSContext* cx, unsigned argc, Value* vp) {
+  CallArgs args = CallArgsFromVp(argc, vp);
+  if (!args.requireAtLeast(cx, "bench", 1)) {
+    return false;
+  }
+
+  if (!args[0].isObject() || !IsCallable(args[0])) {
+    JS_ReportErrorASCII(cx, "bench's first argument should be a function.");
+    return false;
+  }
+
+  uint32_t iterations = 10;
+  if (args.length() > 1 && !args[1].isUndefined()) {
+    if (!JS::ToUint32(cx, args[1], &iterations)) {
+      return false;
+    }
+    if (iterations == 0) {
+      JS_ReportErrorASCII(cx, "bench needs at least one iteration.");
+      return false;
+    }
+  }
+
+  uint32_t warmup = iterations;
+  if (args.length() > 2 && !args[2].isUndefined()) {
+    if (!JS::ToUint32(cx, args[2], &warmup)) {
+      return false;
+    }
+  }
+
+  RootedValue fun(cx, args[0]);
+  RootedValue rval(cx);
+
+  // Untimed runs to let the function reach its steady-state JIT tier.
+  for (uint32_t i = 0; i < warmup; i++) {
+    if (!JS::Call(cx, UndefinedHandleValue, fun, JS::HandleValueArray::empty(),
+                  &rval)) {
+      return false;
+    }
+  }
+
+  Vector<double, 0, SystemAllocPolicy> times;
+  if (!times.reserve(iterations)) {
+    ReportOutOfMemory(cx);
+    return false;
+  }
+
+  gc::GCRuntime& gc = cx->runtime()->gc;
+  uint64_t minorGCsBefore = gc.minorGCCount();
+  uint64_t majorGCsBefore = gc.majorGCCount();
+
+  for (uint32_t i = 0; i < iterations; i++) {
+    TimeStamp start = TimeStamp::Now();
+    if (!JS::Call(cx, UndefinedHandleValue, fun, JS::HandleValueArray::empty(),
+                  &rval)) {
+      return false;
+    }
+    times.infallibleAppend((TimeStamp::Now() - start).ToMilliseconds());
+  }
+
+  uint64_t minorGCs = gc.minorGCCount() - minorGCsBefore;
+  uint64_t majorGCs = gc.majorGCCount() - majorGCsBefore;
+
+  double total = 0;
+  for (double t : times) {
+    total += t;
+  }
+  std::sort(times.begin(), times.end());
+
+  size_t p99Index = (size_t(iterations) * 99 + 99) / 100 - 1;
+
+  RootedObject obj(cx, JS_NewPlainObject(cx));
+  if (!obj) {
+    return false;
+  }
+
+  struct {
+    const char* name;
+    double value;
+  } results[] = {
+      {"iterations", double(iterations)},
+      {"min", times[0]},
+      {"median", times[times.length() / 2]},
+      {"p99", times[p99Index]},
+      {"max", times.back()},
+      {"mean", total / iterations},
+      {"minorGCs", double(minorGCs)},
+      {"majorGCs", double(majorGCs)},
+  };
+  for (const auto& result : results) {
+    if (!JS_DefineProperty(cx, obj, result.name, result.value,
+                           JSPROP_ENUMERATE)) {
+      return false;
+    }
+  }
+
+  args.rval().setObject(*obj);
+  return true;
+}
+
 static const char* ToSource(JSContext* cx, HandleValue vp, UniqueChars* bytes) {
   RootedString str(cx, JS_ValueToSource(cx, vp));
   if (str) {
@@ -9990,6 +10089,13 @@ static const JSFunctionSpecWithHelp shell_functions[] = {
 "stopTimingMutator()",
 "  Stop accounting time to mutator vs GC and dump the results."),
 
+    JS_FN_HELP("bench", Bench, 1, 0,
+"bench(fun[, iterations[, warmup]])",
+"  Call |fun| |warmup| times (default: |iterations|), then time |iterations|\n"
+"  further calls (default: 10). Returns an object with the min, median, p99,\n"
+"  max and mean time per call in milliseconds, and the number of minor and\n"
+"  major GCs during the timed calls."),
+
     JS_FN_HELP("throwError", ThrowError, 0, 0,
 "throwError()",
 "  Throw an error from JS_ReportError."),
@@ -12836,6 +12942,8 @@ bool InitOptionParser(OptionParser& op) {
           "  backtracking: Priority based backtracking register allocation "
           "(default)\n"
           "  testbed: Backtracking allocator with experimental features\n"
+          "  fast: Backtracking allocator without eviction, used by default "
+          "for very large functions\n"
           "  stupid: Simple block local register allocation") ||
       !op.addBoolOption(
           '\0', "ion-eager",
@@ -13054,9 +13162,13 @@ bool InitOptionParser(OptionParser& op) {
           '\0', "delazification-mode", "[option]",
           "Select one of the delazification mode for scripts given on the "
           "command line, valid options are: "
-          "'on-demand', 'concurrent-df', 'eager', 'concurrent-df+on-demand'. "
+          "'on-demand', 'concurrent-df', 'eager', 'eager-concurrent', "
+          "'concurrent-df+on-demand'. "
           "Choosing 'concurrent-df+on-demand' will run both concurrent-df and "
           "on-demand delazification mode, and compare compilation outcome. ") ||
+      !op.addStringOption('\0', "source-compression", "[option]",
+                          "Select the codec used to compress script sources, "
+                          "valid options are: 'zlib' (default), 'lz4'.") ||
       !op.addBoolOption('\0', "wasm-compile-and-serialize",
                         "Compile the wasm bytecode from stdin and serialize "
                         "the results to stdout") ||
@@ -13469,6 +13581,9 @@ bool SetContextOptions(JSContext* cx, const OptionParser& op) {
     } else if (strcmp(mode, "eager") == 0) {
       defaultDelazificationMode =
           JS::DelazificationOption::ParseEverythingEagerly;
+    } else if (strcmp(mode, "eager-concurrent") == 0) {
+      defaultDelazificationMode =
+          JS::DelazificationOption::ParseEverythingConcurrently;
     } else if (strcmp(mode, "concurrent-df+on-demand") == 0 ||
                strcmp(mode, "on-demand+concurrent-df") == 0) {
       defaultDelazificationMode =
@@ -13478,6 +13593,16 @@ bool SetContextOptions(JSContext* cx, const OptionParser& op) {
     }
   }
 
+  if (const char* codec = op.getStringOption("source-compression")) {
+    if (strcmp(codec, "zlib") == 0) {
+      JS::SetSourceCompressionCodec(cx, JS::SourceCompressionCodec::Zlib);
+    } else if (strcmp(codec, "lz4") == 0) {
+      JS::SetSourceCompressionCodec(cx, JS::SourceCompressionCodec::LZ4);
+    } else {
+      return OptionFailure("source-compression", codec);
+    }
+  }
+
   return true;
 }
 
@@ -27,6 +27,17 @@ static MOZ_ALWAYS_INLINE void* js_memcpy(void* dst_, const void* src_,
 
 namespace js {
 
+// Hint to the processor that the memory at |ptr| is about to be read. This
+// never faults and has no effect on correctness, so it is fine to pass a
+// pointer that will turn out not to be used.
+static MOZ_ALWAYS_INLINE void PrefetchForRead(const void* ptr) {
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(ptr, 0, 3);
+#else
+  (void)ptr;
+#endif
+}
+
 template <typename T, typename U>
 static constexpr U ComputeByteAlignment(T bytes, U alignment) {
   static_assert(std::is_unsigned_v<U>, "alignment amount must be unsigned");
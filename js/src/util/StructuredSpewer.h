@@ -73,7 +73,8 @@ namespace js {
 
 #  define STRUCTURED_CHANNEL_LIST(_) \
     _(BaselineICStats)               \
-    _(CacheIRHealthReport)
+    _(CacheIRHealthReport)           \
+    _(JitCompiles)
 
 // Structured spew channels
 enum class SpewChannel {
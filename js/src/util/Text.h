@@ -75,6 +75,41 @@ static constexpr bool IsAsciiPrintable(CharT c) {
   return ' ' <= uc && uc <= '~';
 }
 
+namespace detail {
+
+template <typename CharT>
+constexpr bool IsStringChar =
+    std::is_same_v<CharT, JS::Latin1Char> || std::is_same_v<CharT, char16_t>;
+
+// Number of characters compared at once by SkipEqualCharBlocks.
+static constexpr size_t EqualCharBlockLength = 16;
+
+// Return the start of the first block of EqualCharBlockLength characters in
+// which |s1| and |s2| differ. If all whole blocks are equal, return the start
+// of the trailing partial block instead.
+//
+// Each block is compared without branching, so that compilers can vectorize
+// the comparison even when the two strings have different character types.
+template <typename Char1, typename Char2>
+inline size_t SkipEqualCharBlocks(const Char1* s1, const Char2* s2,
+                                  size_t len) {
+  static_assert(IsStringChar<Char1> && IsStringChar<Char2>);
+
+  size_t i = 0;
+  for (; i + EqualCharBlockLength <= len; i += EqualCharBlockLength) {
+    char16_t diff = 0;
+    for (size_t k = 0; k < EqualCharBlockLength; k++) {
+      diff |= char16_t(s1[i + k]) ^ char16_t(s2[i + k]);
+    }
+    if (diff) {
+      break;
+    }
+  }
+  return i;
+}
+
+}  // namespace detail
+
 template <typename Char1, typename Char2>
 inline bool EqualChars(const Char1* s1, const Char2* s2, size_t len) {
   // Cast |JS::Latin1Char| to |char| to ensure compilers emit std::memcmp for
@@ -85,6 +120,15 @@ inline bool EqualChars(const Char1* s1, const Char2* s2, size_t len) {
   } else if constexpr (std::is_same_v<Char1, JS::Latin1Char> &&
                        std::is_same_v<Char2, char>) {
     return mozilla::ArrayEqual(reinterpret_cast<const char*>(s1), s2, len);
+  } else if constexpr (!std::is_same_v<Char1, Char2> &&
+                       detail::IsStringChar<Char1> &&
+                       detail::IsStringChar<Char2>) {
+    // Latin-1 and two-byte characters can't be compared with std::memcmp.
+    size_t i = detail::SkipEqualCharBlocks(s1, s2, len);
+    if (len - i >= detail::EqualCharBlockLength) {
+      return false;
+    }
+    return mozilla::ArrayEqual(s1 + i, s2 + i, len - i);
   } else {
     return mozilla::ArrayEqual(s1, s2, len);
   }
@@ -96,7 +140,12 @@ template <typename Char1, typename Char2>
 inline int32_t CompareChars(const Char1* s1, size_t len1, const Char2* s2,
                             size_t len2) {
   size_t n = std::min(len1, len2);
-  for (size_t i = 0; i < n; i++) {
+
+  size_t i = 0;
+  if constexpr (detail::IsStringChar<Char1> && detail::IsStringChar<Char2>) {
+    i = detail::SkipEqualCharBlocks(s1, s2, n);
+  }
+  for (; i < n; i++) {
     if (int32_t cmp = s1[i] - s2[i]) {
       return cmp;
     }
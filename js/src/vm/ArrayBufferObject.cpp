@@ -1149,10 +1149,14 @@ void WasmArrayRawBuffer::discard(size_t byteOffset, size_t byteLen) {
 
   void* addr = memBase + uintptr_t(byteOffset);
 
-  // On POSIX-ish platforms, we discard memory by overwriting previously-mapped
-  // pages with freshly-mapped pages (which are all zeroed). The operating
-  // system recognizes this and decreases the process RSS, and eventually
-  // collects the abandoned physical pages.
+  // On Linux, MADV_DONTNEED drops the pages of a private anonymous mapping
+  // immediately and they read back as zero on the next access. This leaves the
+  // mapping itself alone, so the address space is never briefly unmapped.
+  //
+  // On other POSIX-ish platforms, we discard memory by overwriting
+  // previously-mapped pages with freshly-mapped pages (which are all zeroed).
+  // The operating system recognizes this and decreases the process RSS, and
+  // eventually collects the abandoned physical pages.
   //
   // On Windows, committing over previously-committed pages has no effect, and
   // the memory must be explicitly decommitted first. This is not the same as an
@@ -1167,6 +1171,10 @@ void WasmArrayRawBuffer::discard(size_t byteOffset, size_t byteLen) {
   };
 #elif defined(__wasi__)
   memset(addr, 0, byteLen);
+#elif defined(XP_LINUX)
+  if (madvise(addr, byteLen, MADV_DONTNEED) != 0) {
+    MOZ_CRASH("failed to discard wasm memory");
+  }
 #else  // !XP_WIN
   void* data = MozTaggedAnonymousMmap(addr, byteLen, PROT_READ | PROT_WRITE,
                                       MAP_PRIVATE | MAP_ANON | MAP_FIXED, -1, 0,
@@ -1974,6 +1982,13 @@ ResizableArrayBufferObject::createBufferAndData(
   // virtual memory based approach to avoid eagerly allocating the maximum byte
   // length. We don't yet support this and instead are allocating the maximum
   // byte length direct from the start.
+  //
+  // Allocating the maximum byte length up front means resizing never moves or
+  // copies the contents, so views keep their data pointer and |resize| only
+  // has to clear the bytes removed when shrinking. Large zeroed allocations
+  // are usually backed by fresh pages from the OS, which are only committed
+  // when they're first touched. Switching to the wasm reservation path would
+  // mostly change how the memory is accounted, not the cost of resizing.
   size_t nbytes = maxByteLength;
 
   auto [buffer, data] =
@@ -2279,6 +2294,17 @@ ArrayBufferObject* ArrayBufferObject::createZeroed(
   return buffer;
 }
 
+/* static */ std::tuple<ArrayBufferObject*, uint8_t*>
+ArrayBufferObject::createUninitialized(JSContext* cx, size_t nbytes,
+                                       AutoSetNewObjectMetadata& metadata) {
+  if (!CheckArrayBufferTooLarge(cx, nbytes)) {
+    return {nullptr, nullptr};
+  }
+
+  return createBufferAndData<FillContents::Uninitialized>(cx, nbytes,
+                                                         metadata, nullptr);
+}
+
 ResizableArrayBufferObject* ResizableArrayBufferObject::createZeroed(
     JSContext* cx, size_t byteLength, size_t maxByteLength,
     HandleObject proto /* = nullptr */) {
@@ -464,6 +464,12 @@ class ArrayBufferObject : public ArrayBufferObjectMaybeShared {
   static ArrayBufferObject* createZeroed(JSContext* cx, size_t nbytes,
                                          HandleObject proto = nullptr);
 
+  // Create an ArrayBufferObject whose contents are left uninitialized. The
+  // caller must fill all |nbytes| of the returned data pointer before the
+  // buffer can be observed, i.e. while |metadata| is still live.
+  static std::tuple<ArrayBufferObject*, uint8_t*> createUninitialized(
+      JSContext* cx, size_t nbytes, AutoSetNewObjectMetadata& metadata);
+
   // Create an ArrayBufferObject that is safely finalizable and can later be
   // initialize()d to become a real, content-visible ArrayBufferObject.
   static ArrayBufferObject* createEmpty(JSContext* cx);
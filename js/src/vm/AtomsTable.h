@@ -20,6 +20,14 @@
 /*
  * The atoms table is a mapping from strings to JSAtoms that supports
  * incremental sweeping.
+ *
+ * The table is only accessed from the main thread. Atoms are GC things in the
+ * atoms zone, and new atoms may be added to |atomsAddedWhileSweeping| while
+ * an incremental GC sweeps the main set, so neither allocation nor insertion
+ * can happen concurrently with the collector. Off-thread compilation instead
+ * collects strings in a frontend::ParserAtomsTable, which is converted to
+ * JSAtoms in a single pass when the stencil is instantiated on the main
+ * thread.
  */
 
 namespace js {
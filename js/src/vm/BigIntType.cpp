@@ -80,6 +80,7 @@
 
 #include "mozilla/Casting.h"
 #include "mozilla/CheckedInt.h"
+#include "mozilla/DebugOnly.h"
 #include "mozilla/FloatingPoint.h"
 #include "mozilla/HashFunctions.h"
 #include "mozilla/MathAlgorithms.h"
@@ -92,6 +93,7 @@
 #include "mozilla/Try.h"
 #include "mozilla/WrappingOperations.h"
 
+#include <algorithm>
 #include <charconv>
 #include <functional>
 #include <limits>
@@ -451,22 +453,19 @@ void BigInt::inplaceMultiplyAdd(Digit factor, Digit summand) {
 
 // Multiplies `multiplicand` with `multiplier` and adds the result to
 // `accumulator`, starting at `accumulatorIndex` for the least-significant
-// digit.  Callers must ensure that `accumulator`'s digitLength and
-// corresponding digit storage is long enough to hold the result.
-void BigInt::multiplyAccumulate(const BigInt* multiplicand, Digit multiplier,
-                                BigInt* accumulator,
-                                unsigned accumulatorIndex) {
-  MOZ_ASSERT(accumulator->digitLength() >
-             multiplicand->digitLength() + accumulatorIndex);
+// digit.  Callers must ensure that `accumulator` is long enough to hold the
+// result.
+void BigInt::multiplyAccumulate(ConstDigits multiplicand, Digit multiplier,
+                                Digits accumulator, size_t accumulatorIndex) {
+  MOZ_ASSERT(accumulator.size() > multiplicand.size() + accumulatorIndex);
   if (!multiplier) {
     return;
   }
 
   Digit carry = 0;
   Digit high = 0;
-  for (unsigned i = 0; i < multiplicand->digitLength();
-       i++, accumulatorIndex++) {
-    Digit acc = accumulator->digit(accumulatorIndex);
+  for (size_t i = 0; i < multiplicand.size(); i++, accumulatorIndex++) {
+    Digit acc = accumulator[accumulatorIndex];
     Digit newCarry = 0;
 
     // Add last round's carryovers.
@@ -474,28 +473,179 @@ void BigInt::multiplyAccumulate(const BigInt* multiplicand, Digit multiplier,
     acc = digitAdd(acc, carry, &newCarry);
 
     // Compute this round's multiplication.
-    Digit multiplicandDigit = multiplicand->digit(i);
+    Digit multiplicandDigit = multiplicand[i];
     Digit low = digitMul(multiplier, multiplicandDigit, &high);
     acc = digitAdd(acc, low, &newCarry);
 
     // Store result and prepare for next round.
-    accumulator->setDigit(accumulatorIndex, acc);
+    accumulator[accumulatorIndex] = acc;
     carry = newCarry;
   }
 
   while (carry || high) {
-    MOZ_ASSERT(accumulatorIndex < accumulator->digitLength());
-    Digit acc = accumulator->digit(accumulatorIndex);
+    MOZ_ASSERT(accumulatorIndex < accumulator.size());
+    Digit acc = accumulator[accumulatorIndex];
     Digit newCarry = 0;
     acc = digitAdd(acc, high, &newCarry);
     high = 0;
     acc = digitAdd(acc, carry, &newCarry);
-    accumulator->setDigit(accumulatorIndex, acc);
+    accumulator[accumulatorIndex] = acc;
     carry = newCarry;
     accumulatorIndex++;
   }
 }
 
+// Adds `summand` onto `digits` and propagates the carry through the remaining
+// digits of `digits`. Returns the final carry (0 or 1).
+BigInt::Digit BigInt::digitsInplaceAdd(Digits digits, ConstDigits summand) {
+  MOZ_ASSERT(digits.size() >= summand.size());
+
+  Digit carry = 0;
+  size_t i = 0;
+  for (; i < summand.size(); i++) {
+    Digit newCarry = 0;
+    Digit sum = digitAdd(digits[i], summand[i], &newCarry);
+    sum = digitAdd(sum, carry, &newCarry);
+    digits[i] = sum;
+    carry = newCarry;
+  }
+  for (; carry && i < digits.size(); i++) {
+    Digit newCarry = 0;
+    digits[i] = digitAdd(digits[i], carry, &newCarry);
+    carry = newCarry;
+  }
+
+  return carry;
+}
+
+// Subtracts `subtrahend` from `digits` and propagates the borrow through the
+// remaining digits of `digits`. Returns the final borrow (0 or 1).
+BigInt::Digit BigInt::digitsInplaceSub(Digits digits, ConstDigits subtrahend) {
+  MOZ_ASSERT(digits.size() >= subtrahend.size());
+
+  Digit borrow = 0;
+  size_t i = 0;
+  for (; i < subtrahend.size(); i++) {
+    Digit newBorrow = 0;
+    Digit difference = digitSub(digits[i], subtrahend[i], &newBorrow);
+    difference = digitSub(difference, borrow, &newBorrow);
+    digits[i] = difference;
+    borrow = newBorrow;
+  }
+  for (; borrow && i < digits.size(); i++) {
+    Digit newBorrow = 0;
+    digits[i] = digitSub(digits[i], borrow, &newBorrow);
+    borrow = newBorrow;
+  }
+
+  return borrow;
+}
+
+// Returns the number of scratch digits multiplyKaratsuba needs when the larger
+// operand has `length` digits. Each recursion level needs space for the two
+// operand sums and their product, and recurses on operands of at most
+// `half + 1` digits.
+size_t BigInt::karatsubaScratchLength(size_t length) {
+  size_t scratchLength = 0;
+  while (length >= KaratsubaThreshold) {
+    size_t half = (length + 1) / 2;
+    scratchLength += 4 * (half + 1);
+    length = half + 1;
+  }
+  return scratchLength;
+}
+
+// Computes `result = x * y` using Karatsuba multiplication. `result` must be
+// zero-initialized and hold exactly `x.size() + y.size()` digits, and `x` must
+// not be shorter than `y`. `scratch` must hold at least
+// `karatsubaScratchLength(x.size())` digits.
+void BigInt::multiplyKaratsuba(Digits result, ConstDigits x, ConstDigits y,
+                               Digits scratch) {
+  MOZ_ASSERT(x.size() >= y.size());
+  MOZ_ASSERT(result.size() == x.size() + y.size());
+  MOZ_ASSERT(scratch.size() >= karatsubaScratchLength(x.size()));
+
+  if (y.size() < KaratsubaThreshold) {
+    for (size_t i = 0; i < y.size(); i++) {
+      multiplyAccumulate(x, y[i], result, i);
+    }
+    return;
+  }
+
+  size_t half = (x.size() + 1) / 2;
+
+  // If `y` is at most half as long as `x`, splitting both at `half` would
+  // leave `y` without a high part. Instead multiply `y` with `y`-sized chunks
+  // of `x` and add up the partial products.
+  if (y.size() <= half) {
+    size_t chunkLength = y.size();
+    Digits product = scratch.First(2 * chunkLength);
+    Digits rest = scratch.From(2 * chunkLength);
+    for (size_t i = 0; i < x.size(); i += chunkLength) {
+      ConstDigits chunk = x.Subspan(i, std::min(chunkLength, x.size() - i));
+      Digits chunkProduct = product.First(chunk.size() + y.size());
+      std::fill(chunkProduct.begin(), chunkProduct.end(), 0);
+      multiplyKaratsuba(chunkProduct, y, chunk, rest);
+
+      mozilla::DebugOnly<Digit> carry =
+          digitsInplaceAdd(result.From(i), chunkProduct);
+      MOZ_ASSERT(!carry);
+    }
+    return;
+  }
+
+  // Split x = x1 * B^half + x0 and y = y1 * B^half + y0. Then
+  //
+  //   x * y = z2 * B^(2 * half) + z1 * B^half + z0
+  //
+  // with z0 = x0 * y0, z2 = x1 * y1 and
+  // z1 = (x0 + x1) * (y0 + y1) - z0 - z2.
+  ConstDigits x0 = x.First(half);
+  ConstDigits x1 = x.From(half);
+  ConstDigits y0 = y.First(half);
+  ConstDigits y1 = y.From(half);
+  MOZ_ASSERT(x1.size() >= y1.size());
+  MOZ_ASSERT(!y1.empty());
+
+  // z0 and z2 don't overlap, so compute them directly into `result`.
+  Digits z0 = result.First(2 * half);
+  Digits z2 = result.From(2 * half);
+  multiplyKaratsuba(z0, x0, y0, scratch);
+  multiplyKaratsuba(z2, x1, y1, scratch);
+
+  Digits xSum = scratch.Subspan(0, half + 1);
+  Digits ySum = scratch.Subspan(half + 1, half + 1);
+  Digits z1 = scratch.Subspan(2 * (half + 1), 2 * (half + 1));
+  Digits rest = scratch.From(4 * (half + 1));
+
+  std::copy(x0.begin(), x0.end(), xSum.begin());
+  xSum[half] = 0;
+  mozilla::DebugOnly<Digit> carry = digitsInplaceAdd(xSum, x1);
+  MOZ_ASSERT(!carry);
+
+  std::copy(y0.begin(), y0.end(), ySum.begin());
+  ySum[half] = 0;
+  carry = digitsInplaceAdd(ySum, y1);
+  MOZ_ASSERT(!carry);
+
+  std::fill(z1.begin(), z1.end(), 0);
+  multiplyKaratsuba(z1, xSum, ySum, rest);
+
+  mozilla::DebugOnly<Digit> borrow = digitsInplaceSub(z1, z0);
+  MOZ_ASSERT(!borrow);
+  borrow = digitsInplaceSub(z1, z2);
+  MOZ_ASSERT(!borrow);
+
+  // z1 = x0 * y1 + x1 * y0 fits into the digits of `result` above `half`, but
+  // its buffer can be longer than that, so drop its high zero digits first.
+  size_t z1Length = z1.size();
+  while (z1Length > 0 && z1[z1Length - 1] == 0) {
+    z1Length--;
+  }
+  carry = digitsInplaceAdd(result.From(half), z1.First(z1Length));
+  MOZ_ASSERT(!carry);
+}
+
 inline int8_t BigInt::absoluteCompare(const BigInt* x, const BigInt* y) {
   MOZ_ASSERT(!HasLeadingZeroes(x));
   MOZ_ASSERT(!HasLeadingZeroes(y));
@@ -1877,6 +2027,22 @@ BigInt* BigInt::mul(JSContext* cx, HandleBigInt x, HandleBigInt y) {
     }
   }
 
+  // Reorder operands to minimize calls to multiplyAccumulate.
+  HandleBigInt left = x->digitLength() >= y->digitLength() ? x : y;
+  HandleBigInt right = x->digitLength() >= y->digitLength() ? y : x;
+
+  // Schoolbook multiplication is quadratic in the operand length, so switch
+  // to Karatsuba multiplication when both operands are large.
+  UniquePtr<Digit[], JS::FreePolicy> scratch;
+  size_t scratchLength = 0;
+  if (right->digitLength() >= KaratsubaThreshold) {
+    scratchLength = karatsubaScratchLength(left->digitLength());
+    scratch = cx->make_pod_array<Digit>(scratchLength);
+    if (!scratch) {
+      return nullptr;
+    }
+  }
+
   unsigned resultLength = x->digitLength() + y->digitLength();
   BigInt* result = createUninitialized(cx, resultLength, resultNegative);
   if (!result) {
@@ -1884,15 +2050,14 @@ BigInt* BigInt::mul(JSContext* cx, HandleBigInt x, HandleBigInt y) {
   }
   result->initializeDigitsToZero();
 
-  // Reorder operands to minimize calls to multiplyAccumulate.
-  BigInt* left = x;
-  BigInt* right = y;
-  if (left->digitLength() < right->digitLength()) {
-    std::swap(left, right);
-  }
-
-  for (size_t i = 0; i < right->digitLength(); i++) {
-    multiplyAccumulate(left, right->digit(i), result, i);
+  if (scratch) {
+    multiplyKaratsuba(result->digits(), left->digits(), right->digits(),
+                      Digits(scratch.get(), scratchLength));
+  } else {
+    for (size_t i = 0; i < right->digitLength(); i++) {
+      multiplyAccumulate(left->digits(), right->digit(i), result->digits(),
+                         i);
+    }
   }
 
   return destructivelyTrimHighZeroDigits(cx, result);
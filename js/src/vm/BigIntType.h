@@ -324,9 +324,20 @@ class BigInt final : public js::gc::CellWithLengthAndFlags {
       bool quotientNegative);
   static void internalMultiplyAdd(const BigInt* source, Digit factor,
                                   Digit summand, unsigned, BigInt* result);
-  static void multiplyAccumulate(const BigInt* multiplicand, Digit multiplier,
-                                 BigInt* accumulator,
-                                 unsigned accumulatorIndex);
+  static void multiplyAccumulate(ConstDigits multiplicand, Digit multiplier,
+                                 Digits accumulator, size_t accumulatorIndex);
+
+  // Multiplications where the shorter operand has at least this many digits
+  // use Karatsuba multiplication instead of schoolbook multiplication.
+  static constexpr size_t KaratsubaThreshold = 40;
+  static_assert(KaratsubaThreshold >= 4,
+                "splitting must make progress on the `half + 1` digit sums");
+
+  static size_t karatsubaScratchLength(size_t length);
+  static void multiplyKaratsuba(Digits result, ConstDigits x, ConstDigits y,
+                                Digits scratch);
+  static Digit digitsInplaceAdd(Digits digits, ConstDigits summand);
+  static Digit digitsInplaceSub(Digits digits, ConstDigits subtrahend);
   static bool absoluteDivWithBigIntDivisor(
       JSContext* cx, Handle<BigInt*> dividend, Handle<BigInt*> divisor,
       const mozilla::Maybe<MutableHandle<BigInt*>>& quotient,
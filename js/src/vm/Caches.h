@@ -14,16 +14,21 @@
 #include "mozilla/TemplateLib.h"
 #include "mozilla/UniquePtr.h"
 
+#include "frontend/DynamicFunctionCache.h"
 #include "frontend/ScopeBindingCache.h"
+#include "frontend/SharedDelazificationCache.h"
 #include "gc/Tracer.h"
 #include "js/RootingAPI.h"
 #include "js/TypeDecls.h"
 #include "vm/JSScript.h"
+#include "vm/MatchPairs.h"
 #include "vm/Shape.h"
 #include "vm/StringType.h"
 
 namespace js {
 
+class RegExpShared;
+
 struct EvalCacheEntry {
   JSLinearString* str;
   JSScript* script;
@@ -180,6 +185,11 @@ class MegamorphicCacheEntry {
 // invalidate all entries.
 //
 // The cache is also invalidated on each major GC.
+//
+// The cache counts misses, evictions of live entries and generation bumps for
+// JS::GetMegamorphicCacheStats. Misses are counted when an entry is
+// (re)initialized by the VM after a failed lookup; hits in JIT code are not
+// counted to keep the inline lookup unchanged.
 class MegamorphicCache {
  public:
   using Entry = MegamorphicCacheEntry;
@@ -201,6 +211,17 @@ class MegamorphicCache {
   // Generation counter used to invalidate all entries.
   uint16_t generation_ = 0;
 
+  uint64_t numMisses_ = 0;
+  uint64_t numEvictions_ = 0;
+  uint64_t numInvalidations_ = 0;
+
+  void noteMiss(const Entry* entry) {
+    numMisses_++;
+    if (entry->shape_ && entry->generation_ == generation_) {
+      numEvictions_++;
+    }
+  }
+
   // NOTE: this logic is mirrored in MacroAssembler::emitMegamorphicCacheLookup
   Entry& getEntry(Shape* shape, PropertyKey key) {
     static_assert(mozilla::IsPowerOfTwo(NumEntries),
@@ -213,6 +234,7 @@ class MegamorphicCache {
 
  public:
   void bumpGeneration() {
+    numInvalidations_++;
     generation_++;
     if (generation_ == 0) {
       // Generation overflowed. Invalidate the whole cache.
@@ -221,6 +243,10 @@ class MegamorphicCache {
       }
     }
   }
+
+  uint64_t numMisses() const { return numMisses_; }
+  uint64_t numEvictions() const { return numEvictions_; }
+  uint64_t numInvalidations() const { return numInvalidations_; }
   bool isValidForLookup(const Entry& entry, Shape* shape, PropertyKey key) {
     return (entry.shape_ == shape && entry.key_ == key &&
             entry.generation_ == generation_);
@@ -233,16 +259,19 @@ class MegamorphicCache {
 
   void initEntryForMissingProperty(Entry* entry, Shape* shape,
                                    PropertyKey key) {
+    noteMiss(entry);
     entry->init(shape, key, generation_, Entry::NumHopsForMissingProperty,
                 TaggedSlotOffset());
   }
   void initEntryForMissingOwnProperty(Entry* entry, Shape* shape,
                                       PropertyKey key) {
+    noteMiss(entry);
     entry->init(shape, key, generation_, Entry::NumHopsForMissingOwnProperty,
                 TaggedSlotOffset());
   }
   void initEntryForDataProperty(Entry* entry, Shape* shape, PropertyKey key,
                                 size_t numHops, TaggedSlotOffset slotOffset) {
+    noteMiss(entry);
     if (numHops > Entry::MaxHopsForDataProperty) {
       return;
     }
@@ -251,6 +280,7 @@ class MegamorphicCache {
   void initEntryForAccessorProperty(Entry* entry, Shape* shape, PropertyKey key,
                                     size_t numHops,
                                     TaggedSlotOffset slotOffset) {
+    noteMiss(entry);
     if (numHops > Entry::MaxHopsForAccessorProperty) {
       return;
     }
@@ -346,6 +376,11 @@ class MegamorphicSetPropCache {
   // Generation counter used to invalidate all entries.
   uint16_t generation_ = 0;
 
+  // See MegamorphicCache.
+  uint64_t numMisses_ = 0;
+  uint64_t numEvictions_ = 0;
+  uint64_t numInvalidations_ = 0;
+
   Entry& getEntry(Shape* beforeShape, PropertyKey key) {
     static_assert(mozilla::IsPowerOfTwo(NumEntries),
                   "NumEntries must be a power-of-two for fast modulo");
@@ -357,6 +392,7 @@ class MegamorphicSetPropCache {
 
  public:
   void bumpGeneration() {
+    numInvalidations_++;
     generation_++;
     if (generation_ == 0) {
       // Generation overflowed. Invalidate the whole cache.
@@ -365,6 +401,10 @@ class MegamorphicSetPropCache {
       }
     }
   }
+
+  uint64_t numMisses() const { return numMisses_; }
+  uint64_t numEvictions() const { return numEvictions_; }
+  uint64_t numInvalidations() const { return numInvalidations_; }
   void set(Shape* beforeShape, Shape* afterShape, PropertyKey key,
            TaggedSlotOffset slotOffset, uint32_t newCapacity) {
     uint16_t newSlots = (uint16_t)newCapacity;
@@ -372,6 +412,10 @@ class MegamorphicSetPropCache {
       return;
     }
     Entry& entry = getEntry(beforeShape, key);
+    numMisses_++;
+    if (entry.beforeShape_ && entry.generation_ == generation_) {
+      numEvictions_++;
+    }
     entry.init(beforeShape, afterShape, key, generation_, slotOffset, newSlots);
   }
 
@@ -525,6 +569,64 @@ class StringToAtomCache {
   }
 };
 
+// Remembers the result of the last RegExp execution, so that executing the
+// same RegExp on the same input and start index again, for example in a
+// |test| guard followed by |exec|, doesn't have to run the matcher twice.
+// The match result only depends on these three inputs.
+//
+// Only the pointers are compared, so this cache is purged on minor and major
+// GC.
+class RegExpExecCache {
+  static constexpr size_t MaxPairCount = 8;
+
+  RegExpShared* shared_ = nullptr;
+  JSLinearString* input_ = nullptr;
+  size_t start_ = 0;
+  bool found_ = false;
+  uint32_t pairCount_ = 0;
+  MatchPair pairs_[MaxPairCount];
+
+ public:
+  // On a hit, copy the cached match into |matches| and return true. |found|
+  // is set to false if the last execution didn't find a match.
+  bool lookup(RegExpShared* shared, JSLinearString* input, size_t start,
+              MatchPairs& matches, bool* found) const {
+    if (shared != shared_ || input != input_ || start != start_) {
+      return false;
+    }
+    MOZ_ASSERT(matches.length() == pairCount_);
+    *found = found_;
+    if (found_) {
+      for (size_t i = 0; i < pairCount_; i++) {
+        matches[i] = pairs_[i];
+      }
+    }
+    return true;
+  }
+
+  void put(RegExpShared* shared, JSLinearString* input, size_t start,
+           const MatchPairs& matches, bool found) {
+    if (matches.length() > MaxPairCount) {
+      return;
+    }
+    shared_ = shared;
+    input_ = input;
+    start_ = start;
+    found_ = found;
+    pairCount_ = matches.length();
+    if (found) {
+      for (size_t i = 0; i < pairCount_; i++) {
+        pairs_[i] = matches[i];
+      }
+    }
+  }
+
+  void purge() {
+    shared_ = nullptr;
+    input_ = nullptr;
+  }
+};
+
 #ifdef MOZ_EXECUTION_TRACING
 
 // Holds a handful of caches used for tracing JS execution. These effectively
@@ -617,6 +719,7 @@ class RuntimeCaches {
   UncompressedSourceCache uncompressedSourceCache;
   EvalCache evalCache;
   StringToAtomCache stringToAtomCache;
+  RegExpExecCache regExpExecCache;
 
 #ifdef MOZ_EXECUTION_TRACING
   TracingCaches tracingCaches;
@@ -627,6 +730,14 @@ class RuntimeCaches {
   // iterating over the list of bindings.
   frontend::RuntimeScopeBindingCache scopeCache;
 
+  // Delazification: Stencils of delazified functions, shared with functions
+  // which have the same source text in other scripts.
+  frontend::SharedDelazificationCache sharedDelazificationCache;
+
+  // Stencils compiled by the Function constructor, keyed on the function text
+  // and the calling script.
+  frontend::DynamicFunctionCache dynamicFunctionCache;
+
   void sweepAfterMinorGC(JSTracer* trc) { evalCache.traceWeak(trc); }
 #ifdef JSGC_HASH_TABLE_CHECKS
   void checkEvalCacheAfterMinorGC();
@@ -635,6 +746,7 @@ class RuntimeCaches {
   void purgeForCompaction() {
     evalCache.clear();
     stringToAtomCache.purge();
+    regExpExecCache.purge();
     megamorphicCache.bumpGeneration();
     if (megamorphicSetPropCache) {
       // MegamorphicSetPropCache can be null if we failed out of
@@ -643,6 +755,8 @@ class RuntimeCaches {
       megamorphicSetPropCache->bumpGeneration();
     }
     scopeCache.purge();
+    sharedDelazificationCache.purge();
+    dynamicFunctionCache.purge();
 #ifdef MOZ_EXECUTION_TRACING
     tracingCaches.clearOnCompaction();
 #endif
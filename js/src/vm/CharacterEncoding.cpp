@@ -531,6 +531,22 @@ Latin1CharsZ JS::LossyUTF8CharsToNewLatin1CharsZ(JSContext* cx,
       cx, utf8, outlen, destArenaId);
 }
 
+// Compute the exact number of UTF-16 code units and the smallest encoding
+// needed to hold |utf8| in a single pass, reporting an error and returning
+// false if it is malformed.
+bool GetUTF8InflationData(JSContext* cx, const JS::UTF8Chars& utf8,
+                          size_t* outlen, JS::SmallestEncoding* encoding) {
+  *outlen = 0;
+  *encoding = JS::SmallestEncoding::ASCII;
+
+  auto getMetadata = [outlen, encoding](char16_t c) -> LoopDisposition {
+    (*outlen)++;
+    UpdateSmallestEncodingForChar(c, encoding);
+    return LoopDisposition::Continue;
+  };
+  return InflateUTF8ToUTF16<OnUTF8Error::Throw>(cx, utf8, getMetadata);
+}
+
 /**
  * Atomization Helpers.
  *
@@ -244,6 +244,16 @@ JS_PUBLIC_API void JS::AbortCollectingDelazifications(
       ->unsetCollectingDelazifications();
 }
 
+JS_PUBLIC_API bool JS::GetDelazificationOrder(
+    JSContext* cx, JS::Handle<JSScript*> script,
+    DelazificationOrderVector& offsets) {
+  if (!script->scriptSource()->getDelazificationOrder(offsets)) {
+    ReportOutOfMemory(cx);
+    return false;
+  }
+  return true;
+}
+
 JSScript* JS::CompileUtf8File(JSContext* cx,
                               const ReadOnlyCompileOptions& options,
                               FILE* file) {
@@ -6,6 +6,7 @@
 
 #include "vm/Compression.h"
 
+#include "mozilla/Compression.h"
 #include "mozilla/DebugOnly.h"
 #include "mozilla/MemoryChecking.h"
 #include "mozilla/PodOperations.h"
@@ -16,15 +17,21 @@
 
 using namespace js;
 
+using mozilla::Compression::LZ4;
+
 static void* zlib_alloc(void* cx, uInt items, uInt size) {
   return js_calloc(items, size);
 }
 
 static void zlib_free(void* cx, void* addr) { js_free(addr); }
 
-Compressor::Compressor(const unsigned char* inp, size_t inplen)
-    : inp(inp),
+Compressor::Compressor(const unsigned char* inp, size_t inplen,
+                       CompressionCodec codec)
+    : codec(codec),
+      inp(inp),
       inplen(inplen),
+      out(nullptr),
+      outlen(0),
       initialized(false),
       finished(false),
       currentChunkSize(0) {
@@ -69,6 +76,10 @@ bool Compressor::init() {
   if (inplen >= UINT32_MAX) {
     return false;
   }
+  if (codec == CompressionCodec::LZ4) {
+    // LZ4 blocks are compressed without any persistent state.
+    return true;
+  }
   // zlib is slow and we'd rather be done compression sooner
   // even if it means decompression is slower which penalizes
   // Function.toString()
@@ -84,11 +95,23 @@ bool Compressor::init() {
 
 void Compressor::setOutput(unsigned char* out, size_t outlen) {
   MOZ_ASSERT(outlen > outbytes);
+  this->out = out;
+  this->outlen = outlen;
   zs.next_out = out + outbytes;
   zs.avail_out = outlen - outbytes;
 }
 
 Compressor::Status Compressor::compressMore() {
+  switch (codec) {
+    case CompressionCodec::Zlib:
+      return compressMoreZlib();
+    case CompressionCodec::LZ4:
+      return compressMoreLZ4();
+  }
+  MOZ_CRASH("Unexpected compression codec");
+}
+
+Compressor::Status Compressor::compressMoreZlib() {
   MOZ_ASSERT(zs.next_out);
   uInt left = inplen - (zs.next_in - inp);
   if (left <= MAX_INPUT_SIZE) {
@@ -144,6 +167,33 @@ Compressor::Status Compressor::compressMore() {
   return done ? DONE : CONTINUE;
 }
 
+Compressor::Status Compressor::compressMoreLZ4() {
+  MOZ_ASSERT(out);
+
+  // Compress a whole chunk at a time, as an independent block.
+  size_t chunk = chunkOffsets.length();
+  size_t chunkBytes = chunkSize(inplen, chunk);
+  const char* chunkStart =
+      reinterpret_cast<const char*>(inp) + chunk * CHUNK_SIZE;
+
+  MOZ_ASSERT(outlen >= outbytes);
+  size_t written = LZ4::compressLimitedOutput(
+      chunkStart, chunkBytes, reinterpret_cast<char*>(out + outbytes),
+      outlen - outbytes);
+  if (written == 0) {
+    return MOREOUTPUT;
+  }
+  outbytes += written;
+
+  if (!chunkOffsets.append(outbytes)) {
+    return OOM;
+  }
+
+  bool done = chunk * CHUNK_SIZE + chunkBytes == inplen;
+  MOZ_ASSERT_IF(done, chunkOffsets.length() == (inplen - 1) / CHUNK_SIZE + 1);
+  return done ? DONE : CONTINUE;
+}
+
 size_t Compressor::totalBytesNeeded() const {
   return AlignBytes(outbytes, sizeof(uint32_t)) + sizeOfChunkOffsets();
 }
@@ -154,6 +204,7 @@ void Compressor::finish(char* dest, size_t destBytes) {
   CompressedDataHeader* compressedHeader =
       reinterpret_cast<CompressedDataHeader*>(dest);
   compressedHeader->compressedBytes = outbytes;
+  compressedHeader->codec = uint32_t(codec);
 
   size_t outbytesAligned = AlignBytes(outbytes, sizeof(uint32_t));
 
@@ -217,6 +268,18 @@ bool js::DecompressStringChunk(const unsigned char* inp, size_t chunk,
   MOZ_ASSERT(compressedStart < compressedEnd);
   MOZ_ASSERT(compressedEnd <= compressedBytes);
 
+  if (CompressionCodec(header->codec) == CompressionCodec::LZ4) {
+    size_t decompressedBytes = 0;
+    bool ok = LZ4::decompress(
+        reinterpret_cast<const char*>(inp + compressedStart),
+        compressedEnd - compressedStart, reinterpret_cast<char*>(out), outlen,
+        &decompressedBytes);
+    MOZ_RELEASE_ASSERT(ok);
+    MOZ_RELEASE_ASSERT(decompressedBytes == outlen);
+    return true;
+  }
+  MOZ_RELEASE_ASSERT(CompressionCodec(header->codec) == CompressionCodec::Zlib);
+
   bool lastChunk = compressedEnd == compressedBytes;
 
   // Mark the memory we pass to zlib as initialized for MSan.
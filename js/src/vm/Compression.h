@@ -16,8 +16,22 @@
 
 namespace js {
 
+// The codec used to compress a script source. The value is stored in the
+// CompressedDataHeader, so the compressed data can be decoded regardless of
+// the codec selected when it is read.
+enum class CompressionCodec : uint8_t {
+  // Raw deflate, fully flushed at the end of each chunk.
+  Zlib,
+
+  // Each chunk is compressed as an independent LZ4 block. This compresses
+  // less than zlib but is much faster in both directions.
+  LZ4,
+};
+
 struct CompressedDataHeader {
   uint32_t compressedBytes;
+  // A CompressionCodec, widened so that the header has no padding bytes.
+  uint32_t codec;
 };
 
 class Compressor {
@@ -30,9 +44,12 @@ class Compressor {
   // Number of bytes we should hand to zlib each compressMore() call.
   static constexpr size_t MAX_INPUT_SIZE = 2 * 1024;
 
+  CompressionCodec codec;
   z_stream zs;
   const unsigned char* inp;
   size_t inplen;
+  unsigned char* out;
+  size_t outlen;
   size_t outbytes;
   bool initialized;
   bool finished;
@@ -48,7 +65,12 @@ class Compressor {
  public:
   enum Status { MOREOUTPUT, DONE, CONTINUE, OOM };
 
-  Compressor(const unsigned char* inp, size_t inplen);
+ private:
+  Status compressMoreZlib();
+  Status compressMoreLZ4();
+
+ public:
+  Compressor(const unsigned char* inp, size_t inplen, CompressionCodec codec);
   ~Compressor();
   bool init();
   void setOutput(unsigned char* out, size_t outlen);
@@ -103,8 +125,8 @@ bool DecompressString(const unsigned char* inp, size_t inplen,
                       unsigned char* out, size_t outlen);
 
 /*
- * Decompress a single chunk of at most Compressor::CHUNK_SIZE bytes.
- * |chunk| is the chunk index. The caller must know the length of the output
+ * Decompress a single chunk of at most Compressor::CHUNK_SIZE bytes, written
+ * by a Compressor with any codec. |chunk| is the chunk index. The caller must know the length of the output
  * (the uncompressed chunk) and allocate |out| to a string of that length.
  */
 bool DecompressStringChunk(const unsigned char* inp, size_t chunk,
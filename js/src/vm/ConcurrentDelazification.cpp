@@ -11,14 +11,15 @@
 #include "mozilla/ReverseIterator.h"  // mozilla::Reversed
 #include "mozilla/ScopeExit.h"        // mozilla::MakeScopeExit
 
-#include <stddef.h>  // size_t
-#include <utility>   // std::swap, std::move, std::pair
+#include <algorithm>   // std::push_heap, std::pop_heap
+#include <functional>  // std::greater
+#include <stddef.h>    // size_t
+#include <utility>     // std::swap, std::move, std::pair
 
-#include "ds/LifoAlloc.h"  // LifoAlloc
 #include "frontend/BytecodeCompiler.h"  // DelazifyCanonicalScriptedFunction, DelazifyFailureReason
 #include "frontend/CompilationStencil.h"  // CompilationStencil, ExtensibleCompilationStencil, BorrowingCompilationStencil, ScriptStencilRef
 #include "frontend/FrontendContext.h"     // JS::FrontendContext
-#include "frontend/ScopeBindingCache.h"   // StencilScopeBindingCache
+#include "frontend/FrontendLifoAllocCache.h"  // AutoFrontendLifoAlloc
 #include "frontend/Stencil.h"  // TaggedScriptThingIndex, ScriptStencilExtra
 #include "js/AllocPolicy.h"    // ReportOutOfMemory
 #include "js/experimental/JSStencil.h"  // RefPtrTraits<JS::Stencil>
@@ -29,6 +30,23 @@ using namespace js;
 bool DelazifyStrategy::add(FrontendContext* fc,
                            const frontend::CompilationStencil& stencil,
                            ScriptIndex index) {
+  size_t counter = 0;
+  return addImpl(fc, stencil, index, 0, 1, &counter);
+}
+
+bool DelazifyStrategy::addPart(FrontendContext* fc,
+                               const frontend::CompilationStencil& stencil,
+                               ScriptIndex index, size_t partIndex,
+                               size_t partCount) {
+  MOZ_ASSERT(partIndex < partCount);
+  size_t counter = 0;
+  return addImpl(fc, stencil, index, partIndex, partCount, &counter);
+}
+
+bool DelazifyStrategy::addImpl(FrontendContext* fc,
+                               const frontend::CompilationStencil& stencil,
+                               ScriptIndex index, size_t partIndex,
+                               size_t partCount, size_t* counter) {
   using namespace js::frontend;
   ScriptStencilRef scriptRef{stencil, index};
 
@@ -56,12 +74,18 @@ bool DelazifyStrategy::add(FrontendContext* fc,
     if (innerScriptRef.scriptData().hasSharedData()) {
       // The top-level parse decided to eagerly parse this function, thus we
       // should visit its inner function the same way.
-      if (!add(fc, stencil, innerScriptIndex)) {
+      if (!addImpl(fc, stencil, innerScriptIndex, partIndex, partCount,
+                   counter)) {
         return false;
       }
       continue;
     }
 
+    // Leave this function to the task handling its part.
+    if ((*counter)++ % partCount != partIndex) {
+      continue;
+    }
+
     // Maybe insert the new script index in the queue of functions to delazify.
     if (!insert(innerScriptIndex, innerScriptRef)) {
       ReportOutOfMemory(fc);
@@ -141,9 +165,47 @@ bool LargeFirstDelazification::insert(ScriptIndex index,
   return true;
 }
 
+bool RecordedOrderDelazification::init(
+    const JS::ReadOnlyCompileOptions& options) {
+  const uint32_t* order = options.delazificationOrder();
+  size_t length = options.delazificationOrderLength();
+  if (!ranks.reserve(length)) {
+    return false;
+  }
+  for (size_t i = 0; i < length; i++) {
+    // Keep the first occurrence if an offset is listed multiple times.
+    auto p = ranks.lookupForAdd(order[i]);
+    if (!p) {
+      MOZ_ALWAYS_TRUE(ranks.add(p, order[i], Rank(i)));
+    }
+  }
+  return true;
+}
+
+DelazifyStrategy::ScriptIndex RecordedOrderDelazification::next() {
+  std::pop_heap(heap.begin(), heap.end(), std::greater<>());
+  return heap.popCopy().second;
+}
+
+bool RecordedOrderDelazification::insert(ScriptIndex index,
+                                         frontend::ScriptStencilRef& ref) {
+  const frontend::ScriptStencilExtra& extra = ref.scriptExtra();
+  auto p = ranks.lookup(extra.extent.sourceStart);
+  if (!p) {
+    return true;
+  }
+
+  if (!heap.append(std::pair(p->value(), index))) {
+    return false;
+  }
+  std::push_heap(heap.begin(), heap.end(), std::greater<>());
+  return true;
+}
+
 bool DelazificationContext::init(
     const JS::ReadOnlyCompileOptions& options,
-    frontend::InitialStencilAndDelazifications* stencils) {
+    frontend::InitialStencilAndDelazifications* stencils, size_t partIndex,
+    size_t partCount) {
   using namespace js::frontend;
 
   stencils_ = stencils;
@@ -171,6 +233,7 @@ bool DelazificationContext::init(
       break;
     case JS::DelazificationOption::CheckConcurrentWithOnDemand:
     case JS::DelazificationOption::ConcurrentDepthFirst:
+    case JS::DelazificationOption::ParseEverythingConcurrently:
       // ConcurrentDepthFirst visit all functions to be delazified, visiting the
       // inner functions before the siblings functions.
       strategy_ = fc_.getAllocator()->make_unique<DepthFirstDelazification>();
@@ -180,6 +243,17 @@ bool DelazificationContext::init(
       // largest function first.
       strategy_ = fc_.getAllocator()->make_unique<LargeFirstDelazification>();
       break;
+    case JS::DelazificationOption::ConcurrentRecordedOrder: {
+      // ConcurrentRecordedOrder only visit the functions listed in the compile
+      // options, in the order in which they are listed.
+      auto recorded =
+          fc_.getAllocator()->make_unique<RecordedOrderDelazification>();
+      if (!recorded || !recorded->init(options)) {
+        return false;
+      }
+      strategy_ = std::move(recorded);
+      break;
+    }
     case JS::DelazificationOption::ParseEverythingEagerly:
       // ParseEverythingEagerly parse all functions eagerly, thus leaving no
       // functions to be parsed on demand.
@@ -195,7 +269,7 @@ bool DelazificationContext::init(
   // Queue functions from the top-level to be delazify.
   BorrowingCompilationStencil borrow(merger_.getResult());
   ScriptIndex topLevel{0};
-  return strategy_->add(&fc_, borrow, topLevel);
+  return strategy_->addPart(&fc_, borrow, topLevel, partIndex, partCount);
 }
 
 bool DelazificationContext::delazify() {
@@ -205,15 +279,13 @@ bool DelazificationContext::delazify() {
 
   using namespace js::frontend;
 
-  // Create a scope-binding cache dedicated to this delazification. The memory
-  // would be reclaimed when interrupted or if all delazification are completed.
-  //
-  // We do not use the one from the JSContext/Runtime, as it is not thread safe
-  // to use it, as it could be purged by a GC in the mean time.
-  StencilScopeBindingCache scopeCache(merger_);
-
-  LifoAlloc tempLifoAlloc(JSContext::TEMP_LIFO_ALLOC_PRIMARY_CHUNK_SIZE,
-                          js::BackgroundMallocArena);
+  // Borrow a LifoAlloc from the process-wide cache, instead of allocating new
+  // chunks for each delazification task.
+  AutoFrontendLifoAlloc tempLifoAlloc;
+  if (!tempLifoAlloc.init(&fc_)) {
+    strategy_->clear();
+    return false;
+  }
 
   while (!strategy_->done()) {
     if (isInterrupted_) {
@@ -228,7 +300,8 @@ bool DelazificationContext::delazify() {
       // Parse and generate bytecode for the inner function.
       DelazifyFailureReason failureReason;
       innerStencil = DelazifyCanonicalScriptedFunction(
-          &fc_, tempLifoAlloc, initialPrefableOptions_, &scopeCache, borrow,
+          &fc_, tempLifoAlloc.get(), initialPrefableOptions_, &scopeCache_,
+          borrow,
           scriptIndex, stencils_.get(), &failureReason);
       if (!innerStencil) {
         if (failureReason == DelazifyFailureReason::Compressed) {
@@ -13,10 +13,12 @@
 #include <utility>   // std::pair
 
 #include "frontend/CompilationStencil.h"  // frontend::{InitialStencilAndDelazifications, CompilationStencil, ScriptStencilRef, CompilationStencilMerger}
+#include "frontend/ScopeBindingCache.h"   // frontend::StencilScopeBindingCache
 #include "frontend/ScriptIndex.h"         // frontend::ScriptIndex
 #include "js/AllocPolicy.h"               // SystemAllocPolicy
 #include "js/CompileOptions.h"  // JS::PrefableCompileOptions, JS::ReadOnlyCompileOptions
 #include "js/experimental/JSStencil.h"  // RefPtrTraits for InitialStencilAndDelazifications
+#include "js/HashTable.h"               // HashMap, DefaultHasher
 #include "js/UniquePtr.h"               // UniquePtr
 #include "js/Vector.h"                  // Vector
 
@@ -63,6 +65,20 @@ struct DelazifyStrategy {
   [[nodiscard]] bool add(FrontendContext* fc,
                          const frontend::CompilationStencil& stencil,
                          ScriptIndex index);
+
+  // Same as `add`, but only insert one in every `partCount` functions, starting
+  // with the `partIndex`-th one. This is used to split the delazification of a
+  // script between `partCount` tasks, each having a different `partIndex`.
+  [[nodiscard]] bool addPart(FrontendContext* fc,
+                             const frontend::CompilationStencil& stencil,
+                             ScriptIndex index, size_t partIndex,
+                             size_t partCount);
+
+ private:
+  [[nodiscard]] bool addImpl(FrontendContext* fc,
+                             const frontend::CompilationStencil& stencil,
+                             ScriptIndex index, size_t partIndex,
+                             size_t partCount, size_t* counter);
 };
 
 // Delazify all functions using a Depth First traversal of the function-tree
@@ -101,6 +117,34 @@ struct LargeFirstDelazification final : public DelazifyStrategy {
   bool insert(ScriptIndex, frontend::ScriptStencilRef&) override;
 };
 
+// Delazify the functions listed by the embedding with
+// JS::CompileOptions::setDelazificationOrder, in the order in which they are
+// listed. Functions which are not listed are left for on-demand
+// delazification.
+//
+// Functions are identified by their source start offset, as recorded by
+// JS::GetDelazificationOrder during a previous execution of the same source.
+//
+// Hypothesis: The functions are called in the same order as in the recorded
+// execution, so parsing them in that order keeps the helper thread ahead of
+// the main thread without spending time on functions which are never called.
+struct RecordedOrderDelazification final : public DelazifyStrategy {
+  using Rank = uint32_t;
+
+  // Rank of each listed function, keyed by its source start offset.
+  HashMap<uint32_t, Rank, DefaultHasher<uint32_t>, SystemAllocPolicy> ranks;
+
+  // Min-heap of the functions which are ready to be delazified.
+  Vector<std::pair<Rank, ScriptIndex>, 0, SystemAllocPolicy> heap;
+
+  [[nodiscard]] bool init(const JS::ReadOnlyCompileOptions& options);
+
+  bool done() const override { return heap.empty(); }
+  ScriptIndex next() override;
+  void clear() override { return heap.clear(); }
+  bool insert(ScriptIndex, frontend::ScriptStencilRef&) override;
+};
+
 class DelazificationContext {
   const JS::PrefableCompileOptions initialPrefableOptions_;
 
@@ -111,6 +155,14 @@ class DelazificationContext {
   // even more functions.
   frontend::CompilationStencilMerger merger_;
 
+  // Bindings of the enclosing scopes, which are provided by the merger. This
+  // cache persists across the delazifications of the functions of this script,
+  // including when the task is interrupted and resumed.
+  //
+  // We do not use the one from the JSContext/Runtime, as it is not thread safe
+  // to use it, as it could be purged by a GC in the mean time.
+  frontend::StencilScopeBindingCache scopeCache_;
+
   RefPtr<frontend::InitialStencilAndDelazifications> stencils_;
 
   // Record any errors happening while parsing or generating bytecode.
@@ -125,10 +177,14 @@ class DelazificationContext {
       const JS::PrefableCompileOptions& initialPrefableOptions,
       size_t stackQuota)
       : initialPrefableOptions_(initialPrefableOptions),
+        scopeCache_(merger_),
         stackQuota_(stackQuota) {}
 
+  // Initialize the context to delazify the `partIndex`-th of `partCount`
+  // parts of the functions of the script. See DelazifyStrategy::addPart.
   bool init(const JS::ReadOnlyCompileOptions& options,
-            frontend::InitialStencilAndDelazifications* stencils);
+            frontend::InitialStencilAndDelazifications* stencils,
+            size_t partIndex, size_t partCount);
   bool delazify();
 
   // This function is called by `delazify` function to know whether the
@@ -241,6 +241,7 @@ js::DateTimeInfo::DateTimeInfo(bool forceUTC) : forceUTC_(forceUTC) {
 
 js::DateTimeInfo::~DateTimeInfo() = default;
 
+/* static */
 int64_t js::DateTimeInfo::toClampedSeconds(int64_t milliseconds) {
   int64_t seconds = milliseconds / msPerSecond;
   int64_t millis = milliseconds % msPerSecond;
@@ -419,11 +420,64 @@ int32_t js::DateTimeInfo::computeLocalOffsetMilliseconds(int64_t utcSeconds) {
 int32_t js::DateTimeInfo::internalGetOffsetMilliseconds(int64_t milliseconds,
                                                         TimeZoneOffset offset) {
   int64_t seconds = toClampedSeconds(milliseconds);
-  return offset == TimeZoneOffset::UTC
-             ? getOrComputeValue(localRange_, seconds,
-                                 &DateTimeInfo::computeLocalOffsetMilliseconds)
-             : getOrComputeValue(utcRange_, seconds,
-                                 &DateTimeInfo::computeUTCOffsetMilliseconds);
+  RangeCache& range = offset == TimeZoneOffset::UTC ? localRange_ : utcRange_;
+  int32_t result =
+      offset == TimeZoneOffset::UTC
+          ? getOrComputeValue(range, seconds,
+                              &DateTimeInfo::computeLocalOffsetMilliseconds)
+          : getOrComputeValue(range, seconds,
+                              &DateTimeInfo::computeUTCOffsetMilliseconds);
+
+  // Publish the range which contains |seconds| for lock-free lookups.
+  if (!forceUTC_) {
+    auto& shared = sharedOffsetRanges[size_t(offset)];
+    if (range.startSeconds <= seconds && seconds <= range.endSeconds) {
+      shared.update(range.startSeconds, range.endSeconds,
+                    range.offsetMilliseconds);
+    } else {
+      MOZ_ASSERT(range.oldStartSeconds <= seconds &&
+                 seconds <= range.oldEndSeconds);
+      shared.update(range.oldStartSeconds, range.oldEndSeconds,
+                    range.oldOffsetMilliseconds);
+    }
+  }
+
+  return result;
+}
+
+bool js::DateTimeInfo::SharedRangeCache::lookup(
+    int64_t seconds, int32_t* offsetMilliseconds) const {
+  uint32_t sequence = sequence_;
+  if (sequence & 1) {
+    return false;
+  }
+
+  int64_t startSeconds = startSeconds_;
+  int64_t endSeconds = endSeconds_;
+  int32_t offset = offsetMilliseconds_;
+
+  // Discard the values if a writer modified them while we read them.
+  if (sequence_ != sequence) {
+    return false;
+  }
+
+  if (startSeconds <= seconds && seconds <= endSeconds) {
+    *offsetMilliseconds = offset;
+    return true;
+  }
+  return false;
+}
+
+void js::DateTimeInfo::SharedRangeCache::update(int64_t startSeconds,
+                                                int64_t endSeconds,
+                                                int32_t offsetMilliseconds) {
+  MOZ_ASSERT(!(sequence_ & 1), "writers are serialized by the mutex");
+
+  sequence_++;
+  startSeconds_ = startSeconds;
+  endSeconds_ = endSeconds;
+  offsetMilliseconds_ = offsetMilliseconds;
+  sequence_++;
 }
 
 bool js::DateTimeInfo::internalTimeZoneDisplayName(char16_t* buf, size_t buflen,
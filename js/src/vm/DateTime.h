@@ -129,6 +129,35 @@ class DateTimeInfo {
   static inline mozilla::Atomic<int32_t, mozilla::Relaxed>
       utcToLocalOffsetSeconds{InvalidOffset};
 
+#if JS_HAS_INTL_API
+  /**
+   * Lock-free copy of the most recently used offset range of the default
+   * (non-UTC) instance, so that local time conversions on different threads
+   * don't contend for the mutex while they stay within the same DST range.
+   *
+   * Writers hold the instance's mutex and make |sequence_| odd while they
+   * update the range. Readers retry through the mutex-synchronized code path
+   * if the sequence number is odd or changed while they read the range.
+   */
+  class SharedRangeCache {
+    mozilla::Atomic<uint32_t, mozilla::ReleaseAcquire> sequence_{0};
+
+    // Initially empty, so the first lookup is always a miss.
+    mozilla::Atomic<int64_t, mozilla::ReleaseAcquire> startSeconds_{1};
+    mozilla::Atomic<int64_t, mozilla::ReleaseAcquire> endSeconds_{0};
+    mozilla::Atomic<int32_t, mozilla::ReleaseAcquire> offsetMilliseconds_{0};
+
+   public:
+    bool lookup(int64_t seconds, int32_t* offsetMilliseconds) const;
+    void update(int64_t startSeconds, int64_t endSeconds,
+                int32_t offsetMilliseconds);
+    void invalidate() { update(1, 0, 0); }
+  };
+
+  // Indexed by TimeZoneOffset.
+  static inline SharedRangeCache sharedOffsetRanges[2];
+#endif /* JS_HAS_INTL_API */
+
   friend class ExclusiveData<DateTimeInfo>;
 
   friend bool InitDateTimeState();
@@ -198,6 +227,16 @@ class DateTimeInfo {
    */
   static int32_t getOffsetMilliseconds(ForceUTC forceUTC, int64_t milliseconds,
                                        TimeZoneOffset offset) {
+    // First try the shared range cache to avoid any mutex overhead.
+    if (forceUTC == ForceUTC::No) {
+      int32_t result;
+      if (sharedOffsetRanges[size_t(offset)].lookup(
+              toClampedSeconds(milliseconds), &result)) {
+        return result;
+      }
+    }
+
+    // If that fails, use the mutex-synchronized code path.
     auto guard = acquireLockWithValidTimeZone(forceUTC);
     return guard->internalGetOffsetMilliseconds(milliseconds, offset);
   }
@@ -259,8 +298,13 @@ class DateTimeInfo {
       auto guard = instance->lock();
       guard->internalResetTimeZone(mode);
 
-      // Mark the cached value as invalid.
+      // Mark the cached values as invalid.
       utcToLocalOffsetSeconds = InvalidOffset;
+#if JS_HAS_INTL_API
+      for (auto& range : sharedOffsetRanges) {
+        range.invalidate();
+      }
+#endif
     }
     {
       // Only needed to initialize the default state and any later call will
@@ -371,7 +415,7 @@ class DateTimeInfo {
 
   void internalResyncICUDefaultTimeZone();
 
-  int64_t toClampedSeconds(int64_t milliseconds);
+  static int64_t toClampedSeconds(int64_t milliseconds);
 
   using ComputeFn = int32_t (DateTimeInfo::*)(int64_t);
 
@@ -81,6 +81,12 @@ void GeckoProfilerRuntime::enable(bool enabled) {
   /*
    * Ensure all future generated code will be instrumented, or that all
    * currently instrumented code is discarded
+   *
+   * JIT frames are not pushed on the ProfilingStack: samplers unwind them with
+   * JS::ProfilingFrameIterator, which uses the JitcodeGlobalTable to map return
+   * addresses to (possibly inlined) scripts. The instrumentation only keeps
+   * the activation's lastProfilingFrame up to date so that unwinding can start
+   * from any point, and is what this discards when profiling is turned off.
    */
   ReleaseAllJITCode(rt->gcContext());
 
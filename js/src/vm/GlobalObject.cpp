@@ -276,6 +276,14 @@ static unsigned GetAttrsForResolvedGlobal(GlobalObject* global,
   return attrs;
 }
 
+// Standard classes are created lazily, one JSProtoKey at a time, the first
+// time a realm touches them. Most of the cost is creating the constructor and
+// prototype objects and defining their properties. The property maps those
+// definitions produce are shared across realms through the zone's ShapeZone,
+// but shapes are not, because BaseShape records the realm. The objects
+// themselves can't be copied from another realm either: each one refers to
+// realm-specific state (the realm's own Function.prototype, intrinsics and
+// self-hosted clones) and must have its own identity.
 /* static*/
 bool GlobalObject::resolveConstructor(JSContext* cx,
                                       Handle<GlobalObject*> global,
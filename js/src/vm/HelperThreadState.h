@@ -55,6 +55,7 @@ namespace js {
 
 struct DelazifyTask;
 struct FreeDelazifyTask;
+class ModuleGraphCompilation;
 struct PromiseHelperTask;
 class PromiseObject;
 
@@ -125,6 +126,8 @@ class GlobalHelperThreadState {
   using DelazifyTaskList = mozilla::LinkedList<DelazifyTask>;
   using FreeDelazifyTaskVector =
       Vector<js::UniquePtr<FreeDelazifyTask>, 1, SystemAllocPolicy>;
+  using ModuleGraphCompileTaskList =
+      mozilla::LinkedList<ModuleGraphCompileTask>;
   using SourceCompressionTaskVector =
       Vector<UniquePtr<SourceCompressionTask>, 0, SystemAllocPolicy>;
   using PromiseHelperTaskVector =
@@ -154,6 +157,12 @@ class GlobalHelperThreadState {
   IonCompileTaskVector ionWorklist_, ionFinishedList_;
   IonFreeTaskVector ionFreeList_;
 
+  // Time spent by Ion compile tasks in the worklist before a helper thread
+  // started compiling them.
+  mozilla::TimeDuration ionWorklistTotalResidency_;
+  mozilla::TimeDuration ionWorklistMaxResidency_;
+  uint64_t ionWorklistDequeueCount_ = 0;
+
   // wasm worklists.
   wasm::CompileTaskPtrFifo wasmWorklist_tier1_;
   wasm::CompileTaskPtrFifo wasmWorklist_tier2_;
@@ -180,6 +189,9 @@ class GlobalHelperThreadState {
   // risk.
   FreeDelazifyTaskVector freeDelazifyTaskVector_;
 
+  // Module graph compilation tasks waiting for a thread.
+  ModuleGraphCompileTaskList moduleGraphWorklist_;
+
   // Source compression worklist of tasks that we do not yet know can start.
   SourceCompressionTaskVector compressionPendingList_;
 
@@ -231,6 +243,7 @@ class GlobalHelperThreadState {
   size_t maxWasmPartialTier2CompileThreads() const;
   size_t maxPromiseHelperThreads() const;
   size_t maxDelazifyThreads() const;
+  size_t maxModuleGraphThreads() const;
   size_t maxCompressionThreads() const;
   size_t maxGCParallelThreads() const;
 
@@ -304,6 +317,18 @@ class GlobalHelperThreadState {
     return ionFreeList_;
   }
 
+  mozilla::TimeDuration ionWorklistTotalResidency(
+      const AutoLockHelperThreadState&) const {
+    return ionWorklistTotalResidency_;
+  }
+  mozilla::TimeDuration ionWorklistMaxResidency(
+      const AutoLockHelperThreadState&) const {
+    return ionWorklistMaxResidency_;
+  }
+  uint64_t ionWorklistDequeueCount(const AutoLockHelperThreadState&) const {
+    return ionWorklistDequeueCount_;
+  }
+
   wasm::CompileTaskPtrFifo& wasmWorklist(const AutoLockHelperThreadState&,
                                          wasm::CompileState state) {
     switch (state) {
@@ -353,6 +378,11 @@ class GlobalHelperThreadState {
     return freeDelazifyTaskVector_;
   }
 
+  ModuleGraphCompileTaskList& moduleGraphWorklist(
+      const AutoLockHelperThreadState&) {
+    return moduleGraphWorklist_;
+  }
+
   SourceCompressionTaskVector& compressionPendingList(
       const AutoLockHelperThreadState&) {
     return compressionPendingList_;
@@ -390,6 +420,7 @@ class GlobalHelperThreadState {
   bool canStartIonFreeTask(const AutoLockHelperThreadState& lock);
   bool canStartFreeDelazifyTask(const AutoLockHelperThreadState& lock);
   bool canStartDelazifyTask(const AutoLockHelperThreadState& lock);
+  bool canStartModuleGraphTask(const AutoLockHelperThreadState& lock);
   bool canStartCompressionTask(const AutoLockHelperThreadState& lock);
   bool canStartGCParallelTask(const AutoLockHelperThreadState& lock);
 
@@ -416,6 +447,8 @@ class GlobalHelperThreadState {
   HelperThreadTask* maybeGetFreeDelazifyTask(
       const AutoLockHelperThreadState& lock);
   HelperThreadTask* maybeGetDelazifyTask(const AutoLockHelperThreadState& lock);
+  HelperThreadTask* maybeGetModuleGraphTask(
+      const AutoLockHelperThreadState& lock);
   HelperThreadTask* maybeGetCompressionTask(
       const AutoLockHelperThreadState& lock);
   HelperThreadTask* maybeGetGCParallelTask(
@@ -487,6 +520,8 @@ class GlobalHelperThreadState {
   void submitTask(DelazifyTask* task, const AutoLockHelperThreadState& locked);
   bool submitTask(UniquePtr<FreeDelazifyTask> task,
                   const AutoLockHelperThreadState& locked);
+  void submitTask(ModuleGraphCompileTask* task,
+                  const AutoLockHelperThreadState& locked);
   bool submitTask(PromiseHelperTask* task);
   bool submitTask(GCParallelTask* task,
                   const AutoLockHelperThreadState& locked);
@@ -543,14 +578,16 @@ struct DelazifyTask : public mozilla::LinkedListElement<DelazifyTask>,
   // optimization in place.
   static UniquePtr<DelazifyTask> Create(
       JSRuntime* maybeRuntime, const JS::ReadOnlyCompileOptions& options,
-      frontend::InitialStencilAndDelazifications* stencils);
+      frontend::InitialStencilAndDelazifications* stencils, size_t partIndex,
+      size_t partCount);
 
   DelazifyTask(JSRuntime* maybeRuntime,
                const JS::PrefableCompileOptions& initialPrefableOptions);
   ~DelazifyTask();
 
   [[nodiscard]] bool init(const JS::ReadOnlyCompileOptions& options,
-                          frontend::InitialStencilAndDelazifications* stencils);
+                          frontend::InitialStencilAndDelazifications* stencils,
+                          size_t partIndex, size_t partCount);
 
   bool runtimeMatchesOrNoRuntime(JSRuntime* rt) {
     return !maybeRuntime || maybeRuntime == rt;
@@ -587,6 +624,23 @@ struct FreeDelazifyTask : public HelperThreadTask {
   const char* getName() override { return "FreeDelazifyTask"; }
 };
 
+// Compiles the pending modules of a ModuleGraphCompilation, see
+// vm/ModuleGraphCompilation.h. The task deletes itself once it has run.
+struct ModuleGraphCompileTask
+    : public mozilla::LinkedListElement<ModuleGraphCompileTask>,
+      public HelperThreadTask {
+  ModuleGraphCompilation* compilation;
+
+  explicit ModuleGraphCompileTask(ModuleGraphCompilation* compilation)
+      : compilation(compilation) {}
+  void runHelperThreadTask(AutoLockHelperThreadState& locked) override;
+  ThreadType threadType() override {
+    return ThreadType::THREAD_TYPE_MODULE_GRAPH;
+  }
+
+  const char* getName() override { return "ModuleGraphCompileTask"; }
+};
+
 // It is not desirable to eagerly compress: if lazy functions that are tied to
 // the ScriptSource were to be executed relatively soon after parsing, they
 // would need to block on decompression, which hurts responsiveness.
@@ -612,6 +666,9 @@ class SourceCompressionTask : public HelperThreadTask {
   // The source to be compressed.
   RefPtr<ScriptSource> source_;
 
+  // The codec selected by the runtime when the task was enqueued.
+  CompressionCodec codec_;
+
   // The resultant compressed string. If the compressed string is larger
   // than the original, or we OOM'd during compression, or nothing else
   // except the task is holding the ScriptSource alive when scheduled to
@@ -621,7 +678,10 @@ class SourceCompressionTask : public HelperThreadTask {
  public:
   // The majorGCNumber is used for scheduling tasks.
   SourceCompressionTask(JSRuntime* rt, ScriptSource* source)
-      : runtime_(rt), majorGCNumber_(rt->gc.majorGCCount()), source_(source) {
+      : runtime_(rt),
+        majorGCNumber_(rt->gc.majorGCCount()),
+        source_(source),
+        codec_(rt->sourceCompressionCodec()) {
     source->noteSourceCompressionTask();
   }
   virtual ~SourceCompressionTask() = default;
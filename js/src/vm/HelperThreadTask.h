@@ -18,6 +18,7 @@ class AutoLockHelperThreadState;
 struct DelazifyTask;
 struct FreeDelazifyTask;
 class GlobalHelperThreadState;
+struct ModuleGraphCompileTask;
 class SourceCompressionTask;
 
 namespace jit {
@@ -64,6 +65,11 @@ struct MapTypeToThreadType<FreeDelazifyTask> {
   static const ThreadType threadType = THREAD_TYPE_DELAZIFY_FREE;
 };
 
+template <>
+struct MapTypeToThreadType<ModuleGraphCompileTask> {
+  static const ThreadType threadType = THREAD_TYPE_MODULE_GRAPH;
+};
+
 template <>
 struct MapTypeToThreadType<SourceCompressionTask> {
   static const ThreadType threadType = THREAD_TYPE_COMPRESS;
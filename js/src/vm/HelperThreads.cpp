@@ -20,6 +20,7 @@
 #include "jit/IonCompileTask.h"
 #include "jit/JitRuntime.h"
 #include "jit/JitScript.h"
+#include "jit/JitSpewer.h"
 #include "js/CompileOptions.h"  // JS::PrefableCompileOptions, JS::ReadOnlyCompileOptions
 #include "js/experimental/CompileScript.h"  // JS::ThreadStackQuotaForSize
 #include "js/friend/StackLimits.h"          // js::ReportOverRecursed
@@ -31,6 +32,7 @@
 #include "vm/ErrorReporting.h"
 #include "vm/HelperThreadState.h"
 #include "vm/InternalThreadPool.h"
+#include "vm/ModuleGraphCompilation.h"
 #include "vm/MutexIDs.h"
 #include "wasm/WasmGenerator.h"
 
@@ -143,6 +145,18 @@ JS_PUBLIC_API MOZ_NEVER_INLINE const char* JS::GetHelperThreadTaskName(
   return task->getName();
 }
 
+JS_PUBLIC_API bool JS::IsHelperThreadTaskLatencyCritical(
+    HelperThreadTask* task) {
+  switch (task->threadType()) {
+    case THREAD_TYPE_GCPARALLEL:
+    case THREAD_TYPE_BASELINE:
+    case THREAD_TYPE_WASM_COMPILE_TIER1:
+      return true;
+    default:
+      return false;
+  }
+}
+
 void GlobalHelperThreadState::setDispatchTaskCallback(
     JS::HelperThreadTaskCallback callback, size_t threadCount, size_t stackSize,
     const AutoLockHelperThreadState& lock) {
@@ -475,6 +489,13 @@ size_t GlobalHelperThreadState::maxDelazifyThreads() const {
   return std::min(cpuCount, threadCount);
 }
 
+size_t GlobalHelperThreadState::maxModuleGraphThreads() const {
+  if (IsHelperThreadSimulatingOOM(js::THREAD_TYPE_MODULE_GRAPH)) {
+    return 1;
+  }
+  return std::min(cpuCount, threadCount);
+}
+
 size_t GlobalHelperThreadState::maxCompressionThreads() const {
   if (IsHelperThreadSimulatingOOM(js::THREAD_TYPE_COMPRESS)) {
     return 1;
@@ -573,7 +594,15 @@ void GlobalHelperThreadState::trace(JSTracer* trc) {
 
 // Definition of helper thread tasks.
 //
-// Priority is determined by the order they're listed here.
+// Priority is determined by the order they're listed here. A task is only
+// chosen when a thread becomes free (see dispatch()), so newly submitted GC
+// work is picked ahead of any Ion, delazification or compression work that is
+// still queued, even though running tasks are never interrupted.
+//
+// The threads themselves are owned by the embedder when it installs a
+// HelperThreadTaskCallback, so there are no engine-side per-thread queues to
+// steal from; the helper thread lock is only held for the selection itself
+// and released while the task runs.
 const GlobalHelperThreadState::Selector GlobalHelperThreadState::selectors[] = {
     &GlobalHelperThreadState::maybeGetGCParallelTask,
     &GlobalHelperThreadState::maybeGetBaselineCompileTask,
@@ -581,6 +610,7 @@ const GlobalHelperThreadState::Selector GlobalHelperThreadState::selectors[] = {
     &GlobalHelperThreadState::maybeGetWasmTier1CompileTask,
     &GlobalHelperThreadState::maybeGetPromiseHelperTask,
     &GlobalHelperThreadState::maybeGetFreeDelazifyTask,
+    &GlobalHelperThreadState::maybeGetModuleGraphTask,
     &GlobalHelperThreadState::maybeGetDelazifyTask,
     &GlobalHelperThreadState::maybeGetCompressionTask,
     &GlobalHelperThreadState::maybeGetLowPrioIonCompileTask,
@@ -594,8 +624,9 @@ bool GlobalHelperThreadState::canStartTasks(
   return canStartGCParallelTask(lock) || canStartBaselineCompileTask(lock) ||
          canStartIonCompileTask(lock) || canStartWasmTier1CompileTask(lock) ||
          canStartPromiseHelperTask(lock) || canStartFreeDelazifyTask(lock) ||
-         canStartDelazifyTask(lock) || canStartCompressionTask(lock) ||
-         canStartIonFreeTask(lock) || canStartWasmTier2CompileTask(lock) ||
+         canStartModuleGraphTask(lock) || canStartDelazifyTask(lock) ||
+         canStartCompressionTask(lock) || canStartIonFreeTask(lock) ||
+         canStartWasmTier2CompileTask(lock) ||
          canStartWasmCompleteTier2GeneratorTask(lock) ||
          canStartWasmPartialTier2CompileTask(lock);
 }
@@ -712,18 +743,26 @@ bool GlobalHelperThreadState::canStartIonCompileTask(
                               lock);
 }
 
+static uint64_t IonCompileTaskPriority(jit::IonCompileTask* task) {
+  // A higher warm-up counter indicates a higher priority. Warm-up counts
+  // gained while the task is waiting in the worklist are counted twice, so
+  // that scripts which are still running hot get boosted past scripts which
+  // crossed the Ion threshold and then stopped running.
+  JSScript* script = task->script();
+  uint32_t warmUpCount = script->jitScript()->warmUpCount();
+  uint32_t growth = warmUpCount > task->submitWarmUpCount()
+                        ? warmUpCount - task->submitWarmUpCount()
+                        : 0;
+  return (uint64_t(warmUpCount) + growth) / script->length();
+}
+
 static bool IonCompileTaskHasHigherPriority(jit::IonCompileTask* first,
                                             jit::IonCompileTask* second) {
   // Return true if priority(first) > priority(second).
   //
   // This method can return whatever it wants, though it really ought to be a
   // total order. The ordering is allowed to race (change on the fly), however.
-
-  // A higher warm-up counter indicates a higher priority.
-  jit::JitScript* firstJitScript = first->script()->jitScript();
-  jit::JitScript* secondJitScript = second->script()->jitScript();
-  return firstJitScript->warmUpCount() / first->script()->length() >
-         secondJitScript->warmUpCount() / second->script()->length();
+  return IonCompileTaskPriority(first) > IonCompileTaskPriority(second);
 }
 
 jit::IonCompileTask* GlobalHelperThreadState::highestPriorityPendingIonCompile(
@@ -749,6 +788,21 @@ jit::IonCompileTask* GlobalHelperThreadState::highestPriorityPendingIonCompile(
   }
   jit::IonCompileTask* task = worklist[index];
   worklist.erase(&worklist[index]);
+
+  mozilla::TimeDuration residency =
+      mozilla::TimeStamp::Now() - task->submitTime();
+  ionWorklistTotalResidency_ += residency;
+  if (residency > ionWorklistMaxResidency_) {
+    ionWorklistMaxResidency_ = residency;
+  }
+  ionWorklistDequeueCount_++;
+  JitSpew(jit::JitSpew_IonScripts,
+          "Starting off-thread compile of %s:%u:%u after %.3f ms in worklist "
+          "(%zu pending)",
+          task->script()->filename(), task->script()->lineno(),
+          task->script()->column().oneOriginValue(), residency.ToMilliseconds(),
+          worklist.length());
+
   return task;
 }
 
@@ -776,6 +830,9 @@ bool GlobalHelperThreadState::submitTask(
     jit::IonCompileTask* task, const AutoLockHelperThreadState& locked) {
   MOZ_ASSERT(isInitialized(locked));
 
+  task->setSubmitted(task->script()->jitScript()->warmUpCount(),
+                     mozilla::TimeStamp::Now());
+
   if (!ionWorklist(locked).append(task)) {
     return false;
   }
@@ -1041,6 +1098,13 @@ void jit::JitRuntime::maybeStartIonFreeTask(bool force) {
     if (tasks.length() < MinBatchSize) {
       return;
     }
+
+    // Hold on to a few LifoAllocs so compilations started after this batch is
+    // freed can still reuse their memory.
+    cacheIonLifoAllocs(tasks);
+    if (tasks.empty()) {
+      return;
+    }
   }
 
   auto freeTask = js::MakeUnique<jit::IonFreeTask>(std::move(tasks));
@@ -1268,30 +1332,42 @@ void js::StartOffThreadDelazification(
     return;
   }
 
-  JSRuntime* maybeRuntime = maybeCx ? maybeCx->runtime() : nullptr;
-  UniquePtr<DelazifyTask> task;
-  task = DelazifyTask::Create(maybeRuntime, options, stencils);
-  if (!task) {
-    return;
+  // When everything has to be parsed, split the functions between as many
+  // tasks as can run in parallel. Each task delazifies the inner functions of
+  // the functions it was given, such that tasks never wait on each other.
+  size_t partCount = 1;
+  if (strategy == JS::DelazificationOption::ParseEverythingConcurrently) {
+    partCount = std::max<size_t>(HelperThreadState().maxDelazifyThreads(), 1);
   }
 
-  // Schedule delazification task if there is any function to delazify.
-  if (!task->done()) {
-    AutoLockHelperThreadState lock;
-    HelperThreadState().submitTask(task.release(), lock);
+  JSRuntime* maybeRuntime = maybeCx ? maybeCx->runtime() : nullptr;
+  for (size_t partIndex = 0; partIndex < partCount; partIndex++) {
+    UniquePtr<DelazifyTask> task;
+    task = DelazifyTask::Create(maybeRuntime, options, stencils, partIndex,
+                                partCount);
+    if (!task) {
+      return;
+    }
+
+    // Schedule delazification task if there is any function to delazify.
+    if (!task->done()) {
+      AutoLockHelperThreadState lock;
+      HelperThreadState().submitTask(task.release(), lock);
+    }
   }
 }
 
 UniquePtr<DelazifyTask> DelazifyTask::Create(
     JSRuntime* maybeRuntime, const JS::ReadOnlyCompileOptions& options,
-    frontend::InitialStencilAndDelazifications* stencils) {
+    frontend::InitialStencilAndDelazifications* stencils, size_t partIndex,
+    size_t partCount) {
   UniquePtr<DelazifyTask> task;
   task.reset(js_new<DelazifyTask>(maybeRuntime, options.prefableOptions()));
   if (!task) {
     return nullptr;
   }
 
-  if (!task->init(options, stencils)) {
+  if (!task->init(options, stencils, partIndex, partCount)) {
     // In case of errors, skip this and delazify on-demand.
     return nullptr;
   }
@@ -1313,8 +1389,9 @@ DelazifyTask::~DelazifyTask() {
 }
 
 bool DelazifyTask::init(const JS::ReadOnlyCompileOptions& options,
-                        frontend::InitialStencilAndDelazifications* stencils) {
-  return delazificationCx.init(options, stencils);
+                        frontend::InitialStencilAndDelazifications* stencils,
+                        size_t partIndex, size_t partCount) {
+  return delazificationCx.init(options, stencils, partIndex, partCount);
 }
 
 size_t DelazifyTask::sizeOfExcludingThis(
@@ -1466,6 +1543,40 @@ void js::WaitForAllDelazifyTasks(JSRuntime* rt) {
   }
 }
 
+//== ModuleGraphCompileTask ===============================================
+
+bool GlobalHelperThreadState::canStartModuleGraphTask(
+    const AutoLockHelperThreadState& lock) {
+  return !moduleGraphWorklist(lock).isEmpty() &&
+         checkTaskThreadLimit(THREAD_TYPE_MODULE_GRAPH,
+                              maxModuleGraphThreads(), lock);
+}
+
+HelperThreadTask* GlobalHelperThreadState::maybeGetModuleGraphTask(
+    const AutoLockHelperThreadState& lock) {
+  if (!canStartModuleGraphTask(lock)) {
+    return nullptr;
+  }
+  return moduleGraphWorklist(lock).popFirst();
+}
+
+void GlobalHelperThreadState::submitTask(
+    ModuleGraphCompileTask* task, const AutoLockHelperThreadState& locked) {
+  moduleGraphWorklist(locked).insertBack(task);
+  dispatch(locked);
+}
+
+void ModuleGraphCompileTask::runHelperThreadTask(
+    AutoLockHelperThreadState& lock) {
+  // The compilation may be destroyed by the loader once notified.
+  if (compilation->compilePendingModules(lock)) {
+    AutoUnlockHelperThreadState unlock(lock);
+    compilation->notifyFinished();
+  }
+
+  js_delete(this);
+}
+
 //== FreeDelazifyTask =====================================================
 
 bool GlobalHelperThreadState::canStartFreeDelazifyTask(
@@ -21,6 +21,7 @@
 
 #include "builtin/AtomicsObject.h"
 #include "builtin/TestingFunctions.h"
+#include "frontend/FrontendLifoAllocCache.h"
 #include "gc/Statistics.h"
 #include "jit/Assembler.h"
 #include "jit/Ion.h"
@@ -213,6 +214,13 @@ JS_PUBLIC_API const char* JS::detail::InitWithFailureDiagnostic(
 
 #undef RETURN_IF_FAIL
 
+JS_PUBLIC_API void JS::SetExtraPermanentAtoms(
+    JSContext* cx, mozilla::Span<const char* const> names) {
+  MOZ_RELEASE_ASSERT(!cx->runtime()->permanentAtomsPopulated(),
+                     "JS::SetExtraPermanentAtoms() called too late");
+  cx->runtime()->extraPermanentAtomNames = names;
+}
+
 JS_PUBLIC_API bool JS::InitSelfHostedCode(JSContext* cx, SelfHostedCache cache,
                                           SelfHostedWriter writer) {
   MOZ_RELEASE_ASSERT(!cx->runtime()->hasInitializedSelfHosting(),
@@ -226,7 +234,9 @@ JS_PUBLIC_API bool JS::InitSelfHostedCode(JSContext* cx, SelfHostedCache cache,
     return false;
   }
 
-  if (!rt->initializeAtoms(cx)) {
+  bool atomsInitialized = rt->initializeAtoms(cx);
+  rt->extraPermanentAtomNames = nullptr;
+  if (!atomsInitialized) {
     return false;
   }
 
@@ -260,6 +270,7 @@ static void ShutdownImpl(JS::detail::FrontendOnly frontendOnly) {
 #endif
 
   js::frontend::WellKnownParserAtoms::freeSingleton();
+  js::frontend::FrontendLifoAllocCache::purge();
   js::SharedImmutableStringsCache::freeSingleton();
 
   if (frontendOnly == FrontendOnly::No) {
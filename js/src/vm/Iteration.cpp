@@ -974,18 +974,35 @@ static inline bool CanCompareIterableObjectToCache(JSObject* obj) {
   return false;
 }
 
+// The iterated object itself may also have dense elements if they're packed.
+// Its element keys are then determined by the dense initialized length, which
+// is compared to NativeIterator::numDenseElements() on lookup. Only the
+// realm's iterator cache is used for such objects, because the shape cache is
+// also used by JIT code which only checks the shapes.
+static inline bool CanCompareIterableReceiverToCache(JSObject* obj) {
+  if (!obj->is<NativeObject>()) {
+    return false;
+  }
+  auto& nobj = obj->as<NativeObject>();
+  return nobj.getDenseInitializedLength() == 0 ||
+         nobj.denseElementsArePacked();
+}
+
 static bool CanStoreInIteratorCache(JSObject* obj) {
+  MOZ_ASSERT(CanCompareIterableReceiverToCache(obj));
+
+  JSObject* pobj = obj;
   do {
-    MOZ_ASSERT(obj->as<NativeObject>().getDenseInitializedLength() == 0);
+    MOZ_ASSERT_IF(pobj != obj, CanCompareIterableObjectToCache(pobj));
 
     // Typed arrays have indexed properties not captured by the Shape guard.
     // Enumerate hooks may add extra properties.
-    if (MOZ_UNLIKELY(ClassCanHaveExtraEnumeratedProperties(obj->getClass()))) {
+    if (MOZ_UNLIKELY(ClassCanHaveExtraEnumeratedProperties(pobj->getClass()))) {
       return false;
     }
 
-    obj = obj->staticPrototype();
-  } while (obj);
+    pobj = pobj->staticPrototype();
+  } while (pobj);
 
   return true;
 }
@@ -999,6 +1016,7 @@ static MOZ_ALWAYS_INLINE PropertyIteratorObject* LookupInShapeIteratorCache(
   PropertyIteratorObject* iterobj = obj->shape()->cache().toIterator();
   NativeIterator* ni = iterobj->getNativeIterator();
   MOZ_ASSERT(*ni->shapesBegin() == obj->shape());
+  MOZ_ASSERT(ni->numDenseElements() == 0);
   if (!ni->isReusable()) {
     return nullptr;
   }
@@ -1033,7 +1051,8 @@ static MOZ_ALWAYS_INLINE PropertyIteratorObject* LookupInIteratorCache(
   HashNumber shapesHash = 0;
   JSObject* pobj = obj;
   do {
-    if (!CanCompareIterableObjectToCache(pobj)) {
+    if (pobj == obj ? !CanCompareIterableReceiverToCache(pobj)
+                    : !CanCompareIterableObjectToCache(pobj)) {
       return nullptr;
     }
 
@@ -1066,6 +1085,10 @@ static MOZ_ALWAYS_INLINE PropertyIteratorObject* LookupInIteratorCache(
   if (!ni->isReusable()) {
     return nullptr;
   }
+  if (ni->numDenseElements() !=
+      obj->as<NativeObject>().getDenseInitializedLength()) {
+    return nullptr;
+  }
 
   return iterobj;
 }
@@ -1077,7 +1100,14 @@ static MOZ_ALWAYS_INLINE PropertyIteratorObject* LookupInIteratorCache(
   NativeIterator* ni = iterobj->getNativeIterator();
   MOZ_ASSERT(ni->shapeCount() > 0);
 
-  obj->shape()->maybeCacheIterator(cx, iterobj);
+  // The enumerated keys include the dense elements, which aren't covered by
+  // the shape guard. Don't cache these iterators on the shape.
+  uint32_t numDenseElements =
+      obj->as<NativeObject>().getDenseInitializedLength();
+  ni->setNumDenseElements(numDenseElements);
+  if (numDenseElements == 0) {
+    obj->shape()->maybeCacheIterator(cx, iterobj);
+  }
 
   IteratorHashPolicy::Lookup lookup(
       reinterpret_cast<Shape**>(ni->shapesBegin()), ni->shapeCount(),
@@ -1181,6 +1211,9 @@ static PropertyIteratorObject* GetIteratorImpl(JSContext* cx,
     if (!recreateWithIndices) {
       MOZ_ASSERT_IF(WantIndices && ni->hasValidIndices(),
                     IndicesAreValid(&obj->as<NativeObject>(), ni));
+      if (ni->numDenseElements() > 0) {
+        obj->as<NativeObject>().markDenseElementsMaybeInIteration();
+      }
       ni->initObjectBeingIterated(*obj);
       RegisterEnumerator(cx, ni);
       return iterobj;
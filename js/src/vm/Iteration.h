@@ -305,6 +305,12 @@ struct NativeIterator : public NativeIteratorListNode {
   // property count above them.
   uint32_t flagsAndCount_ = 0;
 
+  // The dense initialized length of the iterated object when this iterator was
+  // added to the iterator cache. The shapes don't cover dense elements, so a
+  // cached iterator is only reused for objects with the same number of packed
+  // dense elements. See LookupInIteratorCache.
+  uint32_t numDenseElements_ = 0;
+
 #ifdef DEBUG
   // If true, this iterator may contain indexed properties that came from
   // objects on the prototype chain. This is used by certain debug assertions.
@@ -568,6 +574,9 @@ struct NativeIterator : public NativeIteratorListNode {
     flagsAndCount_ |= Flags::HasUnvisitedPropertyDeletion;
   }
 
+  uint32_t numDenseElements() const { return numDenseElements_; }
+  void setNumDenseElements(uint32_t count) { numDenseElements_ = count; }
+
   bool hasValidIndices() const {
     return indicesState() == NativeIteratorIndices::Valid;
   }
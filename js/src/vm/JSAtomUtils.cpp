@@ -12,6 +12,7 @@
 
 #include "mozilla/HashFunctions.h"  // mozilla::HashStringKnownLength
 #include "mozilla/RangedPtr.h"
+#include "mozilla/TextUtils.h"  // mozilla::IsAscii
 
 #include <charconv>
 #include <iterator>
@@ -26,6 +27,7 @@
 #include "js/CharacterEncoding.h"
 #include "js/friend/ErrorMessages.h"  // js::GetErrorMessage, JSMSG_*
 #include "js/Symbol.h"
+#include "util/Identifier.h"  // js::IsIdentifier
 #include "util/Text.h"
 #include "vm/JSContext.h"
 #include "vm/JSObject.h"
@@ -207,6 +209,21 @@ bool JSRuntime::initializeAtoms(JSContext* cx) {
     return false;
   }
 
+  for (const char* name : extraPermanentAtomNames.ref()) {
+    size_t length = strlen(name);
+    const auto* chars = reinterpret_cast<const Latin1Char*>(name);
+    if (!mozilla::IsAscii(mozilla::Span(name, length)) ||
+        !IsIdentifier(chars, length)) {
+      continue;
+    }
+    JSAtom* atom = PermanentlyAtomizeCharsValidLength(
+        cx, *atomSet, mozilla::HashStringKnownLength(name, length), chars,
+        length);
+    if (!atom) {
+      return false;
+    }
+  }
+
   // Create the well-known symbols.
   auto wks = js_new<WellKnownSymbols>();
   if (!wks) {
@@ -1272,8 +1272,12 @@ size_t JSContext::sizeOfExcludingThis(
    * ones have been found by DMD to be worth measuring.  More stuff may be
    * added later.
    */
-  return cycleDetectorVector().sizeOfExcludingThis(mallocSizeOf) +
-         irregexp::IsolateSizeOfIncludingThis(isolate, mallocSizeOf);
+  size_t n = cycleDetectorVector().sizeOfExcludingThis(mallocSizeOf) +
+             irregexp::IsolateSizeOfIncludingThis(isolate, mallocSizeOf);
+#ifdef ENABLE_WASM_JSPI
+  n += wasm_.promiseIntegration.sizeOfExcludingThis(mallocSizeOf);
+#endif
+  return n;
 }
 
 size_t JSContext::sizeOfIncludingThis(
@@ -858,6 +858,13 @@ struct JS_PUBLIC_API JSContext : public JS::RootingContext,
   // cases, this relaxed ordering could lead to an interrupt handler being
   // called twice in succession after a single requestInterrupt call, but
   // that's fine.
+  //
+  // Loop headers poll interruptBits_ with a load and a branch that is almost
+  // never taken, which is cheap next to the rest of a loop body. Turning the
+  // poll into a load from a page that requestInterrupt protects would save
+  // the branch but require every JIT tier to be able to stop at an arbitrary
+  // faulting load with a precise safepoint, which is why the signal-based
+  // interrupt scheme was removed from wasm in favour of polling.
   void requestInterrupt(js::InterruptReason reason);
   bool handleInterrupt();
 
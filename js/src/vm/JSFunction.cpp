@@ -24,7 +24,9 @@
 #include "builtin/BigInt.h"
 #include "builtin/Object.h"
 #include "builtin/Symbol.h"
-#include "frontend/BytecodeCompiler.h"  // frontend::{CompileStandaloneFunction, CompileStandaloneGenerator, CompileStandaloneAsyncFunction, CompileStandaloneAsyncGenerator, DelazifyCanonicalScriptedFunction}
+#include "frontend/BytecodeCompiler.h"  // frontend::{CompileStandaloneFunction, CompileStandaloneGenerator, CompileStandaloneAsyncFunction, CompileStandaloneAsyncGenerator, DelazifyCanonicalScriptedFunction, InstantiateStandaloneFunction}
+#include "frontend/CompilationStencil.h"  // frontend::CompilationStencil
+#include "frontend/DynamicFunctionCache.h"  // frontend::DynamicFunctionCache
 #include "frontend/FrontendContext.h"  // AutoReportFrontendContext, ManualReportFrontendContext
 #include "frontend/Stencil.h"  // js::DumpFunctionFlagsItems
 #include "jit/InlinableNatives.h"
@@ -1518,27 +1520,56 @@ static bool CreateDynamicFunction(JSContext* cx, const CallArgs& args,
 
   FunctionSyntaxKind syntaxKind = FunctionSyntaxKind::Expression;
 
-  RootedFunction fun(cx);
   JSProtoKey protoKey;
   if (isAsync) {
-    if (isGenerator) {
-      fun = CompileStandaloneAsyncGenerator(cx, options, srcBuf,
-                                            parameterListEnd, syntaxKind);
-      protoKey = JSProto_AsyncGeneratorFunction;
-    } else {
-      fun = CompileStandaloneAsyncFunction(cx, options, srcBuf,
-                                           parameterListEnd, syntaxKind);
-      protoKey = JSProto_AsyncFunction;
-    }
+    protoKey =
+        isGenerator ? JSProto_AsyncGeneratorFunction : JSProto_AsyncFunction;
   } else {
-    if (isGenerator) {
-      fun = CompileStandaloneGenerator(cx, options, srcBuf, parameterListEnd,
-                                       syntaxKind);
-      protoKey = JSProto_GeneratorFunction;
+    protoKey = isGenerator ? JSProto_GeneratorFunction : JSProto_Function;
+  }
+
+  // Calls from script are cached by function text and call site. The
+  // function text also encodes the generator and async kinds.
+  Maybe<frontend::DynamicFunctionCache::Lookup> cacheLookup;
+  if (maybeScript) {
+    cacheLookup.emplace(cx->realm(), maybeScript, pcOffset,
+                        linearChars.twoByteChars(), linearChars.length());
+  }
+
+  // Hold a reference to the cached stencil, as instantiation can GC and purge
+  // the cache.
+  frontend::DynamicFunctionCache& cache = cx->caches().dynamicFunctionCache;
+  RefPtr<frontend::CompilationStencil> cachedStencil =
+      cacheLookup ? cache.lookup(*cacheLookup) : nullptr;
+
+  RootedFunction fun(cx);
+  if (cachedStencil) {
+    fun = InstantiateStandaloneFunction(cx, options, *cachedStencil);
+  } else {
+    frontend::CompilationStencil* rawStencil = nullptr;
+    frontend::CompilationStencil** stencilOut =
+        cacheLookup ? &rawStencil : nullptr;
+    if (isAsync) {
+      if (isGenerator) {
+        fun = CompileStandaloneAsyncGenerator(
+            cx, options, srcBuf, parameterListEnd, syntaxKind, stencilOut);
+      } else {
+        fun = CompileStandaloneAsyncFunction(
+            cx, options, srcBuf, parameterListEnd, syntaxKind, stencilOut);
+      }
     } else {
-      fun = CompileStandaloneFunction(cx, options, srcBuf, parameterListEnd,
-                                      syntaxKind);
-      protoKey = JSProto_Function;
+      if (isGenerator) {
+        fun = CompileStandaloneGenerator(cx, options, srcBuf,
+                                         parameterListEnd, syntaxKind,
+                                         stencilOut);
+      } else {
+        fun = CompileStandaloneFunction(cx, options, srcBuf, parameterListEnd,
+                                        syntaxKind, stencilOut);
+      }
+    }
+    RefPtr<frontend::CompilationStencil> stencil = dont_AddRef(rawStencil);
+    if (fun && stencil) {
+      cache.put(*cacheLookup, stencil);
     }
   }
   if (!fun) {
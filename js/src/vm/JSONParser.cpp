@@ -12,11 +12,14 @@
 #include "mozilla/RangedPtr.h"   // mozilla::RangedPtr
 
 #include "mozilla/Sprintf.h"    // SprintfLiteral
-#include "mozilla/TextUtils.h"  // mozilla::AsciiAlphanumericToNumber, mozilla::IsAsciiDigit, mozilla::IsAsciiHexDigit
+#include "mozilla/TextUtils.h"  // mozilla::AsciiAlphanumericToNumber, mozilla::IsAscii, mozilla::IsAsciiDigit, mozilla::IsAsciiHexDigit
+#include "mozilla/Utf8.h"  // mozilla::Utf8Unit
 
 #include <stddef.h>  // size_t
-#include <stdint.h>  // uint32_t
-#include <utility>   // std::move
+#include <stdint.h>  // uint32_t, uint64_t
+#include <string.h>     // memcpy
+#include <type_traits>  // std::is_same_v
+#include <utility>      // std::move
 
 #include "jsnum.h"  // ParseDecimalNumber, GetFullInteger, FullStringToDouble
 
@@ -24,7 +27,7 @@
 #include "builtin/ParseRecordObject.h"  // js::ParseRecordObject
 #include "ds/IdValuePair.h"             // IdValuePair
 #include "gc/GCEnum.h"                  // CanGC
-#include "gc/Tracer.h"                  // JS::TraceRoot
+#include "gc/Tracer.h"                  // JS::TraceRoot, TraceNullableRoot
 #include "js/AllocPolicy.h"             // ReportOutOfMemory
 #include "js/CharacterEncoding.h"       // JS::ConstUTF8CharsZ
 #include "js/ColumnNumber.h"            // JS::ColumnNumberOneOrigin
@@ -42,21 +45,63 @@
 #include "util/StringBuilder.h"  // JSStringBuilder
 #include "vm/ArrayObject.h"      // ArrayObject
 #include "vm/ErrorReporting.h"   // ReportCompileErrorLatin1, ErrorMetadata
-#include "vm/JSAtomUtils.h"      // AtomizeChars
+#include "vm/JSAtomUtils.h"      // AtomizeChars, AtomizeUTF8Chars
 #include "vm/JSContext.h"        // JSContext
 #include "vm/PlainObject.h"  // NewPlainObjectWithMaybeDuplicateKeys, NewPlainObjectWithProto
 #include "vm/Realm.h"  // JS::Realm
-#include "vm/StringType.h"  // JSString, JSAtom, JSLinearString, NewStringCopyN, NameToId
+#include "vm/StringType.h"  // JSString, JSAtom, JSLinearString, NewStringCopyN, NewStringCopyUTF8N, NameToId
 
 #include "vm/JSAtomUtils-inl.h"  // AtomToId
 
 using namespace js;
 
 using mozilla::AsciiAlphanumericToNumber;
+using mozilla::IsAscii;
 using mozilla::IsAsciiDigit;
 using mozilla::IsAsciiHexDigit;
 using mozilla::RangedPtr;
 
+// Return whether the characters of |word| include a '"', a '\\' or a control
+// character, which all need special handling in string literals.
+//
+// Each of the terms below sets the high bit of a character which matches. It
+// might also set the high bit of characters following a matching one, because
+// of borrows, but this does not matter as we only test whether any character
+// of the word matches.
+template <typename CharT>
+static MOZ_ALWAYS_INLINE bool WordHasSpecialStringChar(uint64_t word) {
+  constexpr uint64_t Ones =
+      UINT64_MAX / ((uint64_t(1) << (8 * sizeof(CharT))) - 1);
+  constexpr uint64_t HighBits = Ones << (8 * sizeof(CharT) - 1);
+
+  uint64_t quote = word ^ (Ones * '"');
+  uint64_t backslash = word ^ (Ones * '\\');
+  uint64_t matches = ((quote - Ones) & ~quote) |
+                     ((backslash - Ones) & ~backslash) |
+                     ((word - Ones * 0x20) & ~word);
+  return matches & HighBits;
+}
+
+// Return the number of characters at the start of |chars| which need no
+// special handling in string literals. Characters are tested a word at a
+// time, to quickly skip over long strings. The count might stop short of the
+// first special character, which is then found by the caller.
+template <typename CharT>
+static MOZ_ALWAYS_INLINE size_t CountPlainStringChars(const CharT* chars,
+                                                      size_t length) {
+  constexpr size_t CharsPerWord = sizeof(uint64_t) / sizeof(CharT);
+
+  size_t i = 0;
+  for (; length - i >= CharsPerWord; i += CharsPerWord) {
+    uint64_t word;
+    memcpy(&word, chars + i, sizeof(word));
+    if (WordHasSpecialStringChar<CharT>(word)) {
+      break;
+    }
+  }
+  return i;
+}
+
 template <typename CharT, typename ParserT>
 void JSONTokenizer<CharT, ParserT>::getTextPosition(uint32_t* column,
                                                     uint32_t* line) {
@@ -370,6 +415,7 @@ JSONToken JSONTokenizer<CharT, ParserT>::readString() {
    * string directly from the source text.
    */
   CharPtr start = current;
+  current += CountPlainStringChars(current.get(), end - current);
   for (; current < end; current++) {
     if (*current == '"') {
       size_t length = current - start;
@@ -392,7 +438,7 @@ JSONToken JSONTokenizer<CharT, ParserT>::readString() {
    * of unescaped characters into a temporary buffer, then an escaped
    * character, and repeat until the entire string is consumed.
    */
-  JSONStringBuilder builder(parser->handler.context());
+  JSONStringBuilder builder(parser->handler);
   do {
     if (start < current && !builder.append(start.get(), current.get())) {
       return token(JSONToken::OOM);
@@ -481,6 +527,7 @@ JSONToken JSONTokenizer<CharT, ParserT>::readString() {
     }
 
     start = current;
+    current += CountPlainStringChars(current.get(), end - current);
     for (; current < end; current++) {
       if (*current == '"' || *current == '\\' || *current <= 0x001F) {
         break;
@@ -619,7 +666,11 @@ static void ReportJSONSyntaxError(FrontendContext* fc, ErrorMetadata&& metadata,
 // collections then at least half of it will end up tenured.
 
 JSONFullParseHandlerAnyChar::JSONFullParseHandlerAnyChar(JSContext* cx)
-    : cx(cx), gcHeap(cx, 1), freeElements(cx), freeProperties(cx) {}
+    : cx(cx),
+      gcHeap(cx, 1),
+      freeElements(cx),
+      freeProperties(cx),
+      predictedShapes(cx) {}
 
 JSONFullParseHandlerAnyChar::JSONFullParseHandlerAnyChar(
     JSONFullParseHandlerAnyChar&& other) noexcept
@@ -628,7 +679,8 @@ JSONFullParseHandlerAnyChar::JSONFullParseHandlerAnyChar(
       parseType(other.parseType),
       gcHeap(cx, 1),
       freeElements(std::move(other.freeElements)),
-      freeProperties(std::move(other.freeProperties)) {}
+      freeProperties(std::move(other.freeProperties)),
+      predictedShapes(std::move(other.predictedShapes)) {}
 
 JSONFullParseHandlerAnyChar::~JSONFullParseHandlerAnyChar() {
   for (size_t i = 0; i < freeElements.length(); i++) {
@@ -700,9 +752,19 @@ inline bool JSONFullParseHandlerAnyChar::finishObject(
   if (gcHeap == gc::Heap::Tenured) {
     newKind = TenuredObject;
   }
-  // properties is traced in the parser; see JSONParser<CharT>::trace()
+  size_t depth = stack.length() - 1;
+  if (depth >= predictedShapes.length() &&
+      !predictedShapes.appendN(nullptr,
+                               depth + 1 - predictedShapes.length())) {
+    return false;
+  }
+
+  // properties and predictedShapes are traced in the parser; see
+  // JSONParser<CharT>::trace()
   JSObject* obj = NewPlainObjectWithMaybeDuplicateKeys(
-      cx, Handle<IdValueVector>::fromMarkedLocation(properties), newKind);
+      cx, Handle<IdValueVector>::fromMarkedLocation(properties),
+      MutableHandle<SharedShape*>::fromMarkedLocation(&predictedShapes[depth]),
+      newKind);
   if (!obj) {
     return false;
   }
@@ -774,6 +836,10 @@ inline void JSONFullParseHandlerAnyChar::freeStackEntry(StackEntry& entry) {
 
 void JSONFullParseHandlerAnyChar::trace(JSTracer* trc) {
   JS::TraceRoot(trc, &v, "JSONFullParseHandlerAnyChar current value");
+  for (SharedShape*& shape : predictedShapes) {
+    TraceNullableRoot(trc, &shape,
+                      "JSONFullParseHandlerAnyChar predicted shape");
+  }
 }
 
 template <typename CharT>
@@ -784,6 +850,12 @@ bool JSONFullParseHandler<CharT>::JSONStringBuilder::append(char16_t c) {
 template <typename CharT>
 bool JSONFullParseHandler<CharT>::JSONStringBuilder::append(const CharT* begin,
                                                             const CharT* end) {
+  if constexpr (std::is_same_v<CharT, Latin1Char>) {
+    if (utf8Input) {
+      return buffer.append(reinterpret_cast<const mozilla::Utf8Unit*>(begin),
+                           end - begin);
+    }
+  }
   return buffer.append(begin, end);
 }
 
@@ -791,6 +863,14 @@ template <typename CharT>
 template <JSONStringType ST>
 inline bool JSONFullParseHandler<CharT>::setStringValue(
     CharPtr start, size_t length, mozilla::Span<const CharT>&& source) {
+  if constexpr (std::is_same_v<CharT, Latin1Char>) {
+    if (utf8Input &&
+        !IsAscii(mozilla::Span(reinterpret_cast<const char*>(start.get()),
+                               length))) {
+      return setUTF8StringValue<ST>(start.get(), length);
+    }
+  }
+
   JSString* str;
   if constexpr (ST == JSONStringType::PropertyName) {
     str = AtomizeChars(cx, start.get(), length);
@@ -805,6 +885,25 @@ inline bool JSONFullParseHandler<CharT>::setStringValue(
   return true;
 }
 
+template <typename CharT>
+template <JSONStringType ST>
+bool JSONFullParseHandler<CharT>::setUTF8StringValue(const CharT* start,
+                                                     size_t length) {
+  const char* utf8 = reinterpret_cast<const char*>(start);
+  JSString* str;
+  if constexpr (ST == JSONStringType::PropertyName) {
+    str = AtomizeUTF8Chars(cx, utf8, length);
+  } else {
+    str = NewStringCopyUTF8N(cx, JS::UTF8Chars(utf8, length), gcHeap);
+  }
+
+  if (!str) {
+    return false;
+  }
+  v = JS::StringValue(str);
+  return true;
+}
+
 template <typename CharT>
 template <JSONStringType ST>
 inline bool JSONFullParseHandler<CharT>::setStringValue(
@@ -1387,7 +1486,8 @@ class MOZ_STACK_CLASS DelegateHandler {
    public:
     StringBuilder buffer;
 
-    explicit JSONStringBuilder(FrontendContext* fc) : buffer(fc) {}
+    explicit JSONStringBuilder(DelegateHandler& handler)
+        : buffer(handler.context()) {}
 
     bool append(char16_t c) { return buffer.append(c); }
     bool append(const CharT* begin, const CharT* end) {
@@ -14,8 +14,9 @@
 #include "mozilla/RangedPtr.h"   // mozilla::RangedPtr
 
 #include <stddef.h>  // size_t
-#include <stdint.h>  // uint32_t
-#include <utility>   // std::move
+#include <stdint.h>     // uint32_t
+#include <type_traits>  // std::is_same_v
+#include <utility>      // std::move
 
 #include "builtin/ParseRecordObject.h"  // js::ParseRecordObject
 #include "ds/IdValuePair.h"             // IdValuePair
@@ -33,6 +34,7 @@ class JSTracer;
 namespace js {
 
 class FrontendContext;
+class SharedShape;
 
 enum class JSONToken {
   String,
@@ -225,6 +227,11 @@ class MOZ_STACK_CLASS JSONFullParseHandlerAnyChar {
   Vector<ElementVector*, 5> freeElements;
   Vector<PropertyVector*, 5> freeProperties;
 
+  // Shape of the last object finished at each depth of the stack. Objects at
+  // the same depth, such as the records of an array, are likely to have the
+  // same properties in the same order.
+  Vector<SharedShape*, 10> predictedShapes;
+
  public:
   explicit JSONFullParseHandlerAnyChar(JSContext* cx);
   ~JSONFullParseHandlerAnyChar();
@@ -301,17 +308,23 @@ class MOZ_STACK_CLASS JSONFullParseHandler
   class JSONStringBuilder {
    public:
     JSStringBuilder buffer;
+    bool utf8Input;
 
-    explicit JSONStringBuilder(JSContext* cx) : buffer(cx) {}
+    explicit JSONStringBuilder(JSONFullParseHandler& handler)
+        : buffer(handler.context()), utf8Input(handler.utf8Input) {}
 
     bool append(char16_t c);
     bool append(const CharT* begin, const CharT* end);
   };
 
+  // Whether the Latin-1 units of the input are UTF-8 code units, see
+  // JSONParser::setUTF8Input.
+  bool utf8Input = false;
+
   explicit JSONFullParseHandler(JSContext* cx) : Base(cx) {}
 
   JSONFullParseHandler(JSONFullParseHandler&& other) noexcept
-      : Base(std::move(other)) {}
+      : Base(std::move(other)), utf8Input(other.utf8Input) {}
 
   JSONFullParseHandler(const JSONFullParseHandler& other) = delete;
   void operator=(const JSONFullParseHandler& other) = delete;
@@ -327,6 +340,10 @@ class MOZ_STACK_CLASS JSONFullParseHandler
   inline bool setNullValue(mozilla::Span<const CharT>&& source);
 
   void reportError(const char* msg, uint32_t line, uint32_t column);
+
+ private:
+  template <JSONStringType ST>
+  bool setUTF8StringValue(const CharT* start, size_t length);
 };
 
 template <typename CharT>
@@ -438,7 +455,7 @@ class MOZ_STACK_CLASS JSONSyntaxParseHandler {
 
   class JSONStringBuilder {
    public:
-    explicit JSONStringBuilder(FrontendContext* fc) {}
+    explicit JSONStringBuilder(JSONSyntaxParseHandler& handler) {}
 
     bool append(char16_t c) { return true; }
     bool append(const CharT* begin, const CharT* end) { return true; }
@@ -613,6 +630,18 @@ class MOZ_STACK_CLASS JSONParser
     this->handler.filename = mozilla::Some(filename);
   }
 
+  /*
+   * Interpret the Latin-1 data as UTF-8. Structural characters, numbers and
+   * literals are all ASCII, and UTF-8 sequences only contain non-ASCII units,
+   * so the input is tokenized as Latin-1. Strings which contain non-ASCII
+   * units are decoded when their value is created, and malformed UTF-8 is
+   * reported as an error.
+   */
+  void setUTF8Input() {
+    static_assert(std::is_same_v<CharT, JS::Latin1Char>);
+    this->handler.utf8Input = true;
+  }
+
   void trace(JSTracer* trc);
 };
 
@@ -670,6 +699,7 @@ class MutableWrappedPtrOperations<JSONParser<CharT>, Wrapper>
   void reportLineNumbersFromParsedData(bool b) {
     static_cast<Wrapper*>(this)->get().reportLineNumbersFromParsedData(b);
   }
+  void setUTF8Input() { static_cast<Wrapper*>(this)->get().setUTF8Input(); }
 };
 
 template <typename CharT>
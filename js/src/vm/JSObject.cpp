@@ -1161,6 +1161,8 @@ bool ProxyObject::fixupAfterSwap(JSContext* cx,
 
   auto* valArray = reinterpret_cast<js::detail::ProxyValueArray*>(allocation);
 
+  // Any unique ID is restored by JSObject::swap.
+  valArray->maybeUniqueId = 0;
   valArray->expandoSlot = values[0];
   valArray->privateSlot = values[1];
 
@@ -1249,23 +1251,15 @@ void JSObject::swap(JSContext* cx, HandleObject a, HandleObject b,
   (void)gc::MaybeGetUniqueId(b, &bid);
   NativeObject* na = a->is<NativeObject>() ? &a->as<NativeObject>() : nullptr;
   NativeObject* nb = b->is<NativeObject>() ? &b->as<NativeObject>() : nullptr;
-  if ((aid || bid) && (na || nb)) {
-    // We can't remove unique IDs from native objects when they are swapped with
-    // objects without an ID. Instead ensure they both have IDs so we always
-    // have something to overwrite the old ID with.
+  if (aid || bid) {
+    // Both native objects and proxies store their unique IDs inline, and we
+    // can't remove an ID from an object when it is swapped with an object
+    // without one. Instead ensure they both have IDs so we always have
+    // something to overwrite the old ID with.
     if (!gc::GetOrCreateUniqueId(a, &aid) ||
         !gc::GetOrCreateUniqueId(b, &bid)) {
       oomUnsafe.crash("Failed to create unique ID during swap");
     }
-
-    // IDs stored in NativeObjects could shadow those stored in the zone
-    // table. Remove any zone table IDs first.
-    if (pa && aid) {
-      gc::RemoveUniqueId(a);
-    }
-    if (pb && bid) {
-      gc::RemoveUniqueId(b);
-    }
   }
 
   gc::AllocKind ka = SwappableObjectAllocKind(a);
@@ -1340,7 +1334,7 @@ void JSObject::swap(JSContext* cx, HandleObject a, HandleObject b,
   }
 
   // Restore original unique IDs.
-  if ((aid || bid) && (na || nb)) {
+  if (aid || bid) {
     if ((aid && !gc::SetOrUpdateUniqueId(cx, a, aid)) ||
         (bid && !gc::SetOrUpdateUniqueId(cx, b, bid))) {
       oomUnsafe.crash("Failed to set unique ID after swap");
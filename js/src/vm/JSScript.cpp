@@ -1607,7 +1607,8 @@ void SourceCompressionTask::workEncodingSpecific() {
   }
 
   const Unit* chars = source_->uncompressedData<Unit>()->units();
-  Compressor comp(reinterpret_cast<const unsigned char*>(chars), inputBytes);
+  Compressor comp(reinterpret_cast<const unsigned char*>(chars), inputBytes,
+                  codec_);
   if (!comp.init()) {
     return;
   }
@@ -1794,9 +1795,16 @@ bool js::SynchronouslyCompressSource(JSContext* cx,
 void ScriptSource::addSizeOfIncludingThis(mozilla::MallocSizeOf mallocSizeOf,
                                           JS::ScriptSourceInfo* info) const {
   info->misc += mallocSizeOf(this);
+  info->misc +=
+      delazificationOrder_.lock()->sizeOfExcludingThis(mallocSizeOf);
   info->numScripts++;
 }
 
+bool ScriptSource::getDelazificationOrder(DelazificationOrder& order) {
+  auto guard = delazificationOrder_.lock();
+  return order.appendAll(*guard);
+}
+
 frontend::InitialStencilAndDelazifications*
 ScriptSourceObject::maybeGetStencils() {
   Value stencilsVal = getReservedSlot(STENCILS_SLOT);
@@ -554,6 +554,12 @@ class ScriptSource {
   };
   ExclusiveData<ReaderInstances> readers_;
 
+  // Source start offsets of the functions of this source which have been
+  // delazified on the main thread, in the order in which they were. See
+  // JS::GetDelazificationOrder.
+  using DelazificationOrder = Vector<uint32_t, 0, SystemAllocPolicy>;
+  ExclusiveData<DelazificationOrder> delazificationOrder_;
+
   // The UTF-8 encoded filename of this script.
   SharedImmutableString filename_;
 
@@ -638,7 +644,9 @@ class ScriptSource {
   static const size_t SourceDeflateLimit = 100;
 
   explicit ScriptSource()
-      : id_(++idCount_), readers_(js::mutexid::SourceCompression) {}
+      : id_(++idCount_),
+        readers_(js::mutexid::SourceCompression),
+        delazificationOrder_(js::mutexid::SourceDelazificationOrder) {}
   ~ScriptSource() { MOZ_ASSERT(refs == 0); }
 
   void AddRef() { refs++; }
@@ -1045,6 +1053,13 @@ class ScriptSource {
     return delazificationMode_;
   }
 
+  // Record that the function starting at |sourceStart| has been delazified.
+  // This is best effort and silently drops the entry on OOM.
+  void recordDelazification(uint32_t sourceStart) {
+    (void)delazificationOrder_.lock()->append(sourceStart);
+  }
+  [[nodiscard]] bool getDelazificationOrder(DelazificationOrder& order);
+
   bool hasIntroductionOffset() const { return introductionOffset_.isSome(); }
   uint32_t introductionOffset() const { return introductionOffset_.value(); }
   void setIntroductionOffset(uint32_t offset) {
@@ -399,8 +399,11 @@ static void StatsCellCallback(JSRuntime* rt, void* data, JS::GCCellPtr cellptr,
                                    &realmStats.allocSites);
         jit::AddSizeOfBaselineData(script, rtStats->mallocSizeOf_,
                                    &realmStats.baselineData);
-        realmStats.ionData +=
-            jit::SizeOfIonData(script, rtStats->mallocSizeOf_);
+        size_t ionData = jit::SizeOfIonData(script, rtStats->mallocSizeOf_);
+        size_t ionSnapshots =
+            std::min(jit::SizeOfIonSnapshots(script), ionData);
+        realmStats.ionData += ionData - ionSnapshots;
+        realmStats.ionSnapshots += ionSnapshots;
       }
       CollectScriptSourceStats<granularity>(closure, base->scriptSource());
       break;
@@ -770,6 +773,37 @@ JS_PUBLIC_API bool JS::CollectRuntimeStats(JSContext* cx, RuntimeStats* rtStats,
                                    StatsCellCallback<FineGrained>);
 }
 
+JS_PUBLIC_API void JS::CollectRuntimeSummarySizes(
+    JSContext* cx, RuntimeSummarySizes* sizes) {
+  JSRuntime* rt = cx->runtime();
+
+  // Buffer allocator statistics can only be read while no major GC is
+  // sweeping them. Skip them rather than finishing the GC.
+  bool measureBuffers = !rt->gc.isIncrementalGCInProgress() &&
+                        !rt->gc.isBackgroundSweeping();
+  if (measureBuffers) {
+    rt->gc.nursery().joinSweepTask();
+  }
+
+  sizes->gcHeapChunkTotal =
+      size_t(JS_GetGCParameter(cx, JSGC_TOTAL_CHUNKS)) * gc::ChunkSize;
+  sizes->gcHeapUnusedChunks =
+      size_t(JS_GetGCParameter(cx, JSGC_UNUSED_CHUNKS)) * gc::ChunkSize;
+  sizes->nurseryCommitted = rt->gc.nursery().totalCommitted();
+
+  for (ZonesIter zone(rt, WithAtoms); !zone.done(); zone.next()) {
+    sizes->zoneCount++;
+    sizes->gcHeapArenas += zone->gcHeapSize.bytes();
+    sizes->mallocHeap += zone->mallocHeapSize.bytes();
+    sizes->jitCode += zone->jitHeapSize.bytes();
+    if (measureBuffers) {
+      zone->bufferAllocator.addSizeOfExcludingThis(&sizes->gcBuffersUsed,
+                                                   &sizes->gcBuffersFree,
+                                                   &sizes->gcBuffersAdmin);
+    }
+  }
+}
+
 JS_PUBLIC_API size_t JS::SystemCompartmentCount(JSContext* cx) {
   size_t n = 0;
   for (CompartmentsIter comp(cx->runtime()); !comp.done(); comp.next()) {
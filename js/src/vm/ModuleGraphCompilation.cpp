@@ -0,0 +1,334 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+ * vim: set ts=8 sts=2 et sw=2 tw=80:
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "vm/ModuleGraphCompilation.h"
+
+#include "mozilla/Assertions.h"  // MOZ_ASSERT
+
+#include <algorithm>  // std::min
+#include <utility>    // std::move
+
+#include "frontend/CompilationStencil.h"  // frontend::CompilationStencil, frontend::InitialStencilAndDelazifications
+#include "frontend/FrontendContext.h"  // js::FrontendContext, js::NewFrontendContext
+#include "frontend/ParserAtom.h"           // frontend::ParserAtomsTable
+#include "frontend/Stencil.h"              // frontend::StencilModuleMetadata
+#include "js/ErrorReport.h"                // JS_ReportErrorUTF8
+#include "js/experimental/CompileScript.h"  // JS::CompileModuleScriptToStencil
+#include "js/experimental/JSStencil.h"  // JS::InstantiateModuleStencil
+#include "js/SourceText.h"              // JS::SourceText
+#include "util/Text.h"                  // DuplicateString
+#include "vm/HelperThreadState.h"  // ModuleGraphCompileTask, HelperThreadState
+#include "vm/JSContext.h"          // JSContext, CHECK_THREAD
+#include "vm/Runtime.h"            // CanUseExtraThreads
+
+using namespace js;
+
+ModuleGraphCompilation::CompiledModule::CompiledModule() = default;
+ModuleGraphCompilation::CompiledModule::~CompiledModule() = default;
+
+ModuleGraphCompilation::ModuleGraphCompilation(JS::ModuleGraphLoader* loader,
+                                               JS::NativeStackSize stackQuota)
+    : options_(JS::OwningCompileOptions::ForFrontendContext()),
+      loader_(loader),
+      stackQuota_(stackQuota) {}
+
+ModuleGraphCompilation::~ModuleGraphCompilation() {
+  MOZ_ASSERT(activeTasks_ == 0);
+}
+
+bool ModuleGraphCompilation::init(JSContext* cx,
+                                  const JS::ReadOnlyCompileOptions& options,
+                                  const char* rootKey) {
+  if (!options_.copy(cx, options)) {
+    return false;
+  }
+
+  JS::UniqueChars key = DuplicateString(cx, rootKey);
+  if (!key) {
+    return false;
+  }
+
+  uint32_t index;
+  if (!addModule(std::move(key), &index)) {
+    ReportOutOfMemory(cx);
+    return false;
+  }
+  MOZ_ASSERT(index == 0);
+  return true;
+}
+
+bool ModuleGraphCompilation::addModule(JS::UniqueChars key, uint32_t* index) {
+  auto p = moduleIndices_.lookupForAdd(key.get());
+  if (p) {
+    *index = p->value();
+    return true;
+  }
+
+  if (!modules_.reserve(modules_.length() + 1) ||
+      !pending_.reserve(pending_.length() + 1)) {
+    return false;
+  }
+
+  *index = modules_.length();
+  if (!moduleIndices_.add(p, key.get(), *index)) {
+    return false;
+  }
+
+  Module module;
+  module.key = std::move(key);
+  modules_.infallibleAppend(std::move(module));
+  pending_.infallibleAppend(*index);
+  return true;
+}
+
+bool ModuleGraphCompilation::recordModule(uint32_t index,
+                                          CompiledModule& result) {
+  Vector<uint32_t, 0, SystemAllocPolicy> requestedModules;
+  if (!requestedModules.reserve(result.requestedKeys.length())) {
+    return false;
+  }
+
+  for (JS::UniqueChars& requestedKey : result.requestedKeys) {
+    uint32_t requestedIndex;
+    if (!addModule(std::move(requestedKey), &requestedIndex)) {
+      return false;
+    }
+    requestedModules.infallibleAppend(requestedIndex);
+  }
+
+  // |modules_| might have been reallocated by addModule.
+  Module& module = modules_[index];
+  module.stencil = std::move(result.stencil);
+  module.requestedModules = std::move(requestedModules);
+  return true;
+}
+
+void ModuleGraphCompilation::fail(const char* key, CompiledModule& result) {
+  pending_.clear();
+  if (failed_) {
+    return;
+  }
+
+  failed_ = true;
+  failedFc_ = std::move(result.failedFc);
+  failureReason_ = result.failureReason;
+  failureKey_ = DuplicateString(key);
+}
+
+void ModuleGraphCompilation::compileModule(const char* key,
+                                           CompiledModule& result) {
+  JS::SourceText<mozilla::Utf8Unit> source;
+  if (!loader_->fetch(key, source)) {
+    result.failureReason = "could not be fetched";
+    return;
+  }
+
+  UniquePtr<FrontendContext> fc(NewFrontendContext());
+  if (!fc) {
+    return;
+  }
+  fc->setStackQuota(stackQuota_);
+
+  JS::CompileOptions options(nullptr, options_);
+  options.setFile(key);
+
+  RefPtr<JS::Stencil> stencil =
+      JS::CompileModuleScriptToStencil(fc.get(), options, source);
+  if (!stencil) {
+    result.failedFc = std::move(fc);
+    return;
+  }
+
+  const frontend::CompilationStencil* initial = stencil->getInitial();
+  const frontend::StencilModuleMetadata& metadata = *initial->moduleMetadata;
+  if (!result.requestedKeys.reserve(metadata.requestedModules.length())) {
+    return;
+  }
+
+  for (const frontend::StencilModuleEntry& entry : metadata.requestedModules) {
+    const frontend::StencilModuleRequest& request =
+        metadata.moduleRequests[entry.moduleRequest.value()];
+    if (!request.attributes.empty()) {
+      result.failureReason = "uses unsupported import attributes";
+      return;
+    }
+
+    JS::UniqueChars specifier = frontend::ParserAtomsTable::toNewUTF8CharsZ(
+        fc.get(), initial->parserAtomData, request.specifier);
+    if (!specifier) {
+      return;
+    }
+
+    JS::UniqueChars resolved;
+    if (!loader_->resolve(key, specifier.get(), resolved) || !resolved) {
+      result.failureReason = "has an import which could not be resolved";
+      return;
+    }
+    result.requestedKeys.infallibleAppend(std::move(resolved));
+  }
+
+  result.stencil = std::move(stencil);
+}
+
+void ModuleGraphCompilation::submitTasks(
+    const AutoLockHelperThreadState& lock) {
+  if (!CanUseExtraThreads()) {
+    return;
+  }
+
+  // Running tasks claim a new module as soon as they are done with their
+  // current one, so do not start more tasks than there are pending modules.
+  size_t maxTasks = std::min(HelperThreadState().maxModuleGraphThreads(),
+                             pending_.length());
+  while (activeTasks_ < maxTasks) {
+    auto* task = js_new<ModuleGraphCompileTask>(this);
+    if (!task) {
+      // The running tasks will compile the pending modules.
+      return;
+    }
+    activeTasks_++;
+    HelperThreadState().submitTask(task, lock);
+  }
+}
+
+bool ModuleGraphCompilation::start(AutoLockHelperThreadState& lock) {
+  MOZ_ASSERT(activeTasks_ == 0);
+  MOZ_ASSERT(pending_.length() == 1);
+
+  if (CanUseExtraThreads()) {
+    submitTasks(lock);
+    return activeTasks_ != 0;
+  }
+
+  // Without helper threads, compile everything as a single task. The loader
+  // may destroy the compilation from onFinished, so do not touch it after.
+  activeTasks_++;
+  MOZ_ALWAYS_TRUE(compilePendingModules(lock));
+  AutoUnlockHelperThreadState unlock(lock);
+  notifyFinished();
+  return true;
+}
+
+bool ModuleGraphCompilation::compilePendingModules(
+    AutoLockHelperThreadState& lock) {
+  MOZ_ASSERT(activeTasks_ != 0);
+
+  while (!failed_ && !pending_.empty()) {
+    uint32_t index = pending_.popCopy();
+
+    // The key is owned by |modules_|, but its chars are not moved when
+    // |modules_| is reallocated by other tasks.
+    const char* key = modules_[index].key.get();
+
+    CompiledModule result;
+    {
+      AutoUnlockHelperThreadState unlock(lock);
+      compileModule(key, result);
+    }
+
+    if (!result.stencil || !recordModule(index, result)) {
+      fail(key, result);
+      break;
+    }
+
+    submitTasks(lock);
+  }
+
+  activeTasks_--;
+  return activeTasks_ == 0;
+}
+
+void ModuleGraphCompilation::notifyFinished() { loader_->onFinished(this); }
+
+void ModuleGraphCompilation::reportFailure(JSContext* cx) {
+  MOZ_ASSERT(failed_);
+
+  if (failedFc_ && failedFc_->hadErrors()) {
+    (void)failedFc_->convertToRuntimeError(cx);
+    return;
+  }
+
+  if (failureReason_ && failureKey_) {
+    JS_ReportErrorUTF8(cx, "module %s %s", failureKey_.get(), failureReason_);
+    return;
+  }
+
+  ReportOutOfMemory(cx);
+}
+
+JS_PUBLIC_API JS::ModuleGraphCompilation* JS::StartModuleGraphCompilation(
+    JSContext* cx, const ReadOnlyCompileOptions& options, const char* rootKey,
+    ModuleGraphLoader* loader) {
+  CHECK_THREAD(cx);
+  MOZ_ASSERT(loader);
+
+  UniquePtr<ModuleGraphCompilation> compilation(
+      js_new<ModuleGraphCompilation>(loader, HelperThreadState().stackQuota));
+  if (!compilation) {
+    ReportOutOfMemory(cx);
+    return nullptr;
+  }
+
+  if (!compilation->init(cx, options, rootKey)) {
+    return nullptr;
+  }
+
+  // Once started, the compilation is owned by the loader until it is given
+  // back to FinishModuleGraphCompilation.
+  ModuleGraphCompilation* started = compilation.release();
+  bool ok;
+  {
+    AutoLockHelperThreadState lock;
+    ok = started->start(lock);
+  }
+  if (!ok) {
+    js_delete(started);
+    ReportOutOfMemory(cx);
+    return nullptr;
+  }
+
+  return started;
+}
+
+JS_PUBLIC_API bool JS::FinishModuleGraphCompilation(
+    JSContext* cx, ModuleGraphCompilation* compilation,
+    MutableHandle<StackGCVector<JSObject*>> modules,
+    ModuleGraphEntryVector& entries) {
+  CHECK_THREAD(cx);
+  MOZ_ASSERT(compilation);
+
+  UniquePtr<ModuleGraphCompilation> owned(compilation);
+  if (compilation->failed()) {
+    compilation->reportFailure(cx);
+    return false;
+  }
+
+  auto& graph = compilation->modules();
+  modules.clear();
+  entries.clear();
+  if (!modules.reserve(graph.length()) || !entries.reserve(graph.length())) {
+    ReportOutOfMemory(cx);
+    return false;
+  }
+
+  const JS::InstantiateOptions instantiateOptions(compilation->options());
+  for (ModuleGraphCompilation::Module& module : graph) {
+    MOZ_ASSERT(module.stencil);
+    JSObject* moduleObj = JS::InstantiateModuleStencil(
+        cx, instantiateOptions, module.stencil, nullptr);
+    if (!moduleObj) {
+      return false;
+    }
+    modules.infallibleAppend(moduleObj);
+
+    ModuleGraphEntry entry;
+    entry.key = std::move(module.key);
+    entry.requestedModules = std::move(module.requestedModules);
+    entries.infallibleAppend(std::move(entry));
+  }
+
+  return true;
+}
@@ -0,0 +1,127 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+ * vim: set ts=8 sts=2 et sw=2 tw=80:
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef vm_ModuleGraphCompilation_h
+#define vm_ModuleGraphCompilation_h
+
+#include "mozilla/HashTable.h"  // mozilla::CStringHasher
+#include "mozilla/RefPtr.h"     // RefPtr
+
+#include <stddef.h>  // size_t
+#include <stdint.h>  // uint32_t
+
+#include "js/AllocPolicy.h"        // SystemAllocPolicy
+#include "js/CompileOptions.h"     // JS::OwningCompileOptions
+#include "js/HashTable.h"          // HashMap
+#include "js/Modules.h"            // JS::ModuleGraphLoader
+#include "js/NativeStackLimits.h"  // JS::NativeStackSize
+#include "js/Transcoding.h"        // JS::Stencil
+#include "js/UniquePtr.h"          // UniquePtr
+#include "js/Utility.h"            // JS::UniqueChars
+#include "js/Vector.h"             // Vector
+
+namespace js {
+
+class AutoLockHelperThreadState;
+class FrontendContext;
+
+// The state of a module graph compilation, shared by the
+// ModuleGraphCompileTasks compiling its modules.
+//
+// Each task repeatedly claims a pending module, compiles it without holding
+// the helper thread lock, then records the modules it imports, submitting more
+// tasks when new modules are discovered. When the last running task runs out
+// of modules, the loader's onFinished hook is called.
+//
+// Unless stated otherwise, fields are protected by the helper thread lock.
+class ModuleGraphCompilation {
+ public:
+  struct Module {
+    JS::UniqueChars key;
+    RefPtr<JS::Stencil> stencil;
+    Vector<uint32_t, 0, SystemAllocPolicy> requestedModules;
+  };
+
+  // The result of compiling a single module, produced without the lock.
+  struct CompiledModule {
+    RefPtr<JS::Stencil> stencil;
+    // Resolved keys of the requested modules, in order.
+    Vector<JS::UniqueChars, 0, SystemAllocPolicy> requestedKeys;
+    // Holds the compilation errors if the module failed to compile.
+    UniquePtr<FrontendContext> failedFc;
+    // Static description of any other failure, or nullptr on OOM.
+    const char* failureReason = nullptr;
+
+    CompiledModule();
+    ~CompiledModule();
+  };
+
+ private:
+  // Immutable once the compilation has started.
+  JS::OwningCompileOptions options_;
+  JS::ModuleGraphLoader* const loader_;
+  const JS::NativeStackSize stackQuota_;
+
+  Vector<Module, 0, SystemAllocPolicy> modules_;
+
+  // Index in |modules_| of every module, keyed by the module's key which is
+  // owned by |modules_|.
+  HashMap<const char*, uint32_t, mozilla::CStringHasher, SystemAllocPolicy>
+      moduleIndices_;
+
+  // Indices of the modules which are discovered but not claimed by a task.
+  Vector<uint32_t, 0, SystemAllocPolicy> pending_;
+
+  // Number of submitted or running tasks.
+  size_t activeTasks_ = 0;
+
+  // Once set, no further module is claimed. The first failure is kept to be
+  // reported by reportFailure().
+  bool failed_ = false;
+  UniquePtr<FrontendContext> failedFc_;
+  const char* failureReason_ = nullptr;
+  JS::UniqueChars failureKey_;
+
+  bool addModule(JS::UniqueChars key, uint32_t* index);
+  bool recordModule(uint32_t index, CompiledModule& result);
+  void fail(const char* key, CompiledModule& result);
+  void submitTasks(const AutoLockHelperThreadState& lock);
+
+ public:
+  ModuleGraphCompilation(JS::ModuleGraphLoader* loader,
+                         JS::NativeStackSize stackQuota);
+  ~ModuleGraphCompilation();
+
+  // Called on the main thread before any task is submitted.
+  [[nodiscard]] bool init(JSContext* cx,
+                          const JS::ReadOnlyCompileOptions& options,
+                          const char* rootKey);
+
+  // Submit the first task, or compile the whole graph on the current thread if
+  // helper threads are disabled. Returns false on OOM, in which case nothing
+  // has been compiled and the loader is not notified.
+  [[nodiscard]] bool start(AutoLockHelperThreadState& lock);
+
+  // Compile pending modules until none is left. Called by the
+  // ModuleGraphCompileTasks, and by start() when helper threads are disabled.
+  // Returns true if the caller was the last task and should call
+  // notifyFinished() once the lock is released.
+  [[nodiscard]] bool compilePendingModules(AutoLockHelperThreadState& lock);
+  void notifyFinished();
+
+  // Compile a single module. Called without holding the lock.
+  void compileModule(const char* key, CompiledModule& result);
+
+  // Called on the main thread once the compilation has finished.
+  bool failed() const { return failed_; }
+  void reportFailure(JSContext* cx);
+  const JS::ReadOnlyCompileOptions& options() const { return options_; }
+  Vector<Module, 0, SystemAllocPolicy>& modules() { return modules_; }
+};
+
+}  // namespace js
+
+#endif /* vm_ModuleGraphCompilation_h */
@@ -693,11 +693,32 @@ static bool ModuleResolveExport(JSContext* cx, Handle<ModuleObject*> module,
                                         errorInfoOut);
   }
 
+  // Successful resolutions only depend on the loaded module graph, so they are
+  // cached on the module and shared by all importers of the same name.
+  if (ResolvedBindingObject* binding =
+          module->lookupResolvedExport(exportName)) {
+    result.setObject(*binding);
+    return true;
+  }
+
   // Step 1. If resolveSet is not present, set resolveSet to a new empty List.
   Rooted<ResolveSet> resolveSet(cx);
 
-  return CyclicModuleResolveExport(cx, module, exportName, &resolveSet, result,
-                                   errorInfoOut);
+  if (!CyclicModuleResolveExport(cx, module, exportName, &resolveSet, result,
+                                 errorInfoOut)) {
+    return false;
+  }
+
+  // Null and ambiguous results aren't cached: they are errors, and callers
+  // need |errorInfoOut| filled in to report them.
+  if (result.isObject()) {
+    auto* binding = &result.toObject().as<ResolvedBindingObject>();
+    if (!module->putResolvedExport(cx, exportName, binding)) {
+      return false;
+    }
+  }
+
+  return true;
 }
 
 static bool CreateResolvedBindingObject(JSContext* cx,
@@ -40,6 +40,7 @@
   _(ProtectedRegionTree, 500)         \
   _(ShellOffThreadState, 500)         \
   _(ShellStreamCacheEntryState, 500)  \
+  _(SourceDelazificationOrder, 500)   \
   _(SimulatorCacheLock, 500)          \
   _(Arm64SimulatorLock, 500)          \
   _(IonSpewer, 500)                   \
@@ -62,6 +63,7 @@
   _(SourceCompression, 500)           \
   _(GCDelayedMarkingLock, 500)        \
   _(BufferAllocator, 500)             \
+  _(FrontendLifoAllocCache, 500)      \
                                       \
   _(SharedImmutableStringsCache, 600) \
   _(IrregexpLazyStatic, 600)          \
@@ -24,6 +24,7 @@
 #include "vm/Interpreter.h"         // js::CallGetter, js::CallSetter
 #include "vm/JSONPrinter.h"         // js::JSONPrinter
 #include "vm/PlainObject.h"         // js::PlainObject
+#include "vm/Realm.h"               // js::PlainObjectAssignCache
 #include "vm/TypedArrayObject.h"
 #include "vm/Watchtower.h"
 #include "gc/Nursery-inl.h"
@@ -558,7 +559,7 @@ bool NativeObject::willBeSparseElements(uint32_t requiredCapacity,
 
 /* static */
 DenseElementResult NativeObject::maybeDensifySparseElements(
-    JSContext* cx, Handle<NativeObject*> obj) {
+    JSContext* cx, Handle<NativeObject*> obj, uint32_t index) {
   /*
    * Wait until after the object goes into dictionary mode, which must happen
    * when sparsely packing any array with more than MIN_SPARSE_INDEX elements
@@ -582,6 +583,17 @@ DenseElementResult NativeObject::maybeDensifySparseElements(
     return DenseElementResult::Incomplete;
   }
 
+  /*
+   * The object has at most |slotSpan| indexed properties, and the index we
+   * just added bounds the new initialized length from below. If even that
+   * best case is too sparse, skip the walk over the shape below. This keeps
+   * objects used as hash tables with large integer keys (e.g. IDs) from
+   * rescanning all their properties every time the slot span doubles.
+   */
+  if (uint64_t(slotSpan) * SPARSE_DENSITY_RATIO < uint64_t(index) + 1) {
+    return DenseElementResult::Incomplete;
+  }
+
   /*
    * The indexes in the object need to be sufficiently dense before they can
    * be converted to dense mode.
@@ -1383,7 +1395,7 @@ static MOZ_ALWAYS_INLINE bool AddOrChangeProperty(
     // trying to densify for each sparse element we add. See bug 1782487.
     if (slot == obj->slotSpan() - 1) {
       DenseElementResult edResult =
-          NativeObject::maybeDensifySparseElements(cx, obj);
+          NativeObject::maybeDensifySparseElements(cx, obj, index);
       if (edResult == DenseElementResult::Failure) {
         return false;
       }
@@ -2829,17 +2841,48 @@ bool js::CopyDataPropertiesNative(JSContext* cx, Handle<PlainObject*> target,
     return true;
   }
 
+  // If |target| is empty and we've already copied an object with |from|'s
+  // shape into an empty object with |target|'s shape, either here or in
+  // Object.assign, we can use the resulting shape directly and copy the slots
+  // in order.
+  const bool targetHadNoOwnProperties = target->empty();
+  if (targetHadNoOwnProperties && !excludedItems && from->is<PlainObject>()) {
+    const PlainObjectAssignCache& cache = cx->realm()->plainObjectAssignCache;
+    SharedShape* newShape = cache.lookup(target->shape(), from->shape());
+    if (newShape) {
+      *optimized = true;
+      uint32_t oldSpan = 0;
+      uint32_t newSpan = newShape->slotSpan();
+      if (!target->setShapeAndAddNewSlots(cx, newShape, oldSpan, newSpan)) {
+        return false;
+      }
+      MOZ_ASSERT(from->slotSpan() == newSpan);
+      for (size_t i = 0; i < newSpan; i++) {
+        target->initSlot(i, from->getSlot(i));
+      }
+      return true;
+    }
+  }
+
   // Collect all enumerable data properties.
   Rooted<PropertyInfoWithKeyVector> props(cx, PropertyInfoWithKeyVector(cx));
 
+  // Object.assign uses [[Set]], so it can only share cache entries for keys
+  // which are defined the same way by [[Set]] and [[DefineOwnProperty]].
+  bool canFillAssignCache = true;
+
   Rooted<NativeShape*> fromShape(cx, from->shape());
   for (ShapePropertyIter<NoGC> iter(fromShape); !iter.done(); iter++) {
     jsid id = iter->key();
     MOZ_ASSERT(!id.isInt());
 
     if (!iter->enumerable()) {
+      canFillAssignCache = false;
       continue;
     }
+    if (id.isSymbol() || id.isAtom(cx->names().proto_)) {
+      canFillAssignCache = false;
+    }
     if (excludedItems && excludedItems->contains(cx, id)) {
       continue;
     }
@@ -2860,10 +2903,10 @@ bool js::CopyDataPropertiesNative(JSContext* cx, Handle<PlainObject*> target,
 
   *optimized = true;
 
+  Rooted<Shape*> origTargetShape(cx, target->shape());
+
   // If |target| contains no own properties, we can directly call
   // AddDataPropertyNonPrototype.
-  const bool targetHadNoOwnProperties = target->empty();
-
   RootedId key(cx);
   RootedValue value(cx);
   for (size_t i = props.length(); i > 0; i--) {
@@ -2892,5 +2935,15 @@ bool js::CopyDataPropertiesNative(JSContext* cx, Handle<PlainObject*> target,
     }
   }
 
+  // Dictionary shapes can't be cached, see TryAssignPlain.
+  if (targetHadNoOwnProperties && !excludedItems && canFillAssignCache &&
+      from->is<PlainObject>() && !from->inDictionaryMode() &&
+      !target->inDictionaryMode()) {
+    MOZ_ASSERT(from->slotSpan() == props.length());
+    PlainObjectAssignCache& cache = cx->realm()->plainObjectAssignCache;
+    cache.fill(&origTargetShape->asShared(), from->sharedShape(),
+               target->sharedShape());
+  }
+
   return true;
 }
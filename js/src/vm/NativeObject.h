@@ -1605,10 +1605,10 @@ class NativeObject : public JSObject {
 
   /*
    * After adding a sparse index to obj, see if it should be converted to use
-   * dense elements.
+   * dense elements. |index| is the sparse index that was just added.
    */
   static DenseElementResult maybeDensifySparseElements(
-      JSContext* cx, Handle<NativeObject*> obj);
+      JSContext* cx, Handle<NativeObject*> obj, uint32_t index);
   static bool densifySparseElements(JSContext* cx, Handle<NativeObject*> obj);
 
   inline HeapSlot* fixedElements() const {
@@ -235,6 +235,23 @@ SharedShape* js::NewPlainObjectWithPropsCache::lookup(
   return nullptr;
 }
 
+static PlainObject* NewPlainObjectWithMatchingShape(
+    JSContext* cx, SharedShape* shape, Handle<IdValueVector> properties,
+    NewObjectKind newKind) {
+  MOZ_ASSERT(ShapeMatches(properties, shape));
+
+  Rooted<SharedShape*> shapeRoot(cx, shape);
+  PlainObject* obj = PlainObject::createWithShape(cx, shapeRoot, newKind);
+  if (!obj) {
+    return nullptr;
+  }
+  MOZ_ASSERT(obj->slotSpan() == properties.length());
+  for (size_t i = 0; i < properties.length(); i++) {
+    obj->initSlot(i, properties[i].get().value);
+  }
+  return obj;
+}
+
 enum class KeysKind { UniqueNames, Unknown };
 
 template <KeysKind Kind>
@@ -245,16 +262,7 @@ static PlainObject* NewPlainObjectWithProperties(
   // If we recently created an object with these properties, we can use that
   // Shape directly.
   if (SharedShape* shape = cache.lookup(properties)) {
-    Rooted<SharedShape*> shapeRoot(cx, shape);
-    PlainObject* obj = PlainObject::createWithShape(cx, shapeRoot, newKind);
-    if (!obj) {
-      return nullptr;
-    }
-    MOZ_ASSERT(obj->slotSpan() == properties.length());
-    for (size_t i = 0; i < properties.length(); i++) {
-      obj->initSlot(i, properties[i].get().value);
-    }
-    return obj;
+    return NewPlainObjectWithMatchingShape(cx, shape, properties, newKind);
   }
 
   gc::AllocKind allocKind = gc::GetGCObjectKind(properties.length());
@@ -330,3 +338,28 @@ PlainObject* js::NewPlainObjectWithMaybeDuplicateKeys(
   return NewPlainObjectWithProperties<KeysKind::Unknown>(cx, properties,
                                                          newKind);
 }
+
+PlainObject* js::NewPlainObjectWithMaybeDuplicateKeys(
+    JSContext* cx, Handle<IdValueVector> properties,
+    MutableHandle<SharedShape*> predictedShape, NewObjectKind newKind) {
+  if (predictedShape && ShapeMatches(properties, predictedShape)) {
+    return NewPlainObjectWithMatchingShape(cx, predictedShape, properties,
+                                           newKind);
+  }
+
+  PlainObject* obj = NewPlainObjectWithProperties<KeysKind::Unknown>(
+      cx, properties, newKind);
+  if (!obj) {
+    return nullptr;
+  }
+
+  // Objects with duplicate or integer keys cannot be created from their
+  // shape, see NewPlainObjectWithProperties.
+  if (!obj->inDictionaryMode() && obj->slotSpan() == properties.length() &&
+      obj->getDenseInitializedLength() == 0) {
+    predictedShape.set(obj->sharedShape());
+  } else {
+    predictedShape.set(nullptr);
+  }
+  return obj;
+}
@@ -108,6 +108,16 @@ extern PlainObject* NewPlainObjectWithMaybeDuplicateKeys(
     JSContext* cx, Handle<IdValueVector> properties,
     NewObjectKind newKind = GenericObject);
 
+// Like above, but first try to reuse |predictedShape|, the shape of a previous
+// object which is likely to have the same properties in the same order, such
+// as the previous element of an array of records. |predictedShape| is updated
+// with the shape of the new object, or with nullptr if other objects cannot be
+// created from it.
+extern PlainObject* NewPlainObjectWithMaybeDuplicateKeys(
+    JSContext* cx, Handle<IdValueVector> properties,
+    MutableHandle<SharedShape*> predictedShape,
+    NewObjectKind newKind = GenericObject);
+
 }  // namespace js
 
 #endif  // vm_PlainObject_h
@@ -1148,6 +1148,12 @@ uint64_t ICInterpretOps(uint64_t arg0, uint64_t arg1, ICStub* stub,
         if (reinterpret_cast<uintptr_t>(obj->shape()) != expectedShape) {
           FAIL_IC();
         }
+        // Most monomorphic property stubs are a shape guard followed by a
+        // single slot access.
+        PREDICT_NEXT(LoadFixedSlotResult);
+        PREDICT_NEXT(LoadDynamicSlotResult);
+        PREDICT_NEXT(StoreFixedSlot);
+        PREDICT_NEXT(StoreDynamicSlot);
         DISPATCH_CACHEOP();
       }
 
@@ -5927,6 +5933,15 @@ static EnvironmentObject& getEnvironmentFromCoordinate(
 #  define PREDICT_NEXT(op)
 #endif
 
+// Comparisons are usually followed by a conditional jump, and the fast path of
+// the jump handler reads the boolean we just pushed. Jump straight to it rather
+// than going through the dispatch table.
+#define END_CMP_OP(op)        \
+  ADVANCE(JSOpLength_##op);   \
+  PREDICT_NEXT(JumpIfFalse);  \
+  PREDICT_NEXT(JumpIfTrue);   \
+  DISPATCH();
+
 #ifdef ENABLE_COVERAGE
 #  define COUNT_COVERAGE_PC(PC)                                 \
     if (frame->script()->hasScriptCounts()) {                   \
@@ -6845,7 +6860,7 @@ PBIResult PortableBaselineInterpret(
             VIRTPOP();
             VIRTSPWRITE(0, StackVal(BooleanValue(result)));
             NEXT_IC();
-            END_OP(Eq);
+            END_CMP_OP(Eq);
           }
           if (v0.isNumber() && v1.isNumber()) {
             double lhs = v1.toNumber();
@@ -6854,14 +6869,14 @@ PBIResult PortableBaselineInterpret(
             VIRTPOP();
             VIRTSPWRITE(0, StackVal(BooleanValue(result)));
             NEXT_IC();
-            END_OP(Eq);
+            END_CMP_OP(Eq);
           }
           if (v0.isNumber() && v1.isNumber()) {
             bool result = v0.toNumber() == v1.toNumber();
             VIRTPOP();
             VIRTSPWRITE(0, StackVal(BooleanValue(result)));
             NEXT_IC();
-            END_OP(Eq);
+            END_CMP_OP(Eq);
           }
         }
         goto generic_cmp;
@@ -6876,7 +6891,7 @@ PBIResult PortableBaselineInterpret(
             VIRTPOP();
             VIRTSPWRITE(0, StackVal(BooleanValue(result)));
             NEXT_IC();
-            END_OP(Ne);
+            END_CMP_OP(Ne);
           }
           if (v0.isNumber() && v1.isNumber()) {
             double lhs = v1.toNumber();
@@ -6885,14 +6900,14 @@ PBIResult PortableBaselineInterpret(
             VIRTPOP();
             VIRTSPWRITE(0, StackVal(BooleanValue(result)));
             NEXT_IC();
-            END_OP(Ne);
+            END_CMP_OP(Ne);
           }
           if (v0.isNumber() && v1.isNumber()) {
             bool result = v0.toNumber() != v1.toNumber();
             VIRTPOP();
             VIRTSPWRITE(0, StackVal(BooleanValue(result)));
             NEXT_IC();
-            END_OP(Eq);
+            END_CMP_OP(Eq);
           }
         }
         goto generic_cmp;
@@ -6907,7 +6922,7 @@ PBIResult PortableBaselineInterpret(
             VIRTPOP();
             VIRTSPWRITE(0, StackVal(BooleanValue(result)));
             NEXT_IC();
-            END_OP(Lt);
+            END_CMP_OP(Lt);
           }
           if (v0.isNumber() && v1.isNumber()) {
             double lhs = v1.toNumber();
@@ -6919,7 +6934,7 @@ PBIResult PortableBaselineInterpret(
             VIRTPOP();
             VIRTSPWRITE(0, StackVal(BooleanValue(result)));
             NEXT_IC();
-            END_OP(Lt);
+            END_CMP_OP(Lt);
           }
         }
         goto generic_cmp;
@@ -6933,7 +6948,7 @@ PBIResult PortableBaselineInterpret(
             VIRTPOP();
             VIRTSPWRITE(0, StackVal(BooleanValue(result)));
             NEXT_IC();
-            END_OP(Le);
+            END_CMP_OP(Le);
           }
           if (v0.isNumber() && v1.isNumber()) {
             double lhs = v1.toNumber();
@@ -6945,7 +6960,7 @@ PBIResult PortableBaselineInterpret(
             VIRTPOP();
             VIRTSPWRITE(0, StackVal(BooleanValue(result)));
             NEXT_IC();
-            END_OP(Le);
+            END_CMP_OP(Le);
           }
         }
         goto generic_cmp;
@@ -6959,7 +6974,7 @@ PBIResult PortableBaselineInterpret(
             VIRTPOP();
             VIRTSPWRITE(0, StackVal(BooleanValue(result)));
             NEXT_IC();
-            END_OP(Gt);
+            END_CMP_OP(Gt);
           }
           if (v0.isNumber() && v1.isNumber()) {
             double lhs = v1.toNumber();
@@ -6971,7 +6986,7 @@ PBIResult PortableBaselineInterpret(
             VIRTPOP();
             VIRTSPWRITE(0, StackVal(BooleanValue(result)));
             NEXT_IC();
-            END_OP(Gt);
+            END_CMP_OP(Gt);
           }
         }
         goto generic_cmp;
@@ -6985,7 +7000,7 @@ PBIResult PortableBaselineInterpret(
             VIRTPOP();
             VIRTSPWRITE(0, StackVal(BooleanValue(result)));
             NEXT_IC();
-            END_OP(Ge);
+            END_CMP_OP(Ge);
           }
           if (v0.isNumber() && v1.isNumber()) {
             double lhs = v1.toNumber();
@@ -6997,7 +7012,7 @@ PBIResult PortableBaselineInterpret(
             VIRTPOP();
             VIRTSPWRITE(0, StackVal(BooleanValue(result)));
             NEXT_IC();
-            END_OP(Ge);
+            END_CMP_OP(Ge);
           }
         }
         goto generic_cmp;
@@ -7026,7 +7041,7 @@ PBIResult PortableBaselineInterpret(
                       StackVal(BooleanValue(
                           (JSOp(*pc) == JSOp::StrictEq) ? result : !result)));
           NEXT_IC();
-          END_OP(StrictEq);
+          END_CMP_OP(StrictEq);
         } else {
           goto generic_cmp;
         }
@@ -7045,7 +7060,7 @@ PBIResult PortableBaselineInterpret(
         IC_POP_ARG(0);
         IC_ZERO_ARG(2);
         INVOKE_IC_AND_PUSH(Compare, false);
-        END_OP(Eq);
+        END_CMP_OP(Eq);
       }
 
       CASE(Instanceof) {
@@ -665,9 +665,10 @@ void DictionaryPropMap::removeProperty(JSContext* cx,
   MOZ_ASSERT(map->asLinked()->maybeTable(nogc) == table);
 
   bool removingLast = (map == ptr->map() && *mapLength - 1 == ptr->index());
+  PropertyKey key = ptr->map()->getKey(ptr->index());
   ptr->map()->asDictionary()->clearProperty(ptr->index());
   map->incHoleCount();
-  table->remove(ptr);
+  table->remove(ptr, key);
 
   if (removingLast) {
     skipTrailingHoles(map, mapLength);
@@ -709,7 +710,7 @@ void DictionaryPropMap::densifyElements(JSContext* cx,
       if (table) {
         PropMapTable::Ptr p = table->lookupRaw(key);
         MOZ_ASSERT(p);
-        table->remove(p);
+        table->remove(p, key);
       }
 
       currentMap->clearProperty(i);
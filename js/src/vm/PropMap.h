@@ -396,9 +396,12 @@ class PropMapTable {
     }
   }
 
-  void remove(Ptr ptr) {
+  // Removing an entry doesn't move any of the others, so only the cache entry
+  // for |key| has to be updated. This keeps the cache warm for objects that
+  // are used as dictionaries with frequent deletions.
+  void remove(Ptr ptr, PropertyKey key) {
     set_.remove(ptr);
-    purgeCache();
+    setCacheEntry(key, PropMapAndIndex());
   }
 
   void replaceEntry(Ptr ptr, PropertyKey key, PropMapAndIndex newEntry) {
@@ -513,6 +516,10 @@ class PropMap : public gc::TenuredCellWithFlags {
 
   uint32_t approximateEntryCount() const;
 
+  // For JIT usage.
+  static constexpr size_t offsetOfKeys() { return offsetof(PropMap, keys_); }
+  static constexpr uintptr_t isDictionaryFlag() { return IsDictionaryFlag; }
+
 #if defined(DEBUG) || defined(JS_JITSPEW)
   void dump() const;
   void dump(js::GenericPrinter& out) const;
@@ -1066,6 +1073,12 @@ class DictionaryPropMap final : public PropMap {
                   offsetof(LinkedPropMap, data_));
   }
 
+  // For JIT usage.
+  static constexpr size_t offsetOfPropInfos() {
+    return offsetof(DictionaryPropMap, linkedData_) +
+           offsetof(LinkedPropMap::Data, propInfos);
+  }
+
 #if defined(DEBUG) || defined(JS_JITSPEW)
   void dumpOwnFields(js::JSONPrinter& json) const;
 #endif
@@ -14,11 +14,13 @@
 #include "jsfriendapi.h"  // js::GetPropertyKeys, JSITER_OWNONLY
 #include "jstypes.h"      // JS_PUBLIC_API
 
+#include "gc/Tracer.h"              // js::TraceNullableRoot
 #include "js/CallArgs.h"            // JSNative
 #include "js/Class.h"               // JS::ObjectOpResult
 #include "js/Context.h"             // AssertHeapIsIdle
 #include "js/GCVector.h"            // JS::GCVector, JS::RootedVector
 #include "js/Id.h"                  // JS::PropertyKey, jsid
+#include "js/PropertyAccessPlan.h"  // JS::PropertyAccessPlan
 #include "js/PropertyDescriptor.h"  // JS::PropertyDescriptor, JSPROP_READONLY
 #include "js/PropertySpec.h"        // JSNativeWrapper
 #include "js/RootingAPI.h"          // JS::Rooted, JS::Handle, JS::MutableHandle
@@ -31,7 +33,9 @@
 #include "vm/JSObject.h"            // JSObject, js::DefineFunctions
 #include "vm/ObjectOperations.h"  // js::DefineProperty, js::DefineDataProperty, js::HasOwnProperty
 #include "vm/PropertyResult.h"  // js::PropertyResult
+#include "vm/Shape.h"           // js::Shape
 #include "vm/StringType.h"      // JSAtom, js::PropertyName
+#include "vm/Watchtower.h"      // js::Watchtower
 
 #include "vm/JSAtomUtils-inl.h"       // js::AtomToId, js::IndexToId
 #include "vm/JSContext-inl.h"         // JSContext::check
@@ -998,3 +1002,149 @@ JS_PUBLIC_API JSFunction* JS_DefineFunctionById(JSContext* cx,
   cx->check(obj, id);
   return js::DefineFunction(cx, obj, id, call, nargs, attrs);
 }
+
+bool JS::PropertyAccessPlan::init(JSContext* cx, const char* const* names,
+                                  size_t count) {
+  AssertHeapIsIdle();
+  CHECK_THREAD(cx);
+
+  ids_.clear();
+  slots_.clear();
+  shape_ = nullptr;
+
+  if (!ids_.reserve(count)) {
+    ReportOutOfMemory(cx);
+    return false;
+  }
+  for (size_t i = 0; i < count; i++) {
+    JSAtom* atom = Atomize(cx, names[i], strlen(names[i]));
+    if (!atom) {
+      return false;
+    }
+    ids_.infallibleAppend(AtomToId(atom));
+  }
+  return true;
+}
+
+bool JS::PropertyAccessPlan::init(JSContext* cx, const jsid* ids,
+                                  size_t count) {
+  AssertHeapIsIdle();
+  CHECK_THREAD(cx);
+
+  ids_.clear();
+  slots_.clear();
+  shape_ = nullptr;
+
+  if (!ids_.append(ids, count)) {
+    ReportOutOfMemory(cx);
+    return false;
+  }
+  return true;
+}
+
+void JS::PropertyAccessPlan::trace(JSTracer* trc) {
+  for (jsid& id : ids_) {
+    JS::TraceRoot(trc, &id, "PropertyAccessPlan::id");
+  }
+  TraceNullableRoot(trc, &shape_, "PropertyAccessPlan::shape");
+}
+
+void JS::PropertyAccessPlan::updateCache(JSObject* obj) {
+  shape_ = nullptr;
+  slots_.clear();
+
+  // Only cache slots for shared shapes: a dictionary shape can be mutated in
+  // place without the object's shape pointer changing.
+  if (!obj->is<NativeObject>() || obj->shape()->isDictionary()) {
+    return;
+  }
+  NativeObject* nobj = &obj->as<NativeObject>();
+
+  // Caching is optional, so ignore OOM here.
+  if (!slots_.reserve(ids_.length())) {
+    return;
+  }
+
+  bool writable = !Watchtower::watchesPropertyValueChange(nobj);
+  for (jsid id : ids_) {
+    mozilla::Maybe<PropertyInfo> prop = nobj->lookupPure(id);
+    if (prop.isNothing() || !prop->isDataProperty()) {
+      slots_.clear();
+      return;
+    }
+    writable &= prop->writable();
+    slots_.infallibleAppend(prop->slot());
+  }
+
+  shape_ = nobj->shape();
+  slotsWritable_ = writable;
+}
+
+JS_PUBLIC_API bool JS::GetProperties(
+    JSContext* cx, JS::Handle<JSObject*> obj,
+    JS::MutableHandle<JS::PropertyAccessPlan> plan,
+    JS::MutableHandleValueVector vp) {
+  AssertHeapIsIdle();
+  CHECK_THREAD(cx);
+  cx->check(obj);
+
+  PropertyAccessPlan& p = plan.get();
+  if (!vp.resize(p.length())) {
+    ReportOutOfMemory(cx);
+    return false;
+  }
+
+  if (p.shape_ && obj->shape() == p.shape_) {
+    NativeObject* nobj = &obj->as<NativeObject>();
+    for (size_t i = 0; i < p.length(); i++) {
+      vp[i].set(nobj->getSlot(p.slots_[i]));
+    }
+    return true;
+  }
+
+  JS::Rooted<jsid> id(cx);
+  for (size_t i = 0; i < p.length(); i++) {
+    id = p.ids_[i];
+    if (!js::GetProperty(cx, obj, obj, id, vp[i])) {
+      return false;
+    }
+  }
+
+  // Getters may have reshaped the object, so cache the shape it has now.
+  p.updateCache(obj);
+  return true;
+}
+
+JS_PUBLIC_API bool JS::SetProperties(
+    JSContext* cx, JS::Handle<JSObject*> obj,
+    JS::MutableHandle<JS::PropertyAccessPlan> plan,
+    const JS::HandleValueArray& values) {
+  AssertHeapIsIdle();
+  CHECK_THREAD(cx);
+  cx->check(obj, values);
+
+  PropertyAccessPlan& p = plan.get();
+  MOZ_ASSERT(values.length() == p.length());
+
+  if (p.shape_ && p.slotsWritable_ && obj->shape() == p.shape_) {
+    NativeObject* nobj = &obj->as<NativeObject>();
+    for (size_t i = 0; i < p.length(); i++) {
+      nobj->setSlot(p.slots_[i], values[i]);
+    }
+    return true;
+  }
+
+  JS::Rooted<JS::Value> receiver(cx, JS::ObjectValue(*obj));
+  JS::Rooted<jsid> id(cx);
+  for (size_t i = 0; i < p.length(); i++) {
+    id = p.ids_[i];
+    JS::ObjectOpResult ignored;
+    if (!js::SetProperty(cx, obj, id, values[i], receiver, ignored)) {
+      return false;
+    }
+  }
+
+  // Setters may have added or reconfigured properties.
+  p.updateCache(obj);
+  return true;
+}
@@ -170,6 +170,13 @@ class PropertyInfoBase {
 
   T toRaw() const { return slotAndFlags_; }
 
+  // For JIT usage.
+  static constexpr uint32_t slotShift() { return SlotShift; }
+  static constexpr uint32_t nonDataPropertyFlags() {
+    return uint32_t(PropertyFlag::AccessorProperty) |
+           uint32_t(PropertyFlag::CustomDataProperty);
+  }
+
   bool operator==(const PropertyInfoBase<T>& other) const {
     return slotAndFlags_ == other.slotAndFlags_;
   }
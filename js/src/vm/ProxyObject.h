@@ -65,6 +65,18 @@ class ProxyObject : public JSObject {
                                     MutableHandleValueVector valuesOut);
   [[nodiscard]] bool fixupAfterSwap(JSContext* cx, HandleValueVector values);
 
+  // Unique IDs are stored in the value array rather than the zone's unique ID
+  // table.
+  bool hasUniqueId() const { return data.values()->maybeUniqueId != 0; }
+  uint64_t uniqueId() const {
+    MOZ_ASSERT(hasUniqueId());
+    return data.values()->maybeUniqueId;
+  }
+  void setUniqueId(uint64_t uid) {
+    MOZ_ASSERT(uid != 0);
+    data.values()->maybeUniqueId = uid;
+  }
+
   const Value& private_() const { return GetProxyPrivate(this); }
   const Value& expando() const { return GetProxyExpando(this); }
 
@@ -138,6 +138,15 @@ void js::DtoaCache::checkCacheAfterMovingGC() {
   MOZ_ASSERT(!str || !IsForwarded(str));
 }
 
+void js::Int32ToStringCache::checkCacheAfterMovingGC() {
+  if (!entries_) {
+    return;
+  }
+  for (size_t i = 0; i < NumEntries; i++) {
+    MOZ_ASSERT(!entries_[i].str || !IsForwarded(entries_[i].str));
+  }
+}
+
 #endif  // JSGC_HASH_TABLE_CHECKS
 
 NonSyntacticLexicalEnvironmentObject*
@@ -324,6 +333,7 @@ void ObjectRealm::sweepAfterMinorGC(JSTracer* trc) {
 void Realm::sweepAfterMinorGC(JSTracer* trc) {
   globalWriteBarriered = 0;
   dtoaCache.purge();
+  int32ToStringCache.clear();
   objects_.sweepAfterMinorGC(trc);
 }
 
@@ -350,6 +360,7 @@ void Realm::fixupAfterMovingGC(JSTracer* trc) {
 
 void Realm::purge() {
   dtoaCache.purge();
+  int32ToStringCache.purge();
   newProxyCache.purge();
   newPlainObjectWithPropsCache.purge();
   plainObjectAssignCache.purge();
@@ -8,12 +8,14 @@
 #define vm_Realm_h
 
 #include "mozilla/Array.h"
+#include "mozilla/MathAlgorithms.h"
 #include "mozilla/Maybe.h"
 #include "mozilla/MemoryReporting.h"
 #include "mozilla/TimeStamp.h"
 #include "mozilla/Variant.h"
 #include "mozilla/XorShift128PlusRNG.h"
 
+#include <algorithm>
 #include <stddef.h>
 
 #include "builtin/Array.h"
@@ -83,6 +85,58 @@ class DtoaCache {
 #endif
 };
 
+// A small direct-mapped cache for base-10 int32-to-string conversions of
+// values outside the StaticStrings range. Integers used as property keys or
+// formatted into output are often converted many times, which the single-entry
+// DtoaCache only catches when the same value is converted twice in a row.
+//
+// The entries are allocated lazily, so realms which never convert large
+// integers don't pay for the cache. Like DtoaCache, the cache may hold nursery
+// strings, so it's cleared after every minor GC.
+class Int32ToStringCache {
+  struct Entry {
+    JSLinearString* str;
+    int32_t value;
+  };
+  static const size_t NumEntries = 256;
+  static_assert(mozilla::IsPowerOfTwo(NumEntries));
+  mozilla::UniquePtr<Entry[], JS::FreePolicy> entries_;
+
+  static size_t indexFor(int32_t i) { return uint32_t(i) & (NumEntries - 1); }
+
+ public:
+  JSLinearString* lookup(int32_t i) const {
+    if (!entries_) {
+      return nullptr;
+    }
+    const Entry& entry = entries_[indexFor(i)];
+    return entry.str && entry.value == i ? entry.str : nullptr;
+  }
+
+  void cache(int32_t i, JSLinearString* s) {
+    if (!entries_) {
+      entries_.reset(js_pod_calloc<Entry>(NumEntries));
+      if (!entries_) {
+        return;
+      }
+    }
+    entries_[indexFor(i)] = Entry{s, i};
+  }
+
+  // Forget all cached strings but keep the entries allocated.
+  void clear() {
+    if (entries_) {
+      std::fill_n(entries_.get(), NumEntries, Entry{nullptr, 0});
+    }
+  }
+
+  void purge() { entries_.reset(); }
+
+#ifdef JSGC_HASH_TABLE_CHECKS
+  void checkCacheAfterMovingGC();
+#endif
+};
+
 // Cache to speed up the group/shape lookup in ProxyObject::create. A proxy's
 // shape is only determined by the Class + proto, so a small cache for this is
 // very effective in practice.
@@ -413,6 +467,7 @@ class JS::Realm : public JS::shadow::Realm {
   js::wasm::Realm wasm;
 
   js::DtoaCache dtoaCache;
+  js::Int32ToStringCache int32ToStringCache;
   js::NewProxyCache newProxyCache;
   js::NewPlainObjectWithPropsCache newPlainObjectWithPropsCache;
   js::PlainObjectAssignCache plainObjectAssignCache;
@@ -437,6 +492,14 @@ class JS::Realm : public JS::shadow::Realm {
   // Count the number of allocation sites pretenured, for testing purposes.
   uint16_t numAllocSitesPretenured = 0;
 
+  // Approximate number of bytes of GC things and cell buffers allocated on
+  // behalf of this realm since its zone was last collected by a major GC, and
+  // the optional soft limit on that count (zero means no limit). See
+  // JS::SetRealmGCAllocSoftLimit.
+  size_t gcAllocBytes = 0;
+  size_t gcAllocSoftLimit = 0;
+  bool gcAllocSoftLimitReported = false;
+
 #ifdef DEBUG
   bool firedOnNewGlobalObject = false;
 #endif
@@ -506,6 +569,23 @@ class JS::Realm : public JS::shadow::Realm {
   // inconsistency.
   const JS::RealmBehaviors& behaviors() const { return behaviors_; }
 
+  void addGCAllocBytes(size_t nbytes) { gcAllocBytes += nbytes; }
+  void resetGCAllocBytes() {
+    gcAllocBytes = 0;
+    gcAllocSoftLimitReported = false;
+  }
+
+  // Returns true the first time the allocation count passes the soft limit
+  // after being reset.
+  bool checkGCAllocSoftLimit() {
+    if (!gcAllocSoftLimit || gcAllocSoftLimitReported ||
+        gcAllocBytes < gcAllocSoftLimit) {
+      return false;
+    }
+    gcAllocSoftLimitReported = true;
+    return true;
+  }
+
   void setNonLive() { behaviors_.setNonLive(); }
   void setReduceTimerPrecisionCallerType(JS::RTPCallerTypeToken type) {
     behaviors_.setReduceTimerPrecisionCallerType(type);
@@ -5,12 +5,15 @@
  * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 #include "vm/RealmFuses.h"
 
+#include "builtin/MapObject.h"
 #include "vm/GlobalObject.h"
 #include "vm/NativeObject.h"
 #include "vm/ObjectOperations.h"
 #include "vm/Realm.h"
 #include "vm/SelfHosting.h"
 
+#include "vm/JSObject-inl.h"
+
 void js::InvalidatingRealmFuse::popFuse(JSContext* cx, RealmFuses& realmFuses) {
   InvalidatingFuse::popFuse(cx);
 
@@ -232,3 +235,39 @@ bool js::ObjectPrototypeHasNoReturnProperty::checkInvariant(JSContext* cx) {
   RootedObject proto(cx, &cx->global()->getObjectPrototype());
   return HasNoReturnName(cx, proto);
 }
+
+static bool HasOriginalNativeMethod(NativeObject* proto, PropertyName* name,
+                                    JSNative native) {
+  mozilla::Maybe<PropertyInfo> prop = proto->lookupPure(name);
+  if (prop.isNothing() || !prop->isDataProperty()) {
+    return false;
+  }
+  return IsNativeFunction(proto->getSlot(prop->slot()), native);
+}
+
+/* static */
+bool js::MapPrototypeMethodsFuse::checkInvariant(JSContext* cx) {
+  auto* proto = cx->global()->maybeGetPrototype(JSProto_Map);
+  if (!proto) {
+    // Invariant holds if there is no Map prototype.
+    return true;
+  }
+
+  auto* nproto = &proto->as<NativeObject>();
+  return HasOriginalNativeMethod(nproto, cx->names().get, MapObject::get) &&
+         HasOriginalNativeMethod(nproto, cx->names().set, MapObject::set) &&
+         HasOriginalNativeMethod(nproto, cx->names().has, MapObject::has);
+}
+
+/* static */
+bool js::SetPrototypeMethodsFuse::checkInvariant(JSContext* cx) {
+  auto* proto = cx->global()->maybeGetPrototype(JSProto_Set);
+  if (!proto) {
+    // Invariant holds if there is no Set prototype.
+    return true;
+  }
+
+  auto* nproto = &proto->as<NativeObject>();
+  return HasOriginalNativeMethod(nproto, cx->names().add, SetObject::add) &&
+         HasOriginalNativeMethod(nproto, cx->names().has, SetObject::has);
+}
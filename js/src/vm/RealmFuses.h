@@ -108,18 +108,34 @@ struct ObjectPrototypeHasNoReturnProperty final
   virtual bool checkInvariant(JSContext* cx) override;
 };
 
-#define FOR_EACH_REALM_FUSE(FUSE)                                        \
-  FUSE(OptimizeGetIteratorFuse, optimizeGetIteratorFuse)                 \
-  FUSE(ArrayPrototypeIteratorFuse, arrayPrototypeIteratorFuse)           \
-  FUSE(ArrayPrototypeIteratorNextFuse, arrayPrototypeIteratorNextFuse)   \
-  FUSE(ArrayIteratorPrototypeHasNoReturnProperty,                        \
-       arrayIteratorPrototypeHasNoReturnProperty)                        \
-  FUSE(IteratorPrototypeHasNoReturnProperty,                             \
-       iteratorPrototypeHasNoReturnProperty)                             \
-  FUSE(ArrayIteratorPrototypeHasIteratorProto,                           \
-       arrayIteratorPrototypeHasIteratorProto)                           \
-  FUSE(IteratorPrototypeHasObjectProto, iteratorPrototypeHasObjectProto) \
-  FUSE(ObjectPrototypeHasNoReturnProperty, objectPrototypeHasNoReturnProperty)
+// This fuse covers Map.prototype.get, Map.prototype.set and Map.prototype.has
+// still being the original natives.
+struct MapPrototypeMethodsFuse final : public RealmFuse {
+  virtual const char* name() override { return "MapPrototypeMethodsFuse"; }
+  virtual bool checkInvariant(JSContext* cx) override;
+};
+
+// This fuse covers Set.prototype.add and Set.prototype.has still being the
+// original natives.
+struct SetPrototypeMethodsFuse final : public RealmFuse {
+  virtual const char* name() override { return "SetPrototypeMethodsFuse"; }
+  virtual bool checkInvariant(JSContext* cx) override;
+};
+
+#define FOR_EACH_REALM_FUSE(FUSE)                                            \
+  FUSE(OptimizeGetIteratorFuse, optimizeGetIteratorFuse)                     \
+  FUSE(ArrayPrototypeIteratorFuse, arrayPrototypeIteratorFuse)               \
+  FUSE(ArrayPrototypeIteratorNextFuse, arrayPrototypeIteratorNextFuse)       \
+  FUSE(ArrayIteratorPrototypeHasNoReturnProperty,                            \
+       arrayIteratorPrototypeHasNoReturnProperty)                            \
+  FUSE(IteratorPrototypeHasNoReturnProperty,                                 \
+       iteratorPrototypeHasNoReturnProperty)                                 \
+  FUSE(ArrayIteratorPrototypeHasIteratorProto,                               \
+       arrayIteratorPrototypeHasIteratorProto)                               \
+  FUSE(IteratorPrototypeHasObjectProto, iteratorPrototypeHasObjectProto)     \
+  FUSE(ObjectPrototypeHasNoReturnProperty, objectPrototypeHasNoReturnProperty) \
+  FUSE(MapPrototypeMethodsFuse, mapPrototypeMethodsFuse)                     \
+  FUSE(SetPrototypeMethodsFuse, setPrototypeMethodsFuse)
 
 struct RealmFuses {
   RealmFuses() = default;
@@ -769,6 +769,12 @@ RegExpRunStatus RegExpShared::execute(JSContext* cx,
     return RegExpRunStatus::Error;
   }
 
+  RegExpExecCache& execCache = cx->caches().regExpExecCache;
+  bool found;
+  if (execCache.lookup(re, input, start, *matches, &found)) {
+    return found ? RegExpRunStatus::Success : RegExpRunStatus::Success_NotFound;
+  }
+
   uint32_t interruptRetries = 0;
   const uint32_t maxInterruptRetries = 4;
   do {
@@ -824,6 +830,8 @@ RegExpRunStatus RegExpShared::execute(JSContext* cx,
     MOZ_ASSERT(result == RegExpRunStatus::Success ||
                result == RegExpRunStatus::Success_NotFound);
 
+    execCache.put(re, input, start, *matches,
+                  result == RegExpRunStatus::Success);
     return result;
   } while (true);
 
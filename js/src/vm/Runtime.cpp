@@ -36,6 +36,7 @@
 #include "js/Stack.h"  // JS::NativeStackLimitMin
 #include "js/Wrapper.h"
 #include "js/WrapperCallbacks.h"
+#include "vm/Compression.h"  // js::CompressionCodec
 #include "vm/DateTime.h"
 #include "vm/JSObject.h"
 #include "vm/JSScript.h"
@@ -143,6 +144,7 @@ JSRuntime::JSRuntime(JSRuntime* parentRuntime)
       offthreadBaselineCompilationEnabled_(false),
       offthreadIonCompilationEnabled_(true),
       parallelParsingEnabled_(true),
+      sourceCompressionCodec_(CompressionCodec::Zlib),
       autoWritableJitCodeActive_(false),
       oomCallback(nullptr),
       debuggerMallocSizeOf(ReturnZeroSize),
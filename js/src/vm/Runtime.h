@@ -14,6 +14,7 @@
 #include "mozilla/LinkedList.h"
 #include "mozilla/Maybe.h"
 #include "mozilla/MemoryReporting.h"
+#include "mozilla/Span.h"
 #include "mozilla/TimeStamp.h"
 #include "mozilla/XorShift128PlusRNG.h"
 
@@ -93,6 +94,7 @@ extern MOZ_COLD void ReportOversizedAllocation(JSContext* cx,
 
 class Activation;
 class ActivationIterator;
+enum class CompressionCodec : uint8_t;
 class Shape;
 class SourceHook;
 
@@ -819,6 +821,11 @@ struct JSRuntime {
   js::WriteOnceData<js::FrozenAtomSet*> permanentAtoms_;
 
  public:
+  // Names added to the permanent atoms by initializeAtoms, in addition to the
+  // well-known and self-hosted atoms. Only set while the runtime is being
+  // initialized. See JS::SetExtraPermanentAtoms.
+  js::MainThreadData<mozilla::Span<const char* const>> extraPermanentAtomNames;
+
   bool initializeAtoms(JSContext* cx);
   void finishAtoms();
   bool atomsAreFinished() const { return !atoms_; }
@@ -965,6 +972,9 @@ struct JSRuntime {
   mozilla::Atomic<bool, mozilla::SequentiallyConsistent>
       parallelParsingEnabled_;
 
+  // Codec used by source compression tasks enqueued for this runtime.
+  js::MainThreadData<js::CompressionCodec> sourceCompressionCodec_;
+
   js::MainThreadData<bool> autoWritableJitCodeActive_;
 
  public:
@@ -990,6 +1000,12 @@ struct JSRuntime {
     parallelParsingEnabled_ = value;
   }
   bool canUseParallelParsing() const { return parallelParsingEnabled_; }
+  void setSourceCompressionCodec(js::CompressionCodec codec) {
+    sourceCompressionCodec_ = codec;
+  }
+  js::CompressionCodec sourceCompressionCodec() const {
+    return sourceCompressionCodec_;
+  }
 
   void toggleAutoWritableJitCodeActive(bool b) {
     MOZ_ASSERT(autoWritableJitCodeActive_ != b,
@@ -1978,18 +1978,27 @@ JSObject* SavedStacks::MetadataBuilder::build(
     return nullptr;
   }
 
+  auto recordAllocationCallback =
+      cx->realm()->runtimeFromMainThread()->recordAllocationCallback;
+
+  // If allocations are only being recorded for the embedding's callback, no
+  // Debugger will look at the allocation site, so skip capturing the stack.
+  bool captureStack =
+      !recordAllocationCallback ||
+      DebugAPI::allocationSamplingProbability(cx->global()).isSome();
+
   Rooted<SavedFrame*> frame(cx);
-  if (!stacks.saveCurrentStack(cx, &frame)) {
-    oomUnsafe.crash("SavedStacksMetadataBuilder");
-  }
+  if (captureStack) {
+    if (!stacks.saveCurrentStack(cx, &frame)) {
+      oomUnsafe.crash("SavedStacksMetadataBuilder");
+    }
 
-  if (!DebugAPI::onLogAllocationSite(cx, obj, frame,
-                                     mozilla::TimeStamp::Now())) {
-    oomUnsafe.crash("SavedStacksMetadataBuilder");
+    if (!DebugAPI::onLogAllocationSite(cx, obj, frame,
+                                       mozilla::TimeStamp::Now())) {
+      oomUnsafe.crash("SavedStacksMetadataBuilder");
+    }
   }
 
-  auto recordAllocationCallback =
-      cx->realm()->runtimeFromMainThread()->recordAllocationCallback;
   if (recordAllocationCallback) {
     // The following code translates the JS-specific information, into an
     // RecordAllocationInfo object that can be consumed outside of SpiderMonkey.
@@ -199,6 +199,11 @@ class SavedStacks {
   static const MetadataBuilder metadataBuilder;
 
  private:
+  // Weak set of every SavedFrame in this realm, keyed on the frame's contents
+  // and its parent, so that captures sharing a stack tail share the
+  // SavedFrame objects for it. Every capture, including promise allocation
+  // stacks and the Debugger allocation log, goes through this set, so a live
+  // frame is only allocated once per distinct (location, parent) pair.
   SavedFrame::Set frames;
   bool bernoulliSeeded;
   mozilla::FastBernoulliTrial bernoulli;
@@ -701,6 +701,27 @@ static bool intrinsic_IsPackedArray(JSContext* cx, unsigned argc, Value* vp) {
   return true;
 }
 
+static bool intrinsic_ArrayCopyPacked(JSContext* cx, unsigned argc,
+                                      Value* vp) {
+  CallArgs args = CallArgsFromVp(argc, vp);
+  MOZ_ASSERT(args.length() == 1);
+  MOZ_ASSERT(IsPackedArray(&args[0].toObject()));
+
+  Rooted<ArrayObject*> arr(cx, &args[0].toObject().as<ArrayObject>());
+  uint32_t length = arr->length();
+
+  ArrayObject* result = NewDenseFullyAllocatedArray(cx, length);
+  if (!result) {
+    return false;
+  }
+  if (length > 0) {
+    result->initDenseElements(arr, 0, length);
+  }
+
+  args.rval().setObject(*result);
+  return true;
+}
+
 bool js::intrinsic_NewArrayIterator(JSContext* cx, unsigned argc, Value* vp) {
   CallArgs args = CallArgsFromVp(argc, vp);
   MOZ_ASSERT(args.length() == 0);
@@ -1995,6 +2016,7 @@ static const JSFunctionSpec intrinsic_functions[] = {
                     IntrinsicArrayBufferByteLength),
     JS_FN("ArrayBufferCopyData",
           intrinsic_ArrayBufferCopyData<ArrayBufferObject>, 6, 0),
+    JS_FN("ArrayCopyPacked", intrinsic_ArrayCopyPacked, 1, 0),
     JS_INLINABLE_FN("ArrayIteratorPrototypeOptimizable",
                     intrinsic_ArrayIteratorPrototypeOptimizable, 0, 0,
                     IntrinsicArrayIteratorPrototypeOptimizable),
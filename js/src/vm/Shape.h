@@ -80,6 +80,13 @@
 // The shape cache is also used as cache for prototype shapes, to point to the
 // initial shape for objects using that shape, and for cached iterators.
 //
+// Shared shapes and their SharedPropMaps are per-Zone, even for the built-in
+// prototypes and constructors whose layout is the same in every zone. A shape
+// can't be shared across zones because its BaseShape stores the realm and the
+// prototype object. Sharing only the property maps isn't supported either:
+// apart from atoms and registered symbols, the GC does not allow edges
+// between zones, and atom marking tracks atoms rather than arbitrary cells.
+//
 // DictionaryShape
 // ===============
 // Used only for native objects. An object with a dictionary shape is "in
@@ -522,6 +529,10 @@ class NativeShape : public Shape {
   // For JIT usage.
   static constexpr uint32_t fixedSlotsMask() { return FIXED_SLOTS_MASK; }
   static constexpr uint32_t fixedSlotsShift() { return FIXED_SLOTS_SHIFT; }
+  static constexpr uint32_t propMapLengthMask() { return MAP_LENGTH_MASK; }
+  static constexpr size_t offsetOfPropMap() {
+    return offsetof(NativeShape, propMap_);
+  }
 };
 
 // Shared shape for a NativeObject.
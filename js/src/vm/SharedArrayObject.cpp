@@ -207,10 +207,14 @@ void WasmSharedArrayRawBuffer::discard(size_t byteOffset, size_t byteLen) {
 
   SharedMem<uint8_t*> addr = memBase + uintptr_t(byteOffset);
 
-  // On POSIX-ish platforms, we discard memory by overwriting previously-mapped
-  // pages with freshly-mapped pages (which are all zeroed). The operating
-  // system recognizes this and decreases the process RSS, and eventually
-  // collects the abandoned physical pages.
+  // On Linux, MADV_DONTNEED drops the pages of a private anonymous mapping
+  // immediately and they read back as zero on the next access. This leaves the
+  // mapping itself alone, so the address space is never briefly unmapped.
+  //
+  // On other POSIX-ish platforms, we discard memory by overwriting
+  // previously-mapped pages with freshly-mapped pages (which are all zeroed).
+  // The operating system recognizes this and decreases the process RSS, and
+  // eventually collects the abandoned physical pages.
   //
   // On Windows, committing over previously-committed pages has no effect. We
   // could decommit and recommit, but this doesn't work for shared memories
@@ -241,6 +245,10 @@ void WasmSharedArrayRawBuffer::discard(size_t byteOffset, size_t byteLen) {
   }
 #elif defined(__wasi__)
   AtomicOperations::memsetSafeWhenRacy(addr, 0, byteLen);
+#elif defined(XP_LINUX)
+  if (madvise(addr.unwrap(), byteLen, MADV_DONTNEED) != 0) {
+    MOZ_CRASH("failed to discard wasm memory");
+  }
 #else  // !XP_WIN
   void* data = MozTaggedAnonymousMmap(
       addr.unwrap(), byteLen, PROT_READ | PROT_WRITE,
@@ -51,7 +51,9 @@ class WasmSharedArrayRawBuffer;
  * toward sourceMaxPages_. See extensive comments above WasmArrayRawBuffer in
  * ArrayBufferObject.cpp. length_ only grows when the lock is held.
  */
-class SharedArrayRawBuffer {
+// The explicit alignment keeps the size a multiple of the array buffer
+// alignment on 32-bit platforms, see SharedArrayRawBuffer::Allocate.
+class alignas(ArrayBufferObject::ARRAY_BUFFER_ALIGNMENT) SharedArrayRawBuffer {
  protected:
   // Whether this is a WasmSharedArrayRawBuffer.
   bool isWasm_;
@@ -62,9 +64,15 @@ class SharedArrayRawBuffer {
   mozilla::Atomic<uint32_t, mozilla::ReleaseAcquire> refcount_;
   mozilla::Atomic<size_t, mozilla::SequentiallyConsistent> length_;
 
-  // A list of structures representing tasks waiting on some
-  // location within this buffer.
-  FutexWaiter* waiters_ = nullptr;
+  // Lists of structures representing tasks waiting on some location within
+  // this buffer, hashed by byte offset so that a notify only walks the
+  // waiters whose offset shares its bucket.
+  static constexpr size_t NumWaiterBuckets = 16;
+  FutexWaiter* waiters_[NumWaiterBuckets] = {};
+
+  static size_t waiterBucket(size_t byteOffset) {
+    return (byteOffset / sizeof(int32_t)) % NumWaiterBuckets;
+  }
 
  protected:
   SharedArrayRawBuffer(bool isGrowable, uint8_t* buffer, size_t length)
@@ -85,13 +93,20 @@ class SharedArrayRawBuffer {
 
   inline WasmSharedArrayRawBuffer* toWasmBuffer();
 
+  // The list of waiters that may be waiting on |byteOffset|. Waiters on
+  // other offsets in the same bucket are in the list as well.
+  //
   // This may be called from multiple threads.  The caller must take
   // care of mutual exclusion.
-  FutexWaiter* waiters() const { return waiters_; }
+  FutexWaiter* waiters(size_t byteOffset) const {
+    return waiters_[waiterBucket(byteOffset)];
+  }
 
   // This may be called from multiple threads.  The caller must take
   // care of mutual exclusion.
-  void setWaiters(FutexWaiter* waiters) { waiters_ = waiters; }
+  void setWaiters(size_t byteOffset, FutexWaiter* waiters) {
+    waiters_[waiterBucket(byteOffset)] = waiters;
+  }
 
   inline SharedMem<uint8_t*> dataPointerShared() const;
 
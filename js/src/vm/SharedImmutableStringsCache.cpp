@@ -101,24 +101,29 @@ SharedImmutableTwoByteString SharedImmutableTwoByteString::clone() const {
 }
 
 bool SharedImmutableStringsCache::init() {
-  MOZ_ASSERT(!inner_);
-
-  auto* inner =
-      js_new<ExclusiveData<Inner>>(mutexid::SharedImmutableStringsCache);
-  if (!inner) {
-    return false;
+  for (const ExclusiveData<Inner>*& shard : shards_) {
+    MOZ_ASSERT(!shard);
+
+    auto* inner =
+        js_new<ExclusiveData<Inner>>(mutexid::SharedImmutableStringsCache);
+    if (!inner) {
+      free();
+      return false;
+    }
+
+    auto locked = inner->lock();
+    shard = locked.parent();
   }
 
-  auto locked = inner->lock();
-  inner_ = locked.parent();
-
   return true;
 }
 
 void SharedImmutableStringsCache::free() {
-  if (inner_) {
-    js_delete(inner_);
-    inner_ = nullptr;
+  for (const ExclusiveData<Inner>*& shard : shards_) {
+    if (shard) {
+      js_delete(shard);
+      shard = nullptr;
+    }
   }
 }
 
@@ -31,10 +31,14 @@ class SharedImmutableTwoByteString;
  * immutable strings (either `const char*` [any encoding, not restricted to
  * only Latin-1 or only UTF-8] or `const char16_t*`) between threads.
  *
- * The locking mechanism is dead-simple and coarse grained: a single lock guards
- * all of the internal table itself, the table's entries, and the entries'
- * reference counts. It is only safe to perform any mutation on the cache or any
- * data stored within the cache when this lock is acquired.
+ * The cache is split into a fixed number of shards, selected by the string's
+ * hash, so that threads interning unrelated strings (off-thread parses, source
+ * compression and main-thread compilations across many runtimes) don't all
+ * contend on one lock. Within a shard the locking mechanism is dead-simple and
+ * coarse grained: a single lock guards the shard's table, the table's entries,
+ * and the entries' reference counts. It is only safe to perform any mutation on
+ * a shard or any data stored within it when its lock is acquired. Each entry
+ * remembers its shard, so releasing a reference only takes that shard's lock.
  */
 class SharedImmutableStringsCache {
   static SharedImmutableStringsCache singleton_;
@@ -135,19 +139,22 @@ class SharedImmutableStringsCache {
                                                          size_t length);
 
   size_t sizeOfExcludingThis(mozilla::MallocSizeOf mallocSizeOf) const {
-    MOZ_ASSERT(inner_);
-    size_t n = mallocSizeOf(inner_);
-
-    auto locked = inner_->lock();
-
-    // Size of the table.
-    n += locked->set.shallowSizeOfExcludingThis(mallocSizeOf);
-
-    // Sizes of the strings and their boxes.
-    for (auto r = locked->set.all(); !r.empty(); r.popFront()) {
-      n += mallocSizeOf(r.front().get());
-      if (const char* chars = r.front()->chars()) {
-        n += mallocSizeOf(chars);
+    size_t n = 0;
+    for (const ExclusiveData<Inner>* shard : shards_) {
+      MOZ_ASSERT(shard);
+      n += mallocSizeOf(shard);
+
+      auto locked = shard->lock();
+
+      // Size of the table.
+      n += locked->set.shallowSizeOfExcludingThis(mallocSizeOf);
+
+      // Sizes of the strings and their boxes.
+      for (auto r = locked->set.all(); !r.empty(); r.popFront()) {
+        n += mallocSizeOf(r.front().get());
+        if (const char* chars = r.front()->chars()) {
+          n += mallocSizeOf(chars);
+        }
       }
     }
 
@@ -163,7 +170,7 @@ class SharedImmutableStringsCache {
   static void freeSingleton();
 
   static SharedImmutableStringsCache& getSingleton() {
-    MOZ_ASSERT(singleton_.inner_);
+    MOZ_ASSERT(singleton_.shards_[0]);
     return singleton_;
   }
 
@@ -185,16 +192,18 @@ class SharedImmutableStringsCache {
    * Purge the cache of all refcount == 0 entries.
    */
   void purge() {
-    auto locked = inner_->lock();
-
-    for (Inner::Set::Enum e(locked->set); !e.empty(); e.popFront()) {
-      if (e.front()->refcount == 0) {
-        // The chars should be eagerly freed when refcount reaches zero.
-        MOZ_ASSERT(!e.front()->chars());
-        e.removeFront();
-      } else {
-        // The chars should exist as long as the refcount is non-zero.
-        MOZ_ASSERT(e.front()->chars());
+    for (const ExclusiveData<Inner>* shard : shards_) {
+      auto locked = shard->lock();
+
+      for (Inner::Set::Enum e(locked->set); !e.empty(); e.popFront()) {
+        if (e.front()->refcount == 0) {
+          // The chars should be eagerly freed when refcount reaches zero.
+          MOZ_ASSERT(!e.front()->chars());
+          e.removeFront();
+        } else {
+          // The chars should exist as long as the refcount is non-zero.
+          MOZ_ASSERT(e.front()->chars());
+        }
       }
     }
   }
@@ -314,7 +323,15 @@ class SharedImmutableStringsCache {
     Inner& operator=(const Inner&) = delete;
   };
 
-  const ExclusiveData<Inner>* inner_ = nullptr;
+  static const size_t NumShards = 8;
+
+  const ExclusiveData<Inner>* shardFor(HashNumber hash) const {
+    const ExclusiveData<Inner>* shard = shards_[hash % NumShards];
+    MOZ_ASSERT(shard);
+    return shard;
+  }
+
+  const ExclusiveData<Inner>* shards_[NumShards] = {};
 };
 
 /**
@@ -63,6 +63,15 @@ using JS::AutoStableStringChars;
 
 using UniqueLatin1Chars = UniquePtr<Latin1Char[], JS::FreePolicy>;
 
+template <typename CharT>
+extern void InflateUTF8CharsToBuffer(const JS::UTF8Chars& src, CharT* dst,
+                                     size_t dstLen,
+                                     JS::SmallestEncoding encoding);
+
+extern bool GetUTF8InflationData(JSContext* cx, const JS::UTF8Chars& utf8,
+                                 size_t* outlen,
+                                 JS::SmallestEncoding* encoding);
+
 size_t JSString::sizeOfExcludingThis(mozilla::MallocSizeOf mallocSizeOf) {
   // JSRope: do nothing, we'll count all children chars when we hit the leaf
   // strings.
@@ -141,13 +150,26 @@ JS::ubi::Node::Size JS::ubi::Concrete<JSString>::size(
 const char16_t JS::ubi::Concrete<JSString>::concreteTypeName[] = u"JSString";
 
 mozilla::Maybe<std::tuple<size_t, size_t>> JSString::encodeUTF8Partial(
-    const JS::AutoRequireNoGC& nogc, mozilla::Span<char> buffer) const {
+    const JS::AutoRequireNoGC& nogc, mozilla::Span<char> buffer,
+    size_t start) const {
+  MOZ_ASSERT(start <= length());
+
   mozilla::Vector<const JSString*, 16, SystemAllocPolicy> stack;
   const JSString* current = this;
   char16_t pendingLeadSurrogate = 0;  // U+0000 means no pending lead surrogate
   size_t totalRead = 0;
   size_t totalWritten = 0;
   for (;;) {
+    // Skip whole strings, including ropes, that end before |start|.
+    if (MOZ_UNLIKELY(start) && start >= current->length()) {
+      start -= current->length();
+      if (stack.empty()) {
+        break;
+      }
+      current = stack.popCopy();
+      continue;
+    }
+
     if (current->isRope()) {
       JSRope& rope = current->asRope();
       if (!stack.append(rope.rightChild())) {
@@ -159,6 +181,8 @@ mozilla::Maybe<std::tuple<size_t, size_t>> JSString::encodeUTF8Partial(
     }
 
     JSLinearString& linear = current->asLinear();
+    size_t skip = start;
+    start = 0;
     if (MOZ_LIKELY(linear.hasLatin1Chars())) {
       if (MOZ_UNLIKELY(pendingLeadSurrogate)) {
         if (buffer.Length() < 3) {
@@ -173,7 +197,7 @@ mozilla::Maybe<std::tuple<size_t, size_t>> JSString::encodeUTF8Partial(
         pendingLeadSurrogate = 0;
       }
       auto src = mozilla::AsChars(
-          mozilla::Span(linear.latin1Chars(nogc), linear.length()));
+          mozilla::Span(linear.latin1Chars(nogc), linear.length()).From(skip));
       size_t read;
       size_t written;
       std::tie(read, written) =
@@ -185,7 +209,8 @@ mozilla::Maybe<std::tuple<size_t, size_t>> JSString::encodeUTF8Partial(
         return mozilla::Some(std::make_tuple(totalRead, totalWritten));
       }
     } else {
-      auto src = mozilla::Span(linear.twoByteChars(nogc), linear.length());
+      auto src =
+          mozilla::Span(linear.twoByteChars(nogc), linear.length()).From(skip);
       if (MOZ_UNLIKELY(pendingLeadSurrogate)) {
         char16_t first = 0;
         if (!src.IsEmpty()) {
@@ -1067,6 +1092,19 @@ JSLinearString* JSRope::flattenInternal(JSRope* root) {
    *   leftmost leaf of a subsequent flatten, we will hopefully be able to
    *   fill it, as in the case above.
    *
+   * The capacity policy lives in AllocCharsForFlatten: powers of two up to
+   * 1MB and 12.5% growth beyond that. Buffers below MIN_BYTES_FOR_BUFFER are
+   * allocated in the nursery when the root is, so short-lived flattened
+   * strings are freed by the next minor GC. Larger ones use a StringBuffer,
+   * which can later be shared with Gecko without copying.
+   *
+   * Only the leftmost leaf's buffer is ever reused. An extensible string's
+   * characters always start at the beginning of its buffer, so there is no
+   * spare space in front of them. Prepending loops (|s = x + s|) and balanced
+   * concatenation trees therefore copy everything on each flatten. Supporting
+   * them would need a string kind with headroom before its characters, and
+   * every chars() consumer would have to understand it.
+   *
    * Note that, even though the code for creating JSDependentStrings avoids
    * creating dependents of dependents, we can create that situation here: the
    * JSExtensibleStrings we transform into JSDependentStrings might have
@@ -2244,10 +2282,84 @@ JSLinearString* NewStringCopyUTF8N(JSContext* cx, const JS::UTF8Chars& utf8,
   return NewString<js::CanGC>(cx, std::move(utf16), length, heap);
 }
 
+// Fill |dst| with the |length| code units of |utf8|, whose first
+// |asciiLength| bytes are known to be ASCII and whose remaining bytes are
+// known to be valid UTF-8 in |encoding|.
+template <typename CharT>
+static void InflateUTF8AfterASCII(const JS::UTF8Chars& utf8,
+                                  size_t asciiLength, CharT* dst,
+                                  size_t length,
+                                  JS::SmallestEncoding encoding) {
+  const char* src = reinterpret_cast<const char*>(utf8.begin().get());
+  if constexpr (std::is_same_v<CharT, Latin1Char>) {
+    PodCopy(dst, reinterpret_cast<const Latin1Char*>(src), asciiLength);
+  } else {
+    CopyAndInflateChars(dst, src, asciiLength);
+  }
+
+  JS::UTF8Chars rest(src + asciiLength, utf8.length() - asciiLength);
+  InflateUTF8CharsToBuffer(rest, dst + asciiLength, length - asciiLength,
+                           encoding);
+}
+
+template <typename CharT>
+static JSLinearString* NewStringFromUTF8AfterASCII(
+    JSContext* cx, const JS::UTF8Chars& utf8, size_t asciiLength,
+    size_t length, JS::SmallestEncoding encoding, gc::Heap heap) {
+  if (JSInlineString::lengthFits<CharT>(length)) {
+    CharT* storage;
+    JSInlineString* str =
+        AllocateInlineString<CanGC>(cx, length, &storage, heap);
+    if (!str) {
+      return nullptr;
+    }
+    InflateUTF8AfterASCII(utf8, asciiLength, storage, length, encoding);
+    return str;
+  }
+
+  if (MOZ_UNLIKELY(!JSString::validateLength(cx, length))) {
+    return nullptr;
+  }
+
+  Rooted<JSString::OwnedChars<CharT>> chars(
+      cx, ::AllocChars<CharT>(cx, length, heap));
+  if (!chars) {
+    return nullptr;
+  }
+  InflateUTF8AfterASCII(utf8, asciiLength, chars.data(), length, encoding);
+  return JSLinearString::newValidLength<CanGC, CharT>(cx, &chars, heap);
+}
+
 JSLinearString* NewStringCopyUTF8N(JSContext* cx, const JS::UTF8Chars& utf8,
                                    gc::Heap heap) {
-  JS::SmallestEncoding encoding = JS::FindSmallestEncoding(utf8);
-  return NewStringCopyUTF8N(cx, utf8, encoding, heap);
+  // Skip the leading ASCII run with a vectorized scan. Most input is entirely
+  // ASCII and can be copied directly.
+  auto units = mozilla::AsChars(Span<const unsigned char>(utf8));
+  size_t asciiLength = mozilla::AsciiValidUpTo(units);
+  if (asciiLength == units.Length()) {
+    return NewStringCopyUTF8N(cx, utf8, JS::SmallestEncoding::ASCII, heap);
+  }
+
+  // Validate the rest and compute its exact length and encoding in one pass,
+  // then decode straight into the string's own storage. This avoids scanning
+  // the whole input separately for the encoding, the length and the copy, and
+  // avoids a temporary malloc buffer for short strings.
+  JS::UTF8Chars rest(units.Elements() + asciiLength,
+                     units.Length() - asciiLength);
+  size_t restLength;
+  JS::SmallestEncoding encoding;
+  if (!GetUTF8InflationData(cx, rest, &restLength, &encoding)) {
+    return nullptr;
+  }
+  MOZ_ASSERT(encoding != JS::SmallestEncoding::ASCII);
+
+  size_t length = asciiLength + restLength;
+  if (encoding == JS::SmallestEncoding::Latin1) {
+    return NewStringFromUTF8AfterASCII<Latin1Char>(cx, utf8, asciiLength,
+                                                   length, encoding, heap);
+  }
+  return NewStringFromUTF8AfterASCII<char16_t>(cx, utf8, asciiLength, length,
+                                               encoding, heap);
 }
 
 template <typename CharT>
@@ -827,10 +827,14 @@ class JSString : public js::gc::CellWithLengthAndFlags {
    * it also doesn't modify the representation of left or right halves
    * of this string, or of those halves, and so on.
    *
+   * Encoding starts at code unit |start|, which lets a caller resume a
+   * partial conversion at the number of code units previously read.
+   *
    * Returns mozilla::Nothing on OOM.
    */
   mozilla::Maybe<std::tuple<size_t, size_t>> encodeUTF8Partial(
-      const JS::AutoRequireNoGC& nogc, mozilla::Span<char> buffer) const;
+      const JS::AutoRequireNoGC& nogc, mozilla::Span<char> buffer,
+      size_t start = 0) const;
 
  private:
   // To help avoid writing Spectre-unsafe code, we only allow MacroAssembler
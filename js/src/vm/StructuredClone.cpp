@@ -150,6 +150,12 @@ enum StructuredDataType : uint32_t {
   SCTAG_RESIZABLE_ARRAY_BUFFER_OBJECT,
   SCTAG_GROWABLE_SHARED_ARRAY_BUFFER_OBJECT,
 
+  // A string which may be referred to by later SCTAG_STRING_REFERENCE pairs,
+  // encoded like SCTAG_STRING. Strings are numbered in the order in which they
+  // appear, starting at zero.
+  SCTAG_INTERNED_STRING,
+  SCTAG_STRING_REFERENCE,
+
   SCTAG_TYPED_ARRAY_V1_MIN = 0xFFFF0100,
   SCTAG_TYPED_ARRAY_V1_INT8 = SCTAG_TYPED_ARRAY_V1_MIN + Scalar::Int8,
   SCTAG_TYPED_ARRAY_V1_UINT8 = SCTAG_TYPED_ARRAY_V1_MIN + Scalar::Uint8,
@@ -533,10 +539,20 @@ struct JSStructuredCloneReader {
   // is usually no problem, since both algorithms do a single linear pass
   // over the serialized data. There is one hitch; see readTypedArray.
   //
+  // It also means that the reader can't skip over or defer decoding part of
+  // the graph: the backreference indexes of everything after a skipped
+  // subtree depend on how many objects it contained, and a later
+  // backreference may point into it. Callers that only forward a message
+  // should copy the JSStructuredCloneData rather than read it.
+  //
   // The values in this vector are objects, except it can temporarily have
   // one `undefined` placeholder value (the readTypedArray hack).
   RootedValueVector allObjs;
 
+  // Strings read from SCTAG_INTERNED_STRING pairs, in order, for resolving
+  // SCTAG_STRING_REFERENCE pairs.
+  Rooted<GCVector<JSString*, 0, SystemAllocPolicy>> internedStrings;
+
   size_t numItemsRead;
 
   // The user defined callbacks that will be used for cloning.
@@ -584,6 +600,7 @@ struct JSStructuredCloneWriter {
         objectEntries(cx),
         otherEntries(cx),
         memory(cx),
+        internedStrings(cx),
         transferable(cx, tVal),
         transferableObjects(cx, TransferableObjectsList(cx)),
         cloneDataPolicy(cloneDataPolicy) {
@@ -613,6 +630,7 @@ struct JSStructuredCloneWriter {
   bool writeTransferMap();
 
   bool writeString(uint32_t tag, JSString* str);
+  bool writeInternedString(JSString* str);
   bool writeBigInt(uint32_t tag, BigInt* bi);
   bool writeArrayBuffer(HandleObject obj);
   bool writeTypedArray(HandleObject obj);
@@ -671,6 +689,22 @@ struct JSStructuredCloneWriter {
                                 StableCellHasher<JSObject*>, SystemAllocPolicy>;
   Rooted<CloneMemory> memory;
 
+  // Strings written with SCTAG_INTERNED_STRING, and their index, see
+  // writeInternedString. The strings are hashed by their contents, so moving
+  // them during a GC doesn't invalidate the table.
+  struct StringContentsHasher {
+    using Lookup = JSLinearString*;
+    static HashNumber hash(const Lookup& lookup) {
+      return HashStringChars(lookup);
+    }
+    static bool match(const JSString* key, const Lookup& lookup) {
+      return EqualStrings(&key->asLinear(), lookup);
+    }
+  };
+  using InternedStrings = GCHashMap<JSString*, uint32_t, StringContentsHasher,
+                                    SystemAllocPolicy>;
+  Rooted<InternedStrings> internedStrings;
+
   // Set of transferable objects
   RootedValue transferable;
   using TransferableObjectsList = GCVector<JSObject*>;
@@ -1294,12 +1328,35 @@ bool JSStructuredCloneWriter::writeString(uint32_t tag, JSString* str) {
   static_assert(JSString::MAX_LENGTH < (1 << 30),
                 "String length must fit in 30 bits");
 
-  // Try to share the underlying StringBuffer without copying the contents.
-  bool useBuffer = linear->hasStringBuffer() &&
-                   output().scope() == JS::StructuredCloneScope::SameProcess;
-
   uint32_t length = linear->length();
   bool isLatin1 = linear->hasLatin1Chars();
+
+  // Try to share the underlying StringBuffer without copying the contents. For
+  // large strings that don't have one yet, copy the characters into a new
+  // StringBuffer once so that the reader can adopt it instead of copying the
+  // characters out of the clone buffer again.
+  RefPtr<mozilla::StringBuffer> buffer;
+  if (output().scope() == JS::StructuredCloneScope::SameProcess) {
+    if (linear->hasStringBuffer()) {
+      buffer = linear->stringBuffer();
+    } else {
+      size_t nbytes = length * (isLatin1 ? sizeof(Latin1Char)
+                                         : sizeof(char16_t));
+      if (nbytes >= JSString::MIN_BYTES_FOR_BUFFER) {
+        JS::AutoCheckCannotGC nogc;
+        buffer = isLatin1 ? mozilla::StringBuffer::Create(
+                                linear->latin1Chars(nogc), length)
+                          : mozilla::StringBuffer::Create(
+                                linear->twoByteChars(nogc), length);
+        if (!buffer) {
+          ReportOutOfMemory(context());
+          return false;
+        }
+      }
+    }
+  }
+  bool useBuffer = !!buffer;
+
   uint32_t lengthAndBits =
       length | (uint32_t(isLatin1) << 31) | (uint32_t(useBuffer) << 30);
   if (!out.writePair(tag, lengthAndBits)) {
@@ -1307,12 +1364,11 @@ bool JSStructuredCloneWriter::writeString(uint32_t tag, JSString* str) {
   }
 
   if (useBuffer) {
-    mozilla::StringBuffer* buffer = linear->stringBuffer();
-    if (!out.buf.stringBufferRefsHeld_.emplaceBack(buffer)) {
+    uintptr_t p = reinterpret_cast<uintptr_t>(buffer.get());
+    if (!out.buf.stringBufferRefsHeld_.emplaceBack(std::move(buffer))) {
       ReportOutOfMemory(context());
       return false;
     }
-    uintptr_t p = reinterpret_cast<uintptr_t>(buffer);
     return out.writeBytes(&p, sizeof(p));
   }
 
@@ -1322,6 +1378,34 @@ bool JSStructuredCloneWriter::writeString(uint32_t tag, JSString* str) {
              : out.writeChars(linear->twoByteChars(nogc), length);
 }
 
+// Strings which appear more than once, such as the keys of objects with the
+// same shape, are written in full the first time and as a reference to that
+// first occurrence afterwards. Long strings are unlikely to repeat and would be
+// expensive to hash, so they are always written in full.
+bool JSStructuredCloneWriter::writeInternedString(JSString* str) {
+  static constexpr size_t MaxInternedLength = 256;
+  if (str->length() > MaxInternedLength || js::SupportDifferentialTesting()) {
+    return writeString(SCTAG_STRING, str);
+  }
+
+  JSLinearString* linear = str->ensureLinear(context());
+  if (!linear) {
+    return false;
+  }
+
+  InternedStrings::AddPtr p = internedStrings.lookupForAdd(linear);
+  if (p) {
+    return out.writePair(SCTAG_STRING_REFERENCE, p->value());
+  }
+
+  uint32_t index = internedStrings.count();
+  if (!internedStrings.add(p, linear, index)) {
+    ReportOutOfMemory(context());
+    return false;
+  }
+  return writeString(SCTAG_INTERNED_STRING, linear);
+}
+
 bool JSStructuredCloneWriter::writeBigInt(uint32_t tag, BigInt* bi) {
   bool signBit = bi->isNegative();
   size_t length = bi->digitLength();
@@ -2063,7 +2147,7 @@ bool JSStructuredCloneWriter::writePrimitive(HandleValue v) {
   context()->check(v);
 
   if (v.isString()) {
-    return writeString(SCTAG_STRING, v.toString());
+    return writeInternedString(v.toString());
   } else if (v.isInt32()) {
     if (js::SupportDifferentialTesting()) {
       return out.writeDouble(v.toInt32());
@@ -2529,6 +2613,7 @@ JSStructuredCloneReader::JSStructuredCloneReader(
       objs(in.context()),
       objState(in.context(), in.context()),
       allObjs(in.context()),
+      internedStrings(in.context()),
       numItemsRead(0),
       callbacks(cb),
       closure(cbClosure),
@@ -2831,14 +2916,25 @@ bool JSStructuredCloneReader::readArrayBuffer(StructuredDataType type,
     return false;
   }
 
-  JSObject* obj;
   if (type != SCTAG_RESIZABLE_ARRAY_BUFFER_OBJECT) {
     MOZ_ASSERT(maxbytes == 0);
-    obj = ArrayBufferObject::createZeroed(context(), size_t(nbytes));
-  } else {
-    obj = ResizableArrayBufferObject::createZeroed(context(), size_t(nbytes),
-                                                   size_t(maxbytes));
+
+    // The contents are overwritten immediately, so don't zero them first.
+    AutoSetNewObjectMetadata metadata(context());
+    auto [buffer, toFill] = ArrayBufferObject::createUninitialized(
+        context(), size_t(nbytes), metadata);
+    if (!buffer) {
+      return false;
+    }
+    if (!in.readArray(toFill, nbytes)) {
+      return false;
+    }
+    vp.setObject(*buffer);
+    return true;
   }
+
+  JSObject* obj = ResizableArrayBufferObject::createZeroed(
+      context(), size_t(nbytes), size_t(maxbytes));
   if (!obj) {
     return false;
   }
@@ -3102,6 +3198,38 @@ bool JSStructuredCloneReader::startRead(MutableHandleValue vp,
       break;
     }
 
+    case SCTAG_INTERNED_STRING: {
+      JSString* str = readString(data, atomizeStrings);
+      if (!str) {
+        return false;
+      }
+      if (!internedStrings.append(str)) {
+        ReportOutOfMemory(context());
+        return false;
+      }
+      vp.setString(str);
+      break;
+    }
+
+    case SCTAG_STRING_REFERENCE: {
+      if (data >= internedStrings.length()) {
+        JS_ReportErrorNumberASCII(context(), GetErrorMessage, nullptr,
+                                  JSMSG_SC_BAD_SERIALIZED_DATA,
+                                  "invalid string reference");
+        return false;
+      }
+      JSString* str = internedStrings[data];
+      if (atomizeStrings && !str->isAtom()) {
+        str = AtomizeString(context(), str);
+        if (!str) {
+          return false;
+        }
+        internedStrings[data] = str;
+      }
+      vp.setString(str);
+      break;
+    }
+
     case SCTAG_NUMBER_OBJECT: {
       double d;
       if (!in.readDouble(&d)) {
@@ -393,6 +393,8 @@ class TypedArrayObjectTemplate {
   static constexpr auto ByteLengthLimit = TypedArrayObject::ByteLengthLimit;
   static constexpr auto INLINE_BUFFER_LIMIT =
       FixedLengthTypedArrayObject::INLINE_BUFFER_LIMIT;
+  static constexpr auto LAZY_BUFFER_LIMIT =
+      FixedLengthTypedArrayObject::LAZY_BUFFER_LIMIT;
 
  public:
   static constexpr Scalar::Type ArrayTypeID() {
@@ -780,8 +782,9 @@ class TypedArrayObjectTemplate {
     static_assert(INLINE_BUFFER_LIMIT % BYTES_PER_ELEMENT == 0,
                   "ArrayBuffer inline storage shouldn't waste any space");
 
-    if (byteLength <= INLINE_BUFFER_LIMIT) {
-      // The array's data can be inline, and the buffer created lazily.
+    if (byteLength <= LAZY_BUFFER_LIMIT) {
+      // The array's data can be inline or in a nursery buffer, and the buffer
+      // created lazily.
       return true;
     }
 
@@ -880,9 +883,13 @@ class FixedLengthTypedArrayObjectTemplate
       gc::Heap heap = gc::Heap::Default) {
     MOZ_ASSERT(len <= ByteLengthLimit / BYTES_PER_ELEMENT);
 
-    gc::AllocKind allocKind =
-        buffer ? gc::GetGCObjectKind(instanceClass())
-               : AllocKindForLazyBuffer(len * BYTES_PER_ELEMENT);
+    size_t nbytes = len * BYTES_PER_ELEMENT;
+    bool fitsInline = nbytes <= INLINE_BUFFER_LIMIT;
+    MOZ_ASSERT_IF(!buffer, nbytes <= LAZY_BUFFER_LIMIT);
+
+    gc::AllocKind allocKind = buffer || !fitsInline
+                                  ? gc::GetGCObjectKind(instanceClass())
+                                  : AllocKindForLazyBuffer(nbytes);
 
     AutoSetNewObjectMetadata metadata(cx);
     FixedLengthTypedArrayObject* obj;
@@ -891,7 +898,19 @@ class FixedLengthTypedArrayObjectTemplate
     } else {
       obj = newBuiltinClassInstance(cx, allocKind, heap);
     }
-    if (!obj || !obj->init(cx, buffer, byteOffset, len, BYTES_PER_ELEMENT)) {
+    if (!obj) {
+      return nullptr;
+    }
+
+    if (!buffer && !fitsInline) {
+      MOZ_ASSERT(byteOffset == 0);
+      if (!initLazyBuffer(cx, obj, len, allocKind)) {
+        return nullptr;
+      }
+      return obj;
+    }
+
+    if (!obj->init(cx, buffer, byteOffset, len, BYTES_PER_ELEMENT)) {
       return nullptr;
     }
 
@@ -984,10 +1003,22 @@ class FixedLengthTypedArrayObjectTemplate
       return nullptr;
     }
 
-    initTypedArraySlots(obj, len);
+    if (!initLazyBuffer(cx, obj, len, allocKind)) {
+      return nullptr;
+    }
+
+    return obj;
+  }
 
+  // Initialize a typed array that doesn't have an array buffer object yet.
+  // Its data is stored inline if it fits and otherwise in a nursery buffer.
+  static bool initLazyBuffer(JSContext* cx, FixedLengthTypedArrayObject* obj,
+                             size_t len, gc::AllocKind allocKind) {
+    initTypedArraySlots(obj, int32_t(len));
+
+    size_t nbytes = len * BYTES_PER_ELEMENT;
     void* buf = nullptr;
-    if (!fitsInline) {
+    if (nbytes > INLINE_BUFFER_LIMIT) {
       MOZ_ASSERT(len > 0);
 
       nbytes = RoundUp(nbytes, sizeof(Value));
@@ -995,13 +1026,12 @@ class FixedLengthTypedArrayObjectTemplate
                                                js::ArrayBufferContentsArena);
       if (!buf) {
         ReportOutOfMemory(cx);
-        return nullptr;
+        return false;
       }
     }
 
     initTypedArrayData(obj, buf, nbytes, allocKind);
-
-    return obj;
+    return true;
   }
 };
 
@@ -1869,6 +1899,36 @@ static bool TypedArray_set(JSContext* cx, unsigned argc, Value* vp) {
   return CallNonGenericMethod<IsTypedArrayObject, TypedArray_set>(cx, args);
 }
 
+void js::TypedArraySetSameTypeFromJit(TypedArrayObject* target,
+                                      TypedArrayObject* source,
+                                      intptr_t offset) {
+  AutoUnsafeCallWithABI unsafe;
+
+  // The JIT guards both typed arrays have the same class and that the source
+  // fits into the target at |offset|.
+  MOZ_ASSERT(target->getClass() == source->getClass());
+  MOZ_ASSERT(!target->hasDetachedBuffer());
+  MOZ_ASSERT(!source->hasDetachedBuffer());
+  MOZ_ASSERT(offset >= 0);
+
+  size_t targetLength = target->length().valueOr(0);
+  size_t sourceLength = source->length().valueOr(0);
+  MOZ_ASSERT(sourceLength <= targetLength - size_t(offset));
+
+  // Same element type, so this is a plain byte copy. The buffers may overlap.
+  size_t elementSize = source->bytesPerElement();
+  size_t nbytes = sourceLength * elementSize;
+  SharedMem<uint8_t*> dest = target->dataPointerEither().cast<uint8_t*>() +
+                             size_t(offset) * elementSize;
+  SharedMem<uint8_t*> src = source->dataPointerEither().cast<uint8_t*>();
+
+  if (target->isSharedMemory() || source->isSharedMemory()) {
+    jit::AtomicOperations::memmoveSafeWhenRacy(dest, src, nbytes);
+  } else {
+    memmove(dest.unwrapUnshared(), src.unwrapUnshared(), nbytes);
+  }
+}
+
 /**
  * Convert |value| to an integer and clamp it to a valid integer index within
  * the range `[0..length]`.
@@ -4363,7 +4423,7 @@ static bool uint8array_toHex(JSContext* cx, unsigned argc, Value* vp) {
 
 /* static */ const JSFunctionSpec TypedArrayObject::protoFunctions[] = {
     JS_SELF_HOSTED_FN("subarray", "TypedArraySubarray", 2, 0),
-    JS_FN("set", TypedArray_set, 1, 0),
+    JS_INLINABLE_FN("set", TypedArray_set, 1, 0, TypedArraySet),
     JS_FN("copyWithin", TypedArray_copyWithin, 2, 0),
     JS_SELF_HOSTED_FN("every", "TypedArrayEvery", 1, 0),
     JS_FN("fill", TypedArray_fill, 1, 0),
@@ -5336,6 +5396,13 @@ static void SortByColumn(SharedMem<U*> data, size_t length, SharedMem<U*> aux,
     counts[b + 1]++;
   }
 
+  // Skip the distribution pass when all values have the same byte in this
+  // column. This is common for the high bytes of 64-bit values.
+  if (std::find(std::begin(counts), std::end(counts), length) !=
+      std::end(counts)) {
+    return;
+  }
+
   // Transform counts to indices.
   std::partial_sum(std::begin(counts), std::end(counts), std::begin(counts));
 
@@ -5356,8 +5423,10 @@ static void SortByColumn(SharedMem<U*> data, size_t length, SharedMem<U*> aux,
 template <typename T, typename Ops>
 static bool TypedArrayRadixSort(JSContext* cx, TypedArrayObject* typedArray,
                                 size_t length) {
-  // Determined by performance testing.
-  constexpr size_t StdSortMinCutoff = sizeof(T) == 2 ? 64 : 256;
+  // Determined by performance testing. Eight byte values need twice as many
+  // passes as four byte values, so use a higher cutoff for them.
+  constexpr size_t StdSortMinCutoff =
+      sizeof(T) == 2 ? 64 : sizeof(T) == 4 ? 256 : 1024;
 
   // Radix sort uses O(n) additional space, limit this space to 64 MB.
   constexpr size_t StdSortMaxCutoff = (64 * 1024 * 1024) / sizeof(T);
@@ -5433,18 +5502,12 @@ TypedArraySort() {
 }
 
 template <typename T, typename Ops>
-static constexpr typename std::enable_if_t<sizeof(T) == 2 || sizeof(T) == 4,
-                                           TypedArraySortFn>
+static constexpr typename std::enable_if_t<
+    sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8, TypedArraySortFn>
 TypedArraySort() {
   return TypedArrayRadixSort<T, Ops>;
 }
 
-template <typename T, typename Ops>
-static constexpr typename std::enable_if_t<sizeof(T) == 8, TypedArraySortFn>
-TypedArraySort() {
-  return TypedArrayStdSort<T, Ops>;
-}
-
 static bool TypedArraySortWithoutComparator(JSContext* cx,
                                             TypedArrayObject* typedArray,
                                             size_t len) {
@@ -154,6 +154,11 @@ class FixedLengthTypedArrayObject : public TypedArrayObject {
   static constexpr uint32_t INLINE_BUFFER_LIMIT =
       (NativeObject::MAX_FIXED_SLOTS - FIXED_DATA_START) * sizeof(Value);
 
+  // Typed arrays created with up to this many bytes of data also create their
+  // array buffer object lazily. Data that doesn't fit inline is stored in a
+  // nursery buffer which is moved or freed with the typed array.
+  static constexpr uint32_t LAZY_BUFFER_LIMIT = 4096;
+
   inline gc::AllocKind allocKindForTenure() const;
   static inline gc::AllocKind AllocKindForLazyBuffer(size_t nbytes);
 
@@ -338,6 +343,13 @@ static inline constexpr unsigned TypedArrayElemSize(Scalar::Type viewType) {
 extern ArraySortResult TypedArraySortFromJit(
     JSContext* cx, jit::TrampolineNativeFrameLayout* frame);
 
+// Copy all elements of |source| into |target| starting at |offset|. Called
+// from JIT code for |TypedArray.prototype.set| when both typed arrays have the
+// same class and the source fits into the target.
+extern void TypedArraySetSameTypeFromJit(TypedArrayObject* target,
+                                         TypedArrayObject* source,
+                                         intptr_t offset);
+
 }  // namespace js
 
 template <>
@@ -310,11 +310,33 @@ static void MaybePopArrayIteratorPrototypeNextFuse(JSContext* cx,
       cx, obj->realm()->realmFuses);
 }
 
+static void MaybePopCollectionPrototypeFuses(JSContext* cx, NativeObject* obj,
+                                             jsid id) {
+  GlobalObject& global = obj->global();
+  if (obj == global.maybeGetPrototype(JSProto_Map)) {
+    if (id == NameToId(cx->names().get) || id == NameToId(cx->names().set) ||
+        id == NameToId(cx->names().has)) {
+      obj->realm()->realmFuses.mapPrototypeMethodsFuse.popFuse(
+          cx, obj->realm()->realmFuses);
+    }
+    return;
+  }
+
+  if (obj == global.maybeGetPrototype(JSProto_Set)) {
+    if (id == NameToId(cx->names().add) || id == NameToId(cx->names().has)) {
+      obj->realm()->realmFuses.setPrototypeMethodsFuse.popFuse(
+          cx, obj->realm()->realmFuses);
+    }
+  }
+}
+
 static void MaybePopFuses(JSContext* cx, NativeObject* obj, jsid id) {
   // Handle a write to Array.prototype[@@iterator]
   MaybePopArrayIteratorFuse(cx, obj, id);
   // Handle a write to Array.prototype[@@iterator].next
   MaybePopArrayIteratorPrototypeNextFuse(cx, obj, id);
+  // Handle a write to a Map.prototype or Set.prototype method
+  MaybePopCollectionPrototypeFuses(cx, obj, id);
 }
 
 // static
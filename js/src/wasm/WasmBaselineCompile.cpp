@@ -1217,6 +1217,13 @@ void BaseCompiler::popStackReturnValues(const ResultType& resultType) {
 //  - pick a register at the back of the register set
 //  - pick a random register per block (different blocks have
 //    different join regs)
+//
+// Keeping more than one block result in registers would need a block result
+// convention separate from ABIResultIter, since branches to the function body
+// label and the DebugFrame's spilled register results both assume the call
+// ABI (MaxRegisterResults == 1).  Block entry already syncs the value stack,
+// so what remains at a join is one push per extra result, and those pushes
+// usually land in place so that popStackResults has nothing to shuffle.
 
 void BaseCompiler::popRegisterResults(ABIResultIter& iter) {
   // Pop register results.  Note that in the single-value case, popping to a
@@ -142,7 +142,7 @@ constexpr SymbolicAddressSignature SASigArrayRefsMove = {
     _VOID,
     _Infallible,
     5,
-    {_WAD, _I32, _WAD, _I32, _I32, _END}};
+    {_RoN, _I32, _WAD, _I32, _I32, _END}};
 constexpr SymbolicAddressSignature SASigMemoryGrowM32 = {
     SymbolicAddress::MemoryGrowM32,
     _I32,
@@ -748,20 +748,9 @@ static void WasmHandleRequestTierUp(Instance* instance) {
   // for compilation.
   instance->submitCallRefHints(funcIndex);
 
-  if (JS::Prefs::wasm_lazy_tiering_synchronous()) {
-    UniqueChars error;
-    UniqueCharsVector warnings;
-    mozilla::Atomic<bool> cancelled(false);
-    bool ok = CompilePartialTier2(*codeBlock->code, funcIndex, &error,
-                                  &warnings, &cancelled);
-    ReportTier2ResultsOffThread(ok, mozilla::Some(funcIndex),
-                                codeBlock->code->codeMeta().scriptedCaller(),
-                                error, warnings);
-    return;
-  }
-
   // Try to Ion-compile it.  Note that `ok == true` signifies either
-  // "duplicate request" or "not a duplicate, and compilation succeeded".
+  // "duplicate request" or "not a duplicate, and compilation succeeded" (or,
+  // when tiering synchronously, "compilation was attempted").
   bool ok = codeBlock->code->requestTierUp(funcIndex);
 
   // If compilation failed, there's no feasible way to recover. We use the
@@ -922,6 +911,11 @@ static void* WasmHandleThrow(jit::ResumeFromException* rfe) {
 static void* CheckInterrupt(JSContext* cx, JitActivation* activation) {
   ResetInterruptState(cx);
 
+  if (cx->wasm().funcSampling) {
+    activation->wasmExitInstance()->recordFuncSample(
+        activation->wasmTrapData().unwoundPC);
+  }
+
   if (!CheckForInterrupt(cx)) {
     return nullptr;
   }
@@ -1254,18 +1248,11 @@ static void WasmArrayMemMove(uint8_t* destArrayData, uint32_t destIndex,
           size_t(elementSize) * count);
 }
 
-static void WasmArrayRefsMove(GCPtr<AnyRef>* destArrayData, uint32_t destIndex,
+static void WasmArrayRefsMove(WasmArrayObject* destArray, uint32_t destIndex,
                               AnyRef* srcArrayData, uint32_t srcIndex,
                               uint32_t count) {
   AutoUnsafeCallWithABI unsafe;
-  GCPtr<AnyRef>* dstBegin = destArrayData + destIndex;
-  AnyRef* srcBegin = srcArrayData + srcIndex;
-  // The std::copy performs GCPtr::set() operation under the hood.
-  if (uintptr_t(dstBegin) < uintptr_t(srcBegin)) {
-    std::copy(srcBegin, srcBegin + count, dstBegin);
-  } else {
-    std::copy_backward(srcBegin, srcBegin + count, dstBegin + count);
-  }
+  destArray->moveRefElements(destIndex, srcArrayData + srcIndex, count);
 }
 
 template <class F>
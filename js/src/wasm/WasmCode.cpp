@@ -32,17 +32,23 @@
 #include "jit/FlushICache.h"  // for FlushExecutionContextForAllThreads
 #include "jit/MacroAssembler.h"
 #include "jit/PerfSpewer.h"
+#include "js/Prefs.h"
 #include "util/Poison.h"
 #include "vm/HelperThreadState.h"  // PartialTier2CompileTask
 #ifdef MOZ_VTUNE
 #  include "vtune/VTuneWrapper.h"
 #endif
+#include "wasm/WasmGcObject.h"
+#include "wasm/WasmHeuristics.h"
+#include "wasm/WasmInstanceData.h"
 #include "wasm/WasmModule.h"
 #include "wasm/WasmProcess.h"
 #include "wasm/WasmSerialize.h"
 #include "wasm/WasmStubs.h"
 #include "wasm/WasmUtility.h"
 
+#include "gc/ObjectKind-inl.h"
+
 using namespace js;
 using namespace js::jit;
 using namespace js::wasm;
@@ -736,12 +742,26 @@ bool Code::requestTierUp(uint32_t funcIndex) const {
   // Note: this runs on the requesting (wasm-running) thread, not on a
   // compilation-helper thread.
   MOZ_ASSERT(mode_ == CompileMode::LazyTiering);
+  //
+  // The request is shared by every instance of this code, including instances
+  // on other threads, so only the first of them compiles the function.
   FuncState& state = funcStates_[funcIndex - codeMeta_->numFuncImports];
   if (!state.tierUpState.compareExchange(TierUpState::NotRequested,
                                          TierUpState::Requested)) {
     return true;
   }
 
+  if (JS::Prefs::wasm_lazy_tiering_synchronous()) {
+    UniqueChars error;
+    UniqueCharsVector warnings;
+    Atomic<bool> cancelled(false);
+    bool ok = CompilePartialTier2(*this, funcIndex, &error, &warnings,
+                                  &cancelled);
+    ReportTier2ResultsOffThread(ok, mozilla::Some(funcIndex),
+                                codeMeta_->scriptedCaller(), error, warnings);
+    return true;
+  }
+
   auto task =
       js::MakeUnique<Module::PartialTier2CompileTaskImpl>(*this, funcIndex);
   if (!task) {
@@ -1027,6 +1047,12 @@ void CodeBlock::sendToProfiler(
     }
     uintptr_t start = uintptr_t(segment->base() + codeRange.begin());
     uintptr_t size = codeRange.end() - codeRange.begin();
+#ifdef MOZ_VTUNE
+    if (vtune::IsProfilingActive()) {
+      vtune::MarkWasm(vtune::GenerateUniqueMethodID(), desc.get(), (void*)start,
+                      size);
+    }
+#endif
     funcIonSpewer.spewer.saveWasmProfile(start, size, desc);
   }
 
@@ -1040,6 +1066,12 @@ void CodeBlock::sendToProfiler(
     }
     uintptr_t start = uintptr_t(segment->base() + codeRange.begin());
     uintptr_t size = codeRange.end() - codeRange.begin();
+#ifdef MOZ_VTUNE
+    if (vtune::IsProfilingActive()) {
+      vtune::MarkWasm(vtune::GenerateUniqueMethodID(), desc.get(), (void*)start,
+                      size);
+    }
+#endif
     funcBaselineSpewer.spewer.saveProfile(start, size, desc);
   }
 
@@ -1050,7 +1082,7 @@ void CodeBlock::sendToProfiler(
     }
 
     // Skip functions when they have corresponding spewers, as they will have
-    // already handled the function.
+    // already been reported to both perf and VTune above.
     if (codeRange.isFunction() && hasSpewers) {
       continue;
     }
@@ -1129,11 +1161,21 @@ const StackMap* CodeBlock::lookupStackMap(uint8_t* pc) const {
 const wasm::TryNote* CodeBlock::lookupTryNote(const void* pc) const {
   size_t target = (uint8_t*)pc - segment->base();
 
-  // We find the first hit (there may be multiple) to obtain the innermost
-  // handler, which is why we cannot binary search here.
-  for (const auto& tryNote : tryNotes) {
-    if (tryNote.offsetWithinTryBody(target)) {
-      return &tryNote;
+  // Try notes are sorted by end offset, so every note before the first one
+  // ending at or after `target` cannot contain it. From there we still need
+  // the first hit (there may be multiple) to obtain the innermost handler, but
+  // only notes nested inside it or that start after `target` can be skipped
+  // on the way.
+  const TryNote* begin = tryNotes.begin();
+  const TryNote* end = tryNotes.end();
+  const TryNote* first =
+      std::lower_bound(begin, end, target,
+                       [](const TryNote& tryNote, size_t target) {
+                         return tryNote.tryBodyEnd() < target;
+                       });
+  for (const TryNote* tryNote = first; tryNote != end; tryNote++) {
+    if (tryNote->offsetWithinTryBody(target)) {
+      return tryNote;
     }
   }
 
@@ -1262,7 +1304,8 @@ Code::Code(CompileMode mode, const CodeMetadata& codeMeta,
       trapCode_(nullptr),
       debugStubOffset_(0),
       requestTierUpStubOffset_(0),
-      updateCallRefMetricsStubOffset_(0) {}
+      updateCallRefMetricsStubOffset_(0),
+      initialHotnessLevel_(0) {}
 
 bool Code::initialize(FuncImportVector&& funcImports,
                       UniqueCodeBlock sharedStubs,
@@ -1298,6 +1341,75 @@ bool Code::initialize(FuncImportVector&& funcImports,
     }
   }
 
+  return initInstanceDataTemplates();
+}
+
+bool Code::initInstanceDataTemplates() {
+  const TypeContext& types = *codeMeta_->types;
+  if (!typeDefsInstanceData_.resize(types.length() *
+                                    sizeof(TypeDefInstanceData))) {
+    return false;
+  }
+  for (uint32_t typeIndex = 0; typeIndex < types.length(); typeIndex++) {
+    const TypeDef& typeDef = types.type(typeIndex);
+    TypeDefInstanceData* typeDefData = new (
+        typeDefsInstanceData_.begin() + typeIndex * sizeof(TypeDefInstanceData))
+        TypeDefInstanceData();
+
+    // Store the runtime type for this type index
+    typeDefData->typeDef = &typeDef;
+    typeDefData->superTypeVector = typeDef.superTypeVector();
+
+    if (typeDef.kind() == TypeDefKind::Struct) {
+      // Compute the parameters that allocation will use.
+      const JSClass* clasp = WasmStructObject::classForTypeDef(&typeDef);
+      gc::AllocKind allocKind = WasmStructObject::allocKindForTypeDef(&typeDef);
+
+      // Move the alloc kind to background if possible
+      if (CanChangeToBackgroundAllocKind(allocKind, clasp)) {
+        allocKind = ForegroundToBackgroundAllocKind(allocKind);
+      }
+      typeDefData->clasp = clasp;
+      typeDefData->allocKind = allocKind;
+
+      // Cache the struct's size so that allocators don't have to chase back
+      // through `typeDef` to determine it.
+      typeDefData->structTypeSize = typeDef.structType().size_;
+      // StructLayout::close ensures this is an integral number of words.
+      MOZ_ASSERT((typeDefData->structTypeSize % sizeof(uintptr_t)) == 0);
+    } else if (typeDef.kind() == TypeDefKind::Array) {
+      typeDefData->clasp = &WasmArrayObject::class_;
+      typeDefData->allocKind = gc::AllocKind::INVALID;
+
+      // Similarly, cache the array's element size.
+      uint32_t arrayElemSize = typeDef.arrayType().elementType().size();
+      typeDefData->arrayElemSize = arrayElemSize;
+      MOZ_ASSERT(arrayElemSize == 16 || arrayElemSize == 8 ||
+                 arrayElemSize == 4 || arrayElemSize == 2 ||
+                 arrayElemSize == 1);
+    } else if (typeDef.kind() == TypeDefKind::Func) {
+      // Nothing to do; the default values are OK.
+    } else {
+      MOZ_ASSERT(typeDef.kind() == TypeDefKind::None);
+      MOZ_CRASH();
+    }
+  }
+
+  if (mode_ == CompileMode::LazyTiering) {
+    uint32_t numFuncDefs = codeMeta_->numFuncs() - codeMeta_->numFuncImports;
+    if (!initialHotnessCounters_.resize(numFuncDefs)) {
+      return false;
+    }
+    initialHotnessLevel_ = LazyTieringHeuristics::rawLevel();
+    for (uint32_t funcDefIndex = 0; funcDefIndex < numFuncDefs;
+         funcDefIndex++) {
+      uint32_t funcIndex = codeMeta_->numFuncImports + funcDefIndex;
+      uint32_t bodyLength = codeMeta_->funcDefRange(funcIndex).size;
+      initialHotnessCounters_[funcDefIndex] =
+          LazyTieringHeuristics::estimateIonCompilationCost(bodyLength);
+    }
+  }
+
   return true;
 }
 
@@ -1034,6 +1034,17 @@ class Code : public ShareableBase<Code> {
   // CodeBlock.
   uint32_t updateCallRefMetricsStubOffset_;
 
+  // Instance data for every type definition, as it is at the start of
+  // Instance::init except for the `shape` and `allocSite` fields, which are
+  // per-realm and are left in their default state. Every new instance copies
+  // this instead of recomputing it.
+  Bytes typeDefsInstanceData_;
+
+  // When lazy tiering, the initial hotness counter of every defined function,
+  // computed for lazy tiering level `initialHotnessLevel_`.
+  Vector<int32_t, 0, SystemAllocPolicy> initialHotnessCounters_;
+  uint32_t initialHotnessLevel_;
+
   // Methods for getting complete tiers, private while we're moving to partial
   // tiering.
   Tiers completeTiers() const;
@@ -1042,6 +1053,8 @@ class Code : public ShareableBase<Code> {
                                   UniqueCodeBlock block,
                                   UniqueLinkData maybeLinkData) const;
 
+  [[nodiscard]] bool initInstanceDataTemplates();
+
   [[nodiscard]] const LazyFuncExport* lookupLazyFuncExport(
       const WriteGuard& guard, uint32_t funcIndex) const;
 
@@ -1090,6 +1103,11 @@ class Code : public ShareableBase<Code> {
       uint32_t* codeLengthOut) const;
 
   bool requestTierUp(uint32_t funcIndex) const;
+  bool tierUpRequested(uint32_t funcIndex) const {
+    MOZ_ASSERT(mode_ == CompileMode::LazyTiering);
+    return funcStates_[funcIndex - codeMeta_->numFuncImports].tierUpState !=
+           TierUpState::NotRequested;
+  }
 
   CompileMode mode() const { return mode_; }
 
@@ -1122,6 +1140,16 @@ class Code : public ShareableBase<Code> {
     updateCallRefMetricsStubOffset_ = offs;
   }
 
+  const Bytes& typeDefsInstanceData() const { return typeDefsInstanceData_; }
+
+  // Returns null if the lazy tiering level has changed since this Code was
+  // created, in which case the counters must be recomputed.
+  const int32_t* initialHotnessCounters(uint32_t level) const {
+    MOZ_ASSERT(mode_ == CompileMode::LazyTiering);
+    return level == initialHotnessLevel_ ? initialHotnessCounters_.begin()
+                                         : nullptr;
+  }
+
   const FuncImport& funcImport(uint32_t funcIndex) const {
     return funcImports_[funcIndex];
   }
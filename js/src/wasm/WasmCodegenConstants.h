@@ -24,7 +24,7 @@
 namespace js {
 namespace wasm {
 
-static const unsigned MaxArgsForJitInlineCall = 8;
+static const unsigned MaxArgsForJitInlineCall = 16;
 static const unsigned MaxResultsForJitEntry = 1;
 static const unsigned MaxResultsForJitExit = 1;
 static const unsigned MaxResultsForJitInlineCall = MaxResultsForJitEntry;
@@ -992,15 +992,22 @@ bool wasm::CompilePartialTier2(const Code& code, uint32_t funcIndex,
 
 class StreamingDecoder {
   Decoder d_;
+  ModuleGenerator& mg_;
   const ExclusiveBytesPtr& codeBytesEnd_;
   const Atomic<bool>& cancelled_;
 
+  bool hasBytes(const uint8_t* requiredEnd) {
+    auto codeBytesEnd = codeBytesEnd_.lock();
+    return codeBytesEnd >= requiredEnd;
+  }
+
  public:
-  StreamingDecoder(const CodeMetadata& codeMeta, const Bytes& begin,
-                   const ExclusiveBytesPtr& codeBytesEnd,
+  StreamingDecoder(const CodeMetadata& codeMeta, ModuleGenerator& mg,
+                   const Bytes& begin, const ExclusiveBytesPtr& codeBytesEnd,
                    const Atomic<bool>& cancelled, UniqueChars* error,
                    UniqueCharsVector* warnings)
       : d_(begin, codeMeta.codeSectionRange->start, error, warnings),
+        mg_(mg),
         codeBytesEnd_(codeBytesEnd),
         cancelled_(cancelled) {}
 
@@ -1013,6 +1020,13 @@ class StreamingDecoder {
   bool waitForBytes(size_t numBytes) {
     numBytes = std::min(numBytes, d_.bytesRemain());
     const uint8_t* requiredEnd = d_.currentPosition() + numBytes;
+
+    // Don't let the function bodies decoded so far sit in a partially filled
+    // batch while we wait for the network.
+    if (!hasBytes(requiredEnd) && !mg_.compileBatchedFuncDefs()) {
+      return false;
+    }
+
     auto codeBytesEnd = codeBytesEnd_.lock();
     while (codeBytesEnd < requiredEnd) {
       if (cancelled_) {
@@ -1106,7 +1120,7 @@ SharedModule wasm::CompileStreaming(
   }
 
   {
-    StreamingDecoder d(codeMeta, codeBytes, codeBytesEnd, cancelled, error,
+    StreamingDecoder d(codeMeta, mg, codeBytes, codeBytesEnd, cancelled, error,
                        warnings);
 
     if (!DecodeCodeSection(codeMeta, d, mg)) {
@@ -986,6 +986,8 @@ enum class BuiltinInlineOp {
   StringCast,
   StringTest,
   StringLength,
+  StringCharCodeAt,
+  StringCodePointAt,
 
   // Op limit.
   Limit
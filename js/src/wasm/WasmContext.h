@@ -20,6 +20,10 @@
 #define wasm_context_h
 
 #include "mozilla/DoublyLinkedList.h"
+#include "mozilla/MemoryReporting.h"
+
+#include "js/AllocPolicy.h"
+#include "js/Vector.h"
 
 namespace js::wasm {
 
@@ -33,6 +37,9 @@ class SuspenderContext {
   HeapPtr<SuspenderObject*> activeSuspender_;
   // Using double-linked list to avoid allocation in the JIT code.
   mozilla::DoublyLinkedList<SuspenderObjectData> suspendedStacks_;
+  // Stack memory released by dead suspenders, kept for reuse by new ones. See
+  // JitOptions.wasmSuspendableStackPoolMax.
+  Vector<void*, 0, SystemAllocPolicy> freeStacks_;
 
  public:
   SuspenderContext();
@@ -42,6 +49,14 @@ class SuspenderContext {
   void trace(JSTracer* trc);
   void traceRoots(JSTracer* trc);
 
+  // Get SuspendableStackPlusRedZoneSize bytes of stack memory, from the pool if
+  // possible. Returns nullptr on OOM.
+  void* allocateStack();
+  void releaseStack(void* stackMemory);
+  // Free pooled stacks until at most |keep| remain.
+  void purgeStacks(size_t keep);
+  size_t sizeOfExcludingThis(mozilla::MallocSizeOf mallocSizeOf) const;
+
   friend class SuspenderObject;
 };
 #endif  // ENABLE_WASM_JSPI
@@ -53,7 +68,8 @@ class Context {
  public:
   Context()
       : triedToInstallSignalHandlers(false),
-        haveSignalHandlers(false)
+        haveSignalHandlers(false),
+        funcSampling(false)
 #ifdef ENABLE_WASM_JSPI
         ,
         suspendableStackLimit(JS::NativeStackLimitMin),
@@ -67,6 +83,10 @@ class Context {
   bool triedToInstallSignalHandlers;
   bool haveSignalHandlers;
 
+  // Whether interrupts handled in wasm code are counted against the
+  // interrupted function, see JS::SetWasmFunctionSampling.
+  bool funcSampling;
+
 #ifdef ENABLE_WASM_JSPI
   JS::NativeStackLimit suspendableStackLimit;
   mozilla::Atomic<uint32_t> suspendableStacksCount;
@@ -284,6 +284,9 @@ class StackMaps {
   [[nodiscard]] bool add(const Maplet& maplet) {
     return add(maplet.nextInsnAddr, maplet.map);
   }
+  [[nodiscard]] bool reserve(size_t length) {
+    return mapping_.reserve(length);
+  }
   void clear() {
     for (auto& maplet : mapping_) {
       maplet.nextInsnAddr = nullptr;
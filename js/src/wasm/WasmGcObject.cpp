@@ -28,6 +28,7 @@
 
 #include "gc/GCContext-inl.h"  // GCContext::removeCellMemory
 #include "gc/ObjectKind-inl.h"
+#include "gc/StoreBuffer-inl.h"
 #include "vm/JSContext-inl.h"
 
 using namespace js;
@@ -449,9 +450,63 @@ void WasmArrayObject::fillVal(const Val& val, uint32_t itemIndex,
   size_t elementSize = arrayType.elementType().size();
   uint8_t* data = data_ + elementSize * itemIndex;
   MOZ_ASSERT(itemIndex <= numElements_ && len <= numElements_ - itemIndex);
-  for (uint32_t i = 0; i < len; i++) {
-    WriteValTo(val, arrayType.elementType(), data);
-    data += elementSize;
+  if (arrayType.elementType().isRefRepr()) {
+    for (uint32_t i = 0; i < len; i++) {
+      WriteValTo(val, arrayType.elementType(), data);
+      data += elementSize;
+    }
+    return;
+  }
+  if (len == 0) {
+    return;
+  }
+
+  // Numeric elements have no barriers, so write the first one and then keep
+  // doubling the filled prefix with memcpy.
+  WriteValTo(val, arrayType.elementType(), data);
+  size_t filled = elementSize;
+  size_t total = elementSize * len;
+  while (filled < total) {
+    size_t chunk = std::min(filled, total - filled);
+    memcpy(data + filled, data, chunk);
+    filled += chunk;
+  }
+}
+
+void WasmArrayObject::moveRefElements(uint32_t dstIndex, const AnyRef* src,
+                                      uint32_t count) {
+  MOZ_ASSERT(typeDef().arrayType().elementType().isRefRepr());
+  MOZ_ASSERT(dstIndex <= numElements_ && count <= numElements_ - dstIndex);
+
+  AnyRef* dst = reinterpret_cast<AnyRef*>(data_) + dstIndex;
+  if (count == 0 || dst == src) {
+    return;
+  }
+
+  if (zone()->needsIncrementalBarrier()) {
+    for (uint32_t i = 0; i < count; i++) {
+      InternalBarrierMethods<AnyRef>::preBarrier(dst[i]);
+    }
+  }
+
+  memmove(dst, src, size_t(count) * sizeof(AnyRef));
+
+  // A nursery array is always traced in full by a minor GC. A tenured one
+  // that now holds any nursery pointer goes in the whole cell buffer once,
+  // rather than adding a store buffer edge per element. Edges left over from
+  // earlier per-element stores stay valid: they are traced through the slot
+  // and tolerate tenured values.
+  if (IsInsideNursery(this)) {
+    return;
+  }
+  for (uint32_t i = 0; i < count; i++) {
+    if (!dst[i].isGCThing()) {
+      continue;
+    }
+    if (gc::StoreBuffer* sb = dst[i].toGCThing()->storeBuffer()) {
+      sb->putWholeCell(this);
+      return;
+    }
   }
 }
 
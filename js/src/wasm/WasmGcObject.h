@@ -286,6 +286,12 @@ class WasmArrayObject : public WasmGcObject,
   void storeVal(const wasm::Val& val, uint32_t itemIndex);
   void fillVal(const wasm::Val& val, uint32_t itemIndex, uint32_t len);
 
+  // Copy `count` reference-typed elements from `src`, which may point into
+  // this array's own data, to the elements starting at `dstIndex`. The GC
+  // barriers are done once for the whole range instead of per element.
+  void moveRefElements(uint32_t dstIndex, const wasm::AnyRef* src,
+                       uint32_t count);
+
   static DataHeader* dataHeaderFromDataPointer(const uint8_t* data) {
     MOZ_ASSERT(data);
     return (DataHeader*)data - 1;
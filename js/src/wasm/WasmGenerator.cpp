@@ -35,6 +35,7 @@
 #include "wasm/WasmGC.h"
 #include "wasm/WasmIonCompile.h"
 #include "wasm/WasmStubs.h"
+#include "wasm/WasmValidate.h"
 
 using namespace js;
 using namespace js::jit;
@@ -616,6 +617,131 @@ ThreadType CompileTask::threadType() {
   }
 }
 
+ValidateTask::ValidateTask(const CodeMetadata& codeMeta,
+                           const CompilerEnvironment& compilerEnv,
+                           CompileTaskState& state)
+    : CompileTask(codeMeta, compilerEnv, CompileState::Once, state,
+                  COMPILATION_LIFO_DEFAULT_CHUNK_SIZE) {}
+
+void ValidateTask::runHelperThreadTask(AutoLockHelperThreadState& lock) {
+  bool ok = true;
+
+  {
+    AutoUnlockHelperThreadState unlock(lock);
+    UniqueChars error;
+    for (const FuncCompileInput& input : inputs) {
+      Decoder d(input.begin, input.end, input.lineOrBytecode, &error);
+      if (!ValidateFunctionBody(codeMeta, input.index,
+                                uint32_t(input.end - input.begin), d)) {
+        ok = false;
+        break;
+      }
+    }
+    inputs.clear();
+  }
+
+  // Don't release the lock between updating our state and returning from this
+  // method.
+
+  if (!ok || !state.finished().append(this)) {
+    state.numFailed()++;
+  }
+
+  state.condVar().notify_one(); /* failed or finished */
+}
+
+// Function bodies are validated off thread in batches of about this many
+// bytecode bytes. Validation is much cheaper than compilation, so batches are
+// larger than the compilation batches.
+static constexpr size_t ValidationBatchBytes = 100000;
+
+bool wasm::ValidateFunctionBodiesOffThread(
+    const CodeMetadata& codeMeta, const uint8_t* moduleBegin,
+    const BytecodeRangeVector& funcDefBodies) {
+  if (GetHelperThreadCount() <= 1 || !CanUseExtraThreads() ||
+      GetHelperThreadCPUCount() <= 1) {
+    return false;
+  }
+
+  // Split the bodies into batches first, so that the tasks never move once
+  // they have been submitted.
+  size_t numTasks = 0;
+  size_t batchBytes = 0;
+  for (const BytecodeRange& body : funcDefBodies) {
+    if (numTasks == 0 || batchBytes >= ValidationBatchBytes) {
+      numTasks++;
+      batchBytes = 0;
+    }
+    batchBytes += body.size;
+  }
+  if (numTasks < 2) {
+    return false;
+  }
+
+  CompilerEnvironment compilerEnv(CompileMode::Once, Tier::Baseline,
+                                  DebugEnabled::False);
+  CompileTaskState taskState;
+  Vector<ValidateTask, 0, SystemAllocPolicy> tasks;
+  if (!tasks.initCapacity(numTasks)) {
+    return false;
+  }
+
+  batchBytes = 0;
+  for (uint32_t funcDefIndex = 0; funcDefIndex < funcDefBodies.length();
+       funcDefIndex++) {
+    const BytecodeRange& body = funcDefBodies[funcDefIndex];
+    if (tasks.empty() || batchBytes >= ValidationBatchBytes) {
+      tasks.infallibleEmplaceBack(codeMeta, compilerEnv, taskState);
+      batchBytes = 0;
+    }
+    const uint8_t* begin = moduleBegin + body.start;
+    if (!tasks.back().inputs.emplaceBack(
+            codeMeta.numFuncImports + funcDefIndex, body.start, begin,
+            begin + body.size, Uint32Vector())) {
+      return false;
+    }
+    batchBytes += body.size;
+  }
+  MOZ_ASSERT(tasks.length() == numTasks);
+
+  bool ok = true;
+  size_t outstanding = 0;
+  for (ValidateTask& task : tasks) {
+    if (!StartOffThreadWasmCompile(&task, task.compileState)) {
+      ok = false;
+      break;
+    }
+    outstanding++;
+  }
+
+  AutoLockHelperThreadState lock;
+  while (true) {
+    MOZ_ASSERT(outstanding >= taskState.finished().length());
+    outstanding -= taskState.finished().length();
+    taskState.finished().clear();
+
+    // Once one batch has failed, there is no point in validating the others.
+    if (taskState.numFailed() > 0) {
+      ok = false;
+      MOZ_ASSERT(outstanding >= taskState.numFailed());
+      outstanding -= taskState.numFailed();
+      taskState.numFailed() = 0;
+      size_t removed =
+          RemovePendingWasmCompileTasks(taskState, CompileState::Once, lock);
+      MOZ_ASSERT(outstanding >= removed);
+      outstanding -= removed;
+    }
+
+    if (!outstanding) {
+      break;
+    }
+
+    taskState.condVar().wait(lock); /* failed or finished */
+  }
+
+  return ok;
+}
+
 bool ModuleGenerator::initTasks() {
   // Determine whether parallel or sequential compilation is to be used and
   // initialize the CompileTasks that will be used in either mode.
@@ -693,6 +819,18 @@ bool ModuleGenerator::launchBatchCompile() {
     return locallyCompileCurrentTask();
   }
 
+  // If every other task is still outstanding, the next function would have to
+  // wait for one of them. Compile this batch on the current thread instead so
+  // it contributes to the compilation rather than blocking.
+  if (freeTasks_.empty()) {
+    if (!finishFinishedTasks()) {
+      return false;
+    }
+    if (freeTasks_.empty()) {
+      return locallyCompileCurrentTask();
+    }
+  }
+
   if (!StartOffThreadWasmCompile(currentTask_, compileState_)) {
     return false;
   }
@@ -729,6 +867,30 @@ bool ModuleGenerator::finishOutstandingTask() {
   return finishTask(task);
 }
 
+bool ModuleGenerator::finishFinishedTasks() {
+  MOZ_ASSERT(parallel_);
+
+  CompileTaskPtrVector finished;
+  {
+    AutoLockHelperThreadState lock;
+    if (taskState_.numFailed() > 0) {
+      return false;
+    }
+    finished.swap(taskState_.finished());
+  }
+
+  MOZ_ASSERT(outstanding_ >= finished.length());
+  outstanding_ -= finished.length();
+
+  // Call outside of the compilation lock.
+  for (CompileTask* task : finished) {
+    if (!finishTask(task)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 bool ModuleGenerator::compileFuncDef(uint32_t funcIndex,
                                      uint32_t lineOrBytecode,
                                      const uint8_t* begin, const uint8_t* end,
@@ -787,6 +949,15 @@ bool ModuleGenerator::compileFuncDef(uint32_t funcIndex,
   return true;
 }
 
+bool ModuleGenerator::compileBatchedFuncDefs() {
+  MOZ_ASSERT(!finishedFuncDefs_);
+
+  if (!currentTask_ || currentTask_->inputs.empty()) {
+    return true;
+  }
+  return launchBatchCompile();
+}
+
 bool ModuleGenerator::finishFuncDefs() {
   MOZ_ASSERT(!finishedFuncDefs_);
 
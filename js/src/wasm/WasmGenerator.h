@@ -187,6 +187,29 @@ struct CompileTask : public HelperThreadTask {
   const char* getName() override { return "WasmCompileTask"; }
 };
 
+// A ValidateTask holds a batch of function bodies that are only to be
+// validated on a helper thread. It uses the compile task worklist, and
+// `inputs` holds the bodies; nothing is compiled and `output` stays empty.
+
+struct ValidateTask : public CompileTask {
+  ValidateTask(const CodeMetadata& codeMeta,
+               const CompilerEnvironment& compilerEnv, CompileTaskState& state);
+
+  void runHelperThreadTask(AutoLockHelperThreadState& locked) override;
+
+  const char* getName() override { return "WasmValidateTask"; }
+};
+
+// Validate the function bodies in `funcDefBodies`, whose offsets are relative
+// to `moduleBegin`, in parallel on helper threads. Returns false if any body
+// is invalid, on OOM, or if helper threads can't be used; no error message is
+// produced, so the caller must then validate the bodies serially to report
+// the first error.
+
+[[nodiscard]] bool ValidateFunctionBodiesOffThread(
+    const CodeMetadata& codeMeta, const uint8_t* moduleBegin,
+    const BytecodeRangeVector& funcDefBodies);
+
 // A ModuleGenerator encapsulates the creation of a wasm module. During the
 // lifetime of a ModuleGenerator, a sequence of FunctionGenerators are created
 // and destroyed to compile the individual function bodies. After generating all
@@ -271,6 +294,7 @@ class MOZ_STACK_CLASS ModuleGenerator {
   bool finishTask(CompileTask* task);
   bool launchBatchCompile();
   bool finishOutstandingTask();
+  bool finishFinishedTasks();
 
   // Begins the creation of a code block. All code compiled during this time
   // will go into this code block. All previous code blocks must be finished.
@@ -326,6 +350,12 @@ class MOZ_STACK_CLASS ModuleGenerator {
       uint32_t funcIndex, uint32_t lineOrBytecode, const uint8_t* begin,
       const uint8_t* end, Uint32Vector&& callSiteLineNums = Uint32Vector());
 
+  // Start compiling the functions passed to compileFuncDef() so far without
+  // waiting for the batch to fill up. Streaming compilation calls this when it
+  // has to wait for more bytecode.
+
+  [[nodiscard]] bool compileBatchedFuncDefs();
+
   // Must be called after the last compileFuncDef() and before finishModule()
   // or finishTier2().
 
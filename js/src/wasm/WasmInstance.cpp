@@ -930,7 +930,8 @@ static bool AllSegmentsArePassive(const DataSegmentVector& vec) {
 
 bool Instance::initSegments(JSContext* cx,
                             const DataSegmentVector& dataSegments,
-                            const ModuleElemSegmentVector& elemSegments) {
+                            const ModuleElemSegmentVector& elemSegments,
+                            size_t numMemoryImports) {
   MOZ_ASSERT_IF(codeMeta().memories.length() == 0,
                 AllSegmentsArePassive(dataSegments));
 
@@ -963,6 +964,17 @@ bool Instance::initSegments(JSContext* cx,
     }
   }
 
+  // A memory defined by this module is still all zeroes when its segments are
+  // applied, so the zero runs left out of DataSegment::nonZeroRanges can be
+  // skipped as long as no earlier segment wrote to the same bytes. Segments
+  // are usually laid out in ascending order, so it's enough to track the end
+  // of the highest write to each memory.
+  Vector<uint64_t, 1, SystemAllocPolicy> writtenEnds;
+  if (!writtenEnds.appendN(0, codeMeta().memories.length())) {
+    ReportOutOfMemory(cx);
+    return false;
+  }
+
   for (const DataSegment* seg : dataSegments) {
     if (!seg->active()) {
       continue;
@@ -987,7 +999,17 @@ bool Instance::initSegments(JSContext* cx,
                                JSMSG_WASM_OUT_OF_BOUNDS);
       return false;
     }
-    memcpy(memoryBase + uintptr_t(offset), seg->bytes.begin(), count);
+
+    uint64_t& writtenEnd = writtenEnds[seg->memoryIndex];
+    if (seg->memoryIndex >= numMemoryImports && offset >= writtenEnd) {
+      for (const DataSegmentCopyRange& range : seg->nonZeroRanges) {
+        memcpy(memoryBase + uintptr_t(offset) + range.offset,
+               seg->bytes.begin() + range.offset, range.length);
+      }
+    } else {
+      memcpy(memoryBase + uintptr_t(offset), seg->bytes.begin(), count);
+    }
+    writtenEnd = std::max(writtenEnd, offset + count);
   }
 
   return true;
@@ -1569,10 +1591,8 @@ static bool ArrayCopyFromElem(JSContext* cx, Handle<WasmArrayObject*> arrayObj,
     return false;
   }
 
-  GCPtr<AnyRef>* dst = reinterpret_cast<GCPtr<AnyRef>*>(arrayObj->data_);
-  for (uint32_t i = 0; i < numElements; i++) {
-    dst[arrayIndex + i] = seg[segOffset + i];
-  }
+  const AnyRef* src = seg.begin()->unbarrieredAddress();
+  arrayObj->moveRefElements(arrayIndex, src + segOffset, numElements);
 
   return true;
 }
@@ -1857,14 +1877,7 @@ static bool ArrayCopyFromElem(JSContext* cx, Handle<WasmArrayObject*> arrayObj,
     return 0;
   }
 
-  GCPtr<AnyRef>* dst = (GCPtr<AnyRef>*)dstBase;
-  AnyRef* src = (AnyRef*)srcBase;
-  // The std::copy performs GCPtr::set() operation under the hood.
-  if (uintptr_t(dstBase) < uintptr_t(srcBase)) {
-    std::copy(src, src + numElements, dst);
-  } else {
-    std::copy_backward(src, src + numElements, dst + numElements);
-  }
+  dstArrayObj->moveRefElements(dstIndex, (const AnyRef*)srcBase, numElements);
   return 0;
 }
 
@@ -2255,6 +2268,7 @@ Instance::Instance(JSContext* cx, Handle<WasmInstanceObject*> object,
       maybeDebug_(std::move(maybeDebug)),
       debugFilter_(nullptr),
       callRefMetrics_(nullptr),
+      funcSamples_(nullptr),
       maxInitializedGlobalsIndexPlus1_(0) {
   for (size_t i = 0; i < N_BASELINE_SCRATCH_WORDS; i++) {
     baselineScratchWords_[i] = 0;
@@ -2284,6 +2298,23 @@ void Instance::destroy(Instance* instance) {
   js_free(instance->allocatedBase_);
 }
 
+// The unchecked entry recorded on a wasm JSFunction points at whichever tier
+// was current when the function object was created. When that was tier-1 code,
+// every call through it goes via the tier-1 prologue and the tiering jump
+// table, so bind imports to the callee's current best tier instead.
+static void* BestTierUncheckedCallEntry(JSFunction* fun) {
+  const Instance& calleeInstance = fun->wasmInstance();
+  uint32_t funcIndex = fun->wasmFuncIndex();
+  if (funcIndex < calleeInstance.codeMeta().numFuncImports) {
+    return fun->wasmUncheckedCallEntry();
+  }
+
+  const CodeRange* codeRange;
+  uint8_t* codeBase;
+  calleeInstance.code().funcCodeRange(funcIndex, &codeRange, &codeBase);
+  return codeBase + codeRange->funcUncheckedCallEntry();
+}
+
 bool Instance::init(JSContext* cx, const JSObjectVector& funcImports,
                     const ValVector& globalImportValues,
                     Handle<WasmMemoryObjectVector> memories,
@@ -2302,6 +2333,7 @@ bool Instance::init(JSContext* cx, const JSObjectVector& funcImports,
   jumpTable_ = code_->tieringJumpTable();
   debugFilter_ = nullptr;
   callRefMetrics_ = nullptr;
+  funcSamples_ = nullptr;
   addressOfNeedsIncrementalBarrier_ =
       cx->compartment()->zone()->addressOfNeedsIncrementalBarrier();
   addressOfNurseryPosition_ = cx->nursery().addressOfPosition();
@@ -2322,84 +2354,64 @@ bool Instance::init(JSContext* cx, const JSObjectVector& funcImports,
 
   // Initialize the hotness counters, if relevant.
   if (code().mode() == CompileMode::LazyTiering) {
+    uint32_t numFuncDefs = codeMeta().numFuncs() - codeMeta().numFuncImports;
+    if (const int32_t* counters = code().initialHotnessCounters(
+            LazyTieringHeuristics::rawLevel())) {
+      static_assert(sizeof(FuncDefInstanceData) == sizeof(int32_t));
+      if (numFuncDefs > 0) {
+        memcpy(funcDefInstanceData(codeMeta().numFuncImports), counters,
+               numFuncDefs * sizeof(FuncDefInstanceData));
+      }
+    } else {
+      for (uint32_t funcIndex = codeMeta().numFuncImports;
+           funcIndex < codeMeta().numFuncs(); funcIndex++) {
+        funcDefInstanceData(funcIndex)->hotnessCounter =
+            computeInitialHotnessCounter(funcIndex);
+      }
+    }
+
+    // Another instance of this code, possibly on another thread, may already
+    // have requested tier-up of some functions. Don't count calls to them.
     for (uint32_t funcIndex = codeMeta().numFuncImports;
          funcIndex < codeMeta().numFuncs(); funcIndex++) {
-      funcDefInstanceData(funcIndex)->hotnessCounter =
-          computeInitialHotnessCounter(funcIndex);
+      if (code().tierUpRequested(funcIndex)) {
+        resetHotnessCounter(funcIndex);
+      }
     }
   }
 
-  // Initialize type definitions in the instance data.
+  // Initialize type definitions in the instance data. Everything but the
+  // shape and the allocation site is the same for every instance of the code
+  // and is copied from the template the code prepared.
   const SharedTypeContext& types = codeMeta().types;
+  const Bytes& typeDefsTemplate = code().typeDefsInstanceData();
+  MOZ_ASSERT(typeDefsTemplate.length() ==
+             types->length() * sizeof(TypeDefInstanceData));
+  if (!typeDefsTemplate.empty()) {
+    memcpy(typeDefInstanceData(0), typeDefsTemplate.begin(),
+           typeDefsTemplate.length());
+  }
   Zone* zone = realm()->zone();
   for (uint32_t typeIndex = 0; typeIndex < types->length(); typeIndex++) {
     const TypeDef& typeDef = types->type(typeIndex);
+    if (typeDef.kind() != TypeDefKind::Struct &&
+        typeDef.kind() != TypeDefKind::Array) {
+      continue;
+    }
     TypeDefInstanceData* typeDefData = typeDefInstanceData(typeIndex);
-
-    // Set default field values.
-    new (typeDefData) TypeDefInstanceData();
-
-    // Store the runtime type for this type index
-    typeDefData->typeDef = &typeDef;
-    typeDefData->superTypeVector = typeDef.superTypeVector();
-
-    if (typeDef.kind() == TypeDefKind::Struct ||
-        typeDef.kind() == TypeDefKind::Array) {
-      // Compute the parameters that allocation will use.  First, the class
-      // and alloc kind for the type definition.
-      const JSClass* clasp;
-      gc::AllocKind allocKind;
-
-      if (typeDef.kind() == TypeDefKind::Struct) {
-        clasp = WasmStructObject::classForTypeDef(&typeDef);
-        allocKind = WasmStructObject::allocKindForTypeDef(&typeDef);
-
-        // Move the alloc kind to background if possible
-        if (CanChangeToBackgroundAllocKind(allocKind, clasp)) {
-          allocKind = ForegroundToBackgroundAllocKind(allocKind);
-        }
-      } else {
-        clasp = &WasmArrayObject::class_;
-        allocKind = gc::AllocKind::INVALID;
-      }
-
-      // Find the shape using the class and recursion group
-      const ObjectFlags objectFlags = {ObjectFlag::NotExtensible};
-      typeDefData->shape =
-          WasmGCShape::getShape(cx, clasp, cx->realm(), TaggedProto(),
-                                &typeDef.recGroup(), objectFlags);
-      if (!typeDefData->shape) {
-        return false;
-      }
-
-      typeDefData->clasp = clasp;
-      typeDefData->allocKind = allocKind;
-
-      // Initialize the allocation site for pre-tenuring.
-      typeDefData->allocSite.initWasm(zone);
-
-      // If `typeDef` is a struct, cache its size here, so that allocators
-      // don't have to chase back through `typeDef` to determine that.
-      // Similarly, if `typeDef` is an array, cache its array element size
-      // here.
-      MOZ_ASSERT(typeDefData->unused == 0);
-      if (typeDef.kind() == TypeDefKind::Struct) {
-        typeDefData->structTypeSize = typeDef.structType().size_;
-        // StructLayout::close ensures this is an integral number of words.
-        MOZ_ASSERT((typeDefData->structTypeSize % sizeof(uintptr_t)) == 0);
-      } else {
-        uint32_t arrayElemSize = typeDef.arrayType().elementType().size();
-        typeDefData->arrayElemSize = arrayElemSize;
-        MOZ_ASSERT(arrayElemSize == 16 || arrayElemSize == 8 ||
-                   arrayElemSize == 4 || arrayElemSize == 2 ||
-                   arrayElemSize == 1);
-      }
-    } else if (typeDef.kind() == TypeDefKind::Func) {
-      // Nothing to do; the default values are OK.
-    } else {
-      MOZ_ASSERT(typeDef.kind() == TypeDefKind::None);
-      MOZ_CRASH();
+    MOZ_ASSERT(typeDefData->typeDef == &typeDef);
+
+    // Find the shape using the class and recursion group
+    const ObjectFlags objectFlags = {ObjectFlag::NotExtensible};
+    typeDefData->shape =
+        WasmGCShape::getShape(cx, typeDefData->clasp, cx->realm(),
+                              TaggedProto(), &typeDef.recGroup(), objectFlags);
+    if (!typeDefData->shape) {
+      return false;
     }
+
+    // Initialize the allocation site for pre-tenuring.
+    typeDefData->allocSite.initWasm(zone);
   }
 
   // Initialize function imports in the instance data
@@ -2431,7 +2443,7 @@ bool Instance::init(JSContext* cx, const JSObjectVector& funcImports,
       if (!isAsmJS() && !codeMeta().funcImportsAreJS && fun->isWasm()) {
         import.instance = &fun->wasmInstance();
         import.realm = fun->realm();
-        import.code = fun->wasmUncheckedCallEntry();
+        import.code = BestTierUncheckedCallEntry(fun);
       } else if (void* thunk = MaybeGetBuiltinThunk(fun, funcType)) {
         import.instance = this;
         import.realm = fun->realm();
@@ -2667,6 +2679,9 @@ Instance::~Instance() {
   if (callRefMetrics_) {
     js_free(callRefMetrics_);
   }
+  if (funcSamples_) {
+    js_free(funcSamples_);
+  }
 
   // Any pending exceptions should have been consumed.
   MOZ_ASSERT(pendingException_.isNull());
@@ -2720,6 +2735,13 @@ int32_t Instance::readHotnessCounter(uint32_t funcIndex) const {
   return funcDefInstanceData(funcIndex)->hotnessCounter;
 }
 
+void Instance::setHotnessCounter(uint32_t funcIndex, int32_t counter) {
+  // Negative values are only seen while a tier-up request is being made. See
+  // FuncDefInstanceData.
+  MOZ_ASSERT(counter >= 0);
+  funcDefInstanceData(funcIndex)->hotnessCounter = counter;
+}
+
 void Instance::submitCallRefHints(uint32_t funcIndex) {
 #ifdef JS_JITSPEW
   bool headerShown = false;
@@ -2919,6 +2941,24 @@ void Instance::submitCallRefHints(uint32_t funcIndex) {
   }
 }
 
+void Instance::recordFuncSample(void* pc) {
+  const CodeRange* range = code().lookupFuncRange(pc);
+  if (!range) {
+    return;
+  }
+  if (!funcSamples_) {
+    funcSamples_ =
+        (uint32_t*)js_calloc(codeMeta().numFuncs(), sizeof(uint32_t));
+    if (!funcSamples_) {
+      return;
+    }
+  }
+  uint32_t& count = funcSamples_[range->funcIndex()];
+  if (count != UINT32_MAX) {
+    count++;
+  }
+}
+
 bool Instance::debugFilter(uint32_t funcIndex) const {
   return (debugFilter_[funcIndex / 32] >> funcIndex % 32) & 1;
 }
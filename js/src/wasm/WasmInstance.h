@@ -201,6 +201,10 @@ class alignas(16) Instance {
   // information.
   CallRefMetrics* callRefMetrics_;
 
+  // Per-funcIndex counts of the interrupts taken while running this instance's
+  // code with function sampling enabled. Allocated on the first sample.
+  uint32_t* funcSamples_;
+
   // The exclusive maximum index of a global that has been initialized so far.
   uint32_t maxInitializedGlobalsIndexPlus1_;
 
@@ -384,9 +388,15 @@ class alignas(16) Instance {
   void setTemporaryStackLimit(JS::NativeStackLimit limit);
   void resetTemporaryStackLimit(JSContext* cx);
 
+  // Attribute an interrupt at `pc` to the function containing it, see
+  // JS::SetWasmFunctionSampling. Samples are dropped on OOM.
+  void recordFuncSample(void* pc);
+  const uint32_t* funcSamples() const { return funcSamples_; }
+
   int32_t computeInitialHotnessCounter(uint32_t funcIndex);
   void resetHotnessCounter(uint32_t funcIndex);
   int32_t readHotnessCounter(uint32_t funcIndex) const;
+  void setHotnessCounter(uint32_t funcIndex, int32_t counter);
   void submitCallRefHints(uint32_t funcIndex);
 
   bool debugFilter(uint32_t funcIndex) const;
@@ -440,7 +450,8 @@ class alignas(16) Instance {
   void onMovingGrowTable(const Table* table);
 
   bool initSegments(JSContext* cx, const DataSegmentVector& dataSegments,
-                    const ModuleElemSegmentVector& elemSegments);
+                    const ModuleElemSegmentVector& elemSegments,
+                    size_t numMemoryImports);
 
   // Called to apply a single ElemSegment at a given offset, assuming
   // that all bounds validation has already been performed.
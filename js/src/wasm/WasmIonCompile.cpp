@@ -1558,10 +1558,9 @@ class FunctionCompiler {
       actualBase = extended;
     }
 
-    auto target = memoryIndex == 0 ? MWasmBoundsCheck::Memory0
-                                   : MWasmBoundsCheck::Unknown;
     auto* ins = MWasmBoundsCheck::New(alloc(), actualBase, boundsCheckLimit,
-                                      trapSiteDesc(), target);
+                                      trapSiteDesc(), MWasmBoundsCheck::Memory,
+                                      memoryIndex);
     curBlock_->add(ins);
     actualBase = ins;
 
@@ -3260,6 +3259,57 @@ class FunctionCompiler {
     return ins;
   }
 
+  // Load a character from a string without calling into the instance when the
+  // string is flat enough for MWasmAnyRefJSStringCharAt. Everything else,
+  // including trapping on a bad cast or index, is left to the builtin, which
+  // is called from a separate block.
+  [[nodiscard]] bool stringCharAt(const BuiltinModuleFunc& builtinModuleFunc,
+                                  const DefVector& params, bool codePoint,
+                                  MDefinition** result) {
+    auto* charAt = MWasmAnyRefJSStringCharAt::New(alloc(), params[0],
+                                                  params[1], codePoint);
+    if (!charAt) {
+      return false;
+    }
+    curBlock_->add(charAt);
+
+    MDefinition* failed =
+        compare(charAt, constantI32(0), JSOp::Lt, MCompare::Compare_Int32);
+    if (!failed) {
+      return false;
+    }
+
+    MBasicBlock* slowBlock;
+    MBasicBlock* fastBlock;
+    if (!newBlock(curBlock_, &slowBlock) || !newBlock(curBlock_, &fastBlock)) {
+      return false;
+    }
+    curBlock_->end(MTest::New(alloc(), failed, slowBlock, fastBlock));
+
+    curBlock_ = fastBlock;
+    curBlock_->push(charAt);
+    MBasicBlock* fastJoinPred = curBlock_;
+
+    curBlock_ = slowBlock;
+    mirGraph().moveBlockToEnd(curBlock_);
+    MDefinition* slowResult;
+    if (!callOutOfLineBuiltinModuleFunc(builtinModuleFunc, params,
+                                        &slowResult)) {
+      return false;
+    }
+    curBlock_->push(slowResult);
+
+    MBasicBlock* join;
+    if (!goToNewBlock(fastJoinPred, &join) ||
+        !goToExistingBlock(curBlock_, join)) {
+      return false;
+    }
+    curBlock_ = join;
+    mirGraph().moveBlockToEnd(curBlock_);
+    *result = curBlock_->pop();
+    return true;
+  }
+
   [[nodiscard]] bool dispatchInlineBuiltinModuleFunc(
       const BuiltinModuleFunc& builtinModuleFunc, const DefVector& params) {
     BuiltinInlineOp inlineOp = builtinModuleFunc.inlineOp();
@@ -3295,6 +3345,17 @@ class FunctionCompiler {
         iter().setResult(length);
         return true;
       }
+      case BuiltinInlineOp::StringCharCodeAt:
+      case BuiltinInlineOp::StringCodePointAt: {
+        MOZ_ASSERT(params.length() == 2);
+        bool codePoint = inlineOp == BuiltinInlineOp::StringCodePointAt;
+        MDefinition* result;
+        if (!stringCharAt(builtinModuleFunc, params, codePoint, &result)) {
+          return false;
+        }
+        iter().setResult(result);
+        return true;
+      }
       case BuiltinInlineOp::None:
       case BuiltinInlineOp::Limit:
         break;
@@ -3302,15 +3363,9 @@ class FunctionCompiler {
     MOZ_CRASH();
   }
 
-  [[nodiscard]] bool callBuiltinModuleFunc(
-      const BuiltinModuleFunc& builtinModuleFunc, const DefVector& params) {
-    MOZ_ASSERT(!inDeadCode());
-
-    BuiltinInlineOp inlineOp = builtinModuleFunc.inlineOp();
-    if (inlineOp != BuiltinInlineOp::None) {
-      return dispatchInlineBuiltinModuleFunc(builtinModuleFunc, params);
-    }
-
+  [[nodiscard]] bool callOutOfLineBuiltinModuleFunc(
+      const BuiltinModuleFunc& builtinModuleFunc, const DefVector& params,
+      MDefinition** result) {
     // It's almost possible to use FunctionCompiler::emitInstanceCallN here.
     // Unfortunately not currently possible though, since ::emitInstanceCallN
     // expects an array of arguments along with a size, and that's not what is
@@ -3337,14 +3392,26 @@ class FunctionCompiler {
     }
 
     bool hasResult = !builtinModuleFunc.funcType()->results().empty();
-    MDefinition* result = nullptr;
-    MDefinition** resultOutParam = hasResult ? &result : nullptr;
-    if (!instanceCall(&callState, callee, readBytecodeOffset(),
-                      resultOutParam)) {
+    *result = nullptr;
+    return instanceCall(&callState, callee, readBytecodeOffset(),
+                        hasResult ? result : nullptr);
+  }
+
+  [[nodiscard]] bool callBuiltinModuleFunc(
+      const BuiltinModuleFunc& builtinModuleFunc, const DefVector& params) {
+    MOZ_ASSERT(!inDeadCode());
+
+    BuiltinInlineOp inlineOp = builtinModuleFunc.inlineOp();
+    if (inlineOp != BuiltinInlineOp::None) {
+      return dispatchInlineBuiltinModuleFunc(builtinModuleFunc, params);
+    }
+
+    MDefinition* result;
+    if (!callOutOfLineBuiltinModuleFunc(builtinModuleFunc, params, &result)) {
       return false;
     }
 
-    if (hasResult) {
+    if (result) {
       iter().setResult(result);
     }
     return true;
@@ -5423,7 +5490,9 @@ class FunctionCompiler {
     if (elemsAreRefTyped) {
       MOZ_RELEASE_ASSERT(elemSize == sizeof(void*));
 
-      if (!builtinCall5(SASigArrayRefsMove, lineOrBytecode, dstData,
+      // The builtin takes the destination array object rather than its data,
+      // so that it can batch the post-write barrier for the whole range.
+      if (!builtinCall5(SASigArrayRefsMove, lineOrBytecode, dstArrayObject,
                         dstArrayIndex, srcData, srcArrayIndex, numElements,
                         nullptr)) {
         return false;
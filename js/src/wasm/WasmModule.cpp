@@ -958,7 +958,8 @@ bool Module::instantiate(JSContext* cx, ImportValues& imports,
   // start function fails).
 
   if (!instance->instance().initSegments(cx, moduleMeta().dataSegments,
-                                         moduleMeta().elemSegments)) {
+                                         moduleMeta().elemSegments,
+                                         imports.memories.length())) {
     return false;
   }
 
@@ -175,9 +175,45 @@ size_t ModuleElemSegment::Expressions::sizeOfExcludingThis(
   return exprBytes.sizeOfExcludingThis(mallocSizeOf);
 }
 
+bool DataSegment::computeNonZeroRanges() {
+  MOZ_ASSERT(nonZeroRanges.empty());
+
+  uint32_t length = bytes.length();
+  uint32_t rangeStart = 0;
+  uint32_t i = 0;
+  while (i < length) {
+    if (bytes[i] != 0) {
+      i++;
+      continue;
+    }
+
+    uint32_t zeroStart = i;
+    while (i < length && bytes[i] == 0) {
+      i++;
+    }
+    if (i - zeroStart < ZeroRunLength) {
+      continue;
+    }
+
+    if (zeroStart > rangeStart &&
+        !nonZeroRanges.append(
+            DataSegmentCopyRange{rangeStart, zeroStart - rangeStart})) {
+      return false;
+    }
+    rangeStart = i;
+  }
+
+  if (length > rangeStart) {
+    return nonZeroRanges.append(
+        DataSegmentCopyRange{rangeStart, length - rangeStart});
+  }
+  return true;
+}
+
 size_t DataSegment::sizeOfExcludingThis(MallocSizeOf mallocSizeOf) const {
   return SizeOfMaybeExcludingThis(offsetIfActive, mallocSizeOf) +
-         bytes.sizeOfExcludingThis(mallocSizeOf);
+         bytes.sizeOfExcludingThis(mallocSizeOf) +
+         nonZeroRanges.sizeOfExcludingThis(mallocSizeOf);
 }
 
 size_t CustomSection::sizeOfExcludingThis(MallocSizeOf mallocSizeOf) const {
@@ -660,11 +660,34 @@ struct DataSegmentRange {
 
 using DataSegmentRangeVector = Vector<DataSegmentRange, 0, SystemAllocPolicy>;
 
+// A range of a DataSegment's bytes that must be written into memory when the
+// segment is applied.
+
+struct DataSegmentCopyRange {
+  uint32_t offset;
+  uint32_t length;
+
+  WASM_CHECK_CACHEABLE_POD(offset, length);
+};
+
+WASM_DECLARE_CACHEABLE_POD(DataSegmentCopyRange);
+
+using DataSegmentCopyRangeVector =
+    Vector<DataSegmentCopyRange, 0, SystemAllocPolicy>;
+
 struct DataSegment : AtomicRefCounted<DataSegment> {
   uint32_t memoryIndex;
   mozilla::Maybe<InitExpr> offsetIfActive;
   Bytes bytes;
 
+  // The ranges of |bytes| left after removing runs of zeroes of at least
+  // ZeroRunLength bytes.  Memories created by the instantiating module start
+  // out zeroed, so only these ranges need to be copied into them, and the
+  // pages under the zero runs are never touched.
+  DataSegmentCopyRangeVector nonZeroRanges;
+
+  static constexpr size_t ZeroRunLength = 4096;
+
   DataSegment() = default;
 
   bool active() const { return !!offsetIfActive; }
@@ -681,9 +704,12 @@ struct DataSegment : AtomicRefCounted<DataSegment> {
       }
     }
     MOZ_ASSERT(bytes.length() == 0);
-    return bytes.append(bytecode.begin() + src.bytecodeOffset, src.length);
+    return bytes.append(bytecode.begin() + src.bytecodeOffset, src.length) &&
+           computeNonZeroRanges();
   }
 
+  [[nodiscard]] bool computeNonZeroRanges();
+
   size_t sizeOfExcludingThis(mozilla::MallocSizeOf mallocSizeOf) const;
 };
 
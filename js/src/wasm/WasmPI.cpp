@@ -22,6 +22,7 @@
 #include "debugger/DebugAPI.h"
 #include "debugger/Debugger.h"
 #include "jit/arm/Simulator-arm.h"
+#include "jit/JitOptions.h"
 #include "jit/JitRuntime.h"
 #include "jit/MIRGenerator.h"
 #include "js/CallAndConstruct.h"
@@ -64,8 +65,8 @@ SuspenderObjectData::SuspenderObjectData(void* stackMemory)
       state_(SuspenderState::Initial),
       suspendedBy_(nullptr) {}
 
-void SuspenderObjectData::releaseStackMemory() {
-  js_free(stackMemory_);
+void SuspenderObjectData::releaseStackMemory(SuspenderContext& scx) {
+  scx.releaseStack(stackMemory_);
   stackMemory_ = nullptr;
 }
 
@@ -137,6 +138,43 @@ SuspenderContext::SuspenderContext()
 SuspenderContext::~SuspenderContext() {
   MOZ_ASSERT(activeSuspender_ == nullptr);
   MOZ_ASSERT(suspendedStacks_.isEmpty());
+  purgeStacks(0);
+}
+
+void* SuspenderContext::allocateStack() {
+  if (!freeStacks_.empty()) {
+    return freeStacks_.popCopy();
+  }
+  return js_malloc(SuspendableStackPlusRedZoneSize);
+}
+
+void SuspenderContext::releaseStack(void* stackMemory) {
+  // Suspenders are often created and dropped at a high rate by code that
+  // suspends on every async call, so keep a few stacks around rather than
+  // returning each one to the allocator.
+  if (freeStacks_.length() < JitOptions.wasmSuspendableStackPoolMax &&
+      freeStacks_.append(stackMemory)) {
+    return;
+  }
+  js_free(stackMemory);
+}
+
+void SuspenderContext::purgeStacks(size_t keep) {
+  while (freeStacks_.length() > keep) {
+    js_free(freeStacks_.popCopy());
+  }
+  if (freeStacks_.empty()) {
+    freeStacks_.clearAndFree();
+  }
+}
+
+size_t SuspenderContext::sizeOfExcludingThis(
+    mozilla::MallocSizeOf mallocSizeOf) const {
+  size_t n = freeStacks_.sizeOfExcludingThis(mallocSizeOf);
+  for (void* stackMemory : freeStacks_) {
+    n += mallocSizeOf(stackMemory);
+  }
+  return n;
 }
 
 SuspenderObject* SuspenderContext::activeSuspender() {
@@ -239,7 +277,8 @@ class SuspenderObject : public NativeObject {
       return nullptr;
     }
 
-    void* stackMemory = js_malloc(SuspendableStackPlusRedZoneSize);
+    SuspenderContext& scx = cx->wasm().promiseIntegration;
+    void* stackMemory = scx.allocateStack();
     if (!stackMemory) {
       DecrementSuspendableStacksCount(cx);
       ReportOutOfMemory(cx);
@@ -248,7 +287,7 @@ class SuspenderObject : public NativeObject {
 
     SuspenderObjectData* data = js_new<SuspenderObjectData>(stackMemory);
     if (!data) {
-      js_free(stackMemory);
+      scx.releaseStack(stackMemory);
       DecrementSuspendableStacksCount(cx);
       ReportOutOfMemory(cx);
       return nullptr;
@@ -350,7 +389,8 @@ void SuspenderObject::finalize(JS::GCContext* gcx, JSObject* obj) {
     MOZ_RELEASE_ASSERT(!data->stackMemory());
   } else {
     // Cleaning stack memory and removing from suspendableStacks_.
-    data->releaseStackMemory();
+    JSContext* cx = gcx->runtime()->mainContextFromOwnThread();
+    data->releaseStackMemory(cx->wasm().promiseIntegration);
     if (SuspenderContext* scx = data->suspendedBy()) {
       scx->suspendedStacks_.remove(data);
     }
@@ -383,7 +423,7 @@ void SuspenderObject::setMoribund(JSContext* cx) {
 #  endif
   SuspenderObjectData* data = this->data();
   data->setState(SuspenderState::Moribund);
-  data->releaseStackMemory();
+  data->releaseStackMemory(cx->wasm().promiseIntegration);
   DecrementSuspendableStacksCount(cx);
   MOZ_ASSERT(
       !cx->wasm().promiseIntegration.suspendedStacks_.ElementProbablyInList(
@@ -181,7 +181,7 @@ class SuspenderObjectData
     return suspendedReturnAddress_;
   }
 
-  void releaseStackMemory();
+  void releaseStackMemory(SuspenderContext& scx);
 
 #if defined(_WIN32)
   void updateTIBStackFields();
@@ -884,11 +884,12 @@ CoderResult CodeModuleElemSegment(Coder<mode>& coder,
 template <CoderMode mode>
 CoderResult CodeDataSegment(Coder<mode>& coder,
                             CoderArg<mode, DataSegment> item) {
-  WASM_VERIFY_SERIALIZATION_FOR_SIZE(wasm::DataSegment, 144);
+  WASM_VERIFY_SERIALIZATION_FOR_SIZE(wasm::DataSegment, 184);
   MOZ_TRY(CodePod(coder, &item->memoryIndex));
   MOZ_TRY((CodeMaybe<mode, InitExpr, &CodeInitExpr<mode>>(
       coder, &item->offsetIfActive)));
   MOZ_TRY(CodePodVector(coder, &item->bytes));
+  MOZ_TRY(CodePodVector(coder, &item->nonZeroRanges));
   return Ok();
 }
 
@@ -1058,6 +1059,9 @@ CoderResult CodeStackMaps(Coder<MODE_DECODE>& coder,
   // Decode the amount of stack maps
   size_t length;
   MOZ_TRY(CodePod(coder, &length));
+  if (!item->reserve(length)) {
+    return Err(OutOfMemory());
+  }
 
   for (size_t i = 0; i < length; i++) {
     // Decode the offset relative to codeStart
@@ -1070,9 +1074,7 @@ CoderResult CodeStackMaps(Coder<MODE_DECODE>& coder,
 
     // Add it to the map
     const uint8_t* nextInsnAddr = codeStart + codeOffset;
-    if (!item->add(nextInsnAddr, map)) {
-      return Err(OutOfMemory());
-    }
+    MOZ_ALWAYS_TRUE(item->add(nextInsnAddr, map));
   }
 
   // Finish the maps, asserting they are sorted
@@ -27,6 +27,7 @@
 #include "vm/JSContext.h"
 #include "vm/Realm.h"
 #include "wasm/WasmDump.h"
+#include "wasm/WasmGenerator.h"  // ValidateFunctionBodiesOffThread
 #include "wasm/WasmInitExpr.h"
 #include "wasm/WasmOpIter.h"
 #include "wasm/WasmTypeDecls.h"
@@ -4026,6 +4027,30 @@ static bool DecodeFunctionBody(Decoder& d, const CodeMetadata& codeMeta,
   return ValidateFunctionBody(codeMeta, funcIndex, bodySize, d);
 }
 
+// Code sections smaller than this are not worth validating off thread.
+static constexpr uint32_t MinParallelValidationBytes = 1024 * 1024;
+
+// Read the size of every function body and skip over it, appending its range
+// in the module to `funcDefBodies`.
+static bool SkipFunctionBodies(Decoder& d, uint32_t numFuncDefs,
+                               BytecodeRangeVector* funcDefBodies) {
+  if (!funcDefBodies->reserve(numFuncDefs)) {
+    return false;
+  }
+  for (uint32_t funcDefIndex = 0; funcDefIndex < numFuncDefs; funcDefIndex++) {
+    uint32_t bodySize;
+    if (!d.readVarU32(&bodySize) || bodySize > MaxFunctionBytes) {
+      return false;
+    }
+    uint32_t bodyOffset = d.currentOffset();
+    if (!d.readBytes(bodySize)) {
+      return false;
+    }
+    funcDefBodies->infallibleEmplaceBack(bodyOffset, bodySize);
+  }
+  return true;
+}
+
 static bool DecodeCodeSection(Decoder& d, CodeMetadata* codeMeta) {
   if (!codeMeta->codeSectionRange) {
     if (codeMeta->numFuncDefs() != 0) {
@@ -4044,6 +4069,21 @@ static bool DecodeCodeSection(Decoder& d, CodeMetadata* codeMeta) {
         "function body count does not match function signature count");
   }
 
+  // Large code sections are first validated on helper threads. If that fails
+  // for any reason, the bodies are validated again serially below, so that an
+  // invalid module reports the error of its first invalid body.
+  if (codeMeta->codeSectionRange->size >= MinParallelValidationBytes) {
+    const uint8_t* bodiesBegin = d.currentPosition();
+    BytecodeRangeVector funcDefBodies;
+    if (SkipFunctionBodies(d, numFuncDefs, &funcDefBodies) &&
+        ValidateFunctionBodiesOffThread(*codeMeta, d.begin() - d.beginOffset(),
+                                        funcDefBodies)) {
+      return d.finishSection(*codeMeta->codeSectionRange, "code");
+    }
+    d.clearError();
+    d.rollbackPosition(bodiesBegin);
+  }
+
   for (uint32_t funcDefIndex = 0; funcDefIndex < numFuncDefs; funcDefIndex++) {
     if (!DecodeFunctionBody(d, *codeMeta,
                             codeMeta->numFuncImports + funcDefIndex)) {
@@ -1823,7 +1823,13 @@ static void ReportRealmStats(const JS::RealmStats& realmStats,
                  "GC allocation site data associated with IC stubs.");
 
   ZRREPORT_BYTES(realmJSPathPrefix + "ion-data"_ns, realmStats.ionData,
-                 "The IonMonkey JIT's compilation data (IonScripts).");
+                 "The IonMonkey JIT's compilation data (IonScripts), excluding "
+                 "bailout snapshots.");
+
+  ZRREPORT_BYTES(realmJSPathPrefix + "ion-snapshots"_ns,
+                 realmStats.ionSnapshots,
+                 "The IonMonkey JIT's bailout snapshots and recover "
+                 "instructions.");
 
   ZRREPORT_BYTES(realmJSPathPrefix + "jit-scripts"_ns, realmStats.jitScripts,
                  "JIT data associated with scripts.");
@@ -134,6 +134,18 @@ class BitBloomFilter {
   void add(uint32_t aHash);
   bool mightContain(uint32_t aHash) const;
 
+  /*
+   * Raw access to the filter's bit array, so that it can be saved and later
+   * merged into another filter with the same KeySize.
+   */
+  static constexpr size_t bitsLength() { return kArraySize; }
+  const uint8_t* bits() const { return mBits; }
+  void addBits(const uint8_t* aBits) {
+    for (size_t i = 0; i < kArraySize; i++) {
+      mBits[i] |= aBits[i];
+    }
+  }
+
  private:
   static const size_t kArraySize = (1 << (KeySize - 3));
   static const uint32_t kKeyMask = (1 << KeySize) - 1;